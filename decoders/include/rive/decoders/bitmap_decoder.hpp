@@ -40,7 +40,37 @@ public:
     size_t byteSize(PixelFormat format) const;
     size_t bytesPerPixel(PixelFormat format) const;
 
+    struct DecodeOptions
+    {
+        // If nonzero, the caller never needs more than maxWidth x maxHeight pixels. Decoders that
+        // can scale while decoding (jpeg, webp, CoreGraphics) skip the extra resolution, keeping
+        // the aspect ratio and never going below FitWithin() of the image.
+        uint32_t maxWidth = 0;
+        uint32_t maxHeight = 0;
+        // Decode straight to RGBA, even if the image has no alpha.
+        bool forceRGBA = false;
+        // Premultiply RGBA output by alpha.
+        bool premultiplyAlpha = false;
+    };
+
     static std::unique_ptr<Bitmap> decode(const uint8_t bytes[], size_t byteCount);
+    static std::unique_ptr<Bitmap> decode(const uint8_t bytes[],
+                                          size_t byteCount,
+                                          const DecodeOptions&);
+
+    // Dimensions of a width x height image scaled down (never up) to fit within the options'
+    // maxWidth x maxHeight.
+    static void FitWithin(const DecodeOptions&,
+                          uint32_t width,
+                          uint32_t height,
+                          uint32_t* fitWidth,
+                          uint32_t* fitHeight);
+
+    // Converts pixelCount RGB pixels to opaque RGBA. src and dst may not overlap.
+    static void ExpandRGBToRGBA(const uint8_t* src, uint8_t* dst, size_t pixelCount);
+
+    // Multiplies the color of pixelCount RGBA pixels by their alpha, in place.
+    static void PremultiplyRGBA(uint8_t* pixels, size_t pixelCount);
 
     // Change the pixel format (note this will resize bytes).
     void pixelFormat(PixelFormat format);
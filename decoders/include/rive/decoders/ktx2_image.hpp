@@ -0,0 +1,67 @@
+/*
+ * Copyright 2024 Rive
+ */
+
+#ifndef _RIVE_KTX2_IMAGE_HPP_
+#define _RIVE_KTX2_IMAGE_HPP_
+
+#include <memory>
+#include <stdint.h>
+#include <stddef.h>
+#include <vector>
+
+class Bitmap;
+
+/// A 2D image from a KTX2 container, with its full mip chain in the format it was encoded in.
+/// Block-compressed levels are left compressed so they can be uploaded to the GPU as-is.
+///
+/// The levels point into the encoded bytes, which must outlive the KTX2Image.
+class KTX2Image
+{
+public:
+    enum class Format : uint8_t
+    {
+        rgba8,     // VK_FORMAT_R8G8B8A8_UNORM/SRGB
+        etc2RGBA8, // VK_FORMAT_ETC2_R8G8B8A8_UNORM/SRGB_BLOCK
+        astc4x4,   // VK_FORMAT_ASTC_4x4_UNORM/SRGB_BLOCK
+        bc7,       // VK_FORMAT_BC7_UNORM/SRGB_BLOCK
+    };
+
+    struct Level
+    {
+        uint32_t width;
+        uint32_t height;
+        const uint8_t* bytes;
+        size_t byteCount;
+    };
+
+    /// True if the bytes start with the KTX2 file identifier.
+    static bool IsKTX2(const uint8_t bytes[], size_t byteCount);
+
+    /// Parses the container and validates the level index. Returns null for malformed files, and
+    /// for payloads we can't hand to a GPU directly: supercompressed levels (BasisLZ, zstd, zlib),
+    /// UASTC/ETC1S (which need the Basis Universal transcoder), arrays, cubemaps, and 3D images.
+    static std::unique_ptr<KTX2Image> decode(const uint8_t bytes[], size_t byteCount);
+
+    /// Bytes of one level in the given format. Block formats use 4x4 blocks of 16 bytes.
+    static size_t LevelByteCount(Format, uint32_t width, uint32_t height);
+
+    Format format() const { return m_format; }
+    bool isBlockCompressed() const { return m_format != Format::rgba8; }
+    uint32_t width() const { return m_levels[0].width; }
+    uint32_t height() const { return m_levels[0].height; }
+    const std::vector<Level>& levels() const { return m_levels; }
+
+    /// Decodes a level to an RGBA Bitmap on the CPU, for GPUs that can't sample its block format.
+    std::unique_ptr<Bitmap> decodeLevel(size_t levelIndex) const;
+
+private:
+    KTX2Image(Format format, std::vector<Level> levels) :
+        m_format(format), m_levels(std::move(levels))
+    {}
+
+    Format m_format;
+    std::vector<Level> m_levels; // Level 0 is the full-size image.
+};
+
+#endif
@@ -18,7 +18,11 @@ do
 
     includedirs({ 'include', '../include', libpng, libjpeg, libwebp .. '/src' })
 
-    files({ 'src/bitmap_decoder.cpp' })
+    files({
+        'src/bitmap_decoder.cpp',
+        'src/ktx2_image.cpp',
+        'src/decode_block_formats.cpp',
+    })
 
     filter({ 'options:not no-libjpeg-renames' })
     do
@@ -4,6 +4,8 @@
 
 #include "rive/decoders/bitmap_decoder.hpp"
 #include "rive/rive_types.hpp"
+#include "rive/math/simd.hpp"
+#include <cmath>
 #include <stdio.h>
 #include <string.h>
 #include <vector>
@@ -38,6 +40,87 @@ size_t Bitmap::byteSize(PixelFormat format) const
 
 size_t Bitmap::byteSize() const { return byteSize(m_PixelFormat); }
 
+void Bitmap::FitWithin(const DecodeOptions& options,
+                       uint32_t width,
+                       uint32_t height,
+                       uint32_t* fitWidth,
+                       uint32_t* fitHeight)
+{
+    double scale = 1;
+    if (options.maxWidth != 0 && options.maxWidth < width)
+    {
+        scale = static_cast<double>(options.maxWidth) / width;
+    }
+    if (options.maxHeight != 0 && options.maxHeight < height)
+    {
+        scale = std::min(scale, static_cast<double>(options.maxHeight) / height);
+    }
+    if (scale >= 1)
+    {
+        *fitWidth = width;
+        *fitHeight = height;
+        return;
+    }
+    // Round up so the result still covers the requested size on its limiting axis.
+    *fitWidth = std::max(static_cast<uint32_t>(std::ceil(width * scale - 1e-6)), 1u);
+    *fitHeight = std::max(static_cast<uint32_t>(std::ceil(height * scale - 1e-6)), 1u);
+}
+
+void Bitmap::ExpandRGBToRGBA(const uint8_t* src, uint8_t* dst, size_t pixelCount)
+{
+    size_t i = 0;
+#if SIMD_NATIVE_GVEC && __has_builtin(__builtin_shufflevector)
+    // Expand 4 pixels at a time. Each iteration reads 16 bytes but only consumes 12, so stop while
+    // there are still 4 bytes of slack.
+    const rive::uint8x16 opaque = {0, 0, 0, 255, 0, 0, 0, 255, 0, 0, 0, 255, 0, 0, 0, 255};
+    for (; i + 6 <= pixelCount; i += 4)
+    {
+        auto rgb = rive::simd::load<uint8_t, 16>(src + i * 3);
+        rive::uint8x16 rgba =
+            __builtin_shufflevector(rgb, rgb, 0, 1, 2, 0, 3, 4, 5, 0, 6, 7, 8, 0, 9, 10, 11, 0);
+        rive::simd::store(dst + i * 4, rgba | opaque);
+    }
+#endif
+    for (; i < pixelCount; ++i)
+    {
+        dst[i * 4 + 0] = src[i * 3 + 0];
+        dst[i * 4 + 1] = src[i * 3 + 1];
+        dst[i * 4 + 2] = src[i * 3 + 2];
+        dst[i * 4 + 3] = 255;
+    }
+}
+
+void Bitmap::PremultiplyRGBA(uint8_t* pixels, size_t pixelCount)
+{
+    size_t i = 0;
+    // Process 2 pixels at once.
+    for (; i + 2 <= pixelCount; i += 2)
+    {
+        auto twoPixels = rive::simd::load<uint8_t, 8>(pixels + i * 4);
+        uint8_t a0 = twoPixels[3];
+        uint8_t a1 = twoPixels[7];
+        if ((a0 & a1) == 255)
+        {
+            continue; // Both opaque.
+        }
+        // Cast to 16 bits to avoid overflow, and divide by 255 with rounding.
+        rive::uint16x8 rgbaWidex2 = rive::simd::cast<uint16_t>(twoPixels);
+        rgbaWidex2 *= rive::uint16x8{a0, a0, a0, 255, a1, a1, a1, 255};
+        rgbaWidex2 += 128;
+        rgbaWidex2 = (rgbaWidex2 + (rgbaWidex2 >> 8)) >> 8;
+        rive::simd::store(pixels + i * 4, rive::simd::cast<uint8_t>(rgbaWidex2));
+    }
+    for (; i < pixelCount; ++i)
+    {
+        uint8_t* rgba = pixels + i * 4;
+        for (int j = 0; j < 3; ++j)
+        {
+            uint32_t x = rgba[j] * rgba[3] + 128;
+            rgba[j] = static_cast<uint8_t>((x + (x >> 8)) >> 8);
+        }
+    }
+}
+
 void Bitmap::pixelFormat(PixelFormat format)
 {
     if (format == m_PixelFormat)
@@ -47,6 +130,14 @@ void Bitmap::pixelFormat(PixelFormat format)
     auto nextByteSize = byteSize(format);
     auto nextBytes = std::unique_ptr<uint8_t[]>(new uint8_t[nextByteSize]);
 
+    if (m_PixelFormat == PixelFormat::RGB && format == PixelFormat::RGBA)
+    {
+        ExpandRGBToRGBA(m_Bytes.get(), nextBytes.get(), static_cast<size_t>(m_Width) * m_Height);
+        m_Bytes = std::move(nextBytes);
+        m_PixelFormat = format;
+        return;
+    }
+
     size_t fromBytesPerPixel = bytesPerPixel(m_PixelFormat);
     size_t toBytesPerPixel = bytesPerPixel(format);
     int writeIndex = 0;
@@ -33,6 +33,7 @@ struct PlatformCGImage
 
 bool cg_image_decode(const uint8_t* encodedBytes,
                      size_t encodedSizeInBytes,
+                     const Bitmap::DecodeOptions& options,
                      PlatformCGImage* platformImage)
 {
     AutoCF data = CFDataCreate(kCFAllocatorDefault, encodedBytes, encodedSizeInBytes);
@@ -53,6 +54,34 @@ bool cg_image_decode(const uint8_t* encodedBytes,
         return false;
     }
 
+    // Let ImageIO decode at reduced resolution when the caller doesn't need all of it.
+    uint32_t fitWidth, fitHeight;
+    Bitmap::FitWithin(options,
+                      rive::castTo<uint32_t>(CGImageGetWidth(image)),
+                      rive::castTo<uint32_t>(CGImageGetHeight(image)),
+                      &fitWidth,
+                      &fitHeight);
+    if (fitWidth < CGImageGetWidth(image) || fitHeight < CGImageGetHeight(image))
+    {
+        int maxPixelSize = std::max(fitWidth, fitHeight);
+        AutoCF maxPixelSizeNumber =
+            CFNumberCreate(kCFAllocatorDefault, kCFNumberIntType, &maxPixelSize);
+        const void* keys[] = {kCGImageSourceCreateThumbnailFromImageAlways,
+                              kCGImageSourceThumbnailMaxPixelSize};
+        const void* values[] = {kCFBooleanTrue, maxPixelSizeNumber.get()};
+        AutoCF thumbnailOptions = CFDictionaryCreate(kCFAllocatorDefault,
+                                                     keys,
+                                                     values,
+                                                     2,
+                                                     &kCFTypeDictionaryKeyCallBacks,
+                                                     &kCFTypeDictionaryValueCallBacks);
+        AutoCF thumbnail = CGImageSourceCreateThumbnailAtIndex(source, 0, thumbnailOptions);
+        if (thumbnail)
+        {
+            image = thumbnail;
+        }
+    }
+
     bool isOpaque = false;
     switch (CGImageGetAlphaInfo(image.get()))
     {
@@ -103,13 +132,27 @@ bool cg_image_decode(const uint8_t* encodedBytes,
 }
 
 std::unique_ptr<Bitmap> Bitmap::decode(const uint8_t bytes[], size_t byteCount)
+{
+    return decode(bytes, byteCount, DecodeOptions());
+}
+
+std::unique_ptr<Bitmap> Bitmap::decode(const uint8_t bytes[],
+                                       size_t byteCount,
+                                       const DecodeOptions& options)
 {
     PlatformCGImage image;
-    if (!cg_image_decode(bytes, byteCount, &image))
+    if (!cg_image_decode(bytes, byteCount, options, &image))
     {
         return nullptr;
     }
 
+    if (options.premultiplyAlpha)
+    {
+        // CG already gave us what we want.
+        return std::make_unique<Bitmap>(
+            image.width, image.height, PixelFormat::RGBA, std::move(image.pixels));
+    }
+
     // CG only supports premultiplied alpha. Unmultiply now.
     size_t imageNumPixels = image.height * image.width;
     size_t imageSizeInBytes = imageNumPixels * 4;
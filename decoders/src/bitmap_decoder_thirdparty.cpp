@@ -8,11 +8,19 @@
 #include <string.h>
 #include <vector>
 
-std::unique_ptr<Bitmap> DecodePng(const uint8_t bytes[], size_t byteCount);
-std::unique_ptr<Bitmap> DecodeJpeg(const uint8_t bytes[], size_t byteCount);
-std::unique_ptr<Bitmap> DecodeWebP(const uint8_t bytes[], size_t byteCount);
+std::unique_ptr<Bitmap> DecodePng(const uint8_t bytes[],
+                                  size_t byteCount,
+                                  const Bitmap::DecodeOptions&);
+std::unique_ptr<Bitmap> DecodeJpeg(const uint8_t bytes[],
+                                   size_t byteCount,
+                                   const Bitmap::DecodeOptions&);
+std::unique_ptr<Bitmap> DecodeWebP(const uint8_t bytes[],
+                                   size_t byteCount,
+                                   const Bitmap::DecodeOptions&);
 
-using BitmapDecoder = std::unique_ptr<Bitmap> (*)(const uint8_t bytes[], size_t byteCount);
+using BitmapDecoder = std::unique_ptr<Bitmap> (*)(const uint8_t bytes[],
+                                                  size_t byteCount,
+                                                  const Bitmap::DecodeOptions&);
 struct ImageFormat
 {
     const char* name;
@@ -21,6 +29,13 @@ struct ImageFormat
 };
 
 std::unique_ptr<Bitmap> Bitmap::decode(const uint8_t bytes[], size_t byteCount)
+{
+    return decode(bytes, byteCount, DecodeOptions());
+}
+
+std::unique_ptr<Bitmap> Bitmap::decode(const uint8_t bytes[],
+                                       size_t byteCount,
+                                       const DecodeOptions& options)
 {
     static ImageFormat decoders[] = {
         {
@@ -58,7 +73,7 @@ std::unique_ptr<Bitmap> Bitmap::decode(const uint8_t bytes[], size_t byteCount)
             continue;
         }
 
-        auto bitmap = recognizer.decodeImage(bytes, byteCount);
+        auto bitmap = recognizer.decodeImage(bytes, byteCount, options);
         if (!bitmap)
         {
             fprintf(stderr, "Bitmap::decode - failed to decode a %s.\n", recognizer.name);
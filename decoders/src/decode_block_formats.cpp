@@ -0,0 +1,1173 @@
+/*
+ * Copyright 2024 Rive
+ */
+
+// CPU decoders for the block-compressed formats KTX2Image understands, for GPUs that can't sample
+// them. Each decodes one 4x4 block of 16 bytes to 16 RGBA8 pixels, in rows.
+
+#include <algorithm>
+#include <stdint.h>
+#include <string.h>
+
+static uint8_t clamp255(int x) { return static_cast<uint8_t>(std::min(std::max(x, 0), 255)); }
+
+// Reads little-endian bit fields out of a 128-bit block. Bits outside [0, end) read as 0.
+class BlockBitReader
+{
+public:
+    BlockBitReader(const uint8_t block[16], int end = 128) : m_block(block), m_end(end) {}
+
+    uint32_t read(int bit, int count) const
+    {
+        uint32_t value = 0;
+        for (int i = 0; i < count; ++i)
+        {
+            int b = bit + i;
+            if (b >= 0 && b < m_end && (m_block[b >> 3] >> (b & 7)) & 1)
+            {
+                value |= 1u << i;
+            }
+        }
+        return value;
+    }
+
+    // Reads the next 'count' bits, advancing the cursor.
+    uint32_t next(int count)
+    {
+        uint32_t value = read(m_cursor, count);
+        m_cursor += count;
+        return value;
+    }
+
+    void seek(int bit) { m_cursor = bit; }
+
+private:
+    const uint8_t* m_block;
+    int m_end;
+    int m_cursor = 0;
+};
+
+// BC7 (https://learn.microsoft.com/en-us/windows/win32/direct3d11/bc7-format-mode-reference).
+
+struct BC7Mode
+{
+    uint8_t subsetCount;
+    uint8_t partitionBits;
+    uint8_t rotationBits;
+    uint8_t indexSelectionBits;
+    uint8_t colorBits;
+    uint8_t alphaBits;
+    uint8_t endpointPBits; // One P-bit per endpoint.
+    uint8_t sharedPBits;   // One P-bit per subset, shared by both of its endpoints.
+    uint8_t indexBits;
+    uint8_t secondaryIndexBits;
+};
+
+static const BC7Mode kBC7Modes[8] = {
+    {3, 4, 0, 0, 4, 0, 1, 0, 3, 0},
+    {2, 6, 0, 0, 6, 0, 0, 1, 3, 0},
+    {3, 6, 0, 0, 5, 0, 0, 0, 2, 0},
+    {2, 6, 0, 0, 7, 0, 1, 0, 2, 0},
+    {1, 0, 2, 1, 5, 6, 0, 0, 2, 3},
+    {1, 0, 2, 0, 7, 8, 0, 0, 2, 2},
+    {1, 0, 0, 0, 7, 7, 1, 0, 4, 0},
+    {2, 6, 0, 0, 5, 5, 1, 0, 2, 0},
+};
+
+// Bit i is the subset of pixel i.
+static const uint16_t kBC7Partitions2[64] = {
+    0xcccc, 0x8888, 0xeeee, 0xecc8, 0xc880, 0xfeec, 0xfec8, 0xec80, 0xc800, 0xffec, 0xfe80,
+    0xe800, 0xffe8, 0xff00, 0xfff0, 0xf000, 0xf710, 0x008e, 0x7100, 0x08ce, 0x008c, 0x7310,
+    0x3100, 0x8cce, 0x088c, 0x3110, 0x6666, 0x366c, 0x17e8, 0x0ff0, 0x718e, 0x399c, 0xaaaa,
+    0xf0f0, 0x5a5a, 0x33cc, 0x3c3c, 0x55aa, 0x9696, 0xa55a, 0x73ce, 0x13c8, 0x324c, 0x3bdc,
+    0x6996, 0xc33c, 0x9966, 0x0660, 0x0272, 0x04e4, 0x4e40, 0x2720, 0xc936, 0x936c, 0x39c6,
+    0x639c, 0x9336, 0x9cc6, 0x817e, 0xe718, 0xccf0, 0x0fcc, 0x7744, 0xee22,
+};
+
+// Bits 2i and 2i + 1 are the subset of pixel i.
+static const uint32_t kBC7Partitions3[64] = {
+    0xaa685050, 0x6a5a5040, 0x5a5a4200, 0x5450a0a8, 0xa5a50000, 0xa0a05050, 0x5555a0a0,
+    0x5a5a5050, 0xaa550000, 0xaa555500, 0xaaaa5500, 0x90909090, 0x94949494, 0xa4a4a4a4,
+    0xa9a59450, 0x2a0a4250, 0xa5945040, 0x0a425054, 0xa5a5a500, 0x55a0a0a0, 0xa8a85454,
+    0x6a6a4040, 0xa4a45000, 0x1a1a0500, 0x0050a4a4, 0xaaa59090, 0x14696914, 0x69691400,
+    0xa08585a0, 0xaa821414, 0x50a4a450, 0x6a5a0200, 0xa9a58000, 0x5090a0a8, 0xa8a09050,
+    0x24242424, 0x00aa5500, 0x24924924, 0x24499224, 0x50a50a50, 0x500aa550, 0xaaaa4444,
+    0x66660000, 0xa5a0a5a0, 0x50a050a0, 0x69286928, 0x44aaaa44, 0x66666600, 0xaa444444,
+    0x54a854a8, 0x95809580, 0x96969600, 0xa85454a8, 0x80959580, 0xaa141414, 0x96960000,
+    0xaaaa1414, 0xa05050a0, 0xa0a5a5a0, 0x96000000, 0x40804080, 0xa9a8a9a8, 0xaaaaaa44,
+    0x2a4a5254,
+};
+
+// Pixels whose index drops its top bit: the second subset's, of two.
+static const uint8_t kBC7Anchors2[64] = {
+    15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 2,  8,  2,  2,  8,
+    8,  15, 2,  8,  2,  2,  8,  8,  2,  2,  15, 15, 6,  8,  2,  8,  15, 15, 2,  8,  2,  2,
+    2,  15, 15, 6,  6,  2,  6,  8,  15, 15, 2,  2,  15, 15, 15, 15, 15, 2,  2,  15,
+};
+
+// The second and third subsets', of three.
+static const uint8_t kBC7Anchors3[2][64] = {
+    {3,  3,  15, 15, 8,  3,  15, 15, 8,  8,  6,  6,  6,  5,  3,  3,  3,  3,  8,  15, 3,  3,
+     6,  10, 5,  8,  8,  6,  8,  5,  15, 15, 8,  15, 3,  5,  6,  10, 8,  15, 15, 3,  15, 5,
+     15, 15, 15, 15, 3,  15, 5,  5,  5,  8,  5,  10, 5,  10, 8,  13, 15, 12, 3,  3},
+    {15, 8,  8,  3,  15, 15, 3,  8,  15, 15, 15, 15, 15, 15, 15, 8,  15, 8,  15, 3,  15, 8,
+     15, 8,  3,  15, 6,  10, 15, 15, 10, 8,  15, 3,  15, 10, 10, 8,  9,  10, 6,  15, 8,  15,
+     3,  6,  6,  8,  15, 3,  15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 3,  15, 15, 8},
+};
+
+static const uint8_t kBC7Weights2[4] = {0, 21, 43, 64};
+static const uint8_t kBC7Weights3[8] = {0, 9, 18, 27, 37, 46, 55, 64};
+static const uint8_t kBC7Weights4[16] =
+    {0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+
+static const uint8_t* bc7_weights(int indexBits)
+{
+    return indexBits == 2 ? kBC7Weights2 : indexBits == 3 ? kBC7Weights3 : kBC7Weights4;
+}
+
+static uint8_t bc7_interpolate(int e0, int e1, int weight)
+{
+    return static_cast<uint8_t>((e0 * (64 - weight) + e1 * weight + 32) >> 6);
+}
+
+void DecodeBC7Block(const uint8_t block[16], uint8_t rgba[64])
+{
+    int modeIndex = 0;
+    while (modeIndex < 8 && !(block[0] & (1 << modeIndex)))
+    {
+        ++modeIndex;
+    }
+    if (modeIndex == 8)
+    {
+        // Reserved. Decodes to transparent black.
+        memset(rgba, 0, 64);
+        return;
+    }
+    const BC7Mode& mode = kBC7Modes[modeIndex];
+    BlockBitReader bits(block);
+    bits.seek(modeIndex + 1);
+    int partition = bits.next(mode.partitionBits);
+    int rotation = bits.next(mode.rotationBits);
+    int indexSelection = bits.next(mode.indexSelectionBits);
+
+    int endpoints[3][2][4]; // [subset][endpoint][channel]
+    for (int channel = 0; channel < 4; ++channel)
+    {
+        int channelBits = channel < 3 ? mode.colorBits : mode.alphaBits;
+        for (int subset = 0; subset < mode.subsetCount; ++subset)
+        {
+            for (int e = 0; e < 2; ++e)
+            {
+                endpoints[subset][e][channel] = bits.next(channelBits);
+            }
+        }
+    }
+    bool hasPBits = mode.endpointPBits || mode.sharedPBits;
+    for (int subset = 0; subset < mode.subsetCount; ++subset)
+    {
+        int sharedPBit = mode.sharedPBits ? bits.next(1) : 0;
+        for (int e = 0; e < 2; ++e)
+        {
+            int pBit = mode.endpointPBits ? bits.next(1) : sharedPBit;
+            for (int channel = 0; channel < 4; ++channel)
+            {
+                int channelBits = channel < 3 ? mode.colorBits : mode.alphaBits;
+                if (channelBits == 0)
+                {
+                    endpoints[subset][e][channel] = 255;
+                    continue;
+                }
+                int value = endpoints[subset][e][channel];
+                if (hasPBits)
+                {
+                    value = value << 1 | pBit;
+                    ++channelBits;
+                }
+                endpoints[subset][e][channel] =
+                    value << (8 - channelBits) | value >> (2 * channelBits - 8);
+            }
+        }
+    }
+
+    auto subsetOf = [&](int i) -> int {
+        switch (mode.subsetCount)
+        {
+            case 2:
+                return kBC7Partitions2[partition] >> i & 1;
+            case 3:
+                return kBC7Partitions3[partition] >> (i * 2) & 3;
+            default:
+                return 0;
+        }
+    };
+    auto isAnchor = [&](int i) {
+        return i == 0 || (mode.subsetCount == 2 && i == kBC7Anchors2[partition]) ||
+               (mode.subsetCount == 3 &&
+                (i == kBC7Anchors3[0][partition] || i == kBC7Anchors3[1][partition]));
+    };
+    int indices[16];
+    int secondaryIndices[16] = {};
+    for (int i = 0; i < 16; ++i)
+    {
+        indices[i] = bits.next(mode.indexBits - isAnchor(i));
+    }
+    if (mode.secondaryIndexBits)
+    {
+        for (int i = 0; i < 16; ++i)
+        {
+            secondaryIndices[i] = bits.next(mode.secondaryIndexBits - (i == 0));
+        }
+    }
+
+    for (int i = 0; i < 16; ++i)
+    {
+        const int(&e)[2][4] = endpoints[subsetOf(i)];
+        uint8_t* pixel = rgba + i * 4;
+        int colorIndexBits = mode.indexBits;
+        int colorIndex = indices[i];
+        int alphaIndexBits = mode.indexBits;
+        int alphaIndex = indices[i];
+        if (mode.secondaryIndexBits)
+        {
+            alphaIndexBits = mode.secondaryIndexBits;
+            alphaIndex = secondaryIndices[i];
+            if (indexSelection)
+            {
+                std::swap(colorIndexBits, alphaIndexBits);
+                std::swap(colorIndex, alphaIndex);
+            }
+        }
+        int colorWeight = bc7_weights(colorIndexBits)[colorIndex];
+        int alphaWeight = bc7_weights(alphaIndexBits)[alphaIndex];
+        for (int channel = 0; channel < 3; ++channel)
+        {
+            pixel[channel] = bc7_interpolate(e[0][channel], e[1][channel], colorWeight);
+        }
+        pixel[3] = bc7_interpolate(e[0][3], e[1][3], alphaWeight);
+        if (rotation != 0)
+        {
+            std::swap(pixel[3], pixel[rotation - 1]);
+        }
+    }
+}
+
+// ETC2 RGBA8: an EAC alpha block followed by an ETC2 RGB block, both big endian
+// (https://registry.khronos.org/DataFormat/specs/1.3/dataformat.1.3.html#ETC2).
+
+static const int kETC1Modifiers[8][2] =
+    {{2, 8}, {5, 17}, {9, 29}, {13, 42}, {18, 60}, {24, 80}, {33, 106}, {47, 183}};
+
+static const int kETC2Distances[8] = {3, 6, 11, 16, 23, 32, 41, 64};
+
+static const int kEACModifiers[16][8] = {
+    {-3, -6, -9, -15, 2, 5, 8, 14},
+    {-3, -7, -10, -13, 2, 6, 9, 12},
+    {-2, -5, -8, -13, 1, 4, 7, 12},
+    {-2, -4, -6, -13, 1, 3, 5, 12},
+    {-3, -6, -8, -12, 2, 5, 7, 11},
+    {-3, -7, -9, -11, 2, 6, 8, 10},
+    {-4, -7, -8, -11, 3, 6, 7, 10},
+    {-3, -5, -8, -11, 2, 4, 7, 10},
+    {-2, -6, -8, -10, 1, 5, 7, 9},
+    {-2, -5, -8, -10, 1, 4, 7, 9},
+    {-2, -4, -8, -10, 1, 3, 7, 9},
+    {-2, -5, -7, -10, 1, 4, 6, 9},
+    {-3, -4, -7, -10, 2, 3, 6, 9},
+    {-1, -2, -3, -10, 0, 1, 2, 9},
+    {-4, -6, -8, -9, 3, 5, 7, 8},
+    {-3, -5, -7, -9, 2, 4, 6, 8},
+};
+
+static int extend4(int x) { return x << 4 | x; }
+static int extend5(int x) { return x << 3 | x >> 2; }
+static int extend6(int x) { return x << 2 | x >> 4; }
+static int extend7(int x) { return x << 1 | x >> 6; }
+static int sign_extend3(int x) { return (x ^ 4) - 4; }
+
+static void decode_etc2_rgb(const uint8_t b[8], uint8_t rgba[64])
+{
+    // Pixel indices are stored in columns: pixel (x, y) is bit x * 4 + y of each half.
+    uint32_t indexBits = static_cast<uint32_t>(b[4]) << 24 | static_cast<uint32_t>(b[5]) << 16 |
+                         static_cast<uint32_t>(b[6]) << 8 | b[7];
+    auto pixelIndex = [indexBits](int x, int y) {
+        int i = x * 4 + y;
+        return static_cast<int>((indexBits >> (16 + i)) & 1) << 1 | ((indexBits >> i) & 1);
+    };
+    auto setPixel = [rgba](int x, int y, int r, int g, int b) {
+        uint8_t* pixel = rgba + (y * 4 + x) * 4;
+        pixel[0] = clamp255(r);
+        pixel[1] = clamp255(g);
+        pixel[2] = clamp255(b);
+    };
+
+    int base[2][3];
+    if (b[3] & 2)
+    {
+        int r = b[0] >> 3, dr = sign_extend3(b[0] & 7);
+        int g = b[1] >> 3, dg = sign_extend3(b[1] & 7);
+        int bl = b[2] >> 3, db = sign_extend3(b[2] & 7);
+        if (r + dr < 0 || r + dr > 31 || g + dg < 0 || g + dg > 31)
+        {
+            // T and H modes: four paint colors from two 4-bit base colors and a distance.
+            int c[2][3];
+            int d;
+            int paint[4][3];
+            if (r + dr < 0 || r + dr > 31)
+            {
+                c[0][0] = (b[0] >> 1 & 0xc) | (b[0] & 3);
+                c[0][1] = b[1] >> 4;
+                c[0][2] = b[1] & 0xf;
+                c[1][0] = b[2] >> 4;
+                c[1][1] = b[2] & 0xf;
+                c[1][2] = b[3] >> 4;
+                d = kETC2Distances[(b[3] >> 1 & 6) | (b[3] & 1)];
+                for (int i = 0; i < 3; ++i)
+                {
+                    paint[0][i] = extend4(c[0][i]);
+                    paint[1][i] = extend4(c[1][i]) + d;
+                    paint[2][i] = extend4(c[1][i]);
+                    paint[3][i] = extend4(c[1][i]) - d;
+                }
+            }
+            else
+            {
+                c[0][0] = b[0] >> 3 & 0xf;
+                c[0][1] = (b[0] << 1 & 0xe) | (b[1] >> 4 & 1);
+                c[0][2] = (b[1] & 8) | (b[1] << 1 & 6) | (b[2] >> 7);
+                c[1][0] = b[2] >> 3 & 0xf;
+                c[1][1] = (b[2] << 1 & 0xe) | (b[3] >> 7);
+                c[1][2] = b[3] >> 3 & 0xf;
+                int c0 = c[0][0] << 8 | c[0][1] << 4 | c[0][2];
+                int c1 = c[1][0] << 8 | c[1][1] << 4 | c[1][2];
+                d = kETC2Distances[(b[3] & 4) | (b[3] << 1 & 2) | (c0 >= c1)];
+                for (int i = 0; i < 3; ++i)
+                {
+                    paint[0][i] = extend4(c[0][i]) + d;
+                    paint[1][i] = extend4(c[0][i]) - d;
+                    paint[2][i] = extend4(c[1][i]) + d;
+                    paint[3][i] = extend4(c[1][i]) - d;
+                }
+            }
+            for (int y = 0; y < 4; ++y)
+            {
+                for (int x = 0; x < 4; ++x)
+                {
+                    const int* p = paint[pixelIndex(x, y)];
+                    setPixel(x, y, p[0], p[1], p[2]);
+                }
+            }
+            return;
+        }
+        if (bl + db < 0 || bl + db > 31)
+        {
+            // Planar mode: a gradient between an origin and horizontal and vertical colors.
+            int o[3] = {extend6(b[0] >> 1 & 0x3f),
+                        extend7((b[0] & 1) << 6 | (b[1] >> 1 & 0x3f)),
+                        extend6((b[1] & 1) << 5 | (b[2] & 0x18) | (b[2] << 1 & 6) | (b[3] >> 7))};
+            int h[3] = {extend6((b[3] >> 1 & 0x3e) | (b[3] & 1)),
+                        extend7(b[4] >> 1),
+                        extend6((b[4] & 1) << 5 | (b[5] >> 3))};
+            int v[3] = {extend6((b[5] & 7) << 3 | (b[6] >> 5)),
+                        extend7((b[6] & 0x1f) << 2 | (b[7] >> 6)),
+                        extend6(b[7] & 0x3f)};
+            for (int y = 0; y < 4; ++y)
+            {
+                for (int x = 0; x < 4; ++x)
+                {
+                    int color[3];
+                    for (int i = 0; i < 3; ++i)
+                    {
+                        color[i] = (x * (h[i] - o[i]) + y * (v[i] - o[i]) + 4 * o[i] + 2) >> 2;
+                    }
+                    setPixel(x, y, color[0], color[1], color[2]);
+                }
+            }
+            return;
+        }
+        // Differential mode.
+        int first[3] = {r, g, bl};
+        int second[3] = {r + dr, g + dg, bl + db};
+        for (int i = 0; i < 3; ++i)
+        {
+            base[0][i] = extend5(first[i]);
+            base[1][i] = extend5(second[i]);
+        }
+    }
+    else
+    {
+        // Individual mode.
+        for (int i = 0; i < 3; ++i)
+        {
+            base[0][i] = extend4(b[i] >> 4);
+            base[1][i] = extend4(b[i] & 0xf);
+        }
+    }
+
+    int tables[2] = {b[3] >> 5, b[3] >> 2 & 7};
+    bool flip = b[3] & 1;
+    for (int y = 0; y < 4; ++y)
+    {
+        for (int x = 0; x < 4; ++x)
+        {
+            int subblock = flip ? y >= 2 : x >= 2;
+            int index = pixelIndex(x, y);
+            int modifier = kETC1Modifiers[tables[subblock]][index & 1];
+            if (index & 2)
+            {
+                modifier = -modifier;
+            }
+            const int* c = base[subblock];
+            setPixel(x, y, c[0] + modifier, c[1] + modifier, c[2] + modifier);
+        }
+    }
+}
+
+static void decode_eac_alpha(const uint8_t b[8], uint8_t rgba[64])
+{
+    int base = b[0];
+    int multiplier = b[1] >> 4;
+    const int* modifiers = kEACModifiers[b[1] & 0xf];
+    uint64_t indexBits = 0;
+    for (int i = 2; i < 8; ++i)
+    {
+        indexBits = indexBits << 8 | b[i];
+    }
+    for (int x = 0; x < 4; ++x)
+    {
+        for (int y = 0; y < 4; ++y)
+        {
+            int index = (indexBits >> (45 - 3 * (x * 4 + y))) & 7;
+            rgba[(y * 4 + x) * 4 + 3] = clamp255(base + modifiers[index] * multiplier);
+        }
+    }
+}
+
+void DecodeETC2RGBA8Block(const uint8_t block[16], uint8_t rgba[64])
+{
+    decode_etc2_rgb(block + 8, rgba);
+    decode_eac_alpha(block, rgba);
+}
+
+// ASTC 4x4, LDR profile
+// (https://registry.khronos.org/DataFormat/specs/1.3/dataformat.1.3.html#ASTC). Blocks that are
+// malformed decode to the error color (magenta), as do the texels of partitions with HDR endpoints.
+
+static const uint8_t kASTCErrorColor[4] = {255, 0, 255, 255};
+
+static void fill_astc_error(uint8_t rgba[64])
+{
+    for (int i = 0; i < 16; ++i)
+    {
+        memcpy(rgba + i * 4, kASTCErrorColor, 4);
+    }
+}
+
+// Integer sequence encoding of values in [0, levels): 'bits' low bits per value, plus a trit or
+// quint that's packed across blocks of five or three values.
+struct ISERange
+{
+    int levels;
+    int bits;
+    int trits;
+    int quints;
+};
+
+static const ISERange kISERanges[] = {
+    {2, 1, 0, 0},   {3, 0, 1, 0},   {4, 2, 0, 0},   {5, 0, 0, 1},   {6, 1, 1, 0},
+    {8, 3, 0, 0},   {10, 1, 0, 1},  {12, 2, 1, 0},  {16, 4, 0, 0},  {20, 2, 0, 1},
+    {24, 3, 1, 0},  {32, 5, 0, 0},  {40, 3, 0, 1},  {48, 4, 1, 0},  {64, 6, 0, 0},
+    {80, 4, 0, 1},  {96, 5, 1, 0},  {128, 7, 0, 0}, {160, 5, 0, 1}, {192, 6, 1, 0},
+    {256, 8, 0, 0},
+};
+constexpr static int kISERangeCount = sizeof(kISERanges) / sizeof(kISERanges[0]);
+
+static const ISERange* ise_range(int levels)
+{
+    for (const ISERange& range : kISERanges)
+    {
+        if (range.levels == levels)
+        {
+            return &range;
+        }
+    }
+    return nullptr;
+}
+
+static int ise_bit_count(const ISERange& range, int count)
+{
+    return count * range.bits + (range.trits ? (count * 8 + 4) / 5 : 0) +
+           (range.quints ? (count * 7 + 2) / 3 : 0);
+}
+
+static void decode_trits(uint32_t t, int trits[5])
+{
+    int c;
+    if ((t >> 2 & 7) == 7)
+    {
+        c = (t >> 5 & 7) << 2 | (t & 3);
+        trits[4] = 2;
+        trits[3] = 2;
+    }
+    else
+    {
+        c = t & 0x1f;
+        if ((t >> 5 & 3) == 3)
+        {
+            trits[4] = 2;
+            trits[3] = t >> 7 & 1;
+        }
+        else
+        {
+            trits[4] = t >> 7 & 1;
+            trits[3] = t >> 5 & 3;
+        }
+    }
+    if ((c & 3) == 3)
+    {
+        trits[2] = 2;
+        trits[1] = c >> 4 & 1;
+        trits[0] = (c >> 3 & 1) << 1 | ((c >> 2 & 1) & ~(c >> 3 & 1));
+    }
+    else if ((c >> 2 & 3) == 3)
+    {
+        trits[2] = 2;
+        trits[1] = 2;
+        trits[0] = c & 3;
+    }
+    else
+    {
+        trits[2] = c >> 4 & 1;
+        trits[1] = c >> 2 & 3;
+        trits[0] = (c >> 1 & 1) << 1 | ((c & 1) & ~(c >> 1 & 1));
+    }
+}
+
+static void decode_quints(uint32_t q, int quints[3])
+{
+    if ((q >> 1 & 3) == 3 && (q >> 5 & 3) == 0)
+    {
+        int q0 = q & 1;
+        quints[2] = q0 << 2 | ((q >> 4 & 1) & ~q0 & 1) << 1 | ((q >> 3 & 1) & ~q0 & 1);
+        quints[1] = 4;
+        quints[0] = 4;
+        return;
+    }
+    int c;
+    if ((q >> 1 & 3) == 3)
+    {
+        quints[2] = 4;
+        c = (q >> 3 & 3) << 3 | (~q >> 5 & 3) << 1 | (q & 1);
+    }
+    else
+    {
+        quints[2] = q >> 5 & 3;
+        c = q & 0x1f;
+    }
+    if ((c & 7) == 5)
+    {
+        quints[1] = 4;
+        quints[0] = c >> 3 & 3;
+    }
+    else
+    {
+        quints[1] = c >> 3 & 3;
+        quints[0] = c & 7;
+    }
+}
+
+// Decodes 'count' values starting at 'bit'. Bits past the end of the sequence read as 0.
+static void decode_ise(const uint8_t block[16],
+                       int bit,
+                       const ISERange& range,
+                       int count,
+                       int values[])
+{
+    BlockBitReader bits(block, bit + ise_bit_count(range, count));
+    bits.seek(bit);
+    int m = range.bits;
+    for (int i = 0; i < count;)
+    {
+        if (range.trits)
+        {
+            int low[5];
+            uint32_t t = 0;
+            low[0] = bits.next(m);
+            t |= bits.next(2);
+            low[1] = bits.next(m);
+            t |= bits.next(2) << 2;
+            low[2] = bits.next(m);
+            t |= bits.next(1) << 4;
+            low[3] = bits.next(m);
+            t |= bits.next(2) << 5;
+            low[4] = bits.next(m);
+            t |= bits.next(1) << 7;
+            int trits[5];
+            decode_trits(t, trits);
+            for (int j = 0; j < 5 && i < count; ++j, ++i)
+            {
+                values[i] = trits[j] << m | low[j];
+            }
+        }
+        else if (range.quints)
+        {
+            int low[3];
+            uint32_t q = 0;
+            low[0] = bits.next(m);
+            q |= bits.next(3);
+            low[1] = bits.next(m);
+            q |= bits.next(2) << 3;
+            low[2] = bits.next(m);
+            q |= bits.next(2) << 5;
+            int quints[3];
+            decode_quints(q, quints);
+            for (int j = 0; j < 3 && i < count; ++j, ++i)
+            {
+                values[i] = quints[j] << m | low[j];
+            }
+        }
+        else
+        {
+            values[i++] = bits.next(m);
+        }
+    }
+}
+
+// Maps an encoded color endpoint value to [0, 255].
+static int unquantize_color(const ISERange& range, int value)
+{
+    int m = range.bits;
+    if (!range.trits && !range.quints)
+    {
+        // Replicate the bits out to 8.
+        int result = 0;
+        for (int shift = 8 - m; shift > -m; shift -= m)
+        {
+            result |= shift >= 0 ? value << shift : value >> -shift;
+        }
+        return result & 0xff;
+    }
+    int d = value >> m;
+    int a = value & 1 ? 0x1ff : 0;
+    int b = value >> 1 & 1, c = value >> 2 & 1, dd = value >> 3 & 1, e = value >> 4 & 1,
+        f = value >> 5 & 1;
+    int bb, cc;
+    if (range.trits)
+    {
+        switch (m)
+        {
+            case 1:
+                bb = 0, cc = 204;
+                break;
+            case 2:
+                bb = b * 0x116, cc = 93;
+                break;
+            case 3:
+                bb = c * 0x10a + b * 0x85, cc = 44;
+                break;
+            case 4:
+                bb = dd * 0x104 + c * 0x82 + b * 0x41, cc = 22;
+                break;
+            case 5:
+                bb = e * 0x102 + dd * 0x81 + c * 0x40 + b * 0x20, cc = 11;
+                break;
+            default:
+                bb = f * 0x101 + e * 0x80 + dd * 0x40 + c * 0x20 + b * 0x10, cc = 5;
+                break;
+        }
+    }
+    else
+    {
+        switch (m)
+        {
+            case 1:
+                bb = 0, cc = 113;
+                break;
+            case 2:
+                bb = b * 0x10c, cc = 54;
+                break;
+            case 3:
+                bb = c * 0x105 + b * 0x82, cc = 26;
+                break;
+            case 4:
+                bb = dd * 0x102 + c * 0x81 + b * 0x40, cc = 13;
+                break;
+            default:
+                bb = e * 0x101 + dd * 0x80 + c * 0x40 + b * 0x20, cc = 6;
+                break;
+        }
+    }
+    int t = (d * cc + bb) ^ a;
+    return (a & 0x80) | t >> 2;
+}
+
+// Maps an encoded weight to [0, 64].
+static int unquantize_weight(const ISERange& range, int value)
+{
+    int m = range.bits;
+    int result;
+    if (!range.trits && !range.quints)
+    {
+        // Replicate the bits out to 6.
+        result = 0;
+        for (int shift = 6 - m; shift > -m; shift -= m)
+        {
+            result |= shift >= 0 ? value << shift : value >> -shift;
+        }
+        result &= 0x3f;
+    }
+    else if (m == 0)
+    {
+        static const int kTritWeights[3] = {0, 32, 63};
+        static const int kQuintWeights[5] = {0, 16, 32, 47, 63};
+        result = range.trits ? kTritWeights[value] : kQuintWeights[value];
+    }
+    else
+    {
+        int d = value >> m;
+        int a = value & 1 ? 0x7f : 0;
+        int b = value >> 1 & 1, c = value >> 2 & 1;
+        int bb, cc;
+        if (range.trits)
+        {
+            bb = m == 1 ? 0 : m == 2 ? b * 0x45 : c * 0x42 + b * 0x21;
+            cc = m == 1 ? 50 : m == 2 ? 23 : 11;
+        }
+        else
+        {
+            bb = m == 1 ? 0 : b * 0x42;
+            cc = m == 1 ? 28 : 13;
+        }
+        int t = (d * cc + bb) ^ a;
+        result = (a & 0x20) | t >> 2;
+    }
+    return result > 32 ? result + 1 : result;
+}
+
+static uint32_t astc_hash52(uint32_t p)
+{
+    p ^= p >> 15;
+    p -= p << 17;
+    p += p << 7;
+    p += p << 4;
+    p ^= p >> 5;
+    p += p << 16;
+    p ^= p >> 7;
+    p ^= p >> 3;
+    p ^= p << 6;
+    p ^= p >> 17;
+    return p;
+}
+
+// Which partition a texel of a block with fewer than 31 texels belongs to.
+static int astc_select_partition(int seed, int x, int y, int partitionCount)
+{
+    x <<= 1;
+    y <<= 1;
+    seed += (partitionCount - 1) * 1024;
+    uint32_t rnum = astc_hash52(seed);
+    int seeds[8];
+    for (int i = 0; i < 8; ++i)
+    {
+        seeds[i] = rnum >> (i * 4) & 0xf;
+        seeds[i] *= seeds[i];
+    }
+    int sh1, sh2;
+    if (seed & 1)
+    {
+        sh1 = seed & 2 ? 4 : 5;
+        sh2 = partitionCount == 3 ? 6 : 5;
+    }
+    else
+    {
+        sh1 = partitionCount == 3 ? 6 : 5;
+        sh2 = seed & 2 ? 4 : 5;
+    }
+    for (int i = 0; i < 8; ++i)
+    {
+        seeds[i] >>= i & 1 ? sh2 : sh1;
+    }
+    // The z terms drop out for 2D blocks.
+    int a = (seeds[0] * x + seeds[1] * y + (rnum >> 14)) & 0x3f;
+    int b = (seeds[2] * x + seeds[3] * y + (rnum >> 10)) & 0x3f;
+    int c = (seeds[4] * x + seeds[5] * y + (rnum >> 6)) & 0x3f;
+    int d = (seeds[6] * x + seeds[7] * y + (rnum >> 2)) & 0x3f;
+    if (partitionCount < 4)
+    {
+        d = 0;
+    }
+    if (partitionCount < 3)
+    {
+        c = 0;
+    }
+    if (a >= b && a >= c && a >= d)
+    {
+        return 0;
+    }
+    if (b >= c && b >= d)
+    {
+        return 1;
+    }
+    return c >= d ? 2 : 3;
+}
+
+static void bit_transfer_signed(int& a, int& b)
+{
+    b >>= 1;
+    b |= a & 0x80;
+    a >>= 1;
+    a &= 0x3f;
+    if (a & 0x20)
+    {
+        a -= 0x40;
+    }
+}
+
+// Sets an endpoint, averaging red and green toward blue first if 'blueContract' is true.
+static void set_endpoint(int e[4], int r, int g, int b, int a, bool blueContract = false)
+{
+    if (blueContract)
+    {
+        r = (r + b) >> 1;
+        g = (g + b) >> 1;
+    }
+    e[0] = clamp255(r);
+    e[1] = clamp255(g);
+    e[2] = clamp255(b);
+    e[3] = clamp255(a);
+}
+
+// Decodes one partition's LDR endpoints. Returns false for HDR endpoint modes.
+static bool decode_astc_endpoints(int mode, const int* v, int e0[4], int e1[4])
+{
+    switch (mode)
+    {
+        case 0: // Luminance, direct.
+            set_endpoint(e0, v[0], v[0], v[0], 255);
+            set_endpoint(e1, v[1], v[1], v[1], 255);
+            return true;
+        case 1: // Luminance, base + offset.
+        {
+            int l0 = (v[0] >> 2) | (v[1] & 0xc0);
+            int l1 = std::min(l0 + (v[1] & 0x3f), 255);
+            set_endpoint(e0, l0, l0, l0, 255);
+            set_endpoint(e1, l1, l1, l1, 255);
+            return true;
+        }
+        case 4: // Luminance + alpha, direct.
+            set_endpoint(e0, v[0], v[0], v[0], v[2]);
+            set_endpoint(e1, v[1], v[1], v[1], v[3]);
+            return true;
+        case 5: // Luminance + alpha, base + offset.
+        {
+            int v0 = v[0], v1 = v[1], v2 = v[2], v3 = v[3];
+            bit_transfer_signed(v1, v0);
+            bit_transfer_signed(v3, v2);
+            set_endpoint(e0, v0, v0, v0, v2);
+            set_endpoint(e1, v0 + v1, v0 + v1, v0 + v1, v2 + v3);
+            return true;
+        }
+        case 6: // RGB, base + scale.
+            set_endpoint(e0, v[0] * v[3] >> 8, v[1] * v[3] >> 8, v[2] * v[3] >> 8, 255);
+            set_endpoint(e1, v[0], v[1], v[2], 255);
+            return true;
+        case 10: // RGB, base + scale, plus two alphas.
+            set_endpoint(e0, v[0] * v[3] >> 8, v[1] * v[3] >> 8, v[2] * v[3] >> 8, v[4]);
+            set_endpoint(e1, v[0], v[1], v[2], v[5]);
+            return true;
+        case 8:  // RGB, direct.
+        case 12: // RGBA, direct.
+        {
+            int a0 = mode == 12 ? v[6] : 255;
+            int a1 = mode == 12 ? v[7] : 255;
+            if (v[1] + v[3] + v[5] >= v[0] + v[2] + v[4])
+            {
+                set_endpoint(e0, v[0], v[2], v[4], a0);
+                set_endpoint(e1, v[1], v[3], v[5], a1);
+            }
+            else
+            {
+                set_endpoint(e0, v[1], v[3], v[5], a1, true);
+                set_endpoint(e1, v[0], v[2], v[4], a0, true);
+            }
+            return true;
+        }
+        case 9:  // RGB, base + offset.
+        case 13: // RGBA, base + offset.
+        {
+            int w[8] = {};
+            std::copy(v, v + (mode == 13 ? 8 : 6), w);
+            for (int i = 0; i < 8; i += 2)
+            {
+                bit_transfer_signed(w[i + 1], w[i]);
+            }
+            int a0 = mode == 13 ? w[6] : 255;
+            int a1 = mode == 13 ? w[6] + w[7] : 255;
+            if (w[1] + w[3] + w[5] >= 0)
+            {
+                set_endpoint(e0, w[0], w[2], w[4], a0);
+                set_endpoint(e1, w[0] + w[1], w[2] + w[3], w[4] + w[5], a1);
+            }
+            else
+            {
+                set_endpoint(e0, w[0] + w[1], w[2] + w[3], w[4] + w[5], a1, true);
+                set_endpoint(e1, w[0], w[2], w[4], a0, true);
+            }
+            return true;
+        }
+        default: // HDR.
+            return false;
+    }
+}
+
+void DecodeASTC4x4Block(const uint8_t block[16], uint8_t rgba[64])
+{
+    BlockBitReader bits(block);
+    uint32_t blockMode = bits.read(0, 11);
+    if ((blockMode & 0x1ff) == 0x1fc)
+    {
+        // Void extent: the whole block is one 16-bit color. Its extent must either be all ones or
+        // have mins below its maxes.
+        uint32_t sMin = bits.read(12, 13), sMax = bits.read(25, 13);
+        uint32_t tMin = bits.read(38, 13), tMax = bits.read(51, 13);
+        bool allOnes = (sMin & sMax & tMin & tMax) == 0x1fff;
+        if ((blockMode & 0x200) || (!allOnes && (sMin >= sMax || tMin >= tMax)))
+        {
+            fill_astc_error(rgba); // HDR, or malformed.
+            return;
+        }
+        for (int i = 0; i < 16; ++i)
+        {
+            for (int channel = 0; channel < 4; ++channel)
+            {
+                rgba[i * 4 + channel] = static_cast<uint8_t>(bits.read(64 + channel * 16, 16) >> 8);
+            }
+        }
+        return;
+    }
+
+    // Weight grid size, range, and plane count.
+    int gridWidth, gridHeight;
+    int r, a = blockMode >> 5 & 3, b = blockMode >> 7 & 3;
+    bool highPrecision = blockMode >> 9 & 1;
+    bool dualPlane = blockMode >> 10 & 1;
+    if (blockMode & 3)
+    {
+        r = (blockMode >> 4 & 1) | (blockMode & 3) << 1;
+        switch (blockMode >> 2 & 3)
+        {
+            case 0:
+                gridWidth = b + 4, gridHeight = a + 2;
+                break;
+            case 1:
+                gridWidth = b + 8, gridHeight = a + 2;
+                break;
+            case 2:
+                gridWidth = a + 2, gridHeight = b + 8;
+                break;
+            default:
+                if (blockMode & 0x100)
+                {
+                    gridWidth = (b & 1) + 2, gridHeight = a + 2;
+                }
+                else
+                {
+                    gridWidth = a + 2, gridHeight = (b & 1) + 6;
+                }
+                break;
+        }
+    }
+    else
+    {
+        r = (blockMode >> 4 & 1) | (blockMode >> 2 & 3) << 1;
+        switch (b)
+        {
+            case 0:
+                gridWidth = 12, gridHeight = a + 2;
+                break;
+            case 1:
+                gridWidth = a + 2, gridHeight = 12;
+                break;
+            case 2:
+                gridWidth = a + 6, gridHeight = (blockMode >> 9 & 3) + 6;
+                highPrecision = dualPlane = false;
+                break;
+            default:
+                if (a == 0)
+                {
+                    gridWidth = 6, gridHeight = 10;
+                }
+                else if (a == 1)
+                {
+                    gridWidth = 10, gridHeight = 6;
+                }
+                else
+                {
+                    fill_astc_error(rgba); // Reserved.
+                    return;
+                }
+                break;
+        }
+    }
+    static const int kWeightLevels[2][6] = {{2, 3, 4, 5, 6, 8}, {10, 12, 16, 20, 24, 32}};
+    int partitionCount = bits.read(11, 2) + 1;
+    if (r < 2 || gridWidth > 4 || gridHeight > 4 || (dualPlane && partitionCount == 4))
+    {
+        fill_astc_error(rgba);
+        return;
+    }
+    const ISERange& weightRange = *ise_range(kWeightLevels[highPrecision][r - 2]);
+    int planeCount = dualPlane ? 2 : 1;
+    int weightCount = gridWidth * gridHeight * planeCount;
+    int weightBitCount = ise_bit_count(weightRange, weightCount);
+    if (weightBitCount < 24 || weightBitCount > 96)
+    {
+        fill_astc_error(rgba);
+        return;
+    }
+
+    // Color endpoint modes.
+    int modes[4];
+    int partitionSeed = 0;
+    int colorStart;
+    int colorEnd = 128 - weightBitCount;
+    if (partitionCount == 1)
+    {
+        modes[0] = bits.read(13, 4);
+        colorStart = 17;
+    }
+    else
+    {
+        partitionSeed = bits.read(13, 10);
+        colorStart = 29;
+        uint32_t modeBits = bits.read(23, 6);
+        if ((modeBits & 3) == 0)
+        {
+            for (int i = 0; i < partitionCount; ++i)
+            {
+                modes[i] = modeBits >> 2;
+            }
+        }
+        else
+        {
+            // The rest of the bits go just below the weights.
+            int extraBitCount = partitionCount * 3 - 4;
+            colorEnd -= extraBitCount;
+            modeBits |= bits.read(colorEnd, extraBitCount) << 6;
+            int baseClass = (modeBits & 3) - 1;
+            for (int i = 0; i < partitionCount; ++i)
+            {
+                modes[i] = ((modeBits >> (2 + i) & 1) + baseClass) << 2 |
+                           (modeBits >> (2 + partitionCount + i * 2) & 3);
+            }
+        }
+    }
+    int planeComponent = -1;
+    if (dualPlane)
+    {
+        colorEnd -= 2;
+        planeComponent = bits.read(colorEnd, 2);
+    }
+
+    // Color endpoints use the largest range that fits.
+    int colorValueCount = 0;
+    for (int i = 0; i < partitionCount; ++i)
+    {
+        colorValueCount += ((modes[i] >> 2) + 1) * 2;
+    }
+    const ISERange* colorRange = nullptr;
+    for (int i = kISERangeCount - 1; i >= 0 && kISERanges[i].levels >= 6; --i)
+    {
+        if (ise_bit_count(kISERanges[i], colorValueCount) <= colorEnd - colorStart)
+        {
+            colorRange = &kISERanges[i];
+            break;
+        }
+    }
+    if (colorValueCount > 18 || colorRange == nullptr)
+    {
+        fill_astc_error(rgba);
+        return;
+    }
+    int colorValues[18];
+    decode_ise(block, colorStart, *colorRange, colorValueCount, colorValues);
+    for (int i = 0; i < colorValueCount; ++i)
+    {
+        colorValues[i] = unquantize_color(*colorRange, colorValues[i]);
+    }
+    int endpoints[4][2][4];
+    bool isHDR[4];
+    const int* v = colorValues;
+    for (int i = 0; i < partitionCount; ++i)
+    {
+        isHDR[i] = !decode_astc_endpoints(modes[i], v, endpoints[i][0], endpoints[i][1]);
+        v += ((modes[i] >> 2) + 1) * 2;
+    }
+
+    // Weights are stored bit-reversed, from the top of the block down.
+    uint8_t reversed[16];
+    for (int i = 0; i < 16; ++i)
+    {
+        uint8_t byte = block[15 - i];
+        byte = (byte & 0xf0) >> 4 | (byte & 0x0f) << 4;
+        byte = (byte & 0xcc) >> 2 | (byte & 0x33) << 2;
+        byte = (byte & 0xaa) >> 1 | (byte & 0x55) << 1;
+        reversed[i] = byte;
+    }
+    int weights[64];
+    decode_ise(reversed, 0, weightRange, weightCount, weights);
+    int grid[2][16];
+    for (int i = 0; i < gridWidth * gridHeight; ++i)
+    {
+        for (int plane = 0; plane < planeCount; ++plane)
+        {
+            grid[plane][i] = unquantize_weight(weightRange, weights[i * planeCount + plane]);
+        }
+    }
+
+    for (int y = 0; y < 4; ++y)
+    {
+        for (int x = 0; x < 4; ++x)
+        {
+            // Bilinearly infill the weight grid out to the block's texels. Neighbors past the last
+            // row or column always get a weight of 0.
+            constexpr int kScale = (1024 + 4 / 2) / (4 - 1);
+            int gs = (kScale * x * (gridWidth - 1) + 32) >> 6;
+            int gt = (kScale * y * (gridHeight - 1) + 32) >> 6;
+            int js = gs >> 4, fs = gs & 0xf;
+            int jt = gt >> 4, ft = gt & 0xf;
+            int w11 = (fs * ft + 8) >> 4;
+            int w10 = ft - w11;
+            int w01 = fs - w11;
+            int w00 = 16 - fs - ft + w11;
+            int texelWeights[2];
+            for (int plane = 0; plane < planeCount; ++plane)
+            {
+                auto weightAt = [&](int s, int t) {
+                    return s < gridWidth && t < gridHeight ? grid[plane][t * gridWidth + s] : 0;
+                };
+                texelWeights[plane] =
+                    (weightAt(js, jt) * w00 + weightAt(js + 1, jt) * w01 +
+                     weightAt(js, jt + 1) * w10 + weightAt(js + 1, jt + 1) * w11 + 8) >>
+                    4;
+            }
+
+            int partition =
+                partitionCount > 1 ? astc_select_partition(partitionSeed, x, y, partitionCount)
+                                   : 0;
+            const int(&e)[2][4] = endpoints[partition];
+            uint8_t* pixel = rgba + (y * 4 + x) * 4;
+            if (isHDR[partition])
+            {
+                memcpy(pixel, kASTCErrorColor, 4);
+                continue;
+            }
+            for (int channel = 0; channel < 4; ++channel)
+            {
+                int w = texelWeights[channel == planeComponent ? 1 : 0];
+                int c0 = e[0][channel] << 8 | e[0][channel];
+                int c1 = e[1][channel] << 8 | e[1][channel];
+                pixel[channel] = static_cast<uint8_t>(((c0 * (64 - w) + c1 * w + 32) >> 6) >> 8);
+            }
+        }
+    }
+}
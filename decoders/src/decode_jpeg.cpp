@@ -31,7 +31,9 @@ void my_error_exit(j_common_ptr cinfo)
     longjmp(myerr->setjmp_buffer, 1);
 }
 
-std::unique_ptr<Bitmap> DecodeJpeg(const uint8_t bytes[], size_t byteCount)
+std::unique_ptr<Bitmap> DecodeJpeg(const uint8_t bytes[],
+                                   size_t byteCount,
+                                   const Bitmap::DecodeOptions& options)
 {
     struct jpeg_decompress_struct cinfo;
     struct my_error_mgr jerr;
@@ -70,16 +72,42 @@ std::unique_ptr<Bitmap> DecodeJpeg(const uint8_t bytes[], size_t byteCount)
     cinfo.data_precision = 8;
     cinfo.out_color_space = JCS_RGB;
 
+    // Let the IDCT scale down by M/8 when the caller doesn't need full resolution. Pick the
+    // smallest M whose output still covers the fitted size.
+    uint32_t fitWidth, fitHeight;
+    Bitmap::FitWithin(options, cinfo.image_width, cinfo.image_height, &fitWidth, &fitHeight);
+    if (fitWidth < cinfo.image_width || fitHeight < cinfo.image_height)
+    {
+        unsigned int scaleNum = 1;
+        while (scaleNum < 8 && ((cinfo.image_width * scaleNum + 7) / 8 < fitWidth ||
+                                (cinfo.image_height * scaleNum + 7) / 8 < fitHeight))
+        {
+            ++scaleNum;
+        }
+        cinfo.scale_num = scaleNum;
+        cinfo.scale_denom = 8;
+    }
+
+    // Emit RGBA from the color converter when the library supports it, otherwise expand each
+    // scanline as we copy it out.
+    bool rgbaOutput = options.forceRGBA;
+#ifdef JCS_EXTENSIONS
+    if (rgbaOutput)
+    {
+        cinfo.out_color_space = JCS_EXT_RGBA;
+    }
+#endif
+
     // Step 5: Start decompressor
     jpeg_start_decompress(&cinfo);
 
     /// Api worked as expected and gave us correct format even for jpeg 12 or 16
     assert(cinfo.data_precision == 8);
-    assert(cinfo.output_components == 3);
+    assert(cinfo.output_components == (cinfo.out_color_space == JCS_RGB ? 3 : 4));
 
+    size_t dstBytesPerPixel = rgbaOutput ? 4 : 3;
     size_t pixelBufferSize = static_cast<size_t>(cinfo.output_width) *
-                             static_cast<size_t>(cinfo.output_height) *
-                             static_cast<size_t>(cinfo.output_components);
+                             static_cast<size_t>(cinfo.output_height) * dstBytesPerPixel;
     pixelBuffer = std::make_unique<uint8_t[]>(pixelBufferSize);
 
     uint8_t* pixelWriteBuffer = (uint8_t*)pixelBuffer.get();
@@ -87,6 +115,7 @@ std::unique_ptr<Bitmap> DecodeJpeg(const uint8_t bytes[], size_t byteCount)
 
     // Samples per row in output buffer
     row_stride = cinfo.output_width * cinfo.output_components;
+    size_t dstRowStride = cinfo.output_width * dstBytesPerPixel;
     // Make a one-row-high sample array that will go away when done with image
     buffer = (*cinfo.mem->alloc_sarray)((j_common_ptr)&cinfo, JPOOL_IMAGE, row_stride, 1);
 
@@ -103,15 +132,22 @@ std::unique_ptr<Bitmap> DecodeJpeg(const uint8_t bytes[], size_t byteCount)
         // more than one scanline at a time if that's more convenient.
         jpeg_read_scanlines(&cinfo, buffer, 1);
 
-        if (pixelWriteBuffer + row_stride > pixelWriteBufferEnd)
+        if (pixelWriteBuffer + dstRowStride > pixelWriteBufferEnd)
         {
             // memcpy would cause an overflow.
             jpeg_finish_decompress(&cinfo);
             jpeg_destroy_decompress(&cinfo);
             return nullptr;
         }
-        memcpy(pixelWriteBuffer, buffer[0], row_stride);
-        pixelWriteBuffer += row_stride;
+        if (cinfo.output_components == 3 && rgbaOutput)
+        {
+            Bitmap::ExpandRGBToRGBA(buffer[0], pixelWriteBuffer, cinfo.output_width);
+        }
+        else
+        {
+            memcpy(pixelWriteBuffer, buffer[0], row_stride);
+        }
+        pixelWriteBuffer += dstRowStride;
     }
 
     // Step 7: Finish decompression
@@ -120,8 +156,10 @@ std::unique_ptr<Bitmap> DecodeJpeg(const uint8_t bytes[], size_t byteCount)
     // Step 8: Release JPEG decompression object
     jpeg_destroy_decompress(&cinfo);
 
+    // Jpegs are opaque, so RGBA output is already premultiplied.
     return std::make_unique<Bitmap>(cinfo.output_width,
                                     cinfo.output_height,
-                                    Bitmap::PixelFormat::RGB,
+                                    rgbaOutput ? Bitmap::PixelFormat::RGBA
+                                               : Bitmap::PixelFormat::RGB,
                                     std::move(pixelBuffer));
 }
\ No newline at end of file
@@ -35,7 +35,9 @@ static void ReadDataFromMemory(png_structp png_ptr, png_bytep outBytes, png_size
     }
 }
 
-std::unique_ptr<Bitmap> DecodePng(const uint8_t bytes[], size_t byteCount)
+std::unique_ptr<Bitmap> DecodePng(const uint8_t bytes[],
+                                  size_t byteCount,
+                                  const Bitmap::DecodeOptions& options)
 {
     png_structp png_ptr;
     png_infop info_ptr;
@@ -107,6 +109,12 @@ std::unique_ptr<Bitmap> DecodePng(const uint8_t bytes[], size_t byteCount)
         png_set_gray_to_rgb(png_ptr);
     }
 
+    if (options.forceRGBA && !(color_type & PNG_COLOR_MASK_ALPHA) && trnsCount == 0)
+    {
+        // Have libpng fill in alpha as it unpacks rows, rather than converting afterward.
+        png_set_filler(png_ptr, 0xff, PNG_FILLER_AFTER);
+    }
+
     png_read_update_info(png_ptr, info_ptr);
     uint8_t channels = png_get_channels(png_ptr, info_ptr);
 
@@ -140,6 +148,10 @@ std::unique_ptr<Bitmap> DecodePng(const uint8_t bytes[], size_t byteCount)
     {
         case 4:
             pixelFormat = Bitmap::PixelFormat::RGBA;
+            if (options.premultiplyAlpha)
+            {
+                Bitmap::PremultiplyRGBA(pixelBuffer.get(), static_cast<size_t>(width) * height);
+            }
             break;
         case 3:
             pixelFormat = Bitmap::PixelFormat::RGB;
@@ -5,7 +5,9 @@
 #include <vector>
 #include <memory>
 
-std::unique_ptr<Bitmap> DecodeWebP(const uint8_t bytes[], size_t byteCount)
+std::unique_ptr<Bitmap> DecodeWebP(const uint8_t bytes[],
+                                   size_t byteCount,
+                                   const Bitmap::DecodeOptions& options)
 {
     WebPDecoderConfig config;
     if (!WebPInitDecoderConfig(&config))
@@ -35,11 +37,25 @@ std::unique_ptr<Bitmap> DecodeWebP(const uint8_t bytes[], size_t byteCount)
         WebPDemuxDelete(demuxer);
         return nullptr;
     }
-    config.output.colorspace = MODE_RGBA;
+    config.output.colorspace = options.premultiplyAlpha ? MODE_rgbA : MODE_RGBA;
 
     uint32_t width = WebPDemuxGetI(demuxer, WEBP_FF_CANVAS_WIDTH);
     uint32_t height = WebPDemuxGetI(demuxer, WEBP_FF_CANVAS_HEIGHT);
 
+    // Have libwebp scale while decoding when the caller doesn't need full resolution. (Only when
+    // the frame covers the canvas; otherwise the frame offset would need scaling too.)
+    uint32_t fitWidth, fitHeight;
+    Bitmap::FitWithin(options, width, height, &fitWidth, &fitHeight);
+    if ((fitWidth < width || fitHeight < height) && currentFrame.width == (int)width &&
+        currentFrame.height == (int)height)
+    {
+        config.options.use_scaling = 1;
+        config.options.scaled_width = (int)fitWidth;
+        config.options.scaled_height = (int)fitHeight;
+        width = fitWidth;
+        height = fitHeight;
+    }
+
     size_t pixelBufferSize =
         static_cast<size_t>(width) * static_cast<size_t>(height) * static_cast<size_t>(4);
     std::unique_ptr<uint8_t[]> pixelBuffer = std::make_unique<uint8_t[]>(pixelBufferSize);
@@ -0,0 +1,195 @@
+/*
+ * Copyright 2024 Rive
+ */
+
+#include "rive/decoders/ktx2_image.hpp"
+#include "rive/decoders/bitmap_decoder.hpp"
+#include <algorithm>
+#include <stdio.h>
+#include <string.h>
+
+void DecodeBC7Block(const uint8_t block[16], uint8_t rgba[64]);
+void DecodeETC2RGBA8Block(const uint8_t block[16], uint8_t rgba[64]);
+void DecodeASTC4x4Block(const uint8_t block[16], uint8_t rgba[64]);
+
+// https://registry.khronos.org/KTX/specs/2.0/ktxspec.v2.html
+static const uint8_t kKTX2Identifier[12] =
+    {0xAB, 0x4B, 0x54, 0x58, 0x20, 0x32, 0x30, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A};
+
+// Identifier + 9 uint32 header fields + index (4 uint32, 2 uint64).
+constexpr static size_t kLevelIndexOffset = 12 + 9 * 4 + 4 * 4 + 2 * 8;
+constexpr static size_t kLevelIndexEntrySize = 3 * 8;
+
+enum VkFormat : uint32_t
+{
+    VK_FORMAT_UNDEFINED = 0,
+    VK_FORMAT_R8G8B8A8_UNORM = 37,
+    VK_FORMAT_R8G8B8A8_SRGB = 43,
+    VK_FORMAT_BC7_UNORM_BLOCK = 145,
+    VK_FORMAT_BC7_SRGB_BLOCK = 146,
+    VK_FORMAT_ETC2_R8G8B8A8_UNORM_BLOCK = 151,
+    VK_FORMAT_ETC2_R8G8B8A8_SRGB_BLOCK = 152,
+    VK_FORMAT_ASTC_4x4_UNORM_BLOCK = 157,
+    VK_FORMAT_ASTC_4x4_SRGB_BLOCK = 158,
+};
+
+// KTX2 is little endian.
+static uint32_t read_u32(const uint8_t* p)
+{
+    return static_cast<uint32_t>(p[0]) | static_cast<uint32_t>(p[1]) << 8 |
+           static_cast<uint32_t>(p[2]) << 16 | static_cast<uint32_t>(p[3]) << 24;
+}
+
+static uint64_t read_u64(const uint8_t* p)
+{
+    return static_cast<uint64_t>(read_u32(p)) | static_cast<uint64_t>(read_u32(p + 4)) << 32;
+}
+
+bool KTX2Image::IsKTX2(const uint8_t bytes[], size_t byteCount)
+{
+    return byteCount >= sizeof(kKTX2Identifier) &&
+           memcmp(bytes, kKTX2Identifier, sizeof(kKTX2Identifier)) == 0;
+}
+
+size_t KTX2Image::LevelByteCount(Format format, uint32_t width, uint32_t height)
+{
+    if (format == Format::rgba8)
+    {
+        return static_cast<size_t>(width) * height * 4;
+    }
+    return static_cast<size_t>((width + 3) / 4) * ((height + 3) / 4) * 16;
+}
+
+std::unique_ptr<KTX2Image> KTX2Image::decode(const uint8_t bytes[], size_t byteCount)
+{
+    if (!IsKTX2(bytes, byteCount) || byteCount < kLevelIndexOffset)
+    {
+        return nullptr;
+    }
+
+    const uint8_t* header = bytes + sizeof(kKTX2Identifier);
+    uint32_t vkFormat = read_u32(header + 0);
+    uint32_t pixelWidth = read_u32(header + 8);
+    uint32_t pixelHeight = read_u32(header + 12);
+    uint32_t pixelDepth = read_u32(header + 16);
+    uint32_t layerCount = read_u32(header + 20);
+    uint32_t faceCount = read_u32(header + 24);
+    uint32_t levelCount = std::max(read_u32(header + 28), 1u);
+    uint32_t supercompressionScheme = read_u32(header + 32);
+
+    Format format;
+    switch (vkFormat)
+    {
+        case VK_FORMAT_R8G8B8A8_UNORM:
+        case VK_FORMAT_R8G8B8A8_SRGB:
+            format = Format::rgba8;
+            break;
+        case VK_FORMAT_ETC2_R8G8B8A8_UNORM_BLOCK:
+        case VK_FORMAT_ETC2_R8G8B8A8_SRGB_BLOCK:
+            format = Format::etc2RGBA8;
+            break;
+        case VK_FORMAT_ASTC_4x4_UNORM_BLOCK:
+        case VK_FORMAT_ASTC_4x4_SRGB_BLOCK:
+            format = Format::astc4x4;
+            break;
+        case VK_FORMAT_BC7_UNORM_BLOCK:
+        case VK_FORMAT_BC7_SRGB_BLOCK:
+            format = Format::bc7;
+            break;
+        case VK_FORMAT_UNDEFINED:
+            fprintf(stderr,
+                    "KTX2Image::decode - Basis Universal payloads need to be transcoded.\n");
+            return nullptr;
+        default:
+            fprintf(stderr, "KTX2Image::decode - unsupported vkFormat %u.\n", vkFormat);
+            return nullptr;
+    }
+
+    if (supercompressionScheme != 0)
+    {
+        fprintf(stderr,
+                "KTX2Image::decode - unsupported supercompression scheme %u.\n",
+                supercompressionScheme);
+        return nullptr;
+    }
+    if (pixelWidth == 0 || pixelHeight == 0 || pixelDepth != 0 || layerCount > 1 ||
+        faceCount != 1)
+    {
+        fprintf(stderr, "KTX2Image::decode - only single 2D images are supported.\n");
+        return nullptr;
+    }
+    if (levelCount > 32 || (pixelWidth | pixelHeight) >> (levelCount - 1) == 0)
+    {
+        return nullptr;
+    }
+    if (byteCount < kLevelIndexOffset + levelCount * kLevelIndexEntrySize)
+    {
+        return nullptr;
+    }
+
+    std::vector<Level> levels(levelCount);
+    const uint8_t* levelIndex = bytes + kLevelIndexOffset;
+    for (uint32_t i = 0; i < levelCount; ++i)
+    {
+        const uint8_t* entry = levelIndex + i * kLevelIndexEntrySize;
+        uint64_t byteOffset = read_u64(entry);
+        uint64_t byteLength = read_u64(entry + 8);
+        Level& level = levels[i];
+        level.width = std::max(pixelWidth >> i, 1u);
+        level.height = std::max(pixelHeight >> i, 1u);
+        if (byteOffset > byteCount || byteLength > byteCount - byteOffset ||
+            byteLength != LevelByteCount(format, level.width, level.height))
+        {
+            // Truncated file, or a level that doesn't match its dimensions.
+            return nullptr;
+        }
+        level.bytes = bytes + byteOffset;
+        level.byteCount = static_cast<size_t>(byteLength);
+    }
+
+    return std::unique_ptr<KTX2Image>(new KTX2Image(format, std::move(levels)));
+}
+
+std::unique_ptr<Bitmap> KTX2Image::decodeLevel(size_t levelIndex) const
+{
+    if (levelIndex >= m_levels.size())
+    {
+        return nullptr;
+    }
+    const Level& level = m_levels[levelIndex];
+    size_t rowBytes = static_cast<size_t>(level.width) * 4;
+    std::unique_ptr<uint8_t[]> pixels(new uint8_t[rowBytes * level.height]);
+    if (m_format == Format::rgba8)
+    {
+        memcpy(pixels.get(), level.bytes, rowBytes * level.height);
+    }
+    else
+    {
+        void (*decodeBlock)(const uint8_t[16], uint8_t[64]) =
+            m_format == Format::bc7         ? DecodeBC7Block
+            : m_format == Format::etc2RGBA8 ? DecodeETC2RGBA8Block
+                                            : DecodeASTC4x4Block;
+        const uint8_t* block = level.bytes;
+        uint8_t blockPixels[4 * 4 * 4];
+        for (uint32_t blockY = 0; blockY < level.height; blockY += 4)
+        {
+            for (uint32_t blockX = 0; blockX < level.width; blockX += 4, block += 16)
+            {
+                decodeBlock(block, blockPixels);
+                // Blocks on the right and bottom edges may hang off the level.
+                uint32_t width = std::min(level.width - blockX, 4u);
+                uint32_t height = std::min(level.height - blockY, 4u);
+                for (uint32_t y = 0; y < height; ++y)
+                {
+                    memcpy(pixels.get() + (blockY + y) * rowBytes + blockX * 4,
+                           blockPixels + y * 16,
+                           width * 4);
+                }
+            }
+        }
+    }
+    return std::make_unique<Bitmap>(level.width,
+                                    level.height,
+                                    Bitmap::PixelFormat::RGBA,
+                                    std::unique_ptr<const uint8_t[]>(pixels.release()));
+}
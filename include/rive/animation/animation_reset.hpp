@@ -27,6 +27,14 @@ public:
     void apply(Artboard* artboard);
     void complete();
     void clear();
+#ifdef TESTING
+    // Used in testing to compare resets.
+    std::vector<uint8_t> data() const
+    {
+        return std::vector<uint8_t>(m_WriteBuffer.begin(),
+                                    m_WriteBuffer.begin() + m_binaryWriter.size());
+    }
+#endif
 };
 } // namespace rive
 #endif
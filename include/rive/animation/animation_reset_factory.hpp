@@ -10,6 +10,37 @@
 
 namespace rive
 {
+class LayerState;
+
+// The properties an AnimationReset captures when transitioning between two animations, worked out
+// once when the state machine is imported instead of on every transition.
+class AnimationResetPlan
+{
+    friend class AnimationResetFactory;
+
+public:
+    AnimationResetPlan(const LinearAnimation* animationFrom, const LinearAnimation* animationTo);
+
+    // Returns the animation a state contributes to a reset, or null if it doesn't contribute one.
+    static const LinearAnimation* resetAnimation(const LayerState* state);
+
+    bool matches(const LinearAnimation* animationFrom, const LinearAnimation* animationTo) const
+    {
+        return m_animationFrom == animationFrom && m_animationTo == animationTo;
+    }
+
+private:
+    struct ObjectProperties
+    {
+        uint32_t objectId;
+        uint32_t propertyCount;
+    };
+    const LinearAnimation* m_animationFrom;
+    const LinearAnimation* m_animationTo;
+    std::vector<ObjectProperties> m_objects;
+    // Property keys of every object, in order.
+    std::vector<uint32_t> m_propertyKeys;
+};
 
 class AnimationResetFactory
 {
@@ -22,9 +53,11 @@ private:
 
 public:
     static std::unique_ptr<AnimationReset> getInstance();
+    // Uses the plan, if there is one and it was made for the same pair of animations.
     static std::unique_ptr<AnimationReset> fromStates(StateInstance* stateFrom,
                                                       StateInstance* currentState,
-                                                      ArtboardInstance* artboard);
+                                                      ArtboardInstance* artboard,
+                                                      const AnimationResetPlan* plan = nullptr);
     static std::unique_ptr<AnimationReset> fromAnimations(
         std::vector<const LinearAnimation*>& animations,
         ArtboardInstance* artboard,
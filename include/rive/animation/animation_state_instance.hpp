@@ -24,6 +24,8 @@ public:
 
     bool keepGoing() const override;
     void clearSpilledTime() override;
+    bool restart() override;
+    float secondsUntilChange() const override;
 
     const LinearAnimationInstance* animationInstance() const { return &m_AnimationInstance; }
 
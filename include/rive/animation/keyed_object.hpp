@@ -22,6 +22,13 @@ public:
                               bool isAtStartFrame) const;
     void apply(Artboard* coreContext, float time, float mix);
 
+    /// Returns true if every keyed property is a callback.
+    bool keysOnlyCallbacks() const;
+
+    /// Returns the time of the first callback key frame after seconds, or
+    /// limit if there isn't one before it.
+    float nextCallbackSeconds(float seconds, float limit) const;
+
     StatusCode import(ImportStack& importStack) override;
 
     const KeyedProperty* getProperty(size_t index) const
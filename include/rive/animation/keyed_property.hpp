@@ -25,6 +25,10 @@ public:
     /// Apply interpolating key frames.
     void apply(Core* object, float time, float mix);
 
+    /// Returns the time of the first key frame after seconds, or limit if
+    /// there isn't one before it.
+    float nextKeyFrameSeconds(float seconds, float limit) const;
+
     StatusCode import(ImportStack& importStack) override;
     KeyFrame* first() const
     {
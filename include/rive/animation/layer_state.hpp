@@ -21,6 +21,10 @@ private:
     std::vector<StateTransition*> m_Transitions;
     void addTransition(StateTransition* transition);
 
+    bool m_TransitionsOnlyReadInputs = false;
+    std::vector<uint32_t> m_TransitionInputIds;
+    void findTransitionInputs();
+
 public:
     ~LayerState() override;
     StatusCode onAddedDirty(CoreContext* context) override;
@@ -38,6 +42,17 @@ public:
         return nullptr;
     }
 
+    /// True when whether a transition out of this state is allowed only
+    /// depends on the values of the state machine's inputs (i.e., there are
+    /// no exit times, view model or artboard conditions). The State Machine
+    /// uses this to skip evaluating the transitions while those inputs don't
+    /// change.
+    bool transitionsOnlyReadInputs() const { return m_TransitionsOnlyReadInputs; }
+
+    /// Ids of the inputs read by the conditions of transitions out of this
+    /// state.
+    const std::vector<uint32_t>& transitionInputIds() const { return m_TransitionInputIds; }
+
     /// Make an instance of this state that can be advanced and applied by
     /// the state machine when it is active or being transitioned from.
     virtual std::unique_ptr<StateInstance> makeInstance(ArtboardInstance* instance) const;
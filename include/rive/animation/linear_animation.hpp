@@ -13,6 +13,7 @@ class LinearAnimation : public LinearAnimationBase
 {
 private:
     std::vector<std::unique_ptr<KeyedObject>> m_KeyedObjects;
+    bool m_keysOnlyCallbacks = false;
 
     friend class Artboard;
 
@@ -56,6 +57,14 @@ public:
 
     size_t numKeyedObjects() const { return m_KeyedObjects.size(); }
 
+    /// Returns true if the animation keys nothing but callbacks (like
+    /// events), so applying it never changes the artboard.
+    bool keysOnlyCallbacks() const { return m_keysOnlyCallbacks; }
+
+    /// Returns the time, in seconds, of the first callback key frame after
+    /// seconds, or endSeconds() if there isn't one.
+    float nextCallbackSeconds(float seconds) const;
+
 #ifdef TESTING
     // Used in testing to check how many animations gets deleted.
     static int deleteCount;
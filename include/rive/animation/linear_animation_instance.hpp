@@ -78,6 +78,12 @@ public:
                (directedSpeed() * speedMultiplier < 0 && m_time > m_animation->startSeconds());
     }
 
+    // Returns how many seconds the instance can advance at speedMultiplier
+    // before applying it changes the artboard or it reports a keyed callback.
+    // Only animations that key nothing but callbacks can advance without
+    // changing anything, others return 0 until they stop.
+    float secondsUntilChange(float speedMultiplier) const;
+
     float totalTime() const { return m_totalTime; }
     float lastTotalTime() const { return m_lastTotalTime; }
     float spilledTime() const { return m_spilledTime; }
@@ -97,8 +103,12 @@ public:
 
     bool isTranslucent() const override;
     bool advanceAndApply(float seconds) override;
+    float settledSeconds() const override;
     std::string name() const override;
     void reset(float speedMultiplier);
+    // Puts the instance back the way it was constructed, so it can be
+    // reused instead of allocating a new one.
+    void restart(float speedMultiplier);
     void reportEvent(Event* event, float secondsDelay = 0.0f) override;
 
 private:
@@ -1,6 +1,7 @@
 #ifndef _RIVE_NESTED_REMAP_ANIMATION_HPP_
 #define _RIVE_NESTED_REMAP_ANIMATION_HPP_
 #include "rive/generated/animation/nested_remap_animation_base.hpp"
+#include <limits>
 #include <stdio.h>
 namespace rive
 {
@@ -9,6 +10,8 @@ class NestedRemapAnimation : public NestedRemapAnimationBase
 public:
     void timeChanged() override;
     bool advance(float elapsedSeconds) override;
+    // The animation only moves when time() changes.
+    float settledSeconds() const override { return std::numeric_limits<float>::infinity(); }
     void initializeAnimation(ArtboardInstance*) override;
 };
 } // namespace rive
@@ -8,6 +8,7 @@ class NestedSimpleAnimation : public NestedSimpleAnimationBase
 {
 public:
     bool advance(float elapsedSeconds) override;
+    float settledSeconds() const override;
 };
 } // namespace rive
 
@@ -21,6 +21,7 @@ public:
     NestedStateMachine();
     ~NestedStateMachine() override;
     bool advance(float elapsedSeconds) override;
+    float settledSeconds() const override;
     void initializeAnimation(ArtboardInstance*) override;
     StateMachineInstance* stateMachineInstance();
 
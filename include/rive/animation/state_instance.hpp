@@ -29,6 +29,16 @@ public:
     virtual bool keepGoing() const = 0;
     virtual void clearSpilledTime() {}
 
+    /// Returns how many seconds this state can keep going before it changes
+    /// the artboard, reports an event, or reaches the exit time of one of its
+    /// transitions.
+    virtual float secondsUntilChange() const { return 0.0f; }
+
+    /// Puts the instance back the way it was when it was created, so the
+    /// State Machine can reuse it the next time its state is entered.
+    /// Returns false if this kind of instance can't be reused.
+    virtual bool restart() { return false; }
+
     const LayerState* state() const;
 };
 } // namespace rive
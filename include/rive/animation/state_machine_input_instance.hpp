@@ -37,6 +37,8 @@ public:
 private:
     StateMachineInstance* m_machineInstance;
     const StateMachineInput* m_input;
+    // The machine's input change count when this input last changed.
+    uint64_t m_changeCount = 0;
 #ifdef WITH_RIVE_TOOLS
     uint64_t m_index = 0;
 #endif
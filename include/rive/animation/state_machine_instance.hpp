@@ -76,6 +76,11 @@ public:
     // Returns true when the StateMachineInstance has more data to process.
     bool needsAdvance() const;
 
+    // Unlike needsAdvance(), this also accounts for the artboard, nested
+    // artboards, and states that keep going without changing anything (like
+    // an animation that only reports events, waiting for an exit time).
+    float settledSeconds() const override;
+
     // Returns a pointer to the instance's stateMachine
     const StateMachine* stateMachine() const { return m_machine; }
 
@@ -156,6 +161,10 @@ private:
     std::vector<EventReport> m_reportedEvents;
     const StateMachine* m_machine;
     bool m_needsAdvance = false;
+    // How long the layers can go without changing, as of the last advance.
+    float m_settledSeconds = 0.0f;
+    // Incremented every time an input changes.
+    uint64_t m_inputChangeCount = 0;
     std::vector<SMIInput*> m_inputInstances; // we own each pointer
     size_t m_layerCount;
     StateMachineLayerInstance* m_layers;
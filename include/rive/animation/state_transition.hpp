@@ -12,6 +12,7 @@ class LayerState;
 class StateMachineLayerImporter;
 class StateTransitionImporter;
 class TransitionCondition;
+class AnimationResetPlan;
 class StateInstance;
 class StateMachineInstance;
 class LinearAnimation;
@@ -41,6 +42,9 @@ private:
     std::vector<TransitionCondition*> m_Conditions;
     void addCondition(TransitionCondition* condition);
 
+    AnimationResetPlan* m_AnimationResetPlan = nullptr;
+    void buildAnimationResetPlan(const LayerState* stateFrom);
+
 public:
     ~StateTransition() override;
     const LayerState* stateTo() const { return m_StateTo; }
@@ -125,6 +129,12 @@ public:
     /// correct time to the animation instance in the stateFrom, when
     /// applicable (when it's an AnimationState).
     bool applyExitCondition(StateInstance* stateFrom) const;
+
+    /// The reset this transition needs while mixing, precomputed for when
+    /// it's taken from the state that owns it. Null if the transition
+    /// doesn't mix, or it belongs to the AnyState (which can be left from
+    /// any state).
+    const AnimationResetPlan* animationResetPlan() const { return m_AnimationResetPlan; }
 };
 } // namespace rive
 
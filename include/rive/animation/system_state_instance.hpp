@@ -20,6 +20,7 @@ public:
     void apply(ArtboardInstance* artboard, float mix) override;
 
     bool keepGoing() const override;
+    bool restart() override { return true; }
 };
 } // namespace rive
 #endif
\ No newline at end of file
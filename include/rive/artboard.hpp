@@ -4,6 +4,7 @@
 #include "rive/animation/linear_animation.hpp"
 #include "rive/animation/state_machine.hpp"
 #include "rive/core_context.hpp"
+#include "rive/core/core_arena.hpp"
 #include "rive/data_bind/data_bind.hpp"
 #include "rive/data_bind/data_context.hpp"
 #include "rive/data_bind/data_bind_context.hpp"
@@ -38,6 +39,7 @@ class StateMachineInstance;
 class Joystick;
 class TextValueRun;
 class Event;
+class LayerCache;
 class SMIBool;
 class SMIInput;
 class SMINumber;
@@ -54,6 +56,10 @@ class Artboard : public ArtboardBase, public CoreContext
     friend class Component;
 
 private:
+#ifdef WITH_RIVE_CORE_ARENA
+    // Holds the objects cloned into an instance. Declared first so it gets destroyed after them.
+    std::unique_ptr<CoreArena> m_coreArena;
+#endif
     std::vector<Core*> m_Objects;
     std::vector<LinearAnimation*> m_Animations;
     std::vector<StateMachine*> m_StateMachines;
@@ -67,6 +73,7 @@ private:
     DataContext* m_DataContext = nullptr;
     bool m_JoysticksApplyBeforeUpdate = true;
     bool m_HasChangedDrawOrderInLastUpdate = false;
+    bool m_HasAnimatingLayoutsInLastUpdate = false;
 
     unsigned int m_DirtDepth = 0;
     RawPath m_backgroundRawPath;
@@ -80,9 +87,13 @@ private:
     bool m_updatesOwnLayout = true;
     Artboard* parentArtboard() const;
     NestedArtboard* m_host = nullptr;
+    LayerCache* m_layerCache = nullptr;
+    bool m_cullHiddenNestedArtboards = false;
+    bool m_hasVisibleRegion = false;
+    AABB m_visibleRegion;
     bool sharesLayoutWithHost() const;
 
-#ifdef EXTERNAL_RIVE_AUDIO_ENGINE
+#ifdef WITH_RIVE_AUDIO
     rcp<AudioEngine> m_audioEngine;
 #endif
 
@@ -96,6 +107,31 @@ public:
     void host(NestedArtboard* nestedArtboard);
     NestedArtboard* host() const;
 
+    /// Nested artboards in this artboard, or in any artboard nested within it, that are marked
+    /// with NestedArtboard::cacheAsLayer() keep their content in this cache while they're idle.
+    /// The cache isn't owned by the artboard and has to outlive it. Artboards without a cache use
+    /// the one of the artboard they're nested in.
+    void layerCache(LayerCache* cache) { m_layerCache = cache; }
+    LayerCache* layerCache() const;
+
+    /// When enabled on the root artboard, nested artboards (at any depth) that are hidden, have
+    /// zero opacity, or clip their content and are entirely outside visibleRegion() don't advance
+    /// or update. They catch up on the time they missed once they're visible again.
+    ///
+    /// Off by default, since culled nested artboards don't report events or request advances.
+    void cullHiddenNestedArtboards(bool value) { m_cullHiddenNestedArtboards = value; }
+    bool cullHiddenNestedArtboards() const { return m_cullHiddenNestedArtboards; }
+
+    /// The part of the artboard that's on screen, in its world space, for culling nested
+    /// artboards. Defaults to the artboard's bounds.
+    void visibleRegion(const AABB& region)
+    {
+        m_visibleRegion = region;
+        m_hasVisibleRegion = true;
+    }
+    void resetVisibleRegion() { m_hasVisibleRegion = false; }
+    AABB visibleRegion() const;
+
 private:
 #ifdef TESTING
 public:
@@ -143,6 +179,11 @@ public:
     bool advance(double elapsedSeconds, bool nested = true);
     bool advanceInternal(double elapsedSeconds, bool isRoot, bool nested = true);
     bool hasChangedDrawOrderInLastUpdate() { return m_HasChangedDrawOrderInLastUpdate; };
+
+    /// How many seconds can pass before advancing the artboard changes anything, as of the last
+    /// advance (see Scene::settledSeconds()). Returns 0 if the artboard has pending updates, data
+    /// binds, or animating layouts, otherwise the smallest time any nested artboard can wait.
+    float settledSeconds() const;
     Drawable* firstDrawable() { return m_FirstDrawable; };
 
     enum class DrawOption
@@ -287,6 +328,13 @@ public:
 
         if (!m_Objects.empty())
         {
+#ifdef WITH_RIVE_CORE_ARENA
+            // Clone into the instance's own arena, so its objects are packed together and freed
+            // at once with it. The scope only covers the clones, which the instance deletes
+            // before its arena goes away.
+            artboardClone->m_coreArena = rivestd::make_unique<CoreArena>();
+            CoreArena::Scope arenaScope(artboardClone->m_coreArena.get());
+#endif
             // Skip first object (artboard).
             auto itr = m_Objects.begin();
             while (++itr != m_Objects.end())
@@ -362,7 +410,7 @@ public:
     float volume() const;
     void volume(float value);
 
-#ifdef EXTERNAL_RIVE_AUDIO_ENGINE
+#ifdef WITH_RIVE_AUDIO
     rcp<AudioEngine> audioEngine() const;
     void audioEngine(rcp<AudioEngine> audioEngine);
 #endif
@@ -33,6 +33,13 @@ public:
 
     static rcp<AudioEngine> Make(uint32_t numChannels, uint32_t sampleRate);
 
+    // Makes an engine that isn't attached to a playback device. Time only
+    // moves forward as mixed frames are rendered out of it, which lets hosts
+    // export audio faster than real time (and on machines without an audio
+    // device) in lockstep with StateMachineInstance::advance.
+    static rcp<AudioEngine> MakeOffline(uint32_t numChannels, uint32_t sampleRate);
+    bool isOffline() const { return m_isOffline; }
+
     ma_device* device() { return m_device; }
     ma_engine* engine() { return m_engine; }
 
@@ -49,10 +56,23 @@ public:
 
     static rcp<AudioEngine> RuntimeEngine(bool makeWhenNecessary = true);
 
-#ifdef EXTERNAL_RIVE_AUDIO_ENGINE
     bool readAudioFrames(float* frames, uint64_t numFrames, uint64_t* framesRead = nullptr);
     bool sumAudioFrames(float* frames, uint64_t numFrames);
-#endif
+
+    // Offline stepping. Call beginOfflineStep with the same elapsedSeconds
+    // that will be passed to StateMachineInstance::advance (before advancing)
+    // and then renderOfflineStep to mix the step into frames, which must hold
+    // offlineStepFrames() * channels() floats. Elapsed time is accumulated
+    // precisely so that steps never drift from the timeline, e.g. 60 steps of
+    // 1/60s at 48kHz always produce exactly 48000 frames.
+    uint64_t beginOfflineStep(float elapsedSeconds);
+    uint64_t offlineStepFrames() const { return m_offlineStepFrames; }
+    bool renderOfflineStep(float* frames);
+
+    // Engine time, in frames, at which a sound reported delaySeconds before
+    // the end of the current step (see EventReport::secondsDelay) should
+    // start. Real-time engines just start sounds now.
+    uint64_t eventTimeInFrames(float delaySeconds);
 
 #ifdef WITH_RIVE_AUDIO_TOOLS
     void initLevelMonitor();
@@ -68,10 +88,16 @@ public:
     size_t playingSoundCount();
 #endif
 private:
-    AudioEngine(ma_engine* engine, ma_context* context);
+    AudioEngine(ma_engine* engine, ma_context* context, bool isOffline);
+    static rcp<AudioEngine> Make(uint32_t numChannels, uint32_t sampleRate, bool isOffline);
     ma_device* m_device;
     ma_engine* m_engine;
     ma_context* m_context;
+    bool m_isOffline;
+    // Total offline time requested so far, and the frames it maps to.
+    double m_offlineSeconds = 0.0;
+    uint64_t m_offlineScheduledFrames = 0;
+    uint64_t m_offlineStepFrames = 0;
     std::mutex m_mutex;
 
     void soundCompleted(rcp<AudioSound> sound);
@@ -86,9 +112,7 @@ private:
     std::vector<float> m_levels;
     LevelsNode* m_levelMonitor = nullptr;
 #endif
-#ifdef EXTERNAL_RIVE_AUDIO_ENGINE
     std::vector<float> m_readFrames;
-#endif
 };
 } // namespace rive
 
@@ -13,7 +13,9 @@ public:
     void setAsset(FileAsset* asset) override;
     uint32_t assetId() override;
     void trigger(const CallbackData& value) override;
-    void play();
+    // delaySeconds is how long before the end of the current advance the
+    // event was reported, used by offline engines to place the sound.
+    void play(float delaySeconds = 0.0f);
 
 #ifdef TESTING
     AudioAsset* asset() const { return (AudioAsset*)m_fileAsset; }
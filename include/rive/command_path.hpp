@@ -7,6 +7,7 @@
 
 namespace rive
 {
+class RawPath;
 class RenderPath;
 
 /// Abstract path used to build up commands used for rendering.
@@ -23,6 +24,12 @@ public:
     virtual void cubicTo(float ox, float oy, float ix, float iy, float x, float y) = 0;
     virtual void close() = 0;
 
+    /// Replaces the contents of this path with rawPath. The default replays
+    /// every verb through the virtual moveTo/lineTo/cubicTo/close calls, paths
+    /// that are backed by a RawPath (or something equivalent) should override
+    /// this to copy it wholesale.
+    virtual void copy(const RawPath& rawPath);
+
     virtual RenderPath* renderPath() = 0;
 
     // non-virtual helpers
@@ -3,8 +3,10 @@
 #include "rive/generated/constraints/follow_path_constraint_base.hpp"
 #include "rive/math/transform_components.hpp"
 #include "rive/math/path_measure.hpp"
+#include <vector>
 namespace rive
 {
+class Path;
 class FollowPathConstraint : public FollowPathConstraintBase
 {
 public:
@@ -17,8 +19,24 @@ public:
     void buildDependencies() override;
 
 private:
+    /// A path (and its transform) that m_pathMeasure was built from.
+    struct MeasuredPath
+    {
+        const Path* path;
+        uint32_t rawPathVersion;
+        Mat2D pathTransform;
+    };
+
+    bool canReuseMeasure(const std::vector<Path*>& paths, Mat2D* measureTransform) const;
+
     RawPath m_rawPath;
     PathMeasure m_pathMeasure;
+    std::vector<MeasuredPath> m_measuredPaths;
+    // Maps m_pathMeasure (built in world space when it was last rebuilt) into
+    // the current world space. Transform-only changes of the target that
+    // preserve arc length ratios (translate, rotate, uniform scale) only
+    // update this instead of rebuilding the measure.
+    Mat2D m_measureTransform;
     TransformComponents m_ComponentsA;
     TransformComponents m_ComponentsB;
 };
@@ -17,6 +17,12 @@ public:
     const uint32_t emptyId = -1;
     static const int invalidPropertyKey = 0;
     virtual ~Core() {}
+
+#ifdef WITH_RIVE_CORE_ARENA
+    // Allocates from the current CoreArena::Scope's arena, if there is one.
+    static void* operator new(size_t size);
+    static void operator delete(void* ptr);
+#endif
     virtual uint16_t coreType() const = 0;
     virtual bool isTypeOf(uint16_t typeKey) const = 0;
     virtual bool deserialize(uint16_t propertyKey, BinaryReader& reader) = 0;
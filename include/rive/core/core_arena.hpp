@@ -0,0 +1,77 @@
+/*
+ * Copyright 2024 Rive
+ */
+
+#ifndef _RIVE_CORE_ARENA_HPP_
+#define _RIVE_CORE_ARENA_HPP_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+namespace rive
+{
+/// Monotonic allocator for Core objects. Objects of the same size share chunks, so an artboard's
+/// components, which are mostly a handful of types, end up packed next to each other instead of
+/// scattered across the heap. Deleting an object runs its destructor but doesn't give its memory
+/// back; all of it is freed at once when the arena is destroyed, which has to happen after every
+/// object allocated from it has been deleted.
+///
+/// Only used when built with WITH_RIVE_CORE_ARENA. Then Core's operator new allocates from the
+/// arena of the innermost Scope on the current thread (or the heap, outside of any Scope). File
+/// imports into its own arena, and Artboard::instance() clones into one owned by the instance.
+class CoreArena
+{
+public:
+    CoreArena() = default;
+    CoreArena(const CoreArena&) = delete;
+    CoreArena& operator=(const CoreArena&) = delete;
+    ~CoreArena();
+
+    /// Returns 16 byte aligned memory that lives as long as the arena.
+    void* allocate(size_t size);
+
+    /// Bytes handed out by allocate().
+    size_t allocatedBytes() const { return m_allocatedBytes; }
+    /// Bytes the arena got from the heap.
+    size_t reservedBytes() const { return m_reservedBytes; }
+
+    /// Returns the arena of the innermost Scope on the current thread, or null.
+    static CoreArena* current();
+
+    /// Makes Core objects created on this thread come from 'arena' (or the heap, if it's null)
+    /// until the Scope is destroyed.
+    class Scope
+    {
+    public:
+        explicit Scope(CoreArena* arena);
+        ~Scope();
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        CoreArena* m_previous;
+    };
+
+    constexpr static size_t kAlignment = 16;
+    /// Objects up to this size get a size class of their own. Larger ones get a chunk each.
+    constexpr static size_t kMaxSizeClassBytes = 512;
+    constexpr static size_t kChunkBytes = 16 * 1024;
+
+private:
+    struct SizeClass
+    {
+        uint8_t* cursor = nullptr;
+        uint8_t* end = nullptr;
+    };
+
+    uint8_t* allocateChunk(size_t size);
+
+    SizeClass m_sizeClasses[kMaxSizeClassBytes / kAlignment];
+    std::vector<void*> m_chunks;
+    size_t m_allocatedBytes = 0;
+    size_t m_reservedBytes = 0;
+};
+} // namespace rive
+
+#endif
@@ -25,7 +25,7 @@ public:
     void target(Core* value) { m_target = value; };
     virtual void bind();
     virtual void unbind();
-    ComponentDirt dirt() { return m_Dirt; };
+    ComponentDirt dirt() const { return m_Dirt; };
     void dirt(ComponentDirt value) { m_Dirt = value; };
     bool addDirt(ComponentDirt value, bool recurse);
     DataConverter* converter() const { return m_dataConverter; };
@@ -122,6 +122,12 @@ public:
 private:
     ImportResult read(BinaryReader&, const RuntimeHeader&);
 
+#ifdef WITH_RIVE_CORE_ARENA
+    /// Holds every object read from the file. Declared first so it gets
+    /// destroyed after them.
+    std::unique_ptr<CoreArena> m_coreArena;
+#endif
+
     /// The file's backboard. All Rive files have a single backboard
     /// where the artboards live.
     Backboard* m_backboard;
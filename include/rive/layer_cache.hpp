@@ -0,0 +1,103 @@
+/*
+ * Copyright 2024 Rive
+ */
+
+#ifndef _RIVE_LAYER_CACHE_HPP_
+#define _RIVE_LAYER_CACHE_HPP_
+
+#include "rive/renderer.hpp"
+
+#include <cstdint>
+#include <list>
+#include <unordered_map>
+
+namespace rive
+{
+/// Keeps the content of idle nested artboards in offscreen layers (see Renderer::beginLayer()), so
+/// they can be drawn as a single image instead of path by path.
+///
+/// Nested artboards opt in with NestedArtboard::cacheAsLayer(), and use the cache attached to the
+/// artboard they're in (see Artboard::layerCache()). Once one goes idleFrameThreshold() frames
+/// without changing, it gets drawn into a layer at its current scale, and the layer gets drawn in
+/// its place until it changes again, or until the scale it's drawn at changes by more than
+/// scaleTolerance(). The least recently drawn layers are dropped to stay within the budget.
+///
+/// Renderers that don't support layers just draw the content directly.
+class LayerCache
+{
+public:
+    struct Stats
+    {
+        uint64_t hits = 0;      // Draws that came from a layer.
+        uint64_t misses = 0;    // Draws of idle content that didn't have a usable layer.
+        uint64_t evictions = 0; // Layers dropped to stay within the budget.
+    };
+
+    explicit LayerCache(size_t budgetInBytes);
+    ~LayerCache();
+
+    LayerCache(const LayerCache&) = delete;
+    LayerCache& operator=(const LayerCache&) = delete;
+
+    /// Caps the estimated GPU memory of all layers in the cache.
+    size_t budgetInBytes() const { return m_budgetInBytes; }
+    void budgetInBytes(size_t value);
+
+    size_t usedBytes() const { return m_usedBytes; }
+    size_t layerCount() const { return m_lru.size(); }
+
+    /// Number of frames content has to go without changing before it gets drawn into a layer.
+    uint32_t idleFrameThreshold() const { return m_idleFrameThreshold; }
+    void idleFrameThreshold(uint32_t value) { m_idleFrameThreshold = value; }
+
+    /// How far (as a fraction) the scale of the content can drift from the one its layer was drawn
+    /// at before the layer gets dropped and drawn again.
+    float scaleTolerance() const { return m_scaleTolerance; }
+    void scaleTolerance(float value) { m_scaleTolerance = value; }
+
+    const Stats& stats() const { return m_stats; }
+    void resetStats() { m_stats = Stats(); }
+
+    /// Drops every layer.
+    void clear();
+
+    /// Returns a new key to identify a piece of content in the cache. Keys are never reused.
+    static uint64_t makeKey();
+
+    enum class DrawResult
+    {
+        drawn,     // The layer was drawn.
+        notCached, // There's no layer for the key.
+        dropped,   // The layer can't be drawn at the current scale, so it was dropped.
+    };
+
+    /// Draws the layer for 'key', if there is one that fits the renderer's current transform.
+    DrawResult draw(uint64_t key, Renderer*);
+
+    /// Keeps 'layer' for 'key', in place of any previous one. Returns false, and doesn't keep it,
+    /// if it alone is larger than the budget.
+    bool add(uint64_t key, rcp<RenderLayer> layer);
+
+    void remove(uint64_t key);
+
+private:
+    struct Entry
+    {
+        uint64_t key;
+        rcp<RenderLayer> layer;
+    };
+
+    void evictDownTo(size_t budgetInBytes);
+    void erase(std::list<Entry>::iterator);
+
+    size_t m_budgetInBytes;
+    size_t m_usedBytes = 0;
+    uint32_t m_idleFrameThreshold = 3;
+    float m_scaleTolerance = .25f;
+    Stats m_stats;
+
+    std::list<Entry> m_lru; // Most recently drawn first.
+    std::unordered_map<uint64_t, std::list<Entry>::iterator> m_entries;
+};
+} // namespace rive
+#endif
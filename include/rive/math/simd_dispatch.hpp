@@ -0,0 +1,82 @@
+/*
+ * Copyright 2024 Rive
+ */
+
+// Runtime CPU dispatch for hot SIMD kernels.
+//
+// simd.hpp compiles to whatever instruction set the build targets, which for distribution builds
+// on x86 is baseline SSE2. The kernels in this file are additionally compiled for newer instruction
+// sets (using function-level target attributes, so no special build flags are needed), and the best
+// variant the CPU supports gets picked the first time one is called.
+//
+// simd_dispatch.cpp turns off floating-point contraction (the AVX-512 target would otherwise fuse
+// multiply-adds), so every variant produces bit-identical results. Only x86 builds with GCC or
+// clang get variants; NEON and MSVC builds, and kernels not listed below (e.g., gradient packing),
+// always run the baseline code.
+
+#ifndef _RIVE_SIMD_DISPATCH_HPP_
+#define _RIVE_SIMD_DISPATCH_HPP_
+
+#include "rive/math/aabb.hpp"
+#include "rive/math/vec2d.hpp"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define RIVE_SIMD_X86_DISPATCH 1
+// Compiles a function for a specific instruction set, regardless of what the build targets. Only
+// call these functions after checking simd::active_isa(), and only pass vectors wider than 16
+// bytes to them by pointer, since their calling convention differs from baseline code.
+#define RIVE_SIMD_TARGET_SSE4_1 __attribute__((target("sse4.1")))
+#define RIVE_SIMD_TARGET_AVX2 __attribute__((target("avx2")))
+#define RIVE_SIMD_TARGET_AVX512 __attribute__((target("avx2,avx512f,avx512bw,avx512vl")))
+#else
+#define RIVE_SIMD_X86_DISPATCH 0
+#endif
+
+namespace rive
+{
+namespace simd
+{
+// Instruction set levels that dispatched kernels get compiled for. "baseline" is whatever the build
+// targets (e.g., SSE2 on x86, NEON on arm64, SIMD128 on wasm). The others only exist on x86 builds
+// with GCC or clang.
+enum class ISA : uint8_t
+{
+    baseline,
+    sse4_1,
+    avx2,
+    avx512,
+};
+
+const char* isa_name(ISA);
+
+// Returns true if kernels were compiled for the given ISA, and the CPU supports it.
+bool is_isa_supported(ISA);
+
+// Returns the ISA whose kernels are currently in use.
+ISA active_isa();
+
+// Forces kernels to use the given ISA, for testing and benchmarking. Returns false, and changes
+// nothing, if the ISA isn't supported.
+bool force_isa(ISA);
+
+// Goes back to using the best ISA the CPU supports.
+void reset_isa();
+
+// Table of dispatched kernels.
+struct Kernels
+{
+    // Implements Mat2D::mapPoints(). 'mat' is a Mat2D's 6 values.
+    void (*mapPoints)(const float mat[6], Vec2D dst[], const Vec2D pts[], size_t n);
+    // Implements Mat2D::mapBoundingBox().
+    AABB (*mapBoundingBox)(const float mat[6], const Vec2D pts[], size_t n);
+};
+
+// Returns the kernels for active_isa().
+const Kernels& kernels();
+} // namespace simd
+} // namespace rive
+
+#endif
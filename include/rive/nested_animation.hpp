@@ -59,6 +59,10 @@ public:
     // Advance animations and apply them to the artboard.
     virtual bool advance(float elapsedSeconds) = 0;
 
+    // Returns how many seconds can pass before advancing changes anything
+    // (see Scene::settledSeconds()).
+    virtual float settledSeconds() const = 0;
+
     // Initialize the animation (make instances as necessary) from the
     // source artboard.
     virtual void initializeAnimation(ArtboardInstance*) = 0;
@@ -12,6 +12,7 @@ namespace rive
 {
 
 class ArtboardInstance;
+class LayerCache;
 class NestedAnimation;
 class NestedInput;
 class NestedStateMachine;
@@ -26,6 +27,18 @@ protected:
 protected:
     std::vector<uint32_t> m_DataBindPathIdsBuffer;
 
+private:
+    bool m_cacheAsLayer = false;
+    bool m_layerContentChanged = true;
+    uint32_t m_layerIdleFrames = 0;
+    uint64_t m_layerCacheKey = 0;
+    LayerCache* m_layerCache = nullptr;
+    bool m_isCulled = false;
+    float m_culledSeconds = 0.0f;
+
+    bool drawFromLayerCache(Renderer* renderer);
+    bool shouldCull() const;
+
 public:
     NestedArtboard();
     ~NestedArtboard() override;
@@ -40,8 +53,20 @@ public:
     StatusCode import(ImportStack& importStack) override;
     Core* clone() const override;
     bool advance(float elapsedSeconds);
+    /// How many seconds can pass before the nested artboard or its animations change anything.
+    /// Culled and collapsed nested artboards wait for something else to make them visible.
+    float settledSeconds() const;
     void update(ComponentDirt value) override;
 
+    /// When enabled, and the nested artboard clips its content, the content gets drawn from the
+    /// layer cache of the artboard it's in (see Artboard::layerCache()) while it isn't changing.
+    void cacheAsLayer(bool value) { m_cacheAsLayer = value; }
+    bool cacheAsLayer() const { return m_cacheAsLayer; }
+
+    /// Whether the most recent advance was skipped because the nested artboard couldn't be seen
+    /// (see Artboard::cullHiddenNestedArtboards()).
+    bool isCulled() const { return m_isCulled; }
+
     bool hasNestedStateMachines() const;
     Span<NestedAnimation*> nestedAnimations();
     NestedArtboard* nestedArtboard(std::string name) const;
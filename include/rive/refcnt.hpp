@@ -45,6 +45,10 @@ public:
         }
     }
 
+    // Returns true if the caller holds the only reference. Once that's the case, no other thread
+    // can add one, so it stays true until the caller hands out a new reference.
+    bool unique() const { return m_refcnt.load(std::memory_order_acquire) == 1; }
+
     // not reliable in actual threaded scenarios, but useful (perhaps) for debugging
     int32_t debugging_refcnt() const { return m_refcnt.load(std::memory_order_relaxed); }
 
@@ -148,6 +148,27 @@ public:
     virtual void addRenderPath(RenderPath* path, const Mat2D& transform) = 0;
 };
 
+// Offscreen image of the content drawn between Renderer::beginLayer() and endLayer(), which can be
+// drawn again with Renderer::drawLayer(), in the same frame or in later ones.
+class RenderLayer : public RefCnt<RenderLayer>, public enable_lite_rtti<RenderLayer>
+{
+public:
+    virtual ~RenderLayer();
+
+    // Rectangle the layer covers, in the local coordinate space it was drawn in.
+    const AABB& bounds() const { return m_bounds; }
+
+    // Estimated GPU memory held by the layer.
+    size_t sizeInBytes() const { return m_sizeInBytes; }
+
+protected:
+    RenderLayer(const AABB& bounds, size_t sizeInBytes);
+
+private:
+    AABB m_bounds;
+    size_t m_sizeInBytes;
+};
+
 class Renderer
 {
 public:
@@ -167,6 +188,22 @@ public:
                                BlendMode,
                                float opacity) = 0;
 
+    // Offscreen layers. Renderers that don't support them return null from beginLayer() and false
+    // from drawLayer(), and their callers draw content directly instead.
+    //
+    // beginLayer() redirects draws into a new, transparent layer that covers 'bounds' in the
+    // current local coordinate space, at the resolution of the current transform, until
+    // endLayer(). Draws in the layer use the same coordinates, and aren't clipped by the current
+    // clip. Only call endLayer() if beginLayer() succeeded. Layers don't nest.
+    virtual rcp<RenderLayer> beginLayer(const AABB& bounds) { return nullptr; }
+    virtual void endLayer() {}
+
+    // Draws a finished layer in the current local coordinate space. Returns false, without
+    // drawing, if the layer came from a different renderer, or if the current transform scales
+    // by more than 'scaleTolerance' (a fraction, e.g., .25) more or less than the one the layer
+    // was drawn with.
+    virtual bool drawLayer(const RenderLayer*, float scaleTolerance) { return false; }
+
     // helpers
 
     void translate(float x, float y);
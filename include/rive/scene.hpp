@@ -46,6 +46,15 @@ public:
     // returns true if draw() should be called
     virtual bool advanceAndApply(float elapsedSeconds) = 0;
 
+    // Returns how many seconds can pass before the Scene changes on its own,
+    // as of the last advanceAndApply(). Until then, the host can skip both
+    // advanceAndApply() and draw(), and pass the whole time that went by to
+    // the next advanceAndApply(). Returns 0 if the Scene needs to advance now,
+    // and infinity if nothing will change until something outside of it
+    // does. Setting inputs, pointer events, changing view models, and
+    // editing the artboard all end the settled period.
+    virtual float settledSeconds() const;
+
     void draw(Renderer*);
 
     virtual void setDataContextFromInstance(ViewModelInstance* viewModelInstance);
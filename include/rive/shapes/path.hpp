@@ -42,6 +42,7 @@ protected:
     bool m_deferredPathDirt = false;
     PathFlags m_pathFlags = PathFlags::none;
     RawPath m_rawPath;
+    uint32_t m_rawPathVersion = 0;
 
 public:
     Shape* shape() const { return m_Shape; }
@@ -50,6 +51,9 @@ public:
     virtual const Mat2D& pathTransform() const;
     bool collapse(bool value) override;
     const RawPath& rawPath() const { return m_rawPath; }
+    /// Incremented every time the path's geometry (rawPath) is rebuilt. Lets
+    /// dependents tell geometry changes apart from transform-only changes.
+    uint32_t rawPathVersion() const { return m_rawPathVersion; }
     void update(ComponentDirt value) override;
 
     void addFlags(PathFlags flags);
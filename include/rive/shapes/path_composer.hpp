@@ -3,10 +3,12 @@
 #include "rive/component.hpp"
 #include "rive/refcnt.hpp"
 #include "rive/math/raw_path.hpp"
+#include <vector>
 
 namespace rive
 {
 class Shape;
+class Path;
 class CommandPath;
 class RenderPath;
 class PathComposer : public Component
@@ -25,15 +27,33 @@ public:
     const RawPath& localRawPath() const { return m_localRawPath; }
     const RawPath& worldRawPath() const { return m_worldRawPath; }
 
+    /// Incremented whenever the shape space geometry (localRawPath) changes.
+    /// Transform-only changes of the shape keep the same version.
+    uint32_t localGeometryVersion() const { return m_localGeometryVersion; }
+
     void pathCollapseChanged();
 
 private:
+    /// Snapshot of a path that contributed to m_localRawPath, used to detect
+    /// whether the shape space geometry actually changed.
+    struct LocalPathRecord
+    {
+        const Path* path;
+        uint32_t rawPathVersion;
+        Mat2D localTransform;
+    };
+
+    bool updateLocalRecords(const Mat2D& inverseWorld);
+    void buildLocalRawPath();
+
     Shape* m_shape;
     RawPath m_localRawPath;
     RawPath m_worldRawPath;
     rcp<CommandPath> m_localPath;
     rcp<CommandPath> m_worldPath;
     bool m_deferredPathDirt;
+    std::vector<LocalPathRecord> m_localRecords;
+    uint32_t m_localGeometryVersion = 0;
 };
 } // namespace rive
 #endif
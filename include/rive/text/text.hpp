@@ -56,6 +56,11 @@ public:
     const std::vector<TextRun>& runs() const { return m_runs; }
 
     void swapRuns(std::vector<TextRun>& otherRuns) { m_runs.swap(otherRuns); }
+
+    /// True if both have the same characters in the same fonts and styles, and so would shape
+    /// the same.
+    bool operator==(const StyledText& other) const;
+    bool operator!=(const StyledText& other) const { return !(*this == other); }
 };
 
 // STL-style iterator for individual glyphs in a line, simplfies call sites from
@@ -255,6 +260,33 @@ private:
     StyledText m_styledText;
     StyledText m_modifierStyledText;
 
+    // The text m_shape was shaped from. Layout changes (width, height, alignment, etc.) only need
+    // the lines broken again, so shaping is skipped while the styled text stays the same.
+    StyledText m_shapedText;
+    void shapeStyledText();
+
+    // Yoga can measure the same text several times per layout pass, so keep the most recent
+    // results, until the text gets shaped again.
+    struct MeasureMemo
+    {
+        Vec2D maxSize;
+        float width;
+        float height;
+        float paragraphSpacing;
+        uint32_t sizing;
+        uint32_t align;
+        uint32_t wrap;
+        uint32_t overflow;
+        uint32_t verticalAlign;
+        uint32_t origin;
+        Vec2D size;
+
+        bool sameInputs(const MeasureMemo& other) const;
+    };
+    static constexpr size_t kMaxMeasureMemos = 4;
+    std::vector<MeasureMemo> m_measureMemos;
+    Vec2D measureShape(Vec2D maxSize) const;
+
     GlyphLookup m_glyphLookup;
 #endif
     float m_layoutWidth = NAN;
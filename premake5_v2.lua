@@ -26,6 +26,10 @@ filter({ 'options:with_rive_layout' })
 do
     defines({ 'WITH_RIVE_LAYOUT' })
 end
+filter({ 'options:with_rive_core_arena' })
+do
+    defines({ 'WITH_RIVE_CORE_ARENA' })
+end
 filter({})
 
 dependencies = path.getabsolute('dependencies/')
@@ -200,3 +204,11 @@ newoption({
     trigger = 'with_rive_layout',
     description = 'Compiles in layout features.',
 })
+
+-- Arenas speed up destroying files and instances, but not importing them: jellyfish_test.riv went
+-- from 1.40ms to 1.53ms. Objects are still destroyed one at a time, since their destructors have to
+-- run; arenas only free their memory in bulk.
+newoption({
+    trigger = 'with_rive_core_arena',
+    description = 'Allocates the objects of files and artboard instances from arenas.',
+})
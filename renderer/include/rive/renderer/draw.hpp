@@ -12,11 +12,14 @@
 #include "rive/shapes/paint/stroke_cap.hpp"
 #include "rive/shapes/paint/stroke_join.hpp"
 #include "rive/refcnt.hpp"
+#include <vector>
 
 namespace rive
 {
 class RiveRenderPath;
 class RiveRenderPaint;
+class InteriorTriangulation;
+class InteriorTriangulationWorker;
 } // namespace rive
 
 namespace rive::gpu
@@ -47,7 +50,14 @@ public:
     Draw(AABB bounds, const Mat2D&, BlendMode, rcp<const Texture> imageTexture, Type);
 
     const Texture* imageTexture() const { return m_imageTextureRef; }
+    // Maps the unit image rect to the image's region of imageTexture().
+    const Mat2D& imageUVTransform() const { return m_imageUVTransform; }
+    // True if imageTexture()'s colors are already multiplied by alpha.
+    bool imageIsPremultiplied() const { return m_imageIsPremultiplied; }
     const IAABB& pixelBounds() const { return m_pixelBounds; }
+    // Pixels this draw is guaranteed to cover with fully opaque color, before clipping. Empty if
+    // there's no such region that can be found cheaply.
+    const IAABB& opaquePixelBounds() const { return m_opaquePixelBounds; }
     const Mat2D& matrix() const { return m_matrix; }
     BlendMode blendMode() const { return m_blendMode; }
     Type type() const { return m_type; }
@@ -64,6 +74,15 @@ public:
     gpu::SimplePaintValue simplePaintValue() const { return m_simplePaintValue; }
     const Gradient* gradient() const { return m_gradientRef; }
 
+    // Draws with this content key are treated as different from every other draw.
+    constexpr static uint64_t kAlwaysDamagedContentKey = 0;
+
+    // Hash of everything that determines what this draw renders: its geometry, matrix, paint,
+    // blend mode, and clipRect. Clip IDs aren't stable from frame to frame, so the caller passes in
+    // the content key of the clip this draw reads (or that a clipUpdate is nested in) instead, or
+    // 0 if there isn't one. Draws with equal keys in different frames render the same pixels.
+    virtual uint64_t contentKey(uint64_t clipContentKey) const;
+
     // Clipping setup.
     void setClipID(uint32_t clipID);
     void setClipRect(const gpu::ClipRectInverseMatrix* m) { m_clipRectInverseMatrix = m; }
@@ -97,6 +116,7 @@ protected:
     const Texture* const m_imageTextureRef;
     const AABB m_bounds;
     const IAABB m_pixelBounds;
+    IAABB m_opaquePixelBounds = {0, 0, 0, 0};
     const Mat2D m_matrix;
     const BlendMode m_blendMode;
     const Type m_type;
@@ -114,6 +134,10 @@ protected:
     const Gradient* m_gradientRef = nullptr;
     gpu::SimplePaintValue m_simplePaintValue;
 
+    // Image data used by image paints and imageRects.
+    Mat2D m_imageUVTransform;
+    bool m_imageIsPremultiplied = false;
+
     // Linked list of all Draws within a gpu::DrawBatch.
     const Draw* m_batchInternalNeighbor = nullptr;
 };
@@ -138,6 +162,8 @@ public:
     float strokeRadius() const { return m_strokeRadius; }
     gpu::ContourDirections contourDirections() const { return m_contourDirections; }
 
+    uint64_t contentKey(uint64_t clipContentKey) const override;
+
     void pushToRenderContext(RenderContext::LogicalFlush*) override;
 
     void releaseRefs() override;
@@ -213,6 +239,41 @@ private:
     uint32_t* m_polarSegmentCounts = nullptr;
     uint32_t* m_parametricSegmentCounts = nullptr;
 
+public:
+    // Copy of everything initForMidpointFan() computes, kept by the path so later frames can skip
+    // Wang's formula, chopping, and polar segment counting while the path is unchanged and drawn
+    // at a similar scale (see RiveRenderPath::tessCounts()).
+    struct TessCounts
+    {
+        // The path has to go unchanged between two draws before its counts get saved, so paths
+        // that animate every frame don't pay for copying them.
+        uint64_t rawPathMutationID;
+        bool hasCounts = false;
+
+        Mat2D matrix;
+        float strokeRadius;
+        float strokeMatrixMaxScale;
+        StrokeJoin strokeJoin;
+        StrokeCap strokeCap;
+        size_t tessVertexCount;
+        size_t maxTessellatedSegmentCount;
+        std::vector<ContourInfo> contours;
+        std::vector<uint8_t> numChops;
+        std::vector<Vec2D> chopVertices;
+        std::vector<std::array<Vec2D, 2>> tangentPairs;
+        std::vector<uint32_t> polarSegmentCounts;
+        std::vector<uint32_t> parametricSegmentCounts;
+
+        RIVE_DEBUG_CODE(size_t pendingLineCount;)
+        RIVE_DEBUG_CODE(size_t pendingCurveCount;)
+        RIVE_DEBUG_CODE(size_t pendingRotationCount;)
+        RIVE_DEBUG_CODE(size_t pendingEmptyStrokeCountForCaps;)
+    };
+
+private:
+    bool canReuseTessCounts(const TessCounts&) const;
+    void restoreTessCounts(RenderContext*, const TessCounts&);
+
     // Consistency checks for onPushToRenderContext().
     RIVE_DEBUG_CODE(size_t m_pendingLineCount;)
     RIVE_DEBUG_CODE(size_t m_pendingCurveCount;)
@@ -233,7 +294,13 @@ public:
     };
 
     // Interior Triangulation path draw
-    void initForInteriorTriangulation(RenderContext*, RawPath*, TriangulatorAxis);
+    //
+    // If asyncWorker is non-null and the path doesn't have a matching triangulation ready yet,
+    // this kicks one off in the background and returns false. The draw must then be discarded.
+    bool initForInteriorTriangulation(RenderContext*,
+                                      RawPath*,
+                                      TriangulatorAxis,
+                                      InteriorTriangulationWorker* asyncWorker = nullptr);
     GrInnerFanTriangulator* triangulator() const { return m_triangulator; }
 
 private:
@@ -248,12 +315,14 @@ private:
     // anyway, adding complexity to only run Wang's formula and chop once would save about ~5%
     // of the total CPU time. (And large paths are GPU-bound anyway.)
     void processPath(PathOp op,
-                     TrivialBlockAllocator*,
                      RawPath* scratchPath,
                      TriangulatorAxis,
+                     InteriorTriangulationWorker* asyncWorker,
                      RenderContext::LogicalFlush*);
 
     GrInnerFanTriangulator* m_triangulator = nullptr;
+    // Owns m_triangulator. Held (and possibly cached on the path) across frames.
+    InteriorTriangulation* m_interiorTriangulationRef = nullptr;
 };
 
 // Pushes an imageRect to the render context.
@@ -267,10 +336,14 @@ public:
                   const Mat2D&,
                   BlendMode,
                   rcp<const Texture>,
-                  float opacity);
+                  const Mat2D& uvTransform,
+                  float opacity,
+                  bool imageIsPremultiplied = false);
 
     float opacity() const { return m_opacity; }
 
+    uint64_t contentKey(uint64_t clipContentKey) const override;
+
     void pushToRenderContext(RenderContext::LogicalFlush*) override;
 
 protected:
@@ -297,6 +370,10 @@ public:
     uint32_t indexCount() const { return m_indexCount; }
     float opacity() const { return m_opacity; }
 
+    // The buffers' contents can change without the buffers themselves changing, so meshes always
+    // count as damaged.
+    uint64_t contentKey(uint64_t) const override { return kAlwaysDamagedContentKey; }
+
     void pushToRenderContext(RenderContext::LogicalFlush*) override;
 
     void releaseRefs() override;
@@ -33,6 +33,10 @@ public:
 
     size_t pushCount() const { return m_end - m_array; }
 
+    // Everything pushed since the last reset() or rewind(), including items already popped.
+    const T* begin() const { return m_array; }
+    const T* end() const { return m_end; }
+
     T& push_back()
     {
         assert(m_end < m_array + m_capacity);
@@ -43,6 +43,27 @@ public:
                                   uint32_t mipLevelCount,
                                   const uint8_t imageDataRGBA[]) override;
 
+    bool updateImageTexture(Texture*,
+                            uint32_t mipLevel,
+                            uint32_t x,
+                            uint32_t y,
+                            uint32_t width,
+                            uint32_t height,
+                            size_t rowBytes,
+                            const uint8_t imageDataRGBA[]) override;
+
+    rcp<Texture> makeCompressedImageTexture(uint32_t width,
+                                            uint32_t height,
+                                            ImageTextureFormat,
+                                            uint32_t mipLevelCount,
+                                            const uint8_t* const levelData[],
+                                            const size_t levelSizesInBytes[]) override;
+
+    rcp<RenderTarget> makeLayerRenderTarget(uint32_t width,
+                                            uint32_t height,
+                                            rcp<Texture>*,
+                                            bool* textureIsBottomUp) override;
+
     // Takes ownership of textureID and responsibility for deleting it.
     rcp<Texture> adoptImageTexture(uint32_t width, uint32_t height, GLuint textureID);
 
@@ -90,6 +90,16 @@ static_assert(1 << kTessTextureWidthLog2 == kTessTextureWidth);
 constexpr static uint32_t kGradTextureWidth = 512;
 constexpr static uint32_t kGradTextureWidthInSimpleRamps = kGradTextureWidth / 2;
 
+// Formats image textures can be uploaded in. Everything besides rgba8 is block compressed, with
+// 4x4 blocks of 16 bytes.
+enum class ImageTextureFormat : uint8_t
+{
+    rgba8,
+    etc2RGBA8,
+    astc4x4,
+    bc7,
+};
+
 // Backend-specific capabilities/workarounds and fine tuning.
 struct PlatformFeatures
 {
@@ -109,6 +119,26 @@ struct PlatformFeatures
                                                    // "DrawType::atomicInitialize" draw instead.
     uint8_t pathIDGranularity = 1; // Workaround for precision issues. Determines how far apart we
                                    // space unique path IDs.
+    // Block-compressed image formats that can be uploaded with makeCompressedImageTexture().
+    bool supportsETC2Textures = false;
+    bool supportsASTCTextures = false;
+    bool supportsBC7Textures = false;
+
+    bool supportsImageTextureFormat(ImageTextureFormat format) const
+    {
+        switch (format)
+        {
+            case ImageTextureFormat::rgba8:
+                return true;
+            case ImageTextureFormat::etc2RGBA8:
+                return supportsETC2Textures;
+            case ImageTextureFormat::astc4x4:
+                return supportsASTCTextures;
+            case ImageTextureFormat::bc7:
+                return supportsBC7Textures;
+        }
+        RIVE_UNREACHABLE();
+    }
 };
 
 // Gradient color stops are implemented as a horizontal span of pixels in a global gradient
@@ -944,7 +974,8 @@ public:
              GradTextureLayout,
              uint32_t clipID,
              bool hasClipRect,
-             BlendMode);
+             BlendMode,
+             bool imageIsPremultiplied = false);
 
 private:
     WRITEONLY uint32_t m_params; // [clipID, flags, paintType]
@@ -972,6 +1003,7 @@ public:
              SimplePaintValue,
              const Gradient*,
              const Texture*,
+             const Mat2D& imageUVTransform,
              const ClipRectInverseMatrix*,
              const RenderTarget*,
              const gpu::PlatformFeatures&);
@@ -1045,7 +1077,9 @@ public:
                       const ClipRectInverseMatrix*,
                       uint32_t clipID,
                       BlendMode,
-                      uint32_t zIndex);
+                      uint32_t zIndex,
+                      const Mat2D& texCoordMatrix = Mat2D(),
+                      bool imageIsPremultiplied = false);
 
 private:
     WRITEONLY float m_matrix[6];
@@ -1055,13 +1089,17 @@ private:
     WRITEONLY uint32_t m_clipID;
     WRITEONLY uint32_t m_blendMode;
     WRITEONLY uint32_t m_zIndex; // gpu::InterlockMode::msaa only.
+    WRITEONLY uint32_t m_imageIsPremultiplied;
+    WRITEONLY uint32_t m_padding2[2] = {0, 0};
+    WRITEONLY float m_texCoordMatrix[6]; // imageRect only.
     // Uniform blocks must be multiples of 256 bytes in size.
-    WRITEONLY uint8_t m_padTo256Bytes[256 - 68];
+    WRITEONLY uint8_t m_padTo256Bytes[256 - 104];
 
     constexpr void staticChecks()
     {
         static_assert(offsetof(ImageDrawUniforms, m_matrix) % 16 == 0);
         static_assert(offsetof(ImageDrawUniforms, m_clipRectInverseMatrix) % 16 == 0);
+        static_assert(offsetof(ImageDrawUniforms, m_texCoordMatrix) == 80);
         static_assert(sizeof(ImageDrawUniforms) == 256);
     }
 };
@@ -112,6 +112,13 @@ public:
                                   uint32_t mipLevelCount,
                                   const uint8_t imageDataRGBA[]) override;
 
+    rcp<Texture> makeCompressedImageTexture(uint32_t width,
+                                            uint32_t height,
+                                            ImageTextureFormat,
+                                            uint32_t mipLevelCount,
+                                            const uint8_t* const levelData[],
+                                            const size_t levelSizesInBytes[]) override;
+
     // Atomic mode requires a barrier between overlapping draws. We have to implement this barrier
     // in various different ways, depending on which hardware we're on.
     enum class AtomicBarrierType
@@ -18,14 +18,18 @@ class RenderContextTest;
 
 namespace rive
 {
+class InteriorTriangulationWorker;
 class RawPath;
+class RiveRenderImage;
 class RiveRenderPaint;
 class RiveRenderPath;
 } // namespace rive
 
 namespace rive::gpu
 {
+class DamageTracker;
 class GradientLibrary;
+class ImageAtlas;
 class IntersectionBoard;
 class ImageMeshDraw;
 class ImageRectDraw;
@@ -34,6 +38,8 @@ class Draw;
 class Gradient;
 class RenderContextImpl;
 class RiveRenderPathDraw;
+class Texture;
+class TextureResidencyManager;
 
 // Used as a key for complex gradients.
 class GradientContentKey
@@ -107,6 +113,28 @@ public:
         bool disableRasterOrdering = false; // Use atomic mode in place of rasterOrdering, even if
                                             // rasterOrdering is supported.
 
+        // Filled paths with fewer verbs than interiorTriangulationMaxVerbCount, whose bounds cover
+        // more than interiorTriangulationMinArea pixels, get drawn with interior triangulation
+        // instead of midpoint fans.
+        size_t interiorTriangulationMaxVerbCount = 1000;
+        float interiorTriangulationMinArea = 512 * 512;
+        // Triangulate on a worker thread instead of during the frame. Paths get drawn as midpoint
+        // fans until their triangulation is ready, which takes at least one frame.
+        bool asyncInteriorTriangulation = false;
+
+        // Only redraw the region that changed since the previous frame. Each draw gets compared
+        // against the previous frame's by content (geometry, matrix, paint, clip), and the pixels
+        // of draws that were added, removed, or reordered get cleared to clearColor and redrawn.
+        // The rest of the render target is preserved, and draws outside the damaged region are
+        // skipped. (See damageBounds().) Paths compare by mutation, so a path that gets rebuilt
+        // every frame always counts as changed.
+        //
+        // The render target must still hold the previous frame's pixels. Frames draw in full
+        // instead if loadAction isn't clear, clearColor isn't opaque, the frame can't use
+        // clipRects, or there's no comparable previous frame (a different render target, size,
+        // clearColor, or interlock mode, or a previous frame without damageTracking).
+        bool damageTracking = false;
+
         // Testing flags.
         bool wireframe = false;
         bool fillsDisabled = false;
@@ -124,7 +152,8 @@ public:
         return m_frameDescriptor;
     }
 
-    // True if bounds is empty or outside [0, 0, renderTargetWidth, renderTargetHeight].
+    // True if bounds is empty or outside [0, 0, renderTargetWidth, renderTargetHeight], or outside
+    // the current layer (see beginLayer()).
     bool isOutsideCurrentFrame(const IAABB& pixelBounds);
 
     // True if the current frame supports draws with clipRects (clipRectInverseMatrix != null).
@@ -247,6 +276,51 @@ public:
         return m_perFrameAllocator.make<T>(std::forward<Args>(args)...);
     }
 
+    // Caps the estimated GPU memory of textures for images from decodeImage(). At the end of a
+    // frame that goes over budget, the least recently drawn textures are downscaled, and then
+    // released, until they fit. Evicted textures get decoded again, from encoded bytes that
+    // decodeImage() retains, the next time they're drawn.
+    //
+    // Zero (the default) disables the budget. Only images decoded while a budget is set are
+    // tracked.
+    void setImageTextureBudget(size_t budgetInBytes);
+    size_t imageTextureBudget() const;
+
+    // Estimated GPU memory held by the textures of tracked images.
+    size_t residentImageTextureBytes() const;
+
+    // Packs images from decodeImage() that are no larger than 'maxImageDimension' in either
+    // dimension into shared atlas textures, so draws of different small images (e.g., icons) can
+    // be batched together. Atlased images are decoded on the CPU, and each page gets uploaded
+    // again whenever images are added to it.
+    //
+    // Zero (the default) disables atlasing. Atlased images don't count against the image texture
+    // budget.
+    void setImageAtlasMaxImageDimension(uint32_t maxImageDimension);
+    uint32_t imageAtlasMaxImageDimension() const;
+
+    // Returns the texture to draw 'image' with during the current frame, decoding it again first if
+    // it was evicted. For atlased images, this is the atlas page's texture.
+    rcp<Texture> refImageTexture(const RiveRenderImage*);
+
+    // Redirects the draws that follow into a new, transparent offscreen layer of the given size,
+    // until endLayer(). The layer's draws go in logical flushes of their own, which execute before
+    // the ones after endLayer(), so the returned image can be drawn for the rest of the frame and
+    // in later frames. Layers don't nest.
+    //
+    // Returns null if the backend doesn't support offscreen layers.
+    rcp<RiveRenderImage> beginLayer(uint32_t width, uint32_t height);
+    void endLayer();
+
+    // Number of draws the most recent flush() skipped because later opaque draws covered them
+    // completely. (Only rasterOrdering and atomic modes cull occluded draws.)
+    size_t occlusionCulledDrawCount() const { return m_occlusionCulledDrawCount; }
+
+    // Region of the render target that the most recent flush() updated, e.g., for partial-present
+    // APIs. This is the entire render target unless FrameDescriptor::damageTracking found a smaller
+    // (possibly empty) region that changed.
+    const IAABB& damageBounds() const { return m_damageBounds; }
+
     // Backend-specific RiveRenderFactory implementation.
     rcp<RenderBuffer> makeRenderBuffer(RenderBufferType, RenderBufferFlags, size_t) override;
     rcp<RenderImage> decodeImage(Span<const uint8_t>) override;
@@ -309,6 +383,15 @@ private:
     void mapResourceBuffers(const ResourceAllocationCounts&);
     void unmapResourceBuffers();
 
+    // Lazily starts the thread for FrameDescriptor::asyncInteriorTriangulation. Returns null if
+    // the platform can't run one.
+    InteriorTriangulationWorker* interiorTriangulationWorker();
+
+    // Implements FrameDescriptor::damageTracking. Finds the region that changed since the previous
+    // frame, and if it's smaller than the render target, clips the frame's draws to it and clears
+    // it with a draw, so the first logical flush can preserve the render target instead.
+    void clipFrameToDamage(const RenderTarget*);
+
     const std::unique_ptr<RenderContextImpl> m_impl;
     const size_t m_maxPathID;
 
@@ -329,6 +412,25 @@ private:
     std::vector<int64_t> m_indirectDrawList;
     std::unique_ptr<IntersectionBoard> m_intersectionBoard;
 
+    std::unique_ptr<InteriorTriangulationWorker> m_interiorTriangulationWorker;
+
+    // Counts frames for image texture LRU tracking.
+    uint64_t m_frameNumber = 0;
+    std::unique_ptr<TextureResidencyManager> m_textureResidencyManager;
+    std::unique_ptr<ImageAtlas> m_imageAtlas;
+
+    size_t m_occlusionCulledDrawCount = 0;
+
+    // Damage tracking state (see FrameDescriptor::damageTracking).
+    std::unique_ptr<DamageTracker> m_damageTracker;
+    IAABB m_damageBounds = {0, 0, 0, 0};
+    bool m_isPartialFrame = false; // Only the region inside m_damageBounds gets drawn.
+    const gpu::ClipRectInverseMatrix* m_damageClipRect = nullptr;
+
+    // Offscreen layer that draws currently go into (see beginLayer()).
+    rcp<RenderTarget> m_layerRenderTarget;
+    rcp<Texture> m_layerTexture;
+
     WriteOnlyMappedMemory<gpu::FlushUniforms> m_flushUniformData;
     WriteOnlyMappedMemory<gpu::PathData> m_pathData;
     WriteOnlyMappedMemory<gpu::PaintData> m_paintData;
@@ -379,6 +481,11 @@ private:
         // Resets the CPU-side STL containers so they don't have unbounded growth.
         void resetContainers();
 
+        // Sends this flush to an offscreen layer instead of the frame's render target. The first
+        // flush of a layer clears it to transparent.
+        void setLayer(rcp<RenderTarget>, rcp<Texture>, bool isFirstFlushOfLayer);
+        bool isLayer() const { return m_layerRenderTarget != nullptr; }
+
         // Access this flush's gpu::FlushDescriptor (which is not valid until layoutResources()).
         // NOTE: Some fields in the FlushDescriptor (tessVertexSpanCount, hasTriangleVertices,
         // drawList, and combinedShaderFeatures) do not become valid until after writeResources().
@@ -421,6 +528,26 @@ private:
         // point the context must append a new logical flush and try again.
         [[nodiscard]] bool pushDrawBatch(DrawUniquePtr draws[], size_t drawCount);
 
+        // Drops draws that are completely hidden behind later draws with opaque, axis-aligned,
+        // unclipped rectangles (Draw::opaquePixelBounds()), and takes them out of the resource
+        // counts. Must be called before layoutResources(). Returns the number of dropped draws.
+        size_t cullOccludedDraws();
+
+        // Adds the draws that produce color to the tracker, keyed by Draw::contentKey(). (Clip
+        // updates go into the keys of the draws that read them.)
+        void addDrawsToDamageTracker(DamageTracker*) const;
+
+        // Draws clipped by non-axis-aligned clipRects can't also be clipped to the damaged region,
+        // so the region grows to cover them instead. Returns true if 'damage' changed.
+        bool expandDamageForClipRects(IAABB* damage) const;
+
+        // Pushes a draw that renders before all the others in this flush.
+        [[nodiscard]] bool pushBackgroundDraw(DrawUniquePtr);
+
+        // Drops the draws that are entirely outside the render context's damaged region, and clips
+        // the ones that straddle it.
+        void clipDrawsToDamage();
+
         // Running counts of data records required by Draws that need to be allocated in the
         // render context's various GPU buffers.
         struct ResourceCounters
@@ -643,6 +770,12 @@ private:
         RIVE_DEBUG_CODE(uint32_t m_expectedPathMirroredTessLocationAtEndOfPath;)
         RIVE_DEBUG_CODE(uint32_t m_pathCurveCount;)
 
+        // Offscreen layer this flush renders to, if any (see RenderContext::beginLayer()). The
+        // texture is referenced until the flush executes, in case nothing else holds it.
+        rcp<RenderTarget> m_layerRenderTarget;
+        rcp<Texture> m_layerTexture;
+        bool m_isFirstFlushOfLayer;
+
         // Stateful Z index of the current draw being pushed. Used by msaa mode to avoid double hits
         // and to reverse-sort opaque paths front to back.
         uint32_t m_currentZIndex;
@@ -21,8 +21,54 @@ public:
     virtual rcp<RenderBuffer> makeRenderBuffer(RenderBufferType, RenderBufferFlags, size_t) = 0;
 
     // Decodes the image bytes and creates a texture that can be bound to the draw shader for an
-    // image paint.
-    virtual rcp<Texture> decodeImageTexture(Span<const uint8_t> encodedBytes) = 0;
+    // image paint. If maxDimension is nonzero, formats that support it are decoded at a reduced
+    // size whose width and height are both <= maxDimension.
+    //
+    // KTX2 files in block formats that platformFeatures() supports are uploaded as-is with
+    // makeCompressedImageTexture(). Other block formats are decoded to RGBA on the CPU.
+    virtual rcp<Texture> decodeImageTexture(Span<const uint8_t> encodedBytes,
+                                            uint32_t maxDimension);
+
+    // Creates an RGBA8 texture from already-decoded pixels. If mipLevelCount > 1, the mipmaps are
+    // generated from the top level.
+    virtual rcp<Texture> makeImageTexture(uint32_t width,
+                                          uint32_t height,
+                                          uint32_t mipLevelCount,
+                                          const uint8_t imageDataRGBA[]) = 0;
+
+    // Overwrites a region of one mip level of a texture from makeImageTexture(). 'imageDataRGBA'
+    // points at the region's top-left pixel, and its rows are 'rowBytes' apart. Other levels aren't
+    // regenerated, so callers update the region in each level themselves. Draws that have already
+    // been recorded may be using the texture, so callers may only write regions those draws don't
+    // sample.
+    //
+    // Returns false if the backend can't update textures in place, in which case callers need to
+    // make a new texture instead.
+    virtual bool updateImageTexture(Texture*,
+                                    uint32_t mipLevel,
+                                    uint32_t x,
+                                    uint32_t y,
+                                    uint32_t width,
+                                    uint32_t height,
+                                    size_t rowBytes,
+                                    const uint8_t imageDataRGBA[])
+    {
+        return false;
+    }
+
+    // Creates a render target that draws into a new RGBA8 texture, which can then be sampled like
+    // an image texture, for offscreen layers (see RenderContext::beginLayer()). Sets
+    // 'textureIsBottomUp' if the render target's top row of pixels lands in the texture's bottom
+    // row, as it does in OpenGL.
+    //
+    // Returns null if the backend doesn't support offscreen layers.
+    virtual rcp<RenderTarget> makeLayerRenderTarget(uint32_t width,
+                                                    uint32_t height,
+                                                    rcp<Texture>* texture,
+                                                    bool* textureIsBottomUp)
+    {
+        return nullptr;
+    }
 
     // Resize GPU buffers. These methods cannot fail, and must allocate the exact size requested.
     //
@@ -93,6 +139,16 @@ public:
     virtual double secondsNow() const = 0;
 
 protected:
+    // Uploads a pre-built mip chain of block-compressed data (4x4 blocks of 16 bytes), starting
+    // with the full-size level. Only called for formats that platformFeatures() says are
+    // supported.
+    virtual rcp<Texture> makeCompressedImageTexture(uint32_t width,
+                                                    uint32_t height,
+                                                    ImageTextureFormat,
+                                                    uint32_t mipLevelCount,
+                                                    const uint8_t* const levelData[],
+                                                    const size_t levelSizesInBytes[]);
+
     PlatformFeatures m_platformFeatures;
 };
 } // namespace rive::gpu
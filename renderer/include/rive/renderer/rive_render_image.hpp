@@ -6,31 +6,47 @@
 
 #include "rive/renderer/texture.hpp"
 
+namespace rive::gpu
+{
+class ImageAtlas;
+class ImageAtlasPage;
+class ImageResidency;
+class TextureResidencyManager;
+} // namespace rive::gpu
+
 namespace rive
 {
 class RiveRenderImage : public lite_rtti_override<RenderImage, RiveRenderImage>
 {
 public:
-    RiveRenderImage(rcp<gpu::Texture> texture) :
-        RiveRenderImage(texture->width(), texture->height())
-    {
-        resetTexture(std::move(texture));
-    }
+    RiveRenderImage(rcp<gpu::Texture> texture);
+    // 'isPremultiplied' says the texture's colors are already multiplied by alpha, as they are when
+    // the texture was rendered to (e.g., an offscreen layer). Decoded images are unpremultiplied.
+    RiveRenderImage(rcp<gpu::Texture> texture, const Mat2D& uvTransform, bool isPremultiplied);
+    ~RiveRenderImage() override;
 
     rcp<gpu::Texture> refTexture() const { return m_texture; }
     const gpu::Texture* getTexture() const { return m_texture.get(); }
+    bool isPremultiplied() const { return m_isPremultiplied; }
+
+    // Non-null if the texture counts against a RenderContext's image texture budget, in which case
+    // it may be downscaled or released while the image isn't being drawn. Draw with
+    // RenderContext::refImageTexture() instead of refTexture() to bring it back.
+    gpu::ImageResidency* residency() const { return m_residency.get(); }
+
+    // Non-null if the image was packed into a shared atlas page, in which case it has no texture of
+    // its own. uvTransform() locates the image within the page. Draw with
+    // RenderContext::refImageTexture() to get the page's texture.
+    gpu::ImageAtlasPage* atlasPage() const { return m_atlasPage.get(); }
 
 protected:
-    RiveRenderImage(int width, int height)
-    {
-        m_Width = width;
-        m_Height = height;
-    }
+    RiveRenderImage(int width, int height);
 
     void resetTexture(rcp<gpu::Texture> texture = nullptr)
     {
-        assert(texture == nullptr || texture->width() == m_Width);
-        assert(texture == nullptr || texture->height() == m_Height);
+        // Textures under a budget may be decoded at a reduced size.
+        assert(texture == nullptr || texture->width() == m_Width || m_residency != nullptr);
+        assert(texture == nullptr || texture->height() == m_Height || m_residency != nullptr);
         m_texture = std::move(texture);
     }
 
@@ -38,6 +54,14 @@ protected:
     gpu::Texture* releaseTexture() { return m_texture.release(); }
 
 private:
+    friend class gpu::ImageAtlas;
+    friend class gpu::TextureResidencyManager;
+
+    RiveRenderImage(rcp<gpu::ImageAtlasPage>, int width, int height, const Mat2D& uvTransform);
+
     rcp<gpu::Texture> m_texture;
+    std::unique_ptr<gpu::ImageResidency> m_residency;
+    rcp<gpu::ImageAtlasPage> m_atlasPage;
+    bool m_isPremultiplied = false;
 };
 } // namespace rive
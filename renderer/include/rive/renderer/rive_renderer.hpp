@@ -43,6 +43,9 @@ public:
                        uint32_t indexCount,
                        BlendMode,
                        float opacity) override;
+    rcp<RenderLayer> beginLayer(const AABB& bounds) override;
+    void endLayer() override;
+    bool drawLayer(const RenderLayer*, float scaleTolerance) override;
 
     // Determines if a path is an axis-aligned rectangle that can be represented by rive::AABB.
     static bool IsAABB(const RawPath&, AABB* result);
@@ -103,6 +106,11 @@ private:
     };
     std::vector<ClipElement> m_clipStack;
 
+    // While drawing into a layer, the clip stack from outside of it is set aside, and m_stack can't
+    // be restored below the layer's state.
+    std::vector<ClipElement> m_clipStackOutsideLayer;
+    size_t m_layerStackHeight = 0; // Zero if not in a layer.
+
     gpu::RenderContext* const m_context;
 
     std::vector<gpu::DrawUniquePtr> m_internalDrawBatch;
@@ -12,11 +12,14 @@ namespace rive::gpu
 class Texture : public RefCnt<Texture>
 {
 public:
-    Texture(uint32_t width, uint32_t height);
+    Texture(uint32_t width,
+            uint32_t height,
+            ImageTextureFormat format = ImageTextureFormat::rgba8);
     virtual ~Texture() {}
 
     uint32_t width() const { return m_width; }
     uint32_t height() const { return m_height; }
+    ImageTextureFormat format() const { return m_format; }
 
     // Quazi-unique identifier of the underlying GPU texture resource managed by this class.
     uint32_t textureResourceHash() const { return m_textureResourceHash; }
@@ -24,6 +27,7 @@ public:
 protected:
     uint32_t m_width;
     uint32_t m_height;
+    ImageTextureFormat m_format;
     uint32_t m_textureResourceHash;
 };
 
@@ -28,8 +28,12 @@ public:
         m_blocks.resize(1);
         m_currentBlockSize = m_initialBlockSize;
         m_currentBlockUsage = 0;
+        m_totalBlockSize = m_initialBlockSize;
     }
 
+    // Total size of the blocks currently held by the allocator.
+    size_t totalBlockSize() const { return m_totalBlockSize; }
+
     template <size_t AlignmentInBytes = 8> void* alloc(size_t sizeInBytes)
     {
         uintptr_t start = reinterpret_cast<uintptr_t>(m_blocks.back().get()) + m_currentBlockUsage;
@@ -49,6 +53,7 @@ public:
             m_blocks.push_back(std::unique_ptr<char[]>(new char[blockSize]));
             m_currentBlockSize = blockSize;
             m_currentBlockUsage = 0;
+            m_totalBlockSize += blockSize;
 
             start = reinterpret_cast<uintptr_t>(m_blocks.back().get());
             alignmentPad = math::round_up_to_multiple_of<AlignmentInBytes>(start) - start;
@@ -85,6 +90,7 @@ private:
     std::vector<std::unique_ptr<char[]>> m_blocks;
     size_t m_currentBlockSize;
     size_t m_currentBlockUsage;
+    size_t m_totalBlockSize;
 };
 
 // Basic array allocator for POD types, based on TrivialBlockAllocator.
@@ -114,7 +114,17 @@ public:
 
     rcp<RenderBuffer> makeRenderBuffer(RenderBufferType, RenderBufferFlags, size_t) override;
 
-    rcp<Texture> decodeImageTexture(Span<const uint8_t> encodedBytes) override;
+    rcp<Texture> makeImageTexture(uint32_t width,
+                                  uint32_t height,
+                                  uint32_t mipLevelCount,
+                                  const uint8_t imageDataRGBA[]) override;
+
+    rcp<Texture> makeCompressedImageTexture(uint32_t width,
+                                            uint32_t height,
+                                            ImageTextureFormat,
+                                            uint32_t mipLevelCount,
+                                            const uint8_t* const levelData[],
+                                            const size_t levelSizesInBytes[]) override;
 
 private:
     RenderContextVulkanImpl(VkInstance instance,
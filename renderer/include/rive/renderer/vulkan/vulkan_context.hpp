@@ -51,6 +51,8 @@ public:
     const VulkanFeatures features;
     const VmaAllocator vmaAllocator;
 
+#define RIVE_VULKAN_INSTANCE_COMMANDS(F) F(GetPhysicalDeviceFormatProperties)
+
 #define RIVE_VULKAN_DEVICE_COMMANDS(F)                                                             \
     F(AllocateCommandBuffers)                                                                      \
     F(AllocateDescriptorSets)                                                                      \
@@ -100,6 +102,7 @@ public:
     F(WaitForFences)
 
 #define DECLARE_VULKAN_COMMAND(CMD) const PFN_vk##CMD CMD;
+    RIVE_VULKAN_INSTANCE_COMMANDS(DECLARE_VULKAN_COMMAND)
     RIVE_VULKAN_DEVICE_COMMANDS(DECLARE_VULKAN_COMMAND)
 #undef DECLARE_VULKAN_COMMAND
 
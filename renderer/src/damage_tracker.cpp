@@ -0,0 +1,101 @@
+/*
+ * Copyright 2024 Rive
+ */
+
+#include "damage_tracker.hpp"
+
+#include "rive/renderer/draw.hpp"
+#include "rive/renderer/render_target.hpp"
+
+#include <algorithm>
+
+namespace rive::gpu
+{
+IAABB DamageTracker::findDamage(const RenderTarget* renderTarget,
+                                ColorInt clearColor,
+                                gpu::InterlockMode interlockMode)
+{
+    // (Initialized with a maximally negative rectangle whose union with any other rectangle will be
+    // equal to that same rectangle.)
+    IAABB damage = {std::numeric_limits<int32_t>::max(),
+                    std::numeric_limits<int32_t>::max(),
+                    std::numeric_limits<int32_t>::min(),
+                    std::numeric_limits<int32_t>::min()};
+
+    if (renderTarget != m_previousRenderTarget || renderTarget->width() != m_previousWidth ||
+        renderTarget->height() != m_previousHeight || clearColor != m_previousClearColor ||
+        interlockMode != m_previousInterlockMode)
+    {
+        damage = renderTarget->bounds();
+    }
+    else
+    {
+        // Match each draw with the earliest unmatched draw from the previous frame that has the
+        // same key.
+        m_sortedPreviousKeys.resize(m_previousDraws.size());
+        for (size_t i = 0; i < m_previousDraws.size(); ++i)
+        {
+            m_sortedPreviousKeys[i] = {m_previousDraws[i].contentKey, static_cast<uint32_t>(i)};
+        }
+        std::sort(m_sortedPreviousKeys.begin(), m_sortedPreviousKeys.end());
+        m_previousDrawIsMatched.assign(m_previousDraws.size(), false);
+
+        // Matched draws have to stay in the same order. If a draw matches one from earlier in the
+        // previous frame than a draw that's now behind it, the two (may) overlap differently, and
+        // the overlap is inside the later one's bounds.
+        uint32_t maxMatchedIdx = 0;
+        bool hasMatch = false;
+        for (const DrawRecord& draw : m_draws)
+        {
+            auto match = m_sortedPreviousKeys.end();
+            if (draw.contentKey != Draw::kAlwaysDamagedContentKey)
+            {
+                match = std::lower_bound(m_sortedPreviousKeys.begin(),
+                                         m_sortedPreviousKeys.end(),
+                                         std::make_pair(draw.contentKey, 0u));
+                while (match != m_sortedPreviousKeys.end() && match->first == draw.contentKey &&
+                       m_previousDrawIsMatched[match->second])
+                {
+                    ++match;
+                }
+            }
+            if (match == m_sortedPreviousKeys.end() || match->first != draw.contentKey)
+            {
+                damage = damage.join(draw.pixelBounds); // New draw.
+                continue;
+            }
+            m_previousDrawIsMatched[match->second] = true;
+            if (hasMatch && match->second < maxMatchedIdx)
+            {
+                damage = damage.join(draw.pixelBounds); // Reordered draw.
+            }
+            else
+            {
+                maxMatchedIdx = match->second;
+                hasMatch = true;
+            }
+        }
+
+        for (size_t i = 0; i < m_previousDraws.size(); ++i)
+        {
+            if (!m_previousDrawIsMatched[i])
+            {
+                damage = damage.join(m_previousDraws[i].pixelBounds); // Removed draw.
+            }
+        }
+    }
+
+    std::swap(m_draws, m_previousDraws);
+    m_previousRenderTarget = renderTarget;
+    m_previousWidth = renderTarget->width();
+    m_previousHeight = renderTarget->height();
+    m_previousClearColor = clearColor;
+    m_previousInterlockMode = interlockMode;
+
+    if (damage.empty())
+    {
+        damage = {0, 0, 0, 0};
+    }
+    return damage;
+}
+} // namespace rive::gpu
@@ -0,0 +1,61 @@
+/*
+ * Copyright 2024 Rive
+ */
+
+#pragma once
+
+#include "rive/math/aabb.hpp"
+#include "rive/renderer/gpu.hpp"
+#include "rive/shapes/paint/color.hpp"
+#include <vector>
+
+namespace rive::gpu
+{
+class RenderTarget;
+
+// Finds the region of the render target that changed since the previous frame, by comparing each
+// frame's draws, in order, by content key (Draw::contentKey()) and pixel bounds.
+//
+// A draw that was added, removed, or moved relative to the draws around it damages its pixel
+// bounds. Draws that are identical, in the same order, don't.
+class DamageTracker
+{
+public:
+    // Starts collecting the draws for a new frame.
+    void beginFrame() { m_draws.clear(); }
+
+    // Draws whose content key is Draw::kAlwaysDamagedContentKey never match the previous frame.
+    void addDraw(uint64_t contentKey, const IAABB& pixelBounds)
+    {
+        m_draws.push_back({contentKey, pixelBounds});
+    }
+
+    // Compares the draws collected since beginFrame() against the previous frame's, and then keeps
+    // them for the next comparison. Returns the union of the pixel bounds that changed, which may
+    // be empty, or the entire render target if the previous frame was rendered to a different
+    // target, with a different clear color or interlock mode, or if there was no previous frame.
+    IAABB findDamage(const RenderTarget*, ColorInt clearColor, gpu::InterlockMode);
+
+    // Forgets the previous frame, so the next one is entirely damaged.
+    void reset() { m_previousRenderTarget = nullptr; }
+
+private:
+    struct DrawRecord
+    {
+        uint64_t contentKey;
+        IAABB pixelBounds;
+    };
+
+    std::vector<DrawRecord> m_draws;
+    std::vector<DrawRecord> m_previousDraws;
+    const RenderTarget* m_previousRenderTarget = nullptr;
+    uint32_t m_previousWidth = 0;
+    uint32_t m_previousHeight = 0;
+    ColorInt m_previousClearColor = 0;
+    gpu::InterlockMode m_previousInterlockMode = gpu::InterlockMode::rasterOrdering;
+
+    // Scratch space for findDamage().
+    std::vector<std::pair<uint64_t, uint32_t>> m_sortedPreviousKeys;
+    std::vector<bool> m_previousDrawIsMatched;
+};
+} // namespace rive::gpu
@@ -9,6 +9,7 @@
 #include "rive_render_path.hpp"
 #include "rive_render_paint.hpp"
 #include "rive/math/wangs_formula.hpp"
+#include "rive/renderer/rive_renderer.hpp"
 #include "rive/renderer/texture.hpp"
 #include "gradient.hpp"
 #include "shaders/constants.glsl"
@@ -293,6 +294,83 @@ RIVE_ALWAYS_INLINE uint32_t join_type_flags(StrokeJoin join)
     }
     RIVE_UNREACHABLE();
 }
+
+// Rounds in to the pixels whose centers are at least a half pixel inside the rectangle, which get
+// full coverage from antialiasing.
+static IAABB round_in(const AABB& rect)
+{
+    constexpr static float kMaxCoord = 1 << 24;
+    float4 bounds = simd::clamp(simd::load4f(&rect), float4(-kMaxCoord), float4(kMaxCoord));
+    bounds.xy = simd::ceil(bounds.xy);
+    bounds.zw = simd::floor(bounds.zw);
+    if (bounds.x >= bounds.z || bounds.y >= bounds.w)
+    {
+        return {0, 0, 0, 0};
+    }
+    return math::bit_cast<IAABB>(simd::cast<int32_t>(bounds));
+}
+
+// FNV-1a, for hashing the state that goes into Draw::contentKey().
+constexpr static uint64_t kContentKeyOffsetBasis = 0xcbf29ce484222325ull;
+
+static uint64_t hash_bytes(uint64_t hash, const void* data, size_t sizeInBytes)
+{
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    for (size_t i = 0; i < sizeInBytes; ++i)
+    {
+        hash = (hash ^ bytes[i]) * 0x100000001b3ull;
+    }
+    return hash;
+}
+
+template <typename T> static uint64_t hash_value(uint64_t hash, const T& value)
+{
+    static_assert(std::is_trivially_copyable<T>::value);
+    return hash_bytes(hash, &value, sizeof(T));
+}
+
+// Keeps real hashes from colliding with Draw::kAlwaysDamagedContentKey.
+static uint64_t finish_content_key(uint64_t hash)
+{
+    return hash != Draw::kAlwaysDamagedContentKey ? hash : 1;
+}
+
+// How much (as a fraction) any vector in the path may shrink, relative to the matrix its
+// tessellation segment counts were computed with, before they have to be computed again. Shrinking
+// only over-tessellates, but stretching would leave too few segments to stay within the
+// tessellation's precision, so counts are never reused for a larger scale.
+constexpr static float kTessCountShrinkTolerance = 1.f / 16;
+
+// Can segment counts computed for 'from' be used to draw with 'to'? Wang's formula and the polar
+// segment counts only depend on the lengths of transformed vectors, so rotation is always fine, and
+// scale and skew are fine as long as 'to * inverse(from)' doesn't stretch any vector, and doesn't
+// shrink any vector by too much.
+static bool scale_within_tess_count_tolerance(const Mat2D& from, const Mat2D& to)
+{
+    if (from.xx() == to.xx() && from.xy() == to.xy() && from.yx() == to.yx() &&
+        from.yy() == to.yy())
+    {
+        return true;
+    }
+    Mat2D inverseFrom;
+    if (!from.invert(&inverseFrom))
+    {
+        return false;
+    }
+    Mat2D r = to * inverseFrom;
+    float sumOfSquares = r.xx() * r.xx() + r.xy() * r.xy() + r.yx() * r.yx() + r.yy() * r.yy();
+    // sumOfSquares^2 - 4*det^2, factored so it doesn't cancel out to noise when 'r' is close to a
+    // rotation.
+    float a = r.xx() - r.yy(), b = r.xy() + r.yx(), c = r.xx() + r.yy(), d = r.xy() - r.yx();
+    float discriminant = sqrtf((a * a + b * b) * (c * c + d * d));
+    float maxScaleSquared = (sumOfSquares + discriminant) * .5f;
+    float minScaleSquared = (sumOfSquares - discriminant) * .5f;
+    // Leave room for rounding error, so pure rotations still count as a scale of 1.
+    constexpr static float kMaxScaleSquared = 1 + 1e-5f;
+    constexpr static float kMinScale = 1 / (1 + kTessCountShrinkTolerance);
+    // (Inverse logic so we return false if anything is NaN.)
+    return maxScaleSquared <= kMaxScaleSquared && minScaleSquared >= kMinScale * kMinScale;
+}
 } // namespace
 
 Draw::Draw(AABB bounds,
@@ -338,6 +416,41 @@ bool Draw::allocateGradientIfNeeded(RenderContext::LogicalFlush* flush, Resource
            flush->allocateGradient(m_gradientRef, counters, &m_simplePaintValue.colorRampLocation);
 }
 
+uint64_t Draw::contentKey(uint64_t clipContentKey) const
+{
+    uint64_t key = kContentKeyOffsetBasis;
+    key = hash_value(key, m_type);
+    key = hash_value(key, m_pixelBounds);
+    key = hash_value(key, m_matrix);
+    key = hash_value(key, m_blendMode);
+    key = hash_value(key, m_drawContents);
+    key = hash_value(key, clipContentKey);
+    if (m_clipRectInverseMatrix != nullptr)
+    {
+        key = hash_value(key, m_clipRectInverseMatrix->inverseMatrix());
+    }
+    if (m_imageTextureRef != nullptr)
+    {
+        key = hash_value(key, m_imageTextureRef->textureResourceHash());
+        key = hash_value(key, m_imageUVTransform);
+        key = hash_value(key, m_imageIsPremultiplied);
+    }
+    if (m_gradientRef != nullptr)
+    {
+        // The color ramp location is only valid for the current flush. Hash the gradient instead.
+        key = hash_value(key, m_gradientRef->paintType());
+        key = hash_bytes(key, m_gradientRef->coeffs(), sizeof(float) * 3);
+        key = hash_bytes(key, m_gradientRef->colors(), sizeof(ColorInt) * m_gradientRef->count());
+        key = hash_bytes(key, m_gradientRef->stops(), sizeof(float) * m_gradientRef->count());
+    }
+    else if (!(m_drawContents & gpu::DrawContents::clipUpdate))
+    {
+        // (For clipUpdates, this is the outer clip ID, which clipContentKey accounts for.)
+        key = hash_value(key, m_simplePaintValue);
+    }
+    return finish_content_key(key);
+}
+
 void Draw::releaseRefs()
 {
     safe_unref(m_imageTextureRef);
@@ -384,23 +497,58 @@ DrawUniquePtr RiveRenderPathDraw::Make(RenderContext* context,
     }
     IAABB pixelBounds = mappedBounds.roundOut();
     bool doTriangulation = false;
+    auto triangulatorAxis = RiveRenderPathDraw::TriangulatorAxis::dontCare;
     const AABB& localBounds = path->getBounds();
     if (context->isOutsideCurrentFrame(pixelBounds))
     {
         return DrawUniquePtr();
     }
+    const RenderContext::FrameDescriptor& frameDescriptor = context->frameDescriptor();
     if (!paint->getIsStroked())
     {
         // Use interior triangulation to draw filled paths if they're large enough to benefit from
         // it.
         // FIXME! Implement interior triangulation in msaa mode.
 
+        // Skip straight to a midpoint fan if the triangulation doesn't fit in the cache budget, or
+        // is still being built in the background, rather than initializing a draw only to find
+        // that out.
         if (context->frameInterlockMode() != gpu::InterlockMode::msaa &&
-            path->getRawPath().verbs().count() < 1000 &&
-            gpu::FindTransformedArea(localBounds, matrix) > 512 * 512)
+            path->getRawPath().verbs().count() < frameDescriptor.interiorTriangulationMaxVerbCount &&
+            !path->isInteriorTriangulationOverBudget() &&
+            gpu::FindTransformedArea(localBounds, matrix) >
+                frameDescriptor.interiorTriangulationMinArea)
+        {
+            triangulatorAxis = localBounds.width() > localBounds.height()
+                                   ? RiveRenderPathDraw::TriangulatorAxis::horizontal
+                                   : RiveRenderPathDraw::TriangulatorAxis::vertical;
+            doTriangulation = !frameDescriptor.asyncInteriorTriangulation ||
+                              !path->isInteriorTriangulationPending(fillRule, triangulatorAxis);
+        }
+    }
+
+    if (doTriangulation)
+    {
+        auto draw = context->make<RiveRenderPathDraw>(pixelBounds,
+                                                      matrix,
+                                                      path,
+                                                      fillRule,
+                                                      paint,
+                                                      Type::interiorTriangulationPath,
+                                                      context->frameInterlockMode());
+        if (draw->initForInteriorTriangulation(
+                context,
+                scratchPath,
+                triangulatorAxis,
+                frameDescriptor.asyncInteriorTriangulation ? context->interiorTriangulationWorker()
+                                                           : nullptr))
         {
-            doTriangulation = true;
+            return DrawUniquePtr(draw);
         }
+        // The linearized path changed, so a new triangulation just got submitted to the background
+        // worker (draw as a midpoint fan until a later frame finds it ready), or it just went over
+        // the cache budget.
+        draw->releaseRefs();
     }
 
     auto draw = context->make<RiveRenderPathDraw>(pixelBounds,
@@ -408,22 +556,9 @@ DrawUniquePtr RiveRenderPathDraw::Make(RenderContext* context,
                                                   std::move(path),
                                                   fillRule,
                                                   paint,
-                                                  doTriangulation ? Type::interiorTriangulationPath
-                                                                  : Type::midpointFanPath,
+                                                  Type::midpointFanPath,
                                                   context->frameInterlockMode());
-    if (doTriangulation)
-    {
-        draw->initForInteriorTriangulation(context,
-                                           scratchPath,
-                                           localBounds.width() > localBounds.height()
-                                               ? RiveRenderPathDraw::TriangulatorAxis::horizontal
-                                               : RiveRenderPathDraw::TriangulatorAxis::vertical);
-    }
-    else
-    {
-        draw->initForMidpointFan(context, paint);
-    }
-
+    draw->initForMidpointFan(context, paint);
     return DrawUniquePtr(draw);
 }
 
@@ -494,8 +629,20 @@ RiveRenderPathDraw::RiveRenderPathDraw(AABB bounds,
         m_contourDirections = gpu::ContourDirections::forward;
     }
 
+    if (isOpaque() && !isStroked() && matrix.xy() == 0 && matrix.yx() == 0)
+    {
+        // Opaque, axis-aligned rectangles can hide the draws underneath them.
+        AABB rect;
+        if (RiveRenderer::IsAABB(m_pathRef->getRawPath(), &rect))
+        {
+            m_opaquePixelBounds = round_in(matrix.mapBoundingBox(rect));
+        }
+    }
+
     m_simplePaintValue = paint->getSimpleValue();
     m_gradientRef = safe_ref(paint->getGradient());
+    m_imageUVTransform = paint->getImageUVTransform();
+    m_imageIsPremultiplied = paint->getImageIsPremultiplied();
     RIVE_DEBUG_CODE(m_pathRef->lockRawPathMutations();)
     RIVE_DEBUG_CODE(m_rawPathMutationID = m_pathRef->getRawPathMutationID();)
     assert(isStroked() == (strokeRadius() > 0));
@@ -534,6 +681,7 @@ RiveRenderPathDraw::RiveRenderPathDraw(const RiveRenderPathDraw& from,
     m_polarSegmentCounts = from.m_polarSegmentCounts;
     m_parametricSegmentCounts = from.m_parametricSegmentCounts;
     m_triangulator = from.m_triangulator;
+    m_interiorTriangulationRef = safe_ref(from.m_interiorTriangulationRef);
 
     RIVE_DEBUG_CODE(m_pendingLineCount = from.m_pendingLineCount;)
     RIVE_DEBUG_CODE(m_pendingCurveCount = from.m_pendingCurveCount;)
@@ -543,6 +691,22 @@ RiveRenderPathDraw::RiveRenderPathDraw(const RiveRenderPathDraw& from,
     RIVE_DEBUG_CODE(m_pendingEmptyStrokeCountForCaps = from.m_pendingEmptyStrokeCountForCaps;)
 }
 
+uint64_t RiveRenderPathDraw::contentKey(uint64_t clipContentKey) const
+{
+    uint64_t key = Draw::contentKey(clipContentKey);
+    // Mutation IDs are unique across all paths.
+    key = hash_value(key, m_pathRef->getRawPathMutationID());
+    key = hash_value(key, m_fillRule);
+    key = hash_value(key, m_paintType);
+    if (isStroked())
+    {
+        key = hash_value(key, m_strokeRadius);
+        key = hash_value(key, m_strokeJoin);
+        key = hash_value(key, m_strokeCap);
+    }
+    return finish_content_key(key);
+}
+
 void RiveRenderPathDraw::pushToRenderContext(RenderContext::LogicalFlush* flush)
 {
     // Make sure the rawPath in our path reference hasn't changed since we began holding!
@@ -567,6 +731,7 @@ void RiveRenderPathDraw::pushToRenderContext(RenderContext::LogicalFlush* flush)
 void RiveRenderPathDraw::releaseRefs()
 {
     m_pathRef->invalidateDrawCache();
+    safe_unref(m_interiorTriangulationRef);
     Draw::releaseRefs();
     RIVE_DEBUG_CODE(m_pathRef->unlockRawPathMutations();)
     m_pathRef->unref();
@@ -581,6 +746,13 @@ void RiveRenderPathDraw::initForMidpointFan(RenderContext* context, const RiveRe
         m_strokeCap = paint->getCap();
     }
 
+    std::unique_ptr<TessCounts>& tessCounts = m_pathRef->tessCounts(isStroked());
+    if (tessCounts != nullptr && canReuseTessCounts(*tessCounts))
+    {
+        restoreTessCounts(context, *tessCounts);
+        return;
+    }
+
     // Count up how much temporary storage this function will need to reserve in CPU buffers.
     const RawPath& rawPath = m_pathRef->getRawPath();
     size_t contourCount = rawPath.countMoveTos();
@@ -1070,6 +1242,114 @@ void RiveRenderPathDraw::initForMidpointFan(RenderContext* context, const RiveRe
             m_contourDirections == gpu::ContourDirections::reverseAndForward ? tessVertexCount * 2
                                                                              : tessVertexCount;
     }
+
+    // Save the counts for later frames, once the path has been drawn twice without changing.
+    uint64_t rawPathMutationID = m_pathRef->getRawPathMutationID();
+    if (tessCounts == nullptr)
+    {
+        tessCounts = std::make_unique<TessCounts>();
+    }
+    else if (tessCounts->rawPathMutationID == rawPathMutationID)
+    {
+        tessCounts->hasCounts = true;
+        tessCounts->matrix = m_matrix;
+        tessCounts->strokeRadius = m_strokeRadius;
+        if (isStroked())
+        {
+            tessCounts->strokeMatrixMaxScale = m_strokeMatrixMaxScale;
+            tessCounts->strokeJoin = m_strokeJoin;
+            tessCounts->strokeCap = m_strokeCap;
+            tessCounts->numChops.assign(m_numChops.begin(), m_numChops.end());
+            tessCounts->chopVertices.assign(m_chopVertices.begin(), m_chopVertices.end());
+            tessCounts->tangentPairs.assign(m_tangentPairs, m_tangentPairs + rotationIdx);
+            tessCounts->polarSegmentCounts.assign(m_polarSegmentCounts,
+                                                  m_polarSegmentCounts + rotationIdx);
+        }
+        tessCounts->tessVertexCount = tessVertexCount;
+        tessCounts->maxTessellatedSegmentCount =
+            lineCount + unpaddedCurveCount + emptyStrokeCountForCaps;
+        tessCounts->contours.assign(m_contours, m_contours + contourCount);
+        tessCounts->parametricSegmentCounts.assign(m_parametricSegmentCounts,
+                                                   m_parametricSegmentCounts + curveIdx);
+        RIVE_DEBUG_CODE(tessCounts->pendingLineCount = m_pendingLineCount);
+        RIVE_DEBUG_CODE(tessCounts->pendingCurveCount = m_pendingCurveCount);
+        RIVE_DEBUG_CODE(tessCounts->pendingRotationCount = m_pendingRotationCount);
+        RIVE_DEBUG_CODE(tessCounts->pendingEmptyStrokeCountForCaps =
+                            m_pendingEmptyStrokeCountForCaps);
+        return;
+    }
+    tessCounts->rawPathMutationID = rawPathMutationID;
+    tessCounts->hasCounts = false;
+}
+
+bool RiveRenderPathDraw::canReuseTessCounts(const TessCounts& tessCounts) const
+{
+    if (!tessCounts.hasCounts || tessCounts.rawPathMutationID != m_pathRef->getRawPathMutationID())
+    {
+        return false;
+    }
+    if (isStroked() &&
+        (tessCounts.strokeRadius != m_strokeRadius || tessCounts.strokeJoin != m_strokeJoin ||
+         tessCounts.strokeCap != m_strokeCap))
+    {
+        return false;
+    }
+    return scale_within_tess_count_tolerance(tessCounts.matrix, m_matrix);
+}
+
+void RiveRenderPathDraw::restoreTessCounts(RenderContext* context, const TessCounts& tessCounts)
+{
+    // Cusps get chopped again when the draw is pushed, and that has to match the saved chops.
+    if (isStroked())
+    {
+        m_strokeMatrixMaxScale = tessCounts.strokeMatrixMaxScale;
+    }
+
+    size_t contourCount = tessCounts.contours.size();
+    m_contours = reinterpret_cast<ContourInfo*>(
+        context->perFrameAllocator().alloc(sizeof(ContourInfo) * contourCount));
+    std::copy(tessCounts.contours.begin(), tessCounts.contours.end(), m_contours);
+    if (isStroked())
+    {
+        size_t chopCount = tessCounts.numChops.size();
+        m_numChops.reset(context->numChopsAllocator(), chopCount);
+        std::copy(tessCounts.numChops.begin(),
+                  tessCounts.numChops.end(),
+                  m_numChops.push_back_n(chopCount));
+        size_t chopVertexCount = tessCounts.chopVertices.size();
+        m_chopVertices.reset(context->chopVerticesAllocator(), chopVertexCount);
+        std::copy(tessCounts.chopVertices.begin(),
+                  tessCounts.chopVertices.end(),
+                  m_chopVertices.push_back_n(chopVertexCount));
+        size_t rotationCount = tessCounts.tangentPairs.size();
+        m_tangentPairs = context->tangentPairsAllocator().alloc(rotationCount);
+        std::copy(tessCounts.tangentPairs.begin(), tessCounts.tangentPairs.end(), m_tangentPairs);
+        m_polarSegmentCounts = context->polarSegmentCountsAllocator().alloc(rotationCount);
+        std::copy(tessCounts.polarSegmentCounts.begin(),
+                  tessCounts.polarSegmentCounts.end(),
+                  m_polarSegmentCounts);
+    }
+    m_parametricSegmentCounts = context->parametricSegmentCountsAllocator().alloc(
+        tessCounts.parametricSegmentCounts.size());
+    std::copy(tessCounts.parametricSegmentCounts.begin(),
+              tessCounts.parametricSegmentCounts.end(),
+              m_parametricSegmentCounts);
+
+    RIVE_DEBUG_CODE(m_pendingLineCount = tessCounts.pendingLineCount);
+    RIVE_DEBUG_CODE(m_pendingCurveCount = tessCounts.pendingCurveCount);
+    RIVE_DEBUG_CODE(m_pendingRotationCount = tessCounts.pendingRotationCount);
+    RIVE_DEBUG_CODE(m_pendingEmptyStrokeCountForCaps = tessCounts.pendingEmptyStrokeCountForCaps);
+
+    if (tessCounts.tessVertexCount > 0)
+    {
+        m_resourceCounts.pathCount = 1;
+        m_resourceCounts.contourCount = contourCount;
+        m_resourceCounts.maxTessellatedSegmentCount = tessCounts.maxTessellatedSegmentCount;
+        m_resourceCounts.midpointFanTessVertexCount =
+            m_contourDirections == gpu::ContourDirections::reverseAndForward
+                ? tessCounts.tessVertexCount * 2
+                : tessCounts.tessVertexCount;
+    }
 }
 
 void RiveRenderPathDraw::onPushToRenderContext(RenderContext::LogicalFlush* flush)
@@ -1077,7 +1357,7 @@ void RiveRenderPathDraw::onPushToRenderContext(RenderContext::LogicalFlush* flus
     if (type() == Type::interiorTriangulationPath)
     {
         // Interior Triangulation Case
-        processPath(PathOp::submitOuterCubics, nullptr, nullptr, TriangulatorAxis::dontCare, flush);
+        processPath(PathOp::submitOuterCubics, nullptr, TriangulatorAxis::dontCare, nullptr, flush);
         if (flush->desc().interlockMode == gpu::InterlockMode::atomics)
         {
             // We need a barrier between the outer cubics and interior triangles in atomic mode.
@@ -1418,23 +1698,25 @@ void RiveRenderPathDraw::pushEmulatedStrokeCapAsJoinBeforeCubic(RenderContext::L
     RIVE_DEBUG_CODE(--m_pendingEmptyStrokeCountForCaps;)
 }
 
-void RiveRenderPathDraw::initForInteriorTriangulation(RenderContext* context,
+bool RiveRenderPathDraw::initForInteriorTriangulation(RenderContext* context,
                                                       RawPath* scratchPath,
-                                                      TriangulatorAxis triangulatorAxis)
+                                                      TriangulatorAxis triangulatorAxis,
+                                                      InteriorTriangulationWorker* asyncWorker)
 {
     assert(!isStroked());
     assert(m_strokeRadius == 0);
     processPath(PathOp::countDataAndTriangulate,
-                &context->perFrameAllocator(),
                 scratchPath,
                 triangulatorAxis,
+                asyncWorker,
                 nullptr);
+    return m_triangulator != nullptr;
 }
 
 void RiveRenderPathDraw::processPath(PathOp op,
-                                     TrivialBlockAllocator* allocator,
                                      RawPath* scratchPath,
                                      TriangulatorAxis triangulatorAxis,
+                                     InteriorTriangulationWorker* asyncWorker,
                                      RenderContext::LogicalFlush* flush)
 {
     Vec2D chops[kMaxCurveSubdivisions * 3 + 1];
@@ -1564,14 +1846,16 @@ void RiveRenderPathDraw::processPath(PathOp op,
     {
         assert(m_triangulator == nullptr);
         assert(triangulatorAxis != TriangulatorAxis::dontCare);
-        m_triangulator = allocator->make<GrInnerFanTriangulator>(
-            *scratchPath,
-            m_matrix,
-            triangulatorAxis == TriangulatorAxis::horizontal
-                ? GrTriangulator::Comparator::Direction::kHorizontal
-                : GrTriangulator::Comparator::Direction::kVertical,
-            m_fillRule,
-            allocator);
+        // Reuses the path's triangulation from an earlier frame when the linearized path matches.
+        m_interiorTriangulationRef = m_pathRef->refInteriorTriangulation(*scratchPath,
+                                                                         m_fillRule,
+                                                                         triangulatorAxis,
+                                                                         asyncWorker);
+        if (m_interiorTriangulationRef == nullptr)
+        {
+            return; // The triangulation isn't ready yet, or doesn't fit in the budget.
+        }
+        m_triangulator = m_interiorTriangulationRef->triangulator();
         // We also draw each "grout" triangle using an outerCubic patch.
         patchCount += m_triangulator->groutList().count();
 
@@ -1621,16 +1905,25 @@ ImageRectDraw::ImageRectDraw(RenderContext* context,
                              const Mat2D& matrix,
                              BlendMode blendMode,
                              rcp<const Texture> imageTexture,
-                             float opacity) :
+                             const Mat2D& uvTransform,
+                             float opacity,
+                             bool imageIsPremultiplied) :
     Draw(pixelBounds, matrix, blendMode, std::move(imageTexture), Type::imageRect),
     m_opacity(opacity)
 {
+    m_imageUVTransform = uvTransform;
+    m_imageIsPremultiplied = imageIsPremultiplied;
     // If we support image paints for paths, the client should draw a rectangular path with an
     // image paint instead of using this draw.
     assert(!context->frameSupportsImagePaintForPaths());
     m_resourceCounts.imageDrawCount = 1;
 }
 
+uint64_t ImageRectDraw::contentKey(uint64_t clipContentKey) const
+{
+    return finish_content_key(hash_value(Draw::contentKey(clipContentKey), m_opacity));
+}
+
 void ImageRectDraw::pushToRenderContext(RenderContext::LogicalFlush* flush)
 {
     flush->pushImageRect(this);
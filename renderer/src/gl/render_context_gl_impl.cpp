@@ -94,6 +94,15 @@ RenderContextGLImpl::RenderContextGLImpl(const char* rendererString,
         m_platformFeatures.avoidFlatVaryings = true;
     }
     m_platformFeatures.fragCoordBottomUp = true;
+#ifdef RIVE_WEBGL
+    m_platformFeatures.supportsETC2Textures = m_capabilities.WEBGL_compressed_texture_etc;
+#else
+    // ETC2 is core in GLES 3.0. Desktop drivers tend to decompress it in software, so only use it
+    // on ES.
+    m_platformFeatures.supportsETC2Textures = m_capabilities.isGLES;
+#endif
+    m_platformFeatures.supportsASTCTextures = m_capabilities.KHR_texture_compression_astc_ldr;
+    m_platformFeatures.supportsBC7Textures = m_capabilities.EXT_texture_compression_bptc;
 
     std::vector<const char*> generalDefines;
     if (!m_capabilities.ARB_shader_storage_buffer_object)
@@ -267,7 +276,15 @@ public:
                   uint32_t height,
                   GLuint textureID,
                   const GLCapabilities& capabilities) :
-        Texture(width, height), m_textureID(textureID)
+        TextureGLImpl(width, height, ImageTextureFormat::rgba8, textureID, capabilities)
+    {}
+
+    TextureGLImpl(uint32_t width,
+                  uint32_t height,
+                  ImageTextureFormat format,
+                  GLuint textureID,
+                  const GLCapabilities& capabilities) :
+        Texture(width, height, format), m_textureID(textureID)
     {}
 
     GLuint textureID() const { return m_textureID; }
@@ -301,6 +318,84 @@ rcp<Texture> RenderContextGLImpl::makeImageTexture(uint32_t width,
     return adoptImageTexture(width, height, textureID);
 }
 
+bool RenderContextGLImpl::updateImageTexture(Texture* texture,
+                                             uint32_t mipLevel,
+                                             uint32_t x,
+                                             uint32_t y,
+                                             uint32_t width,
+                                             uint32_t height,
+                                             size_t rowBytes,
+                                             const uint8_t imageDataRGBA[])
+{
+    assert(texture->format() == ImageTextureFormat::rgba8);
+    assert(rowBytes % 4 == 0);
+    glActiveTexture(GL_TEXTURE0 + kPLSTexIdxOffset + IMAGE_TEXTURE_IDX);
+    glBindTexture(GL_TEXTURE_2D, static_cast<TextureGLImpl*>(texture)->textureID());
+    m_state->bindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, static_cast<GLint>(rowBytes / 4));
+    glTexSubImage2D(GL_TEXTURE_2D,
+                    mipLevel,
+                    x,
+                    y,
+                    width,
+                    height,
+                    GL_RGBA,
+                    GL_UNSIGNED_BYTE,
+                    imageDataRGBA);
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+    return true;
+}
+
+static GLenum compressed_internal_format(ImageTextureFormat format)
+{
+    switch (format)
+    {
+        case ImageTextureFormat::etc2RGBA8:
+            return GL_COMPRESSED_RGBA8_ETC2_EAC;
+        case ImageTextureFormat::astc4x4:
+            return GL_COMPRESSED_RGBA_ASTC_4x4_KHR;
+        case ImageTextureFormat::bc7:
+            return GL_COMPRESSED_RGBA_BPTC_UNORM;
+        case ImageTextureFormat::rgba8:
+            break;
+    }
+    RIVE_UNREACHABLE();
+}
+
+rcp<Texture> RenderContextGLImpl::makeCompressedImageTexture(uint32_t width,
+                                                             uint32_t height,
+                                                             ImageTextureFormat format,
+                                                             uint32_t mipLevelCount,
+                                                             const uint8_t* const levelData[],
+                                                             const size_t levelSizesInBytes[])
+{
+    assert(m_platformFeatures.supportsImageTextureFormat(format));
+    GLenum internalFormat = compressed_internal_format(format);
+    GLuint textureID;
+    glGenTextures(1, &textureID);
+    glActiveTexture(GL_TEXTURE0 + kPLSTexIdxOffset + IMAGE_TEXTURE_IDX);
+    glBindTexture(GL_TEXTURE_2D, textureID);
+    glTexStorage2D(GL_TEXTURE_2D, mipLevelCount, internalFormat, width, height);
+    m_state->bindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    for (uint32_t level = 0; level < mipLevelCount; ++level)
+    {
+        glCompressedTexSubImage2D(GL_TEXTURE_2D,
+                                  level,
+                                  0,
+                                  0,
+                                  std::max(width >> level, 1u),
+                                  std::max(height >> level, 1u),
+                                  internalFormat,
+                                  static_cast<GLsizei>(levelSizesInBytes[level]),
+                                  levelData[level]);
+    }
+    // Compressed formats can't glGenerateMipmap. Sample whatever levels the file shipped with.
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, mipLevelCount - 1);
+    glutils::SetTexture2DSamplingParams(mipLevelCount > 1 ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR,
+                                        GL_LINEAR);
+    return make_rcp<TextureGLImpl>(width, height, format, textureID, m_capabilities);
+}
+
 rcp<Texture> RenderContextGLImpl::adoptImageTexture(uint32_t width,
                                                     uint32_t height,
                                                     GLuint textureID)
@@ -308,6 +403,42 @@ rcp<Texture> RenderContextGLImpl::adoptImageTexture(uint32_t width,
     return make_rcp<TextureGLImpl>(width, height, textureID, m_capabilities);
 }
 
+// Texture that an offscreen layer renders into. It owns its GL texture, since layers come and go
+// while the app runs.
+class LayerTextureGLImpl : public TextureGLImpl
+{
+public:
+    LayerTextureGLImpl(uint32_t width,
+                       uint32_t height,
+                       glutils::Texture texture,
+                       const GLCapabilities& capabilities) :
+        TextureGLImpl(width, height, texture, capabilities), m_texture(std::move(texture))
+    {}
+
+private:
+    glutils::Texture m_texture;
+};
+
+rcp<RenderTarget> RenderContextGLImpl::makeLayerRenderTarget(uint32_t width,
+                                                             uint32_t height,
+                                                             rcp<Texture>* texture,
+                                                             bool* textureIsBottomUp)
+{
+    glutils::Texture layerTexture;
+    glActiveTexture(GL_TEXTURE0 + kPLSTexIdxOffset + IMAGE_TEXTURE_IDX);
+    glBindTexture(GL_TEXTURE_2D, layerTexture);
+    glTexStorage2D(GL_TEXTURE_2D, 1, GL_RGBA8, width, height);
+    glutils::SetTexture2DSamplingParams(GL_LINEAR, GL_LINEAR);
+
+    auto renderTarget = make_rcp<TextureRenderTargetGL>(width, height);
+    renderTarget->setTargetTexture(layerTexture);
+    *texture =
+        make_rcp<LayerTextureGLImpl>(width, height, std::move(layerTexture), m_capabilities);
+    // GL puts the bottom row of the viewport at the beginning of the texture.
+    *textureIsBottomUp = true;
+    return renderTarget;
+}
+
 // BufferRingImpl in GL on a given buffer target. In order to support WebGL2, we don't do hardware
 // mapping.
 class BufferRingGLImpl : public BufferRing
@@ -1625,6 +1756,7 @@ std::unique_ptr<RenderContext> RenderContextGLImpl::MakeContext(
         if (capabilities.isContextVersionAtLeast(4, 2))
         {
             capabilities.ARB_shader_image_load_store = true;
+            capabilities.EXT_texture_compression_bptc = true;
         }
         if (capabilities.isContextVersionAtLeast(4, 3))
         {
@@ -1683,6 +1815,10 @@ std::unique_ptr<RenderContext> RenderContextGLImpl::MakeContext(
         {
             capabilities.KHR_blend_equation_advanced_coherent = true;
         }
+        else if (strcmp(ext, "GL_KHR_texture_compression_astc_ldr") == 0)
+        {
+            capabilities.KHR_texture_compression_astc_ldr = true;
+        }
         else if (strcmp(ext, "GL_EXT_base_instance") == 0)
         {
             capabilities.EXT_base_instance = true;
@@ -1699,6 +1835,11 @@ std::unique_ptr<RenderContext> RenderContextGLImpl::MakeContext(
         {
             capabilities.EXT_clip_cull_distance = true;
         }
+        else if (strcmp(ext, "GL_EXT_texture_compression_bptc") == 0 ||
+                 strcmp(ext, "GL_ARB_texture_compression_bptc") == 0)
+        {
+            capabilities.EXT_texture_compression_bptc = true;
+        }
         else if (strcmp(ext, "GL_INTEL_fragment_shader_ordering") == 0)
         {
             capabilities.INTEL_fragment_shader_ordering = true;
@@ -1731,6 +1872,21 @@ std::unique_ptr<RenderContext> RenderContextGLImpl::MakeContext(
     {
         capabilities.EXT_clip_cull_distance = true;
     }
+    if (emscripten_webgl_enable_extension(emscripten_webgl_get_current_context(),
+                                          "WEBGL_compressed_texture_etc"))
+    {
+        capabilities.WEBGL_compressed_texture_etc = true;
+    }
+    if (emscripten_webgl_enable_extension(emscripten_webgl_get_current_context(),
+                                          "WEBGL_compressed_texture_astc"))
+    {
+        capabilities.KHR_texture_compression_astc_ldr = true;
+    }
+    if (emscripten_webgl_enable_extension(emscripten_webgl_get_current_context(),
+                                          "EXT_texture_compression_bptc"))
+    {
+        capabilities.EXT_texture_compression_bptc = true;
+    }
 #endif // RIVE_WEBGL
 
 #ifdef RIVE_DESKTOP_GL
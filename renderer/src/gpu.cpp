@@ -408,7 +408,8 @@ void PaintData::set(FillRule fillRule,
                     GradTextureLayout gradTextureLayout,
                     uint32_t clipID,
                     bool hasClipRect,
-                    BlendMode blendMode)
+                    BlendMode blendMode,
+                    bool imageIsPremultiplied)
 {
     uint32_t shiftedClipID = clipID << 16;
     uint32_t shiftedBlendMode = ConvertBlendModeToPLSBlendMode(blendMode) << 4;
@@ -456,6 +457,11 @@ void PaintData::set(FillRule fillRule,
     {
         localParams |= PAINT_FLAG_HAS_CLIP_RECT;
     }
+    if (imageIsPremultiplied)
+    {
+        assert(paintType == PaintType::image);
+        localParams |= PAINT_FLAG_PREMULTIPLIED_IMAGE;
+    }
     m_params = localParams;
 }
 
@@ -464,6 +470,7 @@ void PaintAuxData::set(const Mat2D& viewMatrix,
                        SimplePaintValue simplePaintValue,
                        const Gradient* gradient,
                        const Texture* imageTexture,
+                       const Mat2D& imageUVTransform,
                        const ClipRectInverseMatrix* clipRectInverseMatrix,
                        const RenderTarget* renderTarget,
                        const gpu::PlatformFeatures& platformFeatures)
@@ -487,6 +494,8 @@ void PaintAuxData::set(const Mat2D& viewMatrix,
             }
             if (paintType == PaintType::image)
             {
+                // Map the unit image rect to the image's region of its texture.
+                paintMatrix = imageUVTransform * paintMatrix;
                 // Since we don't use perspective transformations, the image mipmap level-of-detail
                 // is constant throughout the entire path. Compute it ahead of time here.
                 float dudx = paintMatrix.xx() * imageTexture->width();
@@ -562,7 +571,9 @@ ImageDrawUniforms::ImageDrawUniforms(const Mat2D& matrix,
                                      const ClipRectInverseMatrix* clipRectInverseMatrix,
                                      uint32_t clipID,
                                      BlendMode blendMode,
-                                     uint32_t zIndex)
+                                     uint32_t zIndex,
+                                     const Mat2D& texCoordMatrix,
+                                     bool imageIsPremultiplied)
 {
     write_matrix(m_matrix, matrix);
     m_opacity = opacity;
@@ -573,6 +584,8 @@ ImageDrawUniforms::ImageDrawUniforms(const Mat2D& matrix,
     m_clipID = clipID;
     m_blendMode = ConvertBlendModeToPLSBlendMode(blendMode);
     m_zIndex = zIndex;
+    m_imageIsPremultiplied = imageIsPremultiplied;
+    write_matrix(m_texCoordMatrix, texCoordMatrix);
 }
 
 std::tuple<uint32_t, uint32_t> StorageTextureSize(size_t bufferSizeInBytes,
@@ -22,13 +22,13 @@ class GrInnerFanTriangulator : private GrTriangulator
 public:
     using GroutTriangleList = GrTriangulator::BreadcrumbTriangleList;
 
+    // The polygons are in path space and don't depend on the view matrix, so a triangulator can
+    // be reused by any draw of the same path.
     GrInnerFanTriangulator(const RawPath& path,
-                           const Mat2D& viewMatrix,
                            Comparator::Direction direction,
                            FillRule fillRule,
                            TrivialBlockAllocator* alloc) :
-        GrTriangulator(direction, fillRule, alloc),
-        m_shouldReverseTriangles(viewMatrix[0] * viewMatrix[3] - viewMatrix[2] * viewMatrix[1] < 0)
+        GrTriangulator(direction, fillRule, alloc)
     {
         fPreserveCollinearVertices = true;
         fCollectBreadcrumbTriangles = true;
@@ -45,8 +45,16 @@ public:
 
     size_t maxVertexCount() const { return m_maxVertexCount; }
 
+    // We reverse triangles when using a left-handed view matrix, in order to ensure we always emit
+    // clockwise triangles.
+    static bool ShouldReverseTriangles(const Mat2D& viewMatrix)
+    {
+        return viewMatrix[0] * viewMatrix[3] - viewMatrix[2] * viewMatrix[1] < 0;
+    }
+
     size_t polysToTriangles(gpu::WriteOnlyMappedMemory<gpu::TriangleVertex>* bufferRing,
-                            uint16_t pathID) const
+                            uint16_t pathID,
+                            bool reverseTriangles) const
 
     {
         if (m_polys == nullptr || m_maxVertexCount == 0)
@@ -56,16 +64,13 @@ public:
         return GrTriangulator::polysToTriangles(m_polys,
                                                 m_maxVertexCount,
                                                 pathID,
-                                                m_shouldReverseTriangles,
+                                                reverseTriangles,
                                                 bufferRing);
     }
 
     const GroutTriangleList& groutList() const { return fBreadcrumbList; }
 
 private:
-    // We reverse triangles whe using a left-handed view matrix, in order to ensure we always emit
-    // clockwise triangles.
-    bool m_shouldReverseTriangles;
     Poly* m_polys = nullptr;
     size_t m_maxVertexCount = 0;
 };
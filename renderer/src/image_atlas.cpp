@@ -0,0 +1,236 @@
+/*
+ * Copyright 2024 Rive
+ */
+
+#include "image_atlas.hpp"
+
+#include "rive/math/math_types.hpp"
+#include "rive/renderer/render_context_impl.hpp"
+
+#ifdef RIVE_DECODERS
+#include "rive/decoders/bitmap_decoder.hpp"
+#endif
+
+namespace rive::gpu
+{
+ImageAtlasPage::ImageAtlasPage() : m_pixels(kSize * kSize * 4) {}
+
+static uint32_t round_up_to_padding(uint32_t x)
+{
+    return (x + ImageAtlasPage::kPadding - 1) & ~(ImageAtlasPage::kPadding - 1);
+}
+
+bool ImageAtlasPage::addImage(uint32_t width,
+                              uint32_t height,
+                              const uint8_t pixelsRGBA[],
+                              uint32_t* x,
+                              uint32_t* y)
+{
+    assert(width > 0 && height > 0);
+    uint32_t slotWidth = round_up_to_padding(width + kPadding * 2);
+    uint32_t slotHeight = round_up_to_padding(height + kPadding * 2);
+    if (slotWidth > kSize)
+    {
+        return false;
+    }
+
+    // Start a new shelf if the image doesn't fit on the current one.
+    uint32_t slotLeft = m_shelfRight;
+    uint32_t slotTop = m_shelfTop;
+    uint32_t shelfHeight = m_shelfHeight;
+    if (slotLeft + slotWidth > kSize)
+    {
+        slotLeft = 0;
+        slotTop += m_shelfHeight;
+        shelfHeight = 0;
+    }
+    if (slotTop + slotHeight > kSize)
+    {
+        return false;
+    }
+    m_shelfRight = slotLeft + slotWidth;
+    m_shelfTop = slotTop;
+    m_shelfHeight = std::max(shelfHeight, slotHeight);
+
+    // Fill the whole slot, replicating the image's edge texels out into the padding.
+    *x = slotLeft + kPadding;
+    *y = slotTop + kPadding;
+    for (uint32_t slotY = 0; slotY < slotHeight; ++slotY)
+    {
+        uint32_t srcY = std::min(std::max(slotY, kPadding) - kPadding, height - 1);
+        const uint8_t* srcRow = pixelsRGBA + srcY * width * 4;
+        uint8_t* dstRow = m_pixels.data() + ((slotTop + slotY) * kSize + slotLeft) * 4;
+        for (uint32_t slotX = 0; slotX < slotWidth; ++slotX)
+        {
+            uint32_t srcX = std::min(std::max(slotX, kPadding) - kPadding, width - 1);
+            memcpy(dstRow + slotX * 4, srcRow + srcX * 4, 4);
+        }
+    }
+
+    ++m_imageCount;
+    IAABB slot = {static_cast<int32_t>(slotLeft),
+                  static_cast<int32_t>(slotTop),
+                  static_cast<int32_t>(slotLeft + slotWidth),
+                  static_cast<int32_t>(slotTop + slotHeight)};
+    m_dirtyBounds = m_dirtyBounds.empty() ? slot : m_dirtyBounds.join(slot);
+    return true;
+}
+
+void ImageAtlasPage::markFull()
+{
+    m_isFull = true;
+    if (m_texture != nullptr && m_dirtyBounds.empty())
+    {
+        m_pixels.clear();
+        m_pixels.shrink_to_fit();
+    }
+}
+
+rcp<Texture> ImageAtlasPage::refTexture(RenderContextImpl* impl)
+{
+    if (m_dirtyBounds.empty())
+    {
+        return m_texture;
+    }
+    if (m_texture == nullptr || !updateTexture(impl))
+    {
+        // Draws that already reference the old texture keep it alive until they're done with it.
+        m_texture = impl->makeImageTexture(kSize, kSize, kMipLevelCount, m_pixels.data());
+    }
+    m_dirtyBounds = {0, 0, 0, 0};
+    if (m_isFull)
+    {
+        m_pixels.clear();
+        m_pixels.shrink_to_fit();
+    }
+    return m_texture;
+}
+
+// Box filters a region of one mip level into the next level down, whose region is width x height.
+static void downsample(const uint8_t* src,
+                       size_t srcRowBytes,
+                       uint32_t width,
+                       uint32_t height,
+                       uint8_t* dst)
+{
+    for (uint32_t y = 0; y < height; ++y)
+    {
+        const uint8_t* srcRow = src + y * 2 * srcRowBytes;
+        for (uint32_t x = 0; x < width * 4; ++x)
+        {
+            // Step over to the same channel of the next texel to the right.
+            uint32_t i = (x & ~3u) * 2 + (x & 3u);
+            uint32_t sum =
+                srcRow[i] + srcRow[i + 4] + srcRow[srcRowBytes + i] + srcRow[srcRowBytes + i + 4];
+            *dst++ = static_cast<uint8_t>((sum + 2) >> 2);
+        }
+    }
+}
+
+bool ImageAtlasPage::updateTexture(RenderContextImpl* impl)
+{
+    // Slots are never reused, so draws that are already using the texture don't sample the dirty
+    // region, and it can be updated in place. Slots are also aligned to kPadding, so the dirty
+    // region covers whole texels at every mip level, and each level can be filtered from the one
+    // above it without reading outside the region.
+    uint32_t x = m_dirtyBounds.left;
+    uint32_t y = m_dirtyBounds.top;
+    uint32_t width = m_dirtyBounds.width();
+    uint32_t height = m_dirtyBounds.height();
+    const uint8_t* levelData = m_pixels.data() + (y * kSize + x) * 4;
+    size_t rowBytes = kSize * 4;
+    std::vector<uint8_t> mip;
+    for (uint32_t level = 0;; ++level)
+    {
+        if (!impl->updateImageTexture(m_texture.get(),
+                                      level,
+                                      x,
+                                      y,
+                                      width,
+                                      height,
+                                      rowBytes,
+                                      levelData))
+        {
+            assert(level == 0);
+            return false;
+        }
+        if (level + 1 == kMipLevelCount)
+        {
+            return true;
+        }
+        x >>= 1;
+        y >>= 1;
+        width >>= 1;
+        height >>= 1;
+        std::vector<uint8_t> nextMip(width * height * 4);
+        downsample(levelData, rowBytes, width, height, nextMip.data());
+        mip = std::move(nextMip);
+        levelData = mip.data();
+        rowBytes = width * 4;
+    }
+}
+
+void ImageAtlas::setMaxImageDimension(uint32_t maxImageDimension)
+{
+    m_maxImageDimension =
+        std::min(maxImageDimension, ImageAtlasPage::kSize - ImageAtlasPage::kPadding * 2);
+}
+
+rcp<RiveRenderImage> ImageAtlas::decodeImage(Span<const uint8_t> encodedBytes,
+                                             rcp<Texture>* largeImageTexture)
+{
+    *largeImageTexture = nullptr;
+#ifdef RIVE_DECODERS
+    Bitmap::DecodeOptions options;
+    options.forceRGBA = true;
+    auto bitmap = Bitmap::decode(encodedBytes.data(), encodedBytes.size(), options);
+    if (bitmap == nullptr)
+    {
+        return nullptr;
+    }
+    if (bitmap->pixelFormat() != Bitmap::PixelFormat::RGBA)
+    {
+        bitmap->pixelFormat(Bitmap::PixelFormat::RGBA);
+    }
+    uint32_t width = bitmap->width();
+    uint32_t height = bitmap->height();
+    if (rcp<RiveRenderImage> image = addImage(width, height, bitmap->bytes()))
+    {
+        return image;
+    }
+    uint32_t mipLevelCount = math::msb(height | width);
+    *largeImageTexture = m_impl->makeImageTexture(width, height, mipLevelCount, bitmap->bytes());
+#endif
+    return nullptr;
+}
+
+rcp<RiveRenderImage> ImageAtlas::addImage(uint32_t width,
+                                          uint32_t height,
+                                          const uint8_t pixelsRGBA[])
+{
+    if (width == 0 || height == 0 || width > m_maxImageDimension || height > m_maxImageDimension)
+    {
+        return nullptr;
+    }
+    uint32_t x, y;
+    if (m_currentPage == nullptr || !m_currentPage->addImage(width, height, pixelsRGBA, &x, &y))
+    {
+        if (m_currentPage != nullptr)
+        {
+            m_currentPage->markFull();
+        }
+        m_currentPage = make_rcp<ImageAtlasPage>();
+        bool didAdd RIVE_MAYBE_UNUSED =
+            m_currentPage->addImage(width, height, pixelsRGBA, &x, &y);
+        assert(didAdd);
+    }
+    constexpr static float kInverseSize = 1.f / ImageAtlasPage::kSize;
+    Mat2D uvTransform(width * kInverseSize,
+                      0,
+                      0,
+                      height * kInverseSize,
+                      x * kInverseSize,
+                      y * kInverseSize);
+    return rcp<RiveRenderImage>(new RiveRenderImage(m_currentPage, width, height, uvTransform));
+}
+} // namespace rive::gpu
@@ -0,0 +1,101 @@
+/*
+ * Copyright 2024 Rive
+ */
+
+#pragma once
+
+#include "rive/math/aabb.hpp"
+#include "rive/renderer/rive_render_image.hpp"
+#include "rive/span.hpp"
+#include <vector>
+
+namespace rive::gpu
+{
+class RenderContextImpl;
+
+// A shared texture that small images get packed into, so draws of different images can share a
+// batch.
+//
+// Keeps a CPU copy of its pixels so images can be added after the texture has been created. The
+// next time the page is drawn after a change, only the region the new images went into gets
+// uploaded, along with the same region of each mip level (or the whole page, on backends that can't
+// update textures in place). Once the page is full and uploaded, the CPU copy is freed.
+class ImageAtlasPage : public RefCnt<ImageAtlasPage>
+{
+public:
+    constexpr static uint32_t kSize = 1024;
+    constexpr static uint32_t kMipLevelCount = 3;
+    // Texels of edge-replicated padding around each image. Images are also placed on multiples of
+    // kPadding, so at the smallest mip level, neighbors are still separated by a full texel and
+    // don't bleed into each other.
+    constexpr static uint32_t kPadding = 1 << (kMipLevelCount - 1);
+
+    ImageAtlasPage();
+
+    // Copies the pixels into the page, surrounded by padding. Returns false if there isn't room.
+    bool addImage(uint32_t width,
+                  uint32_t height,
+                  const uint8_t pixelsRGBA[],
+                  uint32_t* x,
+                  uint32_t* y);
+
+    // Called when no more images will be added, so the CPU copy can be freed after the next upload.
+    void markFull();
+
+    // Returns the page's texture, uploading the images that were added since the last call first.
+    rcp<Texture> refTexture(RenderContextImpl*);
+
+    // Null once the page is full and uploaded.
+    const uint8_t* pixels() const { return m_pixels.empty() ? nullptr : m_pixels.data(); }
+    size_t imageCount() const { return m_imageCount; }
+    // The region images have been added to since the last upload. Empty if there isn't one.
+    const IAABB& dirtyBounds() const { return m_dirtyBounds; }
+
+private:
+    // Updates the dirty region of each mip level in m_texture. Returns false if the backend can't
+    // update textures in place.
+    bool updateTexture(RenderContextImpl*);
+
+    std::vector<uint8_t> m_pixels;
+    size_t m_imageCount = 0;
+    bool m_isFull = false;
+
+    // Images are packed onto horizontal shelves, left to right.
+    uint32_t m_shelfTop = 0;
+    uint32_t m_shelfHeight = 0;
+    uint32_t m_shelfRight = 0;
+
+    rcp<Texture> m_texture;
+    IAABB m_dirtyBounds = {0, 0, 0, 0};
+};
+
+// Packs decoded images that fit within a size threshold into shared ImageAtlasPages. Atlased images
+// have a null texture of their own. Their RenderImage::uvTransform() maps the unit image rect to
+// their region of the page, and RenderContext::refImageTexture() returns the page's texture.
+class ImageAtlas
+{
+public:
+    ImageAtlas(RenderContextImpl* impl) : m_impl(impl) {}
+
+    // Images larger than this in either dimension don't get atlased.
+    void setMaxImageDimension(uint32_t maxImageDimension);
+    uint32_t maxImageDimension() const { return m_maxImageDimension; }
+
+    // Decodes on the CPU, and packs the image into a page if it's small enough. Images that are too
+    // large return null, and get a standalone texture from the pixels that were already decoded in
+    // 'largeImageTexture', so the caller doesn't need to decode them again. Both are null if the
+    // image failed to decode.
+    rcp<RiveRenderImage> decodeImage(Span<const uint8_t> encodedBytes,
+                                     rcp<Texture>* largeImageTexture);
+
+    // Packs already-decoded pixels into a page, starting a new page if the current one is full.
+    // Returns null if the image is too large to atlas.
+    rcp<RiveRenderImage> addImage(uint32_t width, uint32_t height, const uint8_t pixelsRGBA[]);
+
+private:
+    RenderContextImpl* const m_impl;
+    uint32_t m_maxImageDimension = 0;
+    // The page new images get added to. Full pages are only kept alive by their images.
+    rcp<ImageAtlasPage> m_currentPage;
+};
+} // namespace rive::gpu
@@ -5,6 +5,7 @@
 #include "intersection_board.hpp"
 
 #include "rive/math/math_types.hpp"
+#include "rive/math/simd_dispatch.hpp"
 
 #if !SIMD_NATIVE_GVEC && (defined(__SSE2__) || defined(_M_AMD64) || defined(_M_X64))
 // MSVC doesn't get codegen for the inner loop. Provide direct SSE intrinsics.
@@ -15,6 +16,69 @@
 
 namespace rive::gpu
 {
+#if !defined(FALLBACK_ON_SSE2_INTRINSICS)
+namespace
+{
+// Accumulates the max groupIndices of every rectangle in the given chunks that intersects the
+// (encoded) rectangle in "complement". 32-byte vectors are passed by pointer because their calling
+// convention differs between the baseline and AVX variants.
+RIVE_ALWAYS_INLINE int16x8 max_intersecting_group_indices(const int8x32* edges,
+                                                          const int16x8* groupIndices,
+                                                          size_t chunkCount,
+                                                          const int8x32* complement,
+                                                          int16x8 runningMaxGroupIndices)
+{
+    for (const int8x32* end = edges + chunkCount; edges != end; ++edges, ++groupIndices)
+    {
+        // Test 32 edges!
+        auto edgeMasks = *edges < *complement;
+        // Since the transposed L,T,R,B rows are a each 64-bit vectors, "and-reducing" them returns
+        // the intersection test (l0 < r1 && t0 < b1 && r0 > l1 && b0 > t1) in each byte.
+        int64_t isectMask = simd::reduce_and(math::bit_cast<int64x4>(edgeMasks));
+        // Each element of isectMasks8 is 0xff if we intersect with the corresponding rectangle,
+        // otherwise 0.
+        int8x8 isectMasks8 = math::bit_cast<int8x8>(isectMask);
+        // Widen isectMasks8 to 16 bits per mask, where each element of isectMasks16 is 0xffff if we
+        // intersect with the rectangle, otherwise 0.
+        int16x8 isectMasks16 = math::bit_cast<int16x8>(simd::zip(isectMasks8, isectMasks8));
+        // Mask out any groupIndices we don't intersect with so they don't participate in the test
+        // for maximum groupIndex.
+        int16x8 maskedGroupIndices = isectMasks16 & *groupIndices;
+        runningMaxGroupIndices = simd::max(maskedGroupIndices, runningMaxGroupIndices);
+    }
+    return runningMaxGroupIndices;
+}
+
+int16x8 max_intersecting_group_indices_baseline(const int8x32* edges,
+                                                const int16x8* groupIndices,
+                                                size_t chunkCount,
+                                                const int8x32* complement,
+                                                int16x8 runningMaxGroupIndices)
+{
+    return max_intersecting_group_indices(edges,
+                                          groupIndices,
+                                          chunkCount,
+                                          complement,
+                                          runningMaxGroupIndices);
+}
+
+#if RIVE_SIMD_X86_DISPATCH
+RIVE_SIMD_TARGET_AVX2 int16x8 max_intersecting_group_indices_avx2(const int8x32* edges,
+                                                                  const int16x8* groupIndices,
+                                                                  size_t chunkCount,
+                                                                  const int8x32* complement,
+                                                                  int16x8 runningMaxGroupIndices)
+{
+    return max_intersecting_group_indices(edges,
+                                          groupIndices,
+                                          chunkCount,
+                                          complement,
+                                          runningMaxGroupIndices);
+}
+#endif
+} // namespace
+#endif // !FALLBACK_ON_SSE2_INTRINSICS
+
 void IntersectionTile::reset(int left, int top, int16_t baselineGroupIndex)
 {
     // Since we mask non-intersecting groupIndices to zero, the "mask and max" algorithm is only
@@ -124,27 +188,26 @@ int16x8 IntersectionTile::findMaxIntersectingGroupIndex(int4 ltrb,
     int8x8 _t = biased.y; // Already converted to "255 - top" above.
 
 #if !defined(FALLBACK_ON_SSE2_INTRINSICS)
-    auto edges = m_edges.begin();
-    auto groupIndices = m_groupIndices.begin();
     assert(m_edges.size() == m_groupIndices.size());
     int8x32 complement = simd::join(r, b, _l, _t);
-    for (; edges != m_edges.end(); ++edges, ++groupIndices)
+#if RIVE_SIMD_X86_DISPATCH
+    if (simd::active_isa() >= simd::ISA::avx2)
     {
-        // Test 32 edges!
-        auto edgeMasks = *edges < complement;
-        // Since the transposed L,T,R,B rows are a each 64-bit vectors, "and-reducing" them returns
-        // the intersection test (l0 < r1 && t0 < b1 && r0 > l1 && b0 > t1) in each byte.
-        int64_t isectMask = simd::reduce_and(math::bit_cast<int64x4>(edgeMasks));
-        // Each element of isectMasks8 is 0xff if we intersect with the corresponding rectangle,
-        // otherwise 0.
-        int8x8 isectMasks8 = math::bit_cast<int8x8>(isectMask);
-        // Widen isectMasks8 to 16 bits per mask, where each element of isectMasks16 is 0xffff if we
-        // intersect with the rectangle, otherwise 0.
-        int16x8 isectMasks16 = math::bit_cast<int16x8>(simd::zip(isectMasks8, isectMasks8));
-        // Mask out any groupIndices we don't intersect with so they don't participate in the test
-        // for maximum groupIndex.
-        int16x8 maskedGroupIndices = isectMasks16 & *groupIndices;
-        runningMaxGroupIndices = simd::max(maskedGroupIndices, runningMaxGroupIndices);
+        // AVX2 tests all 32 edges of a chunk in a single instruction.
+        runningMaxGroupIndices = max_intersecting_group_indices_avx2(m_edges.data(),
+                                                                     m_groupIndices.data(),
+                                                                     m_edges.size(),
+                                                                     &complement,
+                                                                     runningMaxGroupIndices);
+    }
+    else
+#endif
+    {
+        runningMaxGroupIndices = max_intersecting_group_indices_baseline(m_edges.data(),
+                                                                         m_groupIndices.data(),
+                                                                         m_edges.size(),
+                                                                         &complement,
+                                                                         runningMaxGroupIndices);
     }
 #else
     // MSVC doesn't get good codegen for the above loop. Provide direct SSE intrinsics.
@@ -308,6 +308,12 @@ RenderContextMetalImpl::RenderContextMetalImpl(id<MTLDevice> gpu,
     m_platformFeatures.supportsFragmentShaderAtomics = true;
 #endif
     m_platformFeatures.atomicPLSMustBeInitializedAsDraw = true;
+    // Every Apple GPU family can sample ETC2 and ASTC. BC7 is only exposed on macOS.
+    m_platformFeatures.supportsETC2Textures = [m_gpu supportsFamily:MTLGPUFamilyApple2];
+    m_platformFeatures.supportsASTCTextures = [m_gpu supportsFamily:MTLGPUFamilyApple2];
+#if !defined(RIVE_IOS) && !defined(RIVE_IOS_SIMULATOR)
+    m_platformFeatures.supportsBC7Textures = [m_gpu supportsFamily:MTLGPUFamilyMac2];
+#endif
 
 #ifdef RIVE_IOS
     // Atomic barriers are never used on iOS, but if we ever did need them, we would use
@@ -549,6 +555,51 @@ public:
                      bytesPerRow:width * 4];
     }
 
+    // Block-compressed textures come with their full mip chain, and are never mipmapped by the GPU.
+    TextureMetalImpl(id<MTLDevice> gpu,
+                     uint32_t width,
+                     uint32_t height,
+                     ImageTextureFormat format,
+                     uint32_t mipLevelCount,
+                     const uint8_t* const levelData[]) :
+        Texture(width, height, format), m_mipsDirty(false)
+    {
+        MTLTextureDescriptor* desc = [[MTLTextureDescriptor alloc] init];
+        switch (format)
+        {
+            case ImageTextureFormat::etc2RGBA8:
+                desc.pixelFormat = MTLPixelFormatEAC_RGBA8;
+                break;
+            case ImageTextureFormat::astc4x4:
+                desc.pixelFormat = MTLPixelFormatASTC_4x4_LDR;
+                break;
+#if !defined(RIVE_IOS) && !defined(RIVE_IOS_SIMULATOR)
+            case ImageTextureFormat::bc7:
+                desc.pixelFormat = MTLPixelFormatBC7_RGBAUnorm;
+                break;
+#endif
+            default:
+                RIVE_UNREACHABLE();
+        }
+        desc.width = width;
+        desc.height = height;
+        desc.mipmapLevelCount = mipLevelCount;
+        desc.usage = MTLTextureUsageShaderRead;
+        desc.textureType = MTLTextureType2D;
+        m_texture = [gpu newTextureWithDescriptor:desc];
+
+        for (uint32_t level = 0; level < mipLevelCount; ++level)
+        {
+            uint32_t levelWidth = std::max(width >> level, 1u);
+            uint32_t levelHeight = std::max(height >> level, 1u);
+            MTLRegion region = MTLRegionMake2D(0, 0, levelWidth, levelHeight);
+            [m_texture replaceRegion:region
+                         mipmapLevel:level
+                           withBytes:levelData[level]
+                         bytesPerRow:(levelWidth + 3) / 4 * 16];
+        }
+    }
+
     void ensureMipmaps(id<MTLCommandBuffer> commandBuffer) const
     {
         if (m_mipsDirty)
@@ -576,6 +627,17 @@ rcp<Texture> RenderContextMetalImpl::makeImageTexture(uint32_t width,
     return make_rcp<TextureMetalImpl>(m_gpu, width, height, mipLevelCount, imageDataRGBA);
 }
 
+rcp<Texture> RenderContextMetalImpl::makeCompressedImageTexture(uint32_t width,
+                                                                uint32_t height,
+                                                                ImageTextureFormat format,
+                                                                uint32_t mipLevelCount,
+                                                                const uint8_t* const levelData[],
+                                                                const size_t levelSizesInBytes[])
+{
+    assert(m_platformFeatures.supportsImageTextureFormat(format));
+    return make_rcp<TextureMetalImpl>(m_gpu, width, height, format, mipLevelCount, levelData);
+}
+
 std::unique_ptr<BufferRing> RenderContextMetalImpl::makeUniformBufferRing(size_t capacityInBytes)
 {
     return BufferRingMetalImpl::Make(m_gpu, capacityInBytes);
@@ -4,15 +4,20 @@
 
 #include "rive/renderer/render_context.hpp"
 
+#include "damage_tracker.hpp"
 #include "gr_inner_fan_triangulator.hpp"
 #include "intersection_board.hpp"
 #include "gradient.hpp"
+#include "image_atlas.hpp"
 #include "rive_render_paint.hpp"
+#include "rive_render_path.hpp"
+#include "texture_residency_manager.hpp"
 #include "rive/renderer/draw.hpp"
 #include "rive/renderer/rive_render_image.hpp"
 #include "rive/renderer/render_context_impl.hpp"
 #include "shaders/constants.glsl"
 
+#include <algorithm>
 #include <string_view>
 
 namespace rive::gpu
@@ -104,6 +109,19 @@ RenderContext::~RenderContext()
     m_logicalFlushes.clear();
 }
 
+InteriorTriangulationWorker* RenderContext::interiorTriangulationWorker()
+{
+#if defined(__EMSCRIPTEN__) && !defined(__EMSCRIPTEN_PTHREADS__)
+    return nullptr;
+#else
+    if (m_interiorTriangulationWorker == nullptr)
+    {
+        m_interiorTriangulationWorker = std::make_unique<InteriorTriangulationWorker>();
+    }
+    return m_interiorTriangulationWorker.get();
+#endif
+}
+
 const gpu::PlatformFeatures& RenderContext::platformFeatures() const
 {
     return m_impl->platformFeatures();
@@ -118,10 +136,83 @@ rcp<RenderBuffer> RenderContext::makeRenderBuffer(RenderBufferType type,
 
 rcp<RenderImage> RenderContext::decodeImage(Span<const uint8_t> encodedBytes)
 {
-    rcp<Texture> texture = m_impl->decodeImageTexture(encodedBytes);
+    if (imageAtlasMaxImageDimension() != 0)
+    {
+        // Images that are too large to atlas get made into textures from the pixels the atlas
+        // already decoded. Images the atlas couldn't decode (e.g., KTX2) go through the impl.
+        rcp<Texture> largeImageTexture;
+        if (rcp<RiveRenderImage> image =
+                m_imageAtlas->decodeImage(encodedBytes, &largeImageTexture))
+        {
+            return image;
+        }
+        if (largeImageTexture != nullptr)
+        {
+            if (imageTextureBudget() != 0)
+            {
+                return m_textureResidencyManager->makeImage(std::move(largeImageTexture),
+                                                            encodedBytes,
+                                                            m_frameNumber);
+            }
+            return make_rcp<RiveRenderImage>(std::move(largeImageTexture));
+        }
+    }
+    if (imageTextureBudget() != 0)
+    {
+        return m_textureResidencyManager->decodeImage(encodedBytes, m_frameNumber);
+    }
+    rcp<Texture> texture = m_impl->decodeImageTexture(encodedBytes, 0);
     return texture != nullptr ? make_rcp<RiveRenderImage>(std::move(texture)) : nullptr;
 }
 
+void RenderContext::setImageTextureBudget(size_t budgetInBytes)
+{
+    if (m_textureResidencyManager == nullptr)
+    {
+        m_textureResidencyManager = std::make_unique<TextureResidencyManager>(m_impl.get());
+    }
+    m_textureResidencyManager->setBudget(budgetInBytes);
+}
+
+size_t RenderContext::imageTextureBudget() const
+{
+    return m_textureResidencyManager != nullptr ? m_textureResidencyManager->budget() : 0;
+}
+
+size_t RenderContext::residentImageTextureBytes() const
+{
+    return m_textureResidencyManager != nullptr ? m_textureResidencyManager->residentBytes() : 0;
+}
+
+void RenderContext::setImageAtlasMaxImageDimension(uint32_t maxImageDimension)
+{
+    if (m_imageAtlas == nullptr)
+    {
+        m_imageAtlas = std::make_unique<ImageAtlas>(m_impl.get());
+    }
+    m_imageAtlas->setMaxImageDimension(maxImageDimension);
+}
+
+uint32_t RenderContext::imageAtlasMaxImageDimension() const
+{
+    return m_imageAtlas != nullptr ? m_imageAtlas->maxImageDimension() : 0;
+}
+
+rcp<Texture> RenderContext::refImageTexture(const RiveRenderImage* image)
+{
+    if (ImageAtlasPage* atlasPage = image->atlasPage())
+    {
+        return atlasPage->refTexture(m_impl.get());
+    }
+    ImageResidency* residency = image->residency();
+    if (residency != nullptr && residency->manager() != nullptr)
+    {
+        assert(residency->manager() == m_textureResidencyManager.get());
+        return m_textureResidencyManager->refTexture(residency, m_frameNumber);
+    }
+    return image->refTexture();
+}
+
 void RenderContext::releaseResources()
 {
     assert(!m_didBeginFrame);
@@ -190,11 +281,25 @@ void RenderContext::LogicalFlush::rewind()
     RIVE_DEBUG_CODE(m_expectedPathMirroredTessLocationAtEndOfPath = 0;)
     RIVE_DEBUG_CODE(m_pathCurveCount = 0;)
 
+    m_layerRenderTarget = nullptr;
+    m_layerTexture = nullptr;
+    m_isFirstFlushOfLayer = false;
+
     m_currentZIndex = 0;
 
     RIVE_DEBUG_CODE(m_hasDoneLayout = false;)
 }
 
+void RenderContext::LogicalFlush::setLayer(rcp<RenderTarget> renderTarget,
+                                           rcp<Texture> texture,
+                                           bool isFirstFlushOfLayer)
+{
+    assert(m_draws.empty());
+    m_layerRenderTarget = std::move(renderTarget);
+    m_layerTexture = std::move(texture);
+    m_isFirstFlushOfLayer = isFirstFlushOfLayer;
+}
+
 void RenderContext::LogicalFlush::resetContainers()
 {
     m_clips.clear();
@@ -248,6 +353,7 @@ void RenderContext::beginFrame(const FrameDescriptor& frameDescriptor)
         m_frameInterlockMode = gpu::InterlockMode::rasterOrdering;
     }
     m_frameShaderFeaturesMask = gpu::ShaderFeaturesMaskFor(m_frameInterlockMode);
+    ++m_frameNumber;
     if (m_logicalFlushes.empty())
     {
         m_logicalFlushes.emplace_back(new LogicalFlush(this));
@@ -260,7 +366,9 @@ bool RenderContext::isOutsideCurrentFrame(const IAABB& pixelBounds)
     assert(m_didBeginFrame);
     int4 bounds = simd::load4i(&pixelBounds);
     auto renderTargetSize = simd::cast<int32_t>(
-        uint2{m_frameDescriptor.renderTargetWidth, m_frameDescriptor.renderTargetHeight});
+        m_layerRenderTarget != nullptr
+            ? m_layerRenderTarget->size()
+            : uint2{m_frameDescriptor.renderTargetWidth, m_frameDescriptor.renderTargetHeight});
     return simd::any(bounds.xy >= renderTargetSize || bounds.zw <= 0 || bounds.xy >= bounds.zw);
 }
 
@@ -370,6 +478,224 @@ bool RenderContext::LogicalFlush::pushDrawBatch(DrawUniquePtr draws[], size_t dr
     return true;
 }
 
+// True if 'inner' is inside 'outer'. 'inner' must not be empty.
+static bool contains(const IAABB& outer, const IAABB& inner)
+{
+    return outer.left <= inner.left && outer.top <= inner.top && outer.right >= inner.right &&
+           outer.bottom >= inner.bottom;
+}
+
+static int64_t area(const IAABB& rect)
+{
+    return static_cast<int64_t>(rect.width()) * rect.height();
+}
+
+size_t RenderContext::LogicalFlush::cullOccludedDraws()
+{
+    assert(!m_hasDoneLayout);
+
+    // msaa relies on the depth buffer to order draws instead.
+    const FrameDescriptor& frameDescriptor = m_ctx->frameDescriptor();
+    if (m_flushDesc.interlockMode == gpu::InterlockMode::msaa || frameDescriptor.wireframe ||
+        frameDescriptor.fillsDisabled)
+    {
+        return 0;
+    }
+
+    // Walk the draws back to front, keeping only the largest few occluders so this pass stays
+    // linear.
+    constexpr static size_t kMaxOccluders = 4;
+    IAABB occluders[kMaxOccluders];
+    size_t occluderCount = 0;
+    // Only the damaged region gets drawn. (This is the whole render target unless damage tracking
+    // found a smaller one.) Layers are always drawn in full.
+    const IAABB& visibleRegion = isLayer() ? m_layerRenderTarget->bounds() : m_ctx->m_damageBounds;
+    size_t culledCount = 0;
+    for (size_t i = m_draws.size(); i-- != 0;)
+    {
+        const Draw* draw = m_draws[i].get();
+        if (occluderCount != 0 && !(draw->drawContents() & gpu::DrawContents::clipUpdate) &&
+            draw->type() != Draw::Type::stencilClipReset)
+        {
+            IAABB visibleBounds = draw->pixelBounds().intersect(visibleRegion);
+            bool isOccluded = false;
+            for (size_t j = 0; j < occluderCount && !isOccluded && !visibleBounds.empty(); ++j)
+            {
+                isOccluded = contains(occluders[j], visibleBounds);
+            }
+            if (isOccluded)
+            {
+                m_resourceCounts = m_resourceCounts.toVec() - draw->resourceCounts().toVec();
+                m_draws[i].reset();
+                ++culledCount;
+                continue;
+            }
+        }
+
+        // Clipping to the damaged region doesn't matter, since it also clips the draws behind.
+        IAABB opaqueBounds = draw->opaquePixelBounds().intersect(visibleRegion);
+        if (!opaqueBounds.empty() && draw->clipID() == 0 &&
+            (!draw->hasClipRect() || draw->clipRectInverseMatrix() == m_ctx->m_damageClipRect))
+        {
+            if (occluderCount < kMaxOccluders)
+            {
+                occluders[occluderCount++] = opaqueBounds;
+            }
+            else
+            {
+                IAABB* smallest = std::min_element(
+                    occluders,
+                    occluders + kMaxOccluders,
+                    [](const IAABB& a, const IAABB& b) { return area(a) < area(b); });
+                if (area(opaqueBounds) > area(*smallest))
+                {
+                    *smallest = opaqueBounds;
+                }
+            }
+        }
+    }
+
+    if (culledCount != 0)
+    {
+        m_draws.erase(std::remove(m_draws.begin(), m_draws.end(), nullptr), m_draws.end());
+    }
+    return culledCount;
+}
+
+void RenderContext::LogicalFlush::addDrawsToDamageTracker(DamageTracker* damageTracker) const
+{
+    // Content keys of the clips drawn so far, indexed by clipID - 1.
+    std::vector<uint64_t> clipContentKeys(m_clips.size(), 0);
+    auto clipContentKey = [&clipContentKeys](uint32_t clipID) {
+        return clipID != 0 ? clipContentKeys[clipID - 1] : 0;
+    };
+    for (const DrawUniquePtr& draw : m_draws)
+    {
+        if (draw->type() == Draw::Type::stencilClipReset)
+        {
+            continue; // Accounted for by the clipUpdates that follow it.
+        }
+        if (draw->drawContents() & gpu::DrawContents::clipUpdate)
+        {
+            // For clipUpdates, clipID() is the clip being written, and the paint holds the clip
+            // it's nested inside.
+            assert(draw->clipID() != 0 && draw->clipID() <= m_clips.size());
+            uint32_t outerClipID = draw->simplePaintValue().outerClipID;
+            clipContentKeys[draw->clipID() - 1] = draw->contentKey(clipContentKey(outerClipID));
+            continue;
+        }
+        damageTracker->addDraw(draw->contentKey(clipContentKey(draw->clipID())),
+                               draw->pixelBounds());
+    }
+}
+
+// If the clipRect is axis-aligned, returns true and finds the pixel-space rectangle it clips to.
+static bool find_axis_aligned_clip_rect(const gpu::ClipRectInverseMatrix& clipRect, AABB* rect)
+{
+    const Mat2D& m = clipRect.inverseMatrix();
+    if (m.xy() != 0 || m.yx() != 0)
+    {
+        return false;
+    }
+    if (m.xx() == 0 || m.yy() == 0)
+    {
+        // Singular matrices have fixed coverage. They either clip nothing or everything.
+        *rect = m == gpu::ClipRectInverseMatrix::WideOpen().inverseMatrix()
+                    ? AABB(Draw::kFullscreenPixelBounds)
+                    : AABB();
+        return true;
+    }
+    // The clipRect is the region that maps to [-1, -1, +1, +1].
+    float x0 = (-1 - m.tx()) / m.xx();
+    float x1 = (1 - m.tx()) / m.xx();
+    float y0 = (-1 - m.ty()) / m.yy();
+    float y1 = (1 - m.ty()) / m.yy();
+    *rect = AABB(std::min(x0, x1), std::min(y0, y1), std::max(x0, x1), std::max(y0, y1));
+    return true;
+}
+
+bool RenderContext::LogicalFlush::expandDamageForClipRects(IAABB* damage) const
+{
+    bool didExpand = false;
+    AABB unused;
+    for (const DrawUniquePtr& draw : m_draws)
+    {
+        const IAABB& bounds = draw->pixelBounds();
+        if (draw->hasClipRect() && !(draw->drawContents() & gpu::DrawContents::clipUpdate) &&
+            !find_axis_aligned_clip_rect(*draw->clipRectInverseMatrix(), &unused) &&
+            !bounds.intersect(*damage).empty() && !contains(*damage, bounds))
+        {
+            *damage = damage->join(bounds);
+            didExpand = true;
+        }
+    }
+    return didExpand;
+}
+
+bool RenderContext::LogicalFlush::pushBackgroundDraw(DrawUniquePtr draw)
+{
+    if (!pushDrawBatch(&draw, 1))
+    {
+        return false;
+    }
+    std::rotate(m_draws.begin(), m_draws.end() - 1, m_draws.end());
+    return true;
+}
+
+void RenderContext::LogicalFlush::clipDrawsToDamage()
+{
+    assert(!m_hasDoneLayout);
+    assert(m_ctx->m_isPartialFrame);
+
+    const FrameDescriptor& frameDescriptor = m_ctx->frameDescriptor();
+    const IAABB renderTargetBounds = {0,
+                                      0,
+                                      static_cast<int32_t>(frameDescriptor.renderTargetWidth),
+                                      static_cast<int32_t>(frameDescriptor.renderTargetHeight)};
+    const IAABB& damage = m_ctx->m_damageBounds;
+    bool didCull = false;
+    for (DrawUniquePtr& draw : m_draws)
+    {
+        // Clip updates don't write color, but the draws inside the damaged region may read them.
+        // (If nothing was damaged, nothing reads them.)
+        if ((draw->drawContents() & gpu::DrawContents::clipUpdate) && !damage.empty())
+        {
+            continue;
+        }
+        IAABB visibleBounds = draw->pixelBounds().intersect(renderTargetBounds);
+        if (visibleBounds.intersect(damage).empty())
+        {
+            m_resourceCounts = m_resourceCounts.toVec() - draw->resourceCounts().toVec();
+            draw.reset();
+            didCull = true;
+            continue;
+        }
+        if (contains(damage, visibleBounds))
+        {
+            continue;
+        }
+        AABB clipRect;
+        if (!draw->hasClipRect())
+        {
+            draw->setClipRect(m_ctx->m_damageClipRect);
+        }
+        else if (find_axis_aligned_clip_rect(*draw->clipRectInverseMatrix(), &clipRect))
+        {
+            clipRect = AABB(std::max(clipRect.minX, static_cast<float>(damage.left)),
+                            std::max(clipRect.minY, static_cast<float>(damage.top)),
+                            std::min(clipRect.maxX, static_cast<float>(damage.right)),
+                            std::min(clipRect.maxY, static_cast<float>(damage.bottom)));
+            draw->setClipRect(m_ctx->make<gpu::ClipRectInverseMatrix>(Mat2D(), clipRect));
+        }
+        // Otherwise expandDamageForClipRects() already grew the damaged region to cover the draw.
+    }
+
+    if (didCull)
+    {
+        m_draws.erase(std::remove(m_draws.begin(), m_draws.end(), nullptr), m_draws.end());
+    }
+}
+
 bool RenderContext::LogicalFlush::allocateGradient(const Gradient* gradient,
                                                    Draw::ResourceCounters* counters,
                                                    gpu::ColorRampLocation* colorRampLocation)
@@ -449,6 +775,133 @@ void RenderContext::logicalFlush()
     // Don't issue any GPU commands between logical flushes. Instead, build up a list of flushes
     // that we will submit all at once at the end of the frame.
     m_logicalFlushes.emplace_back(new LogicalFlush(this));
+    if (m_layerRenderTarget != nullptr)
+    {
+        m_logicalFlushes.back()->setLayer(m_layerRenderTarget,
+                                          m_layerTexture,
+                                          /*isFirstFlushOfLayer=*/false);
+    }
+}
+
+rcp<RiveRenderImage> RenderContext::beginLayer(uint32_t width, uint32_t height)
+{
+    assert(m_didBeginFrame);
+    assert(m_layerRenderTarget == nullptr); // Layers don't nest.
+    assert(width > 0 && height > 0);
+    rcp<Texture> texture;
+    bool textureIsBottomUp = false;
+    rcp<RenderTarget> renderTarget =
+        m_impl->makeLayerRenderTarget(width, height, &texture, &textureIsBottomUp);
+    if (renderTarget == nullptr)
+    {
+        return nullptr;
+    }
+    assert(texture != nullptr);
+
+    // The layer renders in a flush of its own, which goes before whatever draws it. Only clip
+    // state carries over between flushes, and there's none yet.
+    m_clipContentID = 0;
+    m_logicalFlushes.emplace_back(new LogicalFlush(this));
+    m_logicalFlushes.back()->setLayer(renderTarget, texture, /*isFirstFlushOfLayer=*/true);
+    m_layerRenderTarget = std::move(renderTarget);
+    m_layerTexture = texture;
+
+    // Flip the image right side up if the top row of the layer landed at the bottom of the texture.
+    Mat2D uvTransform = textureIsBottomUp ? Mat2D(1, 0, 0, -1, 0, 1) : Mat2D();
+    // Layers are rendered with premultiplied alpha.
+    return make_rcp<RiveRenderImage>(std::move(texture), uvTransform, /*isPremultiplied=*/true);
+}
+
+void RenderContext::endLayer()
+{
+    assert(m_didBeginFrame);
+    assert(m_layerRenderTarget != nullptr);
+    m_layerRenderTarget = nullptr;
+    m_layerTexture = nullptr;
+    // Resume drawing to the frame's render target.
+    logicalFlush();
+}
+
+void RenderContext::clipFrameToDamage(const RenderTarget* renderTarget)
+{
+    // There's no way to clear part of the render target, or a blend mode that replaces the
+    // destination with a translucent color, so the damaged region gets cleared with an opaque draw.
+    if (m_frameDescriptor.loadAction != gpu::LoadAction::clear ||
+        colorAlpha(m_frameDescriptor.clearColor) != 255 || !frameSupportsClipRects())
+    {
+        if (m_damageTracker != nullptr)
+        {
+            m_damageTracker->reset();
+        }
+        return;
+    }
+
+    if (m_damageTracker == nullptr)
+    {
+        m_damageTracker = std::make_unique<DamageTracker>();
+    }
+    m_damageTracker->beginFrame();
+    for (const auto& flush : m_logicalFlushes)
+    {
+        if (!flush->isLayer())
+        {
+            flush->addDrawsToDamageTracker(m_damageTracker.get());
+        }
+    }
+    IAABB damage = m_damageTracker->findDamage(renderTarget,
+                                               m_frameDescriptor.clearColor,
+                                               m_frameInterlockMode);
+
+    bool didExpand;
+    do
+    {
+        didExpand = false;
+        for (const auto& flush : m_logicalFlushes)
+        {
+            didExpand |= !flush->isLayer() && flush->expandDamageForClipRects(&damage);
+        }
+    } while (didExpand);
+
+    damage = damage.intersect(renderTarget->bounds());
+    if (damage.empty())
+    {
+        damage = {0, 0, 0, 0};
+    }
+    else if (damage == renderTarget->bounds())
+    {
+        return; // Everything changed.
+    }
+    else
+    {
+        RawPath clearRect;
+        clearRect.addRect(AABB(damage));
+        RiveRenderPaint clearPaint;
+        clearPaint.color(m_frameDescriptor.clearColor);
+        RawPath scratchPath;
+        DrawUniquePtr clearDraw =
+            RiveRenderPathDraw::Make(this,
+                                     Mat2D(),
+                                     make_rcp<RiveRenderPath>(FillRule::nonZero, clearRect),
+                                     FillRule::nonZero,
+                                     &clearPaint,
+                                     &scratchPath);
+        if (clearDraw == nullptr ||
+            !m_logicalFlushes.front()->pushBackgroundDraw(std::move(clearDraw)))
+        {
+            return; // Draw the whole frame after all.
+        }
+        m_damageClipRect = make<gpu::ClipRectInverseMatrix>(Mat2D(), AABB(damage));
+    }
+
+    m_damageBounds = damage;
+    m_isPartialFrame = true;
+    for (const auto& flush : m_logicalFlushes)
+    {
+        if (!flush->isLayer())
+        {
+            flush->clipDrawsToDamage();
+        }
+    }
 }
 
 void RenderContext::flush(const FlushResources& flushResources)
@@ -456,14 +909,29 @@ void RenderContext::flush(const FlushResources& flushResources)
     assert(m_didBeginFrame);
     assert(flushResources.renderTarget->width() == m_frameDescriptor.renderTargetWidth);
     assert(flushResources.renderTarget->height() == m_frameDescriptor.renderTargetHeight);
+    assert(m_layerRenderTarget == nullptr); // Every beginLayer() needs an endLayer().
 
     m_clipContentID = 0;
 
+    m_damageBounds = flushResources.renderTarget->bounds();
+    m_isPartialFrame = false;
+    m_damageClipRect = nullptr;
+    if (m_frameDescriptor.damageTracking)
+    {
+        clipFrameToDamage(flushResources.renderTarget);
+    }
+    else if (m_damageTracker != nullptr)
+    {
+        m_damageTracker->reset();
+    }
+
     // Layout this frame's resource buffers and textures.
     LogicalFlush::ResourceCounters totalFrameResourceCounts;
     LogicalFlush::LayoutCounters layoutCounts;
+    m_occlusionCulledDrawCount = 0;
     for (size_t i = 0; i < m_logicalFlushes.size(); ++i)
     {
+        m_occlusionCulledDrawCount += m_logicalFlushes[i]->cullOccludedDraws();
         m_logicalFlushes[i]->layoutResources(flushResources,
                                              i,
                                              i == m_logicalFlushes.size() - 1,
@@ -564,6 +1032,13 @@ void RenderContext::flush(const FlushResources& flushResources)
         m_logicalFlushes.front()->rewind();
     }
 
+    // Now that the frame's draws have let go of their textures, bring image textures back within
+    // budget.
+    if (m_textureResidencyManager != nullptr)
+    {
+        m_textureResidencyManager->evict(m_frameNumber);
+    }
+
     // Drop all memory that was allocated for this frame using TrivialBlockAllocator.
     m_perFrameAllocator.reset();
     m_numChopsAllocator.reset();
@@ -656,7 +1131,7 @@ void RenderContext::LogicalFlush::layoutResources(const FlushResources& flushRes
             maxSpanBreakCount + kPaddingSpanCount + kMaxTessellationAlignmentVertices;
     }
 
-    m_flushDesc.renderTarget = flushResources.renderTarget;
+    m_flushDesc.renderTarget = isLayer() ? m_layerRenderTarget.get() : flushResources.renderTarget;
     m_flushDesc.interlockMode = m_ctx->frameInterlockMode();
     m_flushDesc.msaaSampleCount = frameDescriptor.msaaSampleCount;
 
@@ -664,11 +1139,24 @@ void RenderContext::LogicalFlush::layoutResources(const FlushResources& flushRes
     // into the atomic "resolve" operation instead.
     bool doClearDuringAtomicResolve = false;
 
-    if (logicalFlushIdx != 0)
+    if (isLayer())
+    {
+        // Layers start out transparent. (The frame's loadAction and clearColor are for its own
+        // render target.)
+        m_flushDesc.colorLoadAction = m_isFirstFlushOfLayer ? gpu::LoadAction::clear
+                                                            : gpu::LoadAction::preserveRenderTarget;
+    }
+    else if (logicalFlushIdx != 0)
     {
         // We always have to preserve the renderTarget between logical flushes.
         m_flushDesc.colorLoadAction = gpu::LoadAction::preserveRenderTarget;
     }
+    else if (m_ctx->m_isPartialFrame)
+    {
+        // Damage tracking only redraws what changed. The damaged region gets cleared by the first
+        // draw instead. (See clipFrameToDamage().)
+        m_flushDesc.colorLoadAction = gpu::LoadAction::preserveRenderTarget;
+    }
     else if (frameDescriptor.loadAction == gpu::LoadAction::clear)
     {
         // In atomic mode, we can clear during the resolve operation if the clearColor is opaque
@@ -682,7 +1170,7 @@ void RenderContext::LogicalFlush::layoutResources(const FlushResources& flushRes
     {
         m_flushDesc.colorLoadAction = frameDescriptor.loadAction;
     }
-    m_flushDesc.clearColor = frameDescriptor.clearColor;
+    m_flushDesc.clearColor = isLayer() ? 0 : frameDescriptor.clearColor;
 
     if (doClearDuringAtomicResolve)
     {
@@ -718,7 +1206,8 @@ void RenderContext::LogicalFlush::layoutResources(const FlushResources& flushRes
     {
         // When we don't clear, we only update the draw bounds.
         m_flushDesc.renderTargetUpdateBounds =
-            m_flushDesc.renderTarget->bounds().intersect(m_combinedDrawBounds);
+            (isLayer() ? m_layerRenderTarget->bounds() : m_ctx->m_damageBounds)
+                .intersect(m_combinedDrawBounds);
     }
     if (m_flushDesc.renderTargetUpdateBounds.empty())
     {
@@ -856,7 +1345,7 @@ void RenderContext::LogicalFlush::writeResources()
     // Write a path record for the clearColor paint (used by atomic mode).
     // This also allows us to index the storage buffers directly by pathID.
     gpu::SimplePaintValue clearColorValue;
-    clearColorValue.color = m_ctx->frameDescriptor().clearColor;
+    clearColorValue.color = m_flushDesc.clearColor;
     m_ctx->m_pathData.skip_back();
     m_ctx->m_paintData.set_back(FillRule::nonZero,
                                 PaintType::solidColor,
@@ -1421,12 +1910,14 @@ void RenderContext::LogicalFlush::pushPath(RiveRenderPathDraw* draw,
                                 m_gradTextureLayout,
                                 draw->clipID(),
                                 draw->hasClipRect(),
-                                draw->blendMode());
+                                draw->blendMode(),
+                                draw->imageIsPremultiplied());
     m_ctx->m_paintAuxData.set_back(draw->matrix(),
                                    draw->paintType(),
                                    draw->simplePaintValue(),
                                    draw->gradient(),
                                    draw->imageTexture(),
+                                   draw->imageUVTransform(),
                                    draw->clipRectInverseMatrix(),
                                    m_flushDesc.renderTarget,
                                    m_ctx->platformFeatures());
@@ -1715,8 +2206,10 @@ void RenderContext::LogicalFlush::pushInteriorTriangulation(RiveRenderPathDraw*
     assert(m_ctx->m_triangleVertexData.hasRoomFor(draw->triangulator()->maxVertexCount()));
     uint32_t baseVertex =
         math::lossless_numeric_cast<uint32_t>(m_ctx->m_triangleVertexData.elementsWritten());
-    size_t actualVertexCount =
-        draw->triangulator()->polysToTriangles(&m_ctx->m_triangleVertexData, m_currentPathID);
+    size_t actualVertexCount = draw->triangulator()->polysToTriangles(
+        &m_ctx->m_triangleVertexData,
+        m_currentPathID,
+        GrInnerFanTriangulator::ShouldReverseTriangles(draw->matrix()));
     assert(actualVertexCount <= draw->triangulator()->maxVertexCount());
     DrawBatch& batch = pushPathDraw(draw,
                                     DrawType::interiorTriangulation,
@@ -1741,7 +2234,9 @@ void RenderContext::LogicalFlush::pushImageRect(ImageRectDraw* draw)
                                                draw->clipRectInverseMatrix(),
                                                draw->clipID(),
                                                draw->blendMode(),
-                                               m_currentZIndex);
+                                               m_currentZIndex,
+                                               draw->imageUVTransform(),
+                                               draw->imageIsPremultiplied());
 
     DrawBatch& batch = pushDraw(draw, DrawType::imageRect, PaintType::image, 1, 0);
     batch.imageDrawDataOffset = math::lossless_numeric_cast<uint32_t>(imageDrawDataOffset);
@@ -7,32 +7,8 @@
 #include "rive/renderer/rive_render_image.hpp"
 #include "shaders/constants.glsl"
 
-#ifdef RIVE_DECODERS
-#include "rive/decoders/bitmap_decoder.hpp"
-#endif
-
 namespace rive::gpu
 {
-rcp<Texture> RenderContextHelperImpl::decodeImageTexture(Span<const uint8_t> encodedBytes)
-{
-#ifdef RIVE_DECODERS
-    auto bitmap = Bitmap::decode(encodedBytes.data(), encodedBytes.size());
-    if (bitmap)
-    {
-        // For now, RenderContextImpl::makeImageTexture() only accepts RGBA.
-        if (bitmap->pixelFormat() != Bitmap::PixelFormat::RGBA)
-        {
-            bitmap->pixelFormat(Bitmap::PixelFormat::RGBA);
-        }
-        uint32_t width = bitmap->width();
-        uint32_t height = bitmap->height();
-        uint32_t mipLevelCount = math::msb(height | width);
-        return makeImageTexture(width, height, mipLevelCount, bitmap->bytes());
-    }
-#endif
-    return nullptr;
-}
-
 void RenderContextHelperImpl::resizeFlushUniformBuffer(size_t sizeInBytes)
 {
     m_flushUniformBuffer = makeUniformBufferRing(sizeInBytes);
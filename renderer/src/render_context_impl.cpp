@@ -0,0 +1,117 @@
+/*
+ * Copyright 2024 Rive
+ */
+
+#include "rive/renderer/render_context_impl.hpp"
+
+#include "rive/math/math_types.hpp"
+#include "rive/renderer/texture.hpp"
+
+#ifdef RIVE_DECODERS
+#include "rive/decoders/bitmap_decoder.hpp"
+#include "rive/decoders/ktx2_image.hpp"
+#endif
+
+namespace rive::gpu
+{
+#ifdef RIVE_DECODERS
+static ImageTextureFormat ktx2_texture_format(KTX2Image::Format format)
+{
+    switch (format)
+    {
+        case KTX2Image::Format::rgba8:
+            return ImageTextureFormat::rgba8;
+        case KTX2Image::Format::etc2RGBA8:
+            return ImageTextureFormat::etc2RGBA8;
+        case KTX2Image::Format::astc4x4:
+            return ImageTextureFormat::astc4x4;
+        case KTX2Image::Format::bc7:
+            return ImageTextureFormat::bc7;
+    }
+    RIVE_UNREACHABLE();
+}
+#endif
+
+rcp<Texture> RenderContextImpl::makeCompressedImageTexture(uint32_t width,
+                                                           uint32_t height,
+                                                           ImageTextureFormat,
+                                                           uint32_t mipLevelCount,
+                                                           const uint8_t* const levelData[],
+                                                           const size_t levelSizesInBytes[])
+{
+    // Backends that support block-compressed formats override this.
+    return nullptr;
+}
+
+rcp<Texture> RenderContextImpl::decodeImageTexture(Span<const uint8_t> encodedBytes,
+                                                   uint32_t maxDimension)
+{
+#ifdef RIVE_DECODERS
+    if (KTX2Image::IsKTX2(encodedBytes.data(), encodedBytes.size()))
+    {
+        auto ktx2 = KTX2Image::decode(encodedBytes.data(), encodedBytes.size());
+        if (ktx2 == nullptr)
+        {
+            return nullptr;
+        }
+        // Skip levels that are larger than requested.
+        const auto& levels = ktx2->levels();
+        size_t baseLevel = 0;
+        while (maxDimension != 0 && baseLevel + 1 < levels.size() &&
+               std::max(levels[baseLevel].width, levels[baseLevel].height) > maxDimension)
+        {
+            ++baseLevel;
+        }
+        uint32_t width = levels[baseLevel].width;
+        uint32_t height = levels[baseLevel].height;
+        if (!ktx2->isBlockCompressed())
+        {
+            // Upload the top level and let the GPU build the mips, same as decoded images.
+            uint32_t mipLevelCount = math::msb(height | width);
+            return makeImageTexture(width, height, mipLevelCount, levels[baseLevel].bytes);
+        }
+        ImageTextureFormat format = ktx2_texture_format(ktx2->format());
+        if (!platformFeatures().supportsImageTextureFormat(format))
+        {
+            // Decode the top level on the CPU instead, and let the GPU build the mips.
+            auto bitmap = ktx2->decodeLevel(baseLevel);
+            uint32_t mipLevelCount = math::msb(height | width);
+            return makeImageTexture(width, height, mipLevelCount, bitmap->bytes());
+        }
+        size_t mipLevelCount = levels.size() - baseLevel;
+        std::vector<const uint8_t*> levelData(mipLevelCount);
+        std::vector<size_t> levelSizes(mipLevelCount);
+        for (size_t i = 0; i < mipLevelCount; ++i)
+        {
+            levelData[i] = levels[baseLevel + i].bytes;
+            levelSizes[i] = levels[baseLevel + i].byteCount;
+        }
+        return makeCompressedImageTexture(width,
+                                          height,
+                                          format,
+                                          static_cast<uint32_t>(mipLevelCount),
+                                          levelData.data(),
+                                          levelSizes.data());
+    }
+
+    // For now, RenderContextImpl::makeImageTexture() only accepts RGBA. Ask the decoders to write
+    // it directly, and convert if one can't.
+    Bitmap::DecodeOptions options;
+    options.maxWidth = options.maxHeight = maxDimension;
+    options.forceRGBA = true;
+    auto bitmap = Bitmap::decode(encodedBytes.data(), encodedBytes.size(), options);
+    if (bitmap)
+    {
+        if (bitmap->pixelFormat() != Bitmap::PixelFormat::RGBA)
+        {
+            bitmap->pixelFormat(Bitmap::PixelFormat::RGBA);
+        }
+        uint32_t width = bitmap->width();
+        uint32_t height = bitmap->height();
+        uint32_t mipLevelCount = math::msb(height | width);
+        return makeImageTexture(width, height, mipLevelCount, bitmap->bytes());
+    }
+#endif
+    return nullptr;
+}
+} // namespace rive::gpu
@@ -4,9 +4,50 @@
 
 #include "rive/renderer/rive_render_image.hpp"
 
+#include "image_atlas.hpp"
+#include "texture_residency_manager.hpp"
+
+namespace rive
+{
+RiveRenderImage::RiveRenderImage(rcp<gpu::Texture> texture) :
+    RiveRenderImage(texture->width(), texture->height())
+{
+    resetTexture(std::move(texture));
+}
+
+RiveRenderImage::RiveRenderImage(rcp<gpu::Texture> texture,
+                                 const Mat2D& uvTransform,
+                                 bool isPremultiplied) :
+    lite_rtti_override(uvTransform), m_isPremultiplied(isPremultiplied)
+{
+    m_Width = texture->width();
+    m_Height = texture->height();
+    resetTexture(std::move(texture));
+}
+
+RiveRenderImage::RiveRenderImage(int width, int height)
+{
+    m_Width = width;
+    m_Height = height;
+}
+
+RiveRenderImage::RiveRenderImage(rcp<gpu::ImageAtlasPage> atlasPage,
+                                 int width,
+                                 int height,
+                                 const Mat2D& uvTransform) :
+    lite_rtti_override(uvTransform), m_atlasPage(std::move(atlasPage))
+{
+    m_Width = width;
+    m_Height = height;
+}
+
+RiveRenderImage::~RiveRenderImage() {}
+} // namespace rive
+
 namespace rive::gpu
 {
-Texture::Texture(uint32_t width, uint32_t height) : m_width(width), m_height(height)
+Texture::Texture(uint32_t width, uint32_t height, ImageTextureFormat format) :
+    m_width(width), m_height(height), m_format(format)
 {
     static std::atomic_uint32_t textureResourceHashCounter = 0;
     m_textureResourceHash = ++textureResourceHashCounter;
@@ -18,6 +18,7 @@ void RiveRenderPaint::color(ColorInt color)
     m_simpleValue.color = color;
     m_gradient.reset();
     m_imageTexture.reset();
+    m_imageIsPremultiplied = false;
 }
 
 void RiveRenderPaint::shader(rcp<RenderShader> shader)
@@ -28,14 +29,20 @@ void RiveRenderPaint::shader(rcp<RenderShader> shader)
     // color ramp will decided by the render context every frame.
     m_simpleValue.color = 0xff000000;
     m_imageTexture.reset();
+    m_imageIsPremultiplied = false;
 }
 
-void RiveRenderPaint::image(rcp<const gpu::Texture> imageTexture, float opacity)
+void RiveRenderPaint::image(rcp<const gpu::Texture> imageTexture,
+                            float opacity,
+                            const Mat2D& uvTransform,
+                            bool isPremultiplied)
 {
     m_paintType = gpu::PaintType::image;
     m_simpleValue.imageOpacity = opacity;
     m_gradient.reset();
     m_imageTexture = std::move(imageTexture);
+    m_imageUVTransform = uvTransform;
+    m_imageIsPremultiplied = isPremultiplied;
 }
 
 void RiveRenderPaint::clipUpdate(uint32_t outerClipID)
@@ -44,6 +51,7 @@ void RiveRenderPaint::clipUpdate(uint32_t outerClipID)
     m_simpleValue.outerClipID = outerClipID;
     m_gradient.reset();
     m_imageTexture.reset();
+    m_imageIsPremultiplied = false;
 }
 
 bool RiveRenderPaint::getIsOpaque() const
@@ -28,7 +28,12 @@ public:
     void cap(StrokeCap cap) override { m_cap = cap; }
     void blendMode(BlendMode mode) override { m_blendMode = mode; }
     void shader(rcp<RenderShader> shader) override;
-    void image(rcp<const gpu::Texture>, float opacity);
+    // 'uvTransform' maps the unit image rect to the image's region of the texture.
+    // 'isPremultiplied' says the texture's colors are already multiplied by alpha.
+    void image(rcp<const gpu::Texture>,
+               float opacity,
+               const Mat2D& uvTransform = Mat2D(),
+               bool isPremultiplied = false);
     void clipUpdate(uint32_t outerClipID);
     void invalidateStroke() override {}
 
@@ -38,7 +43,9 @@ public:
     float getThickness() const { return m_thickness; }
     const gpu::Gradient* getGradient() const { return m_gradient.get(); }
     const gpu::Texture* getImageTexture() const { return m_imageTexture.get(); }
+    const Mat2D& getImageUVTransform() const { return m_imageUVTransform; }
     float getImageOpacity() const { return m_simpleValue.imageOpacity; }
+    bool getImageIsPremultiplied() const { return m_imageIsPremultiplied; }
     float getOuterClipID() const { return m_simpleValue.outerClipID; }
     StrokeJoin getJoin() const { return m_join; }
     StrokeCap getCap() const { return m_cap; }
@@ -51,6 +58,8 @@ private:
     gpu::SimplePaintValue m_simpleValue;
     rcp<const gpu::Gradient> m_gradient;
     rcp<const gpu::Texture> m_imageTexture;
+    Mat2D m_imageUVTransform;
+    bool m_imageIsPremultiplied = false;
     float m_thickness = 1;
     StrokeJoin m_join = StrokeJoin::miter;
     StrokeCap m_cap = StrokeCap::butt;
@@ -5,11 +5,134 @@
 #include "rive_render_path.hpp"
 
 #include "eval_cubic.hpp"
+#include "gr_inner_fan_triangulator.hpp"
 #include "rive/math/simd.hpp"
 #include "rive/math/wangs_formula.hpp"
 
 namespace rive
 {
+static std::atomic<size_t> s_interiorTriangulationCachedBytes = 0;
+
+InteriorTriangulation::InteriorTriangulation(const RawPath& linearizedPath,
+                                             uint64_t rawPathMutationID,
+                                             FillRule fillRule,
+                                             TriangulatorAxis axis) :
+    m_linearizedPath(linearizedPath),
+    m_rawPathMutationID(rawPathMutationID),
+    m_fillRule(fillRule),
+    m_axis(axis),
+    m_allocator(std::max<size_t>(linearizedPath.points().size() * 64, 4096))
+{
+    assert(axis != TriangulatorAxis::dontCare);
+}
+
+void InteriorTriangulation::triangulate()
+{
+    assert(!isReady());
+    m_triangulator = m_allocator.make<GrInnerFanTriangulator>(
+        m_linearizedPath,
+        m_axis == TriangulatorAxis::horizontal ? GrTriangulator::Comparator::Direction::kHorizontal
+                                               : GrTriangulator::Comparator::Direction::kVertical,
+        m_fillRule,
+        &m_allocator);
+    m_isReady.store(true, std::memory_order_release);
+}
+
+InteriorTriangulation::~InteriorTriangulation()
+{
+    s_interiorTriangulationCachedBytes -= m_cachedBytes;
+}
+
+size_t InteriorTriangulation::sizeInBytes() const
+{
+    return sizeof(*this) + m_allocator.totalBlockSize() +
+           m_linearizedPath.points().size() * sizeof(Vec2D) +
+           m_linearizedPath.verbs().size() * sizeof(PathVerb);
+}
+
+size_t InteriorTriangulation::TotalCachedBytes() { return s_interiorTriangulationCachedBytes; }
+
+bool InteriorTriangulation::reserveCacheBudget()
+{
+    assert(isReady());
+    if (m_cachedBytes != 0)
+    {
+        return true;
+    }
+    size_t bytes = sizeInBytes();
+    size_t total = s_interiorTriangulationCachedBytes.load();
+    do
+    {
+        if (total + bytes > kCacheBudgetInBytes)
+        {
+            return false;
+        }
+    } while (!s_interiorTriangulationCachedBytes.compare_exchange_weak(total, total + bytes));
+    m_cachedBytes = bytes;
+    return true;
+}
+
+InteriorTriangulationWorker::InteriorTriangulationWorker() :
+    m_thread(&InteriorTriangulationWorker::run, this)
+{}
+
+InteriorTriangulationWorker::~InteriorTriangulationWorker()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_shutdown = true;
+        m_queue.clear();
+    }
+    m_workAvailable.notify_one();
+    m_thread.join();
+}
+
+void InteriorTriangulationWorker::submit(rcp<InteriorTriangulation> triangulation)
+{
+    assert(!triangulation->isReady());
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_queue.push_back(std::move(triangulation));
+    }
+    m_workAvailable.notify_one();
+}
+
+void InteriorTriangulationWorker::waitUntilIdle()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_idle.wait(lock, [this] { return m_queue.empty() && !m_busy; });
+}
+
+void InteriorTriangulationWorker::run()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    for (;;)
+    {
+        m_workAvailable.wait(lock, [this] { return m_shutdown || !m_queue.empty(); });
+        if (m_shutdown)
+        {
+            return;
+        }
+        rcp<InteriorTriangulation> triangulation = std::move(m_queue.front());
+        m_queue.pop_front();
+        m_busy = true;
+        lock.unlock();
+        // Skip triangulations their paths have already dropped, because the path changed or was
+        // deleted while the job was queued.
+        if (!triangulation->unique())
+        {
+            triangulation->triangulate();
+        }
+        // Release our ref outside the lock; it may be the last one.
+        triangulation = nullptr;
+        lock.lock();
+        m_busy = false;
+        if (m_queue.empty())
+        {
+            m_idle.notify_all();
+        }
+    }
+}
 
 RiveRenderPath::RiveRenderPath(FillRule fillRule, RawPath& rawPath)
 {
@@ -22,6 +145,7 @@ void RiveRenderPath::rewind()
     assert(m_rawPathMutationLockCount == 0);
     m_rawPath.rewind();
     m_dirt = kAllDirt;
+    m_interiorTriangulation = nullptr;
 }
 
 void RiveRenderPath::moveTo(float x, float y)
@@ -72,6 +196,17 @@ void RiveRenderPath::close()
     m_dirt = kAllDirt;
 }
 
+void RiveRenderPath::copy(const RawPath& rawPath)
+{
+    assert(m_rawPathMutationLockCount == 0);
+    // Reuses m_rawPath's storage, and skips the per-verb virtual calls.
+    m_rawPath = rawPath;
+    // Match what moveTo/lineTo/cubicTo would have done with the same verbs.
+    m_rawPath.pruneEmptySegments();
+    m_dirt = kAllDirt;
+    m_interiorTriangulation = nullptr;
+}
+
 void RiveRenderPath::addRenderPath(RenderPath* path, const Mat2D& matrix)
 {
     assert(m_rawPathMutationLockCount == 0);
@@ -165,6 +300,56 @@ uint64_t RiveRenderPath::getRawPathMutationID() const
     return m_rawPathMutationID;
 }
 
+InteriorTriangulation* RiveRenderPath::refInteriorTriangulation(
+    const RawPath& linearizedPath,
+    FillRule fillRule,
+    InteriorTriangulation::TriangulatorAxis axis,
+    InteriorTriangulationWorker* asyncWorker) const
+{
+    uint64_t mutationID = getRawPathMutationID();
+    if (mutationID == m_overBudgetMutationID)
+    {
+        return nullptr;
+    }
+    if (m_interiorTriangulation != nullptr &&
+        m_interiorTriangulation->matches(linearizedPath, mutationID, fillRule, axis))
+    {
+        if (m_interiorTriangulation->isReady())
+        {
+            // Triangulations built in the background get charged once they're first used.
+            if (!m_interiorTriangulation->reserveCacheBudget())
+            {
+                m_overBudgetMutationID = mutationID;
+                return m_interiorTriangulation.release();
+            }
+            return safe_ref(m_interiorTriangulation.get());
+        }
+        if (asyncWorker != nullptr)
+        {
+            return nullptr; // Still in progress.
+        }
+    }
+
+    auto triangulation =
+        make_rcp<InteriorTriangulation>(linearizedPath, mutationID, fillRule, axis);
+    // Drop the stale triangulation first so its bytes are back in the budget.
+    m_interiorTriangulation = nullptr;
+    if (asyncWorker != nullptr)
+    {
+        asyncWorker->submit(triangulation);
+        m_interiorTriangulation = std::move(triangulation);
+        return nullptr;
+    }
+    triangulation->triangulate();
+    if (!triangulation->reserveCacheBudget())
+    {
+        m_overBudgetMutationID = mutationID;
+        return triangulation.release();
+    }
+    m_interiorTriangulation = std::move(triangulation);
+    return safe_ref(m_interiorTriangulation.get());
+}
+
 void RiveRenderPath::setDrawCache(gpu::RiveRenderPathDraw* drawCache,
                                   const Mat2D& mat,
                                   rive::RiveRenderPaint* riveRenderPaint) const
@@ -10,8 +10,107 @@
 #include "rive_render_paint.hpp"
 #include "../renderer/src/rive_render_path.hpp"
 
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+
 namespace rive
 {
+// Interior triangulation of a path that outlives the frame it was built in. The inner fan polygons
+// are in path space, so any later draw of the same linearized path can re-emit them instead of
+// running the sweep-line triangulator again; only the triangle winding depends on the view matrix,
+// and that gets picked when the triangles are emitted.
+class InteriorTriangulation : public RefCnt<InteriorTriangulation>
+{
+public:
+    using TriangulatorAxis = gpu::RiveRenderPathDraw::TriangulatorAxis;
+
+    // Captures the linearized path. The sweep doesn't run until triangulate().
+    InteriorTriangulation(const RawPath& linearizedPath,
+                          uint64_t rawPathMutationID,
+                          FillRule,
+                          TriangulatorAxis);
+    ~InteriorTriangulation();
+
+    // Runs the triangulator. Only touches this object, so it may be called from a worker thread.
+    void triangulate();
+    bool isReady() const { return m_isReady.load(std::memory_order_acquire); }
+
+    // Can this triangulation be used for the given linearization of a path? Curves get subdivided
+    // based on the view matrix, so a draw may linearize the same raw path differently.
+    bool matches(const RawPath& linearizedPath,
+                 uint64_t rawPathMutationID,
+                 FillRule fillRule,
+                 TriangulatorAxis axis) const
+    {
+        return m_rawPathMutationID == rawPathMutationID && m_fillRule == fillRule &&
+               m_axis == axis && m_linearizedPath == linearizedPath;
+    }
+
+    // Is this triangulation still being built for the given path contents? (Unlike matches(), this
+    // doesn't need the linearized path.)
+    bool isPendingFor(uint64_t rawPathMutationID, FillRule fillRule, TriangulatorAxis axis) const
+    {
+        return !isReady() && m_rawPathMutationID == rawPathMutationID && m_fillRule == fillRule &&
+               m_axis == axis;
+    }
+
+    GrInnerFanTriangulator* triangulator() const
+    {
+        assert(isReady());
+        return m_triangulator;
+    }
+
+    // Approximate memory held by this triangulation.
+    size_t sizeInBytes() const;
+
+    // Paths only hold on to their triangulations while the total across all paths stays within
+    // this budget. Draws that don't fit still use their triangulation for the frame.
+    constexpr static size_t kCacheBudgetInBytes = 32 * 1024 * 1024;
+    static size_t TotalCachedBytes();
+
+    // Charges this triangulation against the cache budget, if it fits. (Returns true without
+    // charging again if it has already been charged.)
+    bool reserveCacheBudget();
+
+private:
+    const RawPath m_linearizedPath;
+    const uint64_t m_rawPathMutationID;
+    const FillRule m_fillRule;
+    const TriangulatorAxis m_axis;
+    TrivialBlockAllocator m_allocator;
+    GrInnerFanTriangulator* m_triangulator = nullptr;
+    std::atomic<bool> m_isReady = false;
+    size_t m_cachedBytes = 0;
+};
+
+// Runs InteriorTriangulation::triangulate() on a background thread, in submission order.
+class InteriorTriangulationWorker
+{
+public:
+    InteriorTriangulationWorker();
+    // Drops queued work and waits for the triangulation in progress (if any) to finish.
+    ~InteriorTriangulationWorker();
+
+    void submit(rcp<InteriorTriangulation>);
+
+    // Blocks until every submitted triangulation is ready.
+    void waitUntilIdle();
+
+private:
+    void run();
+
+    std::mutex m_mutex;
+    std::condition_variable m_workAvailable;
+    std::condition_variable m_idle;
+    std::deque<rcp<InteriorTriangulation>> m_queue;
+    bool m_busy = false;
+    bool m_shutdown = false;
+    std::thread m_thread;
+};
+
 // RenderPath implementation for Rive's pixel local storage renderer.
 class RiveRenderPath : public lite_rtti_override<RenderPath, RiveRenderPath>
 {
@@ -40,6 +139,7 @@ public:
     void lineTo(float x, float y) override;
     void cubicTo(float ox, float oy, float ix, float iy, float x, float y) override;
     void close() override;
+    void copy(const RawPath& rawPath) override;
 
     void addPath(CommandPath* p, const Mat2D& m) override { addRenderPath(p->renderPath(), m); }
     void addRenderPath(RenderPath* path, const Mat2D& matrix) override;
@@ -54,6 +154,36 @@ public:
     float getCoarseArea() const;
     uint64_t getRawPathMutationID() const;
 
+    // Returns an interior triangulation for linearizedPath (the path as linearized by a draw),
+    // reusing the one from a previous frame if it matches. The returned object carries a ref that
+    // belongs to the caller.
+    //
+    // If asyncWorker is non-null, a triangulation that isn't ready yet gets built on the worker
+    // instead, and this method returns null until it finishes.
+    //
+    // A triangulation that doesn't fit in the cache budget still gets returned once, but then this
+    // method returns null (and the path draws as a midpoint fan) until the path changes.
+    InteriorTriangulation* refInteriorTriangulation(
+        const RawPath& linearizedPath,
+        FillRule,
+        InteriorTriangulation::TriangulatorAxis,
+        InteriorTriangulationWorker* asyncWorker = nullptr) const;
+
+    // Returns true if the path's current triangulation didn't fit in the cache budget.
+    bool isInteriorTriangulationOverBudget() const
+    {
+        return m_overBudgetMutationID == getRawPathMutationID();
+    }
+
+    // Returns true if a triangulation of the path's current contents is still being built in the
+    // background, so draws can skip straight to a midpoint fan without linearizing the path.
+    bool isInteriorTriangulationPending(FillRule fillRule,
+                                        InteriorTriangulation::TriangulatorAxis axis) const
+    {
+        return m_interiorTriangulation != nullptr &&
+               m_interiorTriangulation->isPendingFor(getRawPathMutationID(), fillRule, axis);
+    }
+
 #ifdef DEBUG
     // Allows ref holders to guarantee the rawPath doesn't mutate during a specific time.
     void lockRawPathMutations() const { ++m_rawPathMutationLockCount; }
@@ -101,6 +231,12 @@ public:
                                     TrivialBlockAllocator* allocator,
                                     gpu::InterlockMode interlockMode) const;
 
+    // Midpoint fan segment counts from earlier frames, which persist while the path is unchanged.
+    std::unique_ptr<gpu::RiveRenderPathDraw::TessCounts>& tessCounts(bool isStroked) const
+    {
+        return m_tessCounts[isStroked ? CACHE_STROKED : CACHE_FILLED];
+    }
+
 private:
     enum
     {
@@ -120,5 +256,11 @@ private:
     mutable float m_cachedThickness;
     mutable StrokeJoin m_cachedJoin;
     mutable StrokeCap m_cachedCap;
+
+    // Persists across frames, unlike the draw caches above.
+    mutable rcp<InteriorTriangulation> m_interiorTriangulation;
+    // Mutation ID of the raw path when its triangulation last went over the cache budget.
+    mutable uint64_t m_overBudgetMutationID = 0;
+    mutable std::unique_ptr<gpu::RiveRenderPathDraw::TessCounts> m_tessCounts[NUM_CACHES];
 };
 } // namespace rive
@@ -92,6 +92,7 @@ void RiveRenderer::save()
 void RiveRenderer::restore()
 {
     assert(m_stack.size() > 1);
+    assert(m_stack.size() > m_layerStackHeight); // Use endLayer() to leave a layer.
     assert(m_stack.back().clipStackHeight >= m_stack[m_stack.size() - 2].clipStackHeight);
     m_stack.pop_back();
 }
@@ -287,6 +288,11 @@ void RiveRenderer::clipPathImpl(const RiveRenderPath* path)
 void RiveRenderer::drawImage(const RenderImage* renderImage, BlendMode blendMode, float opacity)
 {
     LITE_RTTI_CAST_OR_RETURN(image, const RiveRenderImage*, renderImage);
+    rcp<gpu::Texture> texture = m_context->refImageTexture(image);
+    if (texture == nullptr)
+    {
+        return;
+    }
 
     // Scale the view matrix so we can draw this image as the rect [0, 0, 1, 1].
     save();
@@ -299,14 +305,15 @@ void RiveRenderer::drawImage(const RenderImage* renderImage, BlendMode blendMode
         if (!m_stack.back().clipIsEmpty)
         {
             const Mat2D& m = m_stack.back().matrix;
-            auto riveRenderImage = static_cast<const RiveRenderImage*>(renderImage);
             clipAndPushDraw(gpu::DrawUniquePtr(
                 m_context->make<gpu::ImageRectDraw>(m_context,
                                                     m.mapBoundingBox(AABB{0, 0, 1, 1}).roundOut(),
                                                     m,
                                                     blendMode,
-                                                    riveRenderImage->refTexture(),
-                                                    opacity)));
+                                                    std::move(texture),
+                                                    image->uvTransform(),
+                                                    opacity,
+                                                    image->isPremultiplied())));
         }
     }
     else
@@ -321,7 +328,7 @@ void RiveRenderer::drawImage(const RenderImage* renderImage, BlendMode blendMode
         }
 
         RiveRenderPaint paint;
-        paint.image(image->refTexture(), opacity);
+        paint.image(std::move(texture), opacity, image->uvTransform(), image->isPremultiplied());
         paint.blendMode(blendMode);
         drawPath(m_unitRectPath.get(), &paint);
     }
@@ -339,7 +346,6 @@ void RiveRenderer::drawImageMesh(const RenderImage* renderImage,
                                  float opacity)
 {
     LITE_RTTI_CAST_OR_RETURN(image, const RiveRenderImage*, renderImage);
-    const gpu::Texture* texture = image->getTexture();
 
     assert(vertices_f32);
     assert(uvCoords_f32);
@@ -350,11 +356,17 @@ void RiveRenderer::drawImageMesh(const RenderImage* renderImage,
         return;
     }
 
+    rcp<gpu::Texture> texture = m_context->refImageTexture(image);
+    if (texture == nullptr)
+    {
+        return;
+    }
+
     clipAndPushDraw(
         gpu::DrawUniquePtr(m_context->make<gpu::ImageMeshDraw>(gpu::Draw::kFullscreenPixelBounds,
                                                                m_stack.back().matrix,
                                                                blendMode,
-                                                               ref_rcp(texture),
+                                                               std::move(texture),
                                                                std::move(vertices_f32),
                                                                std::move(uvCoords_f32),
                                                                std::move(indices_u16),
@@ -362,6 +374,115 @@ void RiveRenderer::drawImageMesh(const RenderImage* renderImage,
                                                                opacity)));
 }
 
+namespace
+{
+class RiveRenderLayer : public lite_rtti_override<RenderLayer, RiveRenderLayer>
+{
+public:
+    RiveRenderLayer(const AABB& bounds,
+                    const Mat2D& matrix,
+                    Vec2D origin,
+                    rcp<RiveRenderImage> image) :
+        lite_rtti_override(bounds, static_cast<size_t>(image->width()) * image->height() * 4),
+        m_matrix(matrix),
+        m_origin(origin),
+        m_image(std::move(image))
+    {}
+
+    // View matrix that the layer's content was drawn with.
+    const Mat2D& matrix() const { return m_matrix; }
+
+    // Pixel location of the layer's top-left corner, when its content was drawn.
+    Vec2D origin() const { return m_origin; }
+
+    const RiveRenderImage* image() const { return m_image.get(); }
+
+private:
+    Mat2D m_matrix;
+    Vec2D m_origin;
+    rcp<RiveRenderImage> m_image;
+};
+} // namespace
+
+rcp<RenderLayer> RiveRenderer::beginLayer(const AABB& bounds)
+{
+    if (m_layerStackHeight != 0)
+    {
+        return nullptr; // Layers don't nest.
+    }
+
+    // Layers larger than the frame are too expensive to be worth keeping.
+    const Mat2D& matrix = m_stack.back().matrix;
+    IAABB pixelBounds = matrix.mapBoundingBox(bounds).roundOut();
+    const gpu::RenderContext::FrameDescriptor& frameDescriptor = m_context->frameDescriptor();
+    if (bounds.isEmptyOrNaN() || pixelBounds.empty() ||
+        static_cast<uint32_t>(pixelBounds.width()) > frameDescriptor.renderTargetWidth ||
+        static_cast<uint32_t>(pixelBounds.height()) > frameDescriptor.renderTargetHeight)
+    {
+        return nullptr;
+    }
+
+    rcp<RiveRenderImage> image =
+        m_context->beginLayer(pixelBounds.width(), pixelBounds.height());
+    if (image == nullptr)
+    {
+        return nullptr;
+    }
+
+    Vec2D origin(static_cast<float>(pixelBounds.left), static_cast<float>(pixelBounds.top));
+    auto layer = make_rcp<RiveRenderLayer>(bounds, matrix, origin, std::move(image));
+
+    // Draw into the layer from a clean state, offset so its top-left corner lands at 0,0.
+    RenderState layerState;
+    layerState.matrix = Mat2D::fromTranslate(-origin.x, -origin.y) * matrix;
+    m_stack.push_back(layerState);
+    m_layerStackHeight = m_stack.size();
+    assert(m_clipStackOutsideLayer.empty());
+    std::swap(m_clipStack, m_clipStackOutsideLayer);
+    return layer;
+}
+
+void RiveRenderer::endLayer()
+{
+    assert(m_layerStackHeight != 0);
+    assert(m_stack.size() == m_layerStackHeight); // save() and restore() calls must match.
+    m_stack.pop_back();
+    m_layerStackHeight = 0;
+    std::swap(m_clipStack, m_clipStackOutsideLayer);
+    m_clipStackOutsideLayer.clear();
+    m_context->endLayer();
+}
+
+bool RiveRenderer::drawLayer(const RenderLayer* renderLayer, float scaleTolerance)
+{
+    auto layer = lite_rtti_cast<const RiveRenderLayer*>(renderLayer);
+    if (layer == nullptr)
+    {
+        return false;
+    }
+
+    // Find how the layer's pixels would map to pixels now, and check that it doesn't stretch them
+    // (or shrink them) too much.
+    Mat2D inverseLayerMatrix;
+    if (!layer->matrix().invert(&inverseLayerMatrix))
+    {
+        return false;
+    }
+    Mat2D layerToCurrent = m_stack.back().matrix * inverseLayerMatrix;
+    float scaleX = Vec2D(layerToCurrent.xx(), layerToCurrent.xy()).length();
+    float scaleY = Vec2D(layerToCurrent.yx(), layerToCurrent.yy()).length();
+    if (!(fabsf(scaleX - 1) <= scaleTolerance && fabsf(scaleY - 1) <= scaleTolerance))
+    {
+        return false;
+    }
+
+    save();
+    transform(inverseLayerMatrix * Mat2D::fromTranslate(layer->origin().x, layer->origin().y));
+    drawImage(layer->image(), BlendMode::srcOver, 1);
+    restore();
+    return true;
+}
+
 void RiveRenderer::clipAndPushDraw(gpu::DrawUniquePtr draw)
 {
     assert(!m_stack.back().clipIsEmpty);
@@ -147,7 +147,8 @@ IMAGE_RECT_VERTEX_MAIN(@drawVertexMain, Attrs, attrs, _vertexID, _instanceID)
         }
     }
 
-    v_texCoord = vertexPosition;
+    v_texCoord = MUL(make_float2x2(imageDrawUniforms.texCoordMatrix), vertexPosition) +
+                 imageDrawUniforms.texCoordTranslate;
     vertexPosition = MUL(M, vertexPosition) + imageDrawUniforms.translate;
 
     if (isOuterVertex)
@@ -574,6 +575,8 @@ ATOMIC_PLS_MAIN_WITH_IMAGE_UNIFORMS(@drawFragmentMain)
     // and furthermore in the case of imageMeshes, we can't calculate UV coordinates based on
     // fragment position.
     half4 imageColor = TEXTURE_SAMPLE(@imageTexture, imageSampler, v_texCoord);
+    imageColor = unmultiply_if_premultiplied(imageColor,
+                                             imageDrawUniforms.imageIsPremultiplied != 0u);
     half meshCoverage = 1.;
 #ifdef @DRAW_IMAGE_RECT
     meshCoverage = min(v_edgeCoverage, meshCoverage);
@@ -127,6 +127,14 @@ INLINE half4 unmultiply(half4 color)
     return color;
 }
 
+// Paint colors are unpremultiplied until they're blended (coverage and opacity only scale alpha).
+// Images that were rendered with premultiplied alpha get unmultiplied as they're sampled, so the
+// premultiply() at blend time doesn't apply alpha to them a second time.
+INLINE half4 unmultiply_if_premultiplied(half4 imageColor, bool isPremultiplied)
+{
+    return isPremultiplied ? unmultiply(imageColor) : imageColor;
+}
+
 INLINE half min_value(half4 min4)
 {
     half2 min2 = min(min4.xy, min4.zw);
@@ -233,6 +241,12 @@ float2 clipRectInverseTranslate;
 uint clipID;
 uint blendMode;
 uint zIndex;
+// Nonzero if the image texture's colors are already multiplied by alpha (e.g., offscreen layers).
+uint imageIsPremultiplied;
+// texCoordMatrix maps the unit image rect to texture coordinates. (Images packed into an atlas
+// only occupy a sub-rect of their texture.)
+float4 texCoordMatrix;
+float2 texCoordTranslate;
 UNIFORM_BLOCK_END(imageDrawUniforms)
 #endif
 #endif
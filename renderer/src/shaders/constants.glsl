@@ -67,6 +67,7 @@
 // Paint flags, found in the x-component value of @paintBuffer.
 #define PAINT_FLAG_EVEN_ODD 0x100u
 #define PAINT_FLAG_HAS_CLIP_RECT 0x200u
+#define PAINT_FLAG_PREMULTIPLIED_IMAGE 0x400u
 
 // PLS draw resources are either updated per flush or per draw. They go into set 0
 // or set 1, depending on how often they are updated.
@@ -116,6 +116,7 @@ PLS_MAIN_WITH_IMAGE_UNIFORMS(@drawFragmentMain)
 #endif
 
     half4 color = TEXTURE_SAMPLE(@imageTexture, imageSampler, v_texCoord);
+    color = unmultiply_if_premultiplied(color, imageDrawUniforms.imageIsPremultiplied != 0u);
     half coverage = 1.;
 
 #ifdef @ENABLE_CLIP_RECT
@@ -172,6 +173,7 @@ FRAG_DATA_MAIN(half4, @drawFragmentMain)
     VARYING_UNPACK(v_texCoord, float2);
 
     half4 color = TEXTURE_SAMPLE(@imageTexture, imageSampler, v_texCoord);
+    color = unmultiply_if_premultiplied(color, imageDrawUniforms.imageIsPremultiplied != 0u);
     color.a *= imageDrawUniforms.opacity;
 
 #ifdef @ENABLE_ADVANCED_BLEND
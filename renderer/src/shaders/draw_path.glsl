@@ -200,9 +200,13 @@ VERTEX_MAIN(@drawVertexMain, Attrs, attrs, _vertexID, _instanceID)
         {
             // v_paint.a <= -1. signals that the paint is an image.
             // -v_paint.a - 2 is the texture mipmap level-of-detail.
-            // v_paint.b is the image opacity.
+            // v_paint.b is the image opacity, or -1 - opacity if the image is premultiplied.
             // v_paint.rg is the normalized image texture coordinate (built into the paintMatrix).
             float opacity = uintBitsToFloat(paintData.y);
+            if ((paintData.x & PAINT_FLAG_PREMULTIPLIED_IMAGE) != 0u)
+            {
+                opacity = -1. - opacity;
+            }
             float lod = paintTranslate.z;
             v_paint = float4(paintCoord.x, paintCoord.y, opacity, -2. - lod);
         }
@@ -286,7 +290,9 @@ INLINE half4 find_paint_color(float4 paint FRAGMENT_CONTEXT_DECL)
     {
         half lod = -paint.a - 2.;
         half4 color = TEXTURE_SAMPLE_LOD(@imageTexture, imageSampler, paint.rg, lod);
-        half opacity = paint.b;
+        bool isPremultiplied = paint.b < .0;
+        color = unmultiply_if_premultiplied(color, isPremultiplied);
+        half opacity = isPremultiplied ? -1. - paint.b : paint.b;
         color.a *= opacity;
         return color;
     }
@@ -0,0 +1,206 @@
+/*
+ * Copyright 2024 Rive
+ */
+
+#include "texture_residency_manager.hpp"
+
+#include "rive/renderer/render_context_impl.hpp"
+
+namespace rive::gpu
+{
+ImageResidency::ImageResidency(TextureResidencyManager* manager,
+                               RiveRenderImage* image,
+                               std::vector<uint8_t> encodedBytes) :
+    m_manager(manager), m_image(image), m_encodedBytes(std::move(encodedBytes))
+{
+    m_manager->pushFront(this);
+    ++m_manager->m_imageCount;
+}
+
+ImageResidency::~ImageResidency()
+{
+    if (m_manager != nullptr)
+    {
+        m_manager->m_residentBytes -= m_textureBytes;
+        m_manager->unlink(this);
+        --m_manager->m_imageCount;
+    }
+}
+
+TextureResidencyManager::~TextureResidencyManager()
+{
+    // The images may outlive us. They keep whatever texture they have.
+    for (ImageResidency* residency = m_head; residency != nullptr; residency = residency->m_next)
+    {
+        residency->m_manager = nullptr;
+    }
+}
+
+// Dimension to decode a downscaled texture at, or 0 if the image is too small to downscale.
+static uint32_t downscaled_dimension(const RiveRenderImage* image)
+{
+    uint32_t maxDimension = std::max(image->width(), image->height());
+    return maxDimension / TextureResidencyManager::kDownscaleFactor;
+}
+
+rcp<RiveRenderImage> TextureResidencyManager::decodeImage(Span<const uint8_t> encodedBytes,
+                                                          uint64_t frameNumber)
+{
+    rcp<Texture> texture = m_impl->decodeImageTexture(encodedBytes, 0);
+    if (texture == nullptr)
+    {
+        return nullptr;
+    }
+    return makeImage(std::move(texture), encodedBytes, frameNumber);
+}
+
+rcp<RiveRenderImage> TextureResidencyManager::makeImage(rcp<Texture> texture,
+                                                        Span<const uint8_t> encodedBytes,
+                                                        uint64_t frameNumber)
+{
+    assert(texture != nullptr);
+    auto image = make_rcp<RiveRenderImage>(texture);
+    image->m_residency = std::make_unique<ImageResidency>(
+        this,
+        image.get(),
+        std::vector<uint8_t>(encodedBytes.begin(), encodedBytes.end()));
+    ImageResidency* residency = image->m_residency.get();
+    residency->m_lastUsedFrame = frameNumber;
+    residency->m_fullSizeTextureBytes = TextureSizeInBytes(texture.get());
+    setTexture(residency, std::move(texture), false);
+    return image;
+}
+
+rcp<Texture> TextureResidencyManager::refTexture(ImageResidency* residency, uint64_t frameNumber)
+{
+    assert(residency->m_manager == this);
+    residency->m_lastUsedFrame = frameNumber;
+    if (residency != m_head)
+    {
+        unlink(residency);
+        pushFront(residency);
+    }
+
+    RiveRenderImage* image = residency->m_image;
+    bool isReleased = image->getTexture() == nullptr;
+    if (isReleased || residency->m_isDownscaled)
+    {
+        bool fullSizeFits = m_budget == 0 || m_residentBytes - residency->m_textureBytes +
+                                                     residency->m_fullSizeTextureBytes <=
+                                                 m_budget;
+        if (isReleased || fullSizeFits)
+        {
+            uint32_t maxDimension = fullSizeFits ? 0 : downscaled_dimension(image);
+            rcp<Texture> texture =
+                m_impl->decodeImageTexture(Span<const uint8_t>(residency->m_encodedBytes.data(),
+                                                               residency->m_encodedBytes.size()),
+                                           maxDimension);
+            if (texture != nullptr)
+            {
+                bool isDownscaled = static_cast<int>(texture->width()) < image->width() ||
+                                    static_cast<int>(texture->height()) < image->height();
+                setTexture(residency, std::move(texture), isDownscaled);
+            }
+        }
+    }
+    return image->refTexture();
+}
+
+void TextureResidencyManager::evict(uint64_t currentFrameNumber)
+{
+    if (m_budget == 0)
+    {
+        return;
+    }
+
+    // The list is ordered by last use, so once we reach an image that was drawn this frame, every
+    // image in front of it was too.
+    auto isEvictable = [currentFrameNumber](const ImageResidency* residency) {
+        return residency != nullptr && residency->m_lastUsedFrame != currentFrameNumber;
+    };
+
+    // Downscale first, so images that come back get drawn at reduced resolution instead of
+    // stalling on a full decode.
+    for (ImageResidency* residency = m_tail; m_residentBytes > m_budget && isEvictable(residency);
+         residency = residency->m_prev)
+    {
+        if (residency->m_textureBytes == 0 || residency->m_isDownscaled)
+        {
+            continue;
+        }
+        uint32_t maxDimension = downscaled_dimension(residency->m_image);
+        if (maxDimension == 0)
+        {
+            continue;
+        }
+        rcp<Texture> texture =
+            m_impl->decodeImageTexture(Span<const uint8_t>(residency->m_encodedBytes.data(),
+                                                           residency->m_encodedBytes.size()),
+                                       maxDimension);
+        // Not every format can decode at a reduced size.
+        if (texture != nullptr && TextureSizeInBytes(texture.get()) < residency->m_textureBytes)
+        {
+            setTexture(residency, std::move(texture), true);
+        }
+    }
+
+    // Then release.
+    for (ImageResidency* residency = m_tail; m_residentBytes > m_budget && isEvictable(residency);
+         residency = residency->m_prev)
+    {
+        if (residency->m_textureBytes != 0)
+        {
+            setTexture(residency, nullptr, false);
+        }
+    }
+}
+
+size_t TextureResidencyManager::TextureSizeInBytes(const Texture* texture)
+{
+    if (texture == nullptr)
+    {
+        return 0;
+    }
+    size_t width = texture->width();
+    size_t height = texture->height();
+    size_t topLevelBytes = texture->format() == ImageTextureFormat::rgba8
+                               ? width * height * 4
+                               : (width + 3) / 4 * ((height + 3) / 4) * 16;
+    // A full mip chain adds another third.
+    return topLevelBytes * 4 / 3;
+}
+
+void TextureResidencyManager::pushFront(ImageResidency* residency)
+{
+    assert(residency->m_prev == nullptr);
+    assert(residency->m_next == nullptr);
+    residency->m_next = m_head;
+    if (m_head != nullptr)
+    {
+        m_head->m_prev = residency;
+    }
+    else
+    {
+        m_tail = residency;
+    }
+    m_head = residency;
+}
+
+void TextureResidencyManager::unlink(ImageResidency* residency)
+{
+    (residency->m_prev != nullptr ? residency->m_prev->m_next : m_head) = residency->m_next;
+    (residency->m_next != nullptr ? residency->m_next->m_prev : m_tail) = residency->m_prev;
+    residency->m_prev = residency->m_next = nullptr;
+}
+
+void TextureResidencyManager::setTexture(ImageResidency* residency,
+                                         rcp<Texture> texture,
+                                         bool isDownscaled)
+{
+    m_residentBytes -= residency->m_textureBytes;
+    residency->m_textureBytes = TextureSizeInBytes(texture.get());
+    m_residentBytes += residency->m_textureBytes;
+    residency->m_isDownscaled = isDownscaled;
+    residency->m_image->resetTexture(std::move(texture));
+}
+} // namespace rive::gpu
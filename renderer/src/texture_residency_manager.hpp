@@ -0,0 +1,105 @@
+/*
+ * Copyright 2024 Rive
+ */
+
+#pragma once
+
+#include "rive/renderer/rive_render_image.hpp"
+#include "rive/span.hpp"
+#include <vector>
+
+namespace rive::gpu
+{
+class RenderContextImpl;
+class TextureResidencyManager;
+
+// Residency state for an image whose texture counts against a TextureResidencyManager's budget.
+// Owned by the RiveRenderImage. Holds on to the encoded bytes so the texture can be decoded again
+// after it gets evicted.
+class ImageResidency
+{
+public:
+    ImageResidency(TextureResidencyManager*, RiveRenderImage*, std::vector<uint8_t> encodedBytes);
+    ~ImageResidency();
+
+    TextureResidencyManager* manager() const { return m_manager; }
+
+    // Estimated GPU memory of the image's current texture.
+    size_t textureBytes() const { return m_textureBytes; }
+    bool isDownscaled() const { return m_isDownscaled; }
+    uint64_t lastUsedFrame() const { return m_lastUsedFrame; }
+
+private:
+    friend class TextureResidencyManager;
+
+    TextureResidencyManager* m_manager; // Null once the manager has been destroyed.
+    RiveRenderImage* const m_image;
+    const std::vector<uint8_t> m_encodedBytes;
+    size_t m_textureBytes = 0;
+    size_t m_fullSizeTextureBytes = 0;
+    uint64_t m_lastUsedFrame = 0;
+    bool m_isDownscaled = false;
+
+    // LRU list links.
+    ImageResidency* m_prev = nullptr; // More recently used.
+    ImageResidency* m_next = nullptr; // Less recently used.
+};
+
+// Keeps the textures of images from RenderContext::decodeImage() within a memory budget.
+//
+// Images are kept in least-recently-drawn order. When the budget is exceeded, cold textures are
+// first replaced with a downscaled decode, and then released outright. The next time an evicted
+// image gets drawn, its texture is decoded again from the retained encoded bytes.
+class TextureResidencyManager
+{
+public:
+    // Textures get downscaled by this factor in each dimension before they get released.
+    constexpr static uint32_t kDownscaleFactor = 4;
+
+    TextureResidencyManager(RenderContextImpl* impl) : m_impl(impl) {}
+    ~TextureResidencyManager();
+
+    // Zero disables eviction.
+    void setBudget(size_t budgetInBytes) { m_budget = budgetInBytes; }
+    size_t budget() const { return m_budget; }
+
+    // Estimated GPU memory of every texture that counts against the budget.
+    size_t residentBytes() const { return m_residentBytes; }
+    size_t imageCount() const { return m_imageCount; }
+
+    // Decodes an image that is tracked by this manager.
+    rcp<RiveRenderImage> decodeImage(Span<const uint8_t> encodedBytes, uint64_t frameNumber);
+
+    // Makes an image that is tracked by this manager from a texture that was already decoded from
+    // 'encodedBytes'.
+    rcp<RiveRenderImage> makeImage(rcp<Texture>,
+                                   Span<const uint8_t> encodedBytes,
+                                   uint64_t frameNumber);
+
+    // Marks the image as used by the given frame and returns the texture to draw it with. Released
+    // textures are decoded again. Downscaled textures are decoded again at full size if that fits
+    // in the budget, and otherwise stay downscaled.
+    rcp<Texture> refTexture(ImageResidency*, uint64_t frameNumber);
+
+    // Downscales, and then releases, the least recently used textures until the resident bytes fit
+    // within the budget. Textures drawn during 'currentFrameNumber' are never evicted.
+    void evict(uint64_t currentFrameNumber);
+
+    // Estimated GPU memory of a texture, including its mipmaps.
+    static size_t TextureSizeInBytes(const Texture*);
+
+private:
+    friend class ImageResidency;
+
+    void pushFront(ImageResidency*);
+    void unlink(ImageResidency*);
+    void setTexture(ImageResidency*, rcp<Texture>, bool isDownscaled);
+
+    RenderContextImpl* const m_impl;
+    size_t m_budget = 0;
+    size_t m_residentBytes = 0;
+    size_t m_imageCount = 0;
+    ImageResidency* m_head = nullptr; // Most recently used.
+    ImageResidency* m_tail = nullptr; // Least recently used.
+};
+} // namespace rive::gpu
@@ -8,6 +8,8 @@
 #include "rive/renderer/rive_render_buffer.hpp"
 #include "shaders/constants.glsl"
 
+#include <numeric>
+
 namespace spirv
 {
 #include "generated/shaders/spirv/color_ramp.vert.h"
@@ -39,10 +41,6 @@ namespace spirv
 #include "generated/shaders/spirv/atomic_resolve_pls.fixedblend_frag.h"
 }; // namespace spirv
 
-#ifdef RIVE_DECODERS
-#include "rive/decoders/bitmap_decoder.hpp"
-#endif
-
 namespace rive::gpu
 {
 static VkBufferUsageFlagBits render_buffer_usage_flags(RenderBufferType renderBufferType)
@@ -98,6 +96,22 @@ rcp<RenderBuffer> RenderContextVulkanImpl::makeRenderBuffer(RenderBufferType typ
     return make_rcp<RenderBufferVulkanImpl>(m_vk, type, flags, sizeInBytes);
 }
 
+static VkFormat vk_image_texture_format(ImageTextureFormat format)
+{
+    switch (format)
+    {
+        case ImageTextureFormat::rgba8:
+            return VK_FORMAT_R8G8B8A8_UNORM;
+        case ImageTextureFormat::etc2:
+            return VK_FORMAT_ETC2_R8G8B8A8_UNORM_BLOCK;
+        case ImageTextureFormat::astc4x4:
+            return VK_FORMAT_ASTC_4x4_UNORM_BLOCK;
+        case ImageTextureFormat::bc7:
+            return VK_FORMAT_BC7_UNORM_BLOCK;
+    }
+    RIVE_UNREACHABLE();
+}
+
 class TextureVulkanImpl : public Texture
 {
 public:
@@ -106,24 +120,43 @@ public:
                       uint32_t height,
                       uint32_t mipLevelCount,
                       const uint8_t imageDataRGBA[]) :
-        Texture(width, height),
-        m_vk(std::move(vk)),
-        m_texture(m_vk->makeTexture({
-            .format = VK_FORMAT_R8G8B8A8_UNORM,
-            .extent = {width, height, 1},
-            .mipLevels = mipLevelCount,
-            .usage = VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT,
-        })),
-        m_textureView(m_vk->makeTextureView(m_texture)),
-        m_imageUploadBuffer(m_vk->makeBuffer(
-            {
-                .size = height * width * 4,
-                .usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-            },
-            vkutil::Mappability::writeOnly))
+        TextureVulkanImpl(std::move(vk),
+                          width,
+                          height,
+                          ImageTextureFormat::rgba8,
+                          mipLevelCount,
+                          height * width * 4)
     {
         memcpy(m_imageUploadBuffer->contents(), imageDataRGBA, m_imageUploadBuffer->info().size);
         m_imageUploadBuffer->flushContents();
+        m_levelUploadOffsets.push_back(0);
+    }
+
+    // Block-compressed images can't be blitted into mipmaps, so every level comes from the file.
+    TextureVulkanImpl(rcp<VulkanContext> vk,
+                      uint32_t width,
+                      uint32_t height,
+                      ImageTextureFormat format,
+                      uint32_t mipLevelCount,
+                      const uint8_t* const levelData[],
+                      const size_t levelSizesInBytes[]) :
+        TextureVulkanImpl(
+            std::move(vk),
+            width,
+            height,
+            format,
+            mipLevelCount,
+            std::accumulate(levelSizesInBytes, levelSizesInBytes + mipLevelCount, size_t(0)))
+    {
+        auto contents = reinterpret_cast<uint8_t*>(m_imageUploadBuffer->contents());
+        VkDeviceSize offset = 0;
+        for (uint32_t level = 0; level < mipLevelCount; ++level)
+        {
+            memcpy(contents + offset, levelData[level], levelSizesInBytes[level]);
+            m_levelUploadOffsets.push_back(offset);
+            offset += levelSizesInBytes[level];
+        }
+        m_imageUploadBuffer->flushContents();
     }
 
     bool hasUpdates() const { return m_imageUploadBuffer != nullptr; }
@@ -133,14 +166,23 @@ public:
         assert(hasUpdates());
 
         // Upload the new image.
-        VkBufferImageCopy bufferImageCopy = {
-            .imageSubresource =
-                {
-                    .aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
-                    .layerCount = 1,
-                },
-            .imageExtent = {width(), height(), 1},
-        };
+        uint32_t uploadLevelCount = static_cast<uint32_t>(m_levelUploadOffsets.size());
+        std::vector<VkBufferImageCopy> bufferImageCopies(uploadLevelCount);
+        for (uint32_t level = 0; level < uploadLevelCount; ++level)
+        {
+            bufferImageCopies[level] = {
+                .bufferOffset = m_levelUploadOffsets[level],
+                .imageSubresource =
+                    {
+                        .aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
+                        .mipLevel = level,
+                        .layerCount = 1,
+                    },
+                .imageExtent = {std::max(width() >> level, 1u),
+                                std::max(height() >> level, 1u),
+                                1},
+            };
+        }
 
         m_vk->imageMemoryBarrier(commandBuffer,
                                  VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
@@ -163,13 +205,17 @@ public:
                                    *m_imageUploadBuffer,
                                    *m_texture,
                                    VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-                                   1,
-                                   &bufferImageCopy);
+                                   uploadLevelCount,
+                                   bufferImageCopies.data());
 
         uint32_t mipLevels = m_texture->info().mipLevels;
-        if (mipLevels > 1)
+        // Levels below this one end up in TRANSFER_SRC after generating mipmaps.
+        uint32_t firstTransferDstLevel = 0;
+        if (mipLevels > uploadLevelCount)
         {
-            // Generate mipmaps.
+            // Generate mipmaps from the base level.
+            assert(uploadLevelCount == 1);
+            firstTransferDstLevel = mipLevels - 1;
             int2 dstSize, srcSize = {static_cast<int32_t>(width()), static_cast<int32_t>(height())};
             for (uint32_t level = 1; level < mipLevels; ++level, srcSize = dstSize)
             {
@@ -253,8 +299,8 @@ public:
                                      .image = *m_texture,
                                      .subresourceRange =
                                          {
-                                             .baseMipLevel = mipLevels - 1,
-                                             .levelCount = 1,
+                                             .baseMipLevel = firstTransferDstLevel,
+                                             .levelCount = mipLevels - firstTransferDstLevel,
                                          },
                                  });
 
@@ -264,11 +310,36 @@ public:
 private:
     friend class RenderContextVulkanImpl;
 
+    TextureVulkanImpl(rcp<VulkanContext> vk,
+                      uint32_t width,
+                      uint32_t height,
+                      ImageTextureFormat format,
+                      uint32_t mipLevelCount,
+                      size_t uploadSizeInBytes) :
+        Texture(width, height, format),
+        m_vk(std::move(vk)),
+        m_texture(m_vk->makeTexture({
+            .format = vk_image_texture_format(format),
+            .extent = {width, height, 1},
+            .mipLevels = mipLevelCount,
+            .usage = VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT,
+        })),
+        m_textureView(m_vk->makeTextureView(m_texture)),
+        m_imageUploadBuffer(m_vk->makeBuffer(
+            {
+                .size = uploadSizeInBytes,
+                .usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+            },
+            vkutil::Mappability::writeOnly))
+    {}
+
     rcp<VulkanContext> m_vk;
     rcp<vkutil::Texture> m_texture;
     rcp<vkutil::TextureView> m_textureView;
 
     mutable rcp<vkutil::Buffer> m_imageUploadBuffer;
+    // Offset of each level in m_imageUploadBuffer. Levels past these get generated with blits.
+    std::vector<VkDeviceSize> m_levelUploadOffsets;
 
     // Location for RenderContextVulkanImpl to store a descriptor set for the
     // current flush that binds this image texture.
@@ -276,24 +347,29 @@ private:
     mutable uint64_t m_descriptorSetFrameIdx = std::numeric_limits<size_t>::max();
 };
 
-rcp<Texture> RenderContextVulkanImpl::decodeImageTexture(Span<const uint8_t> encodedBytes)
+rcp<Texture> RenderContextVulkanImpl::makeImageTexture(uint32_t width,
+                                                       uint32_t height,
+                                                       uint32_t mipLevelCount,
+                                                       const uint8_t imageDataRGBA[])
 {
-#ifdef RIVE_DECODERS
-    auto bitmap = Bitmap::decode(encodedBytes.data(), encodedBytes.size());
-    if (bitmap)
-    {
-        // For now, RenderContextImpl::makeImageTexture() only accepts RGBA.
-        if (bitmap->pixelFormat() != Bitmap::PixelFormat::RGBA)
-        {
-            bitmap->pixelFormat(Bitmap::PixelFormat::RGBA);
-        }
-        uint32_t width = bitmap->width();
-        uint32_t height = bitmap->height();
-        uint32_t mipLevelCount = math::msb(height | width);
-        return make_rcp<TextureVulkanImpl>(m_vk, width, height, mipLevelCount, bitmap->bytes());
-    }
-#endif
-    return nullptr;
+    return make_rcp<TextureVulkanImpl>(m_vk, width, height, mipLevelCount, imageDataRGBA);
+}
+
+rcp<Texture> RenderContextVulkanImpl::makeCompressedImageTexture(uint32_t width,
+                                                                 uint32_t height,
+                                                                 ImageTextureFormat format,
+                                                                 uint32_t mipLevelCount,
+                                                                 const uint8_t* const levelData[],
+                                                                 const size_t levelSizesInBytes[])
+{
+    assert(m_platformFeatures.supportsImageTextureFormat(format));
+    return make_rcp<TextureVulkanImpl>(m_vk,
+                                       width,
+                                       height,
+                                       format,
+                                       mipLevelCount,
+                                       levelData,
+                                       levelSizesInBytes);
 }
 
 // Renders color ramps to the gradient texture.
@@ -1725,6 +1801,20 @@ RenderContextVulkanImpl::RenderContextVulkanImpl(VkInstance instance,
     m_platformFeatures.invertOffscreenY = false;
     m_platformFeatures.uninvertOnScreenY = true;
 
+    auto canSampleFormat = [this](VkFormat format) {
+        VkFormatProperties properties;
+        m_vk->GetPhysicalDeviceFormatProperties(m_vk->physicalDevice, format, &properties);
+        constexpr static VkFormatFeatureFlags kRequiredFeatures =
+            VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT | VK_FORMAT_FEATURE_SAMPLED_IMAGE_FILTER_LINEAR_BIT;
+        return (properties.optimalTilingFeatures & kRequiredFeatures) == kRequiredFeatures;
+    };
+    m_platformFeatures.supportsETC2Textures =
+        canSampleFormat(vk_image_texture_format(ImageTextureFormat::etc2));
+    m_platformFeatures.supportsASTCTextures =
+        canSampleFormat(vk_image_texture_format(ImageTextureFormat::astc4x4));
+    m_platformFeatures.supportsBC7Textures =
+        canSampleFormat(vk_image_texture_format(ImageTextureFormat::bc7));
+
     if (features.vendorID == vkutil::kVendorQualcomm)
     {
         // Qualcomm advertises EXT_rasterization_order_attachment_access, but it's
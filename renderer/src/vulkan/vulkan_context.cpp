@@ -40,6 +40,7 @@ VulkanContext::VulkanContext(VkInstance instance,
     , CMD(reinterpret_cast<PFN_vk##CMD>(fp_vkGetInstanceProcAddr(instance, "vk" #CMD)))
 #define LOAD_VULKAN_DEVICE_COMMAND(CMD)                                                            \
     , CMD(reinterpret_cast<PFN_vk##CMD>(fp_vkGetDeviceProcAddr(device, "vk" #CMD)))
+    RIVE_VULKAN_INSTANCE_COMMANDS(LOAD_VULKAN_INSTANCE_COMMAND)
     RIVE_VULKAN_DEVICE_COMMANDS(LOAD_VULKAN_DEVICE_COMMAND)
 #undef LOAD_VULKAN_DEVICE_COMMAND
 #undef LOAD_VULKAN_INSTANCE_COMMAND
@@ -42,6 +42,7 @@ public:
     void lineTo(float x, float y) override;
     void cubicTo(float ox, float oy, float ix, float iy, float x, float y) override;
     virtual void close() override;
+    void copy(const RawPath& rawPath) override;
 };
 
 class SkiaRenderPaint : public lite_rtti_override<RenderPaint, SkiaRenderPaint>
@@ -99,6 +100,20 @@ void SkiaRenderPath::cubicTo(float ox, float oy, float ix, float iy, float x, fl
     m_Path.cubicTo(ox, oy, ix, iy, x, y);
 }
 void SkiaRenderPath::close() { m_Path.close(); }
+void SkiaRenderPath::copy(const RawPath& rawPath)
+{
+    const bool isVolatile = false;
+    const SkScalar* conicWeights = nullptr;
+    const int conicWeightCount = 0;
+    m_Path = SkPath::Make(reinterpret_cast<const SkPoint*>(rawPath.points().data()),
+                          rawPath.points().size(),
+                          (uint8_t*)rawPath.verbs().data(),
+                          rawPath.verbs().size(),
+                          conicWeights,
+                          conicWeightCount,
+                          m_Path.getFillType(),
+                          isVolatile);
+}
 
 SkiaRenderPaint::SkiaRenderPaint() { m_Paint.setAntiAlias(true); }
 
@@ -94,6 +94,11 @@ public:
         }
     }
 
+    const std::vector<std::unique_ptr<KeyedObjectData>>& objects() const
+    {
+        return keyedObjectsData;
+    }
+
     void writeObjects(AnimationReset* animationReset, ArtboardInstance* artboard)
     {
         for (auto& keyedObjectData : keyedObjectsData)
@@ -155,6 +160,44 @@ public:
     }
 };
 
+AnimationResetPlan::AnimationResetPlan(const LinearAnimation* animationFrom,
+                                       const LinearAnimation* animationTo) :
+    m_animationFrom(animationFrom), m_animationTo(animationTo)
+{
+    std::vector<const LinearAnimation*> animations;
+    if (animationFrom != nullptr)
+    {
+        animations.push_back(animationFrom);
+    }
+    if (animationTo != nullptr)
+    {
+        animations.push_back(animationTo);
+    }
+    AnimationsData animationsData(animations, false);
+    for (auto& keyedObjectData : animationsData.objects())
+    {
+        auto& propertiesData = keyedObjectData->keyedPropertiesData;
+        if (propertiesData.size() > 0)
+        {
+            m_objects.push_back(
+                {keyedObjectData->objectId, static_cast<uint32_t>(propertiesData.size())});
+            for (auto& keyedPropertyData : propertiesData)
+            {
+                m_propertyKeys.push_back(keyedPropertyData.keyedProperty->propertyKey());
+            }
+        }
+    }
+}
+
+const LinearAnimation* AnimationResetPlan::resetAnimation(const LayerState* state)
+{
+    if (state != nullptr && state->is<AnimationState>())
+    {
+        return state->as<AnimationState>()->animation();
+    }
+    return nullptr;
+}
+
 std::unique_ptr<AnimationReset> AnimationResetFactory::getInstance()
 {
     std::unique_lock<std::mutex> lock(m_mutex);
@@ -173,18 +216,50 @@ void AnimationResetFactory::fromState(StateInstance* stateInstance,
 {
     if (stateInstance != nullptr)
     {
-        auto state = stateInstance->state();
-        if (state->is<AnimationState>() && state->as<AnimationState>()->animation() != nullptr)
+        auto animation = AnimationResetPlan::resetAnimation(stateInstance->state());
+        if (animation != nullptr)
         {
-            animations.push_back(state->as<AnimationState>()->animation());
+            animations.push_back(animation);
         }
     }
 }
 
 std::unique_ptr<AnimationReset> AnimationResetFactory::fromStates(StateInstance* stateFrom,
                                                                   StateInstance* currentState,
-                                                                  ArtboardInstance* artboard)
+                                                                  ArtboardInstance* artboard,
+                                                                  const AnimationResetPlan* plan)
 {
+    if (plan != nullptr &&
+        plan->matches(
+            AnimationResetPlan::resetAnimation(stateFrom ? stateFrom->state() : nullptr),
+            AnimationResetPlan::resetAnimation(currentState ? currentState->state() : nullptr)))
+    {
+        auto animationReset = AnimationResetFactory::getInstance();
+        const uint32_t* propertyKey = plan->m_propertyKeys.data();
+        for (const auto& objectProperties : plan->m_objects)
+        {
+            auto object = artboard->resolve(objectProperties.objectId);
+            animationReset->writeObjectId(objectProperties.objectId);
+            animationReset->writeTotalProperties(objectProperties.propertyCount);
+            for (uint32_t i = 0; i < objectProperties.propertyCount; ++i, ++propertyKey)
+            {
+                animationReset->writePropertyKey(*propertyKey);
+                switch (CoreRegistry::propertyFieldId(*propertyKey))
+                {
+                    case CoreDoubleType::id:
+                        animationReset->writePropertyValue(
+                            CoreRegistry::getDouble(object, *propertyKey));
+                        break;
+                    case CoreColorType::id:
+                        animationReset->writePropertyValue(
+                            CoreRegistry::getColor(object, *propertyKey));
+                        break;
+                }
+            }
+        }
+        animationReset->complete();
+        return animationReset;
+    }
     std::vector<const LinearAnimation*> animations;
     fromState(stateFrom, animations);
     fromState(currentState, animations);
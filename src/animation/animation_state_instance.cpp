@@ -1,6 +1,9 @@
 #include "rive/animation/animation_state_instance.hpp"
 #include "rive/animation/animation_state.hpp"
 #include "rive/animation/state_machine_instance.hpp"
+#include "rive/animation/state_transition.hpp"
+#include <algorithm>
+#include <cmath>
 
 using namespace rive;
 
@@ -36,4 +39,46 @@ void AnimationStateInstance::apply(ArtboardInstance* instance, float mix)
 }
 
 bool AnimationStateInstance::keepGoing() const { return m_KeepGoing; }
-void AnimationStateInstance::clearSpilledTime() { m_AnimationInstance.clearSpilledTime(); }
\ No newline at end of file
+void AnimationStateInstance::clearSpilledTime() { m_AnimationInstance.clearSpilledTime(); }
+
+bool AnimationStateInstance::restart()
+{
+    m_AnimationInstance.restart(state()->as<AnimationState>()->speed());
+    m_KeepGoing = true;
+    return true;
+}
+float AnimationStateInstance::secondsUntilChange() const
+{
+    auto animationState = state()->as<AnimationState>();
+    float speed = animationState->speed();
+    float seconds = m_AnimationInstance.secondsUntilChange(speed);
+    if (seconds == 0.0f || std::isinf(seconds))
+    {
+        return seconds;
+    }
+
+    // Exit times are measured against the total time spent in the state, the
+    // same way StateTransition::allowed() does.
+    float localSpeed = std::abs(m_AnimationInstance.directedSpeed() * speed);
+    auto animation = m_AnimationInstance.animation();
+    float duration = animation->durationSeconds();
+    float totalTime = m_AnimationInstance.totalTime();
+    for (size_t i = 0, length = animationState->transitionCount(); i < length; i++)
+    {
+        auto transition = animationState->transition(i);
+        if (transition->isDisabled() || !transition->enableExitTime())
+        {
+            continue;
+        }
+        float exitTime = transition->exitTimeSeconds(animationState);
+        if (duration > 0.0f && exitTime <= duration && animation->loop() != Loop::oneShot)
+        {
+            exitTime += std::floor(totalTime / duration) * duration;
+        }
+        if (exitTime > totalTime)
+        {
+            seconds = std::min(seconds, (exitTime - totalTime) / localSpeed);
+        }
+    }
+    return seconds;
+}
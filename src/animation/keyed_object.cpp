@@ -85,6 +85,30 @@ void KeyedObject::apply(Artboard* artboard, float time, float mix)
     }
 }
 
+bool KeyedObject::keysOnlyCallbacks() const
+{
+    for (const std::unique_ptr<KeyedProperty>& property : m_keyedProperties)
+    {
+        if (!CoreRegistry::isCallback(property->propertyKey()))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+float KeyedObject::nextCallbackSeconds(float seconds, float limit) const
+{
+    for (const std::unique_ptr<KeyedProperty>& property : m_keyedProperties)
+    {
+        if (CoreRegistry::isCallback(property->propertyKey()))
+        {
+            limit = property->nextKeyFrameSeconds(seconds, limit);
+        }
+    }
+    return limit;
+}
+
 StatusCode KeyedObject::import(ImportStack& importStack)
 {
     auto importer = importStack.latest<LinearAnimationImporter>(LinearAnimationBase::typeKey);
@@ -5,6 +5,7 @@
 #include "rive/animation/keyed_callback_reporter.hpp"
 #include "rive/importers/import_stack.hpp"
 #include "rive/importers/keyed_object_importer.hpp"
+#include <algorithm>
 
 using namespace rive;
 
@@ -50,6 +51,20 @@ int KeyedProperty::closestFrameIndex(float seconds, int exactOffset) const
     return start;
 }
 
+float KeyedProperty::nextKeyFrameSeconds(float seconds, float limit) const
+{
+    if (m_keyFrames.empty())
+    {
+        return limit;
+    }
+    auto index = closestFrameIndex(seconds, 1);
+    if (index >= static_cast<int>(m_keyFrames.size()))
+    {
+        return limit;
+    }
+    return std::min(m_keyFrames[index]->seconds(), limit);
+}
+
 void KeyedProperty::reportKeyedCallbacks(KeyedCallbackReporter* reporter,
                                          uint32_t objectId,
                                          float secondsFrom,
@@ -1,10 +1,12 @@
 #include "rive/animation/layer_state.hpp"
 #include "rive/animation/transition_bool_condition.hpp"
+#include "rive/animation/transition_input_condition.hpp"
 #include "rive/importers/import_stack.hpp"
 #include "rive/importers/state_machine_layer_importer.hpp"
 #include "rive/generated/animation/state_machine_layer_base.hpp"
 #include "rive/animation/state_transition.hpp"
 #include "rive/animation/system_state_instance.hpp"
+#include <algorithm>
 
 using namespace rive;
 
@@ -56,6 +58,38 @@ StatusCode LayerState::import(ImportStack& importStack)
 
 void LayerState::addTransition(StateTransition* transition) { m_Transitions.push_back(transition); }
 
+void LayerState::findTransitionInputs()
+{
+    m_TransitionsOnlyReadInputs = false;
+    m_TransitionInputIds.clear();
+    for (auto transition : m_Transitions)
+    {
+        if (transition->isDisabled())
+        {
+            continue;
+        }
+        if (transition->enableExitTime())
+        {
+            return;
+        }
+        for (size_t i = 0, count = transition->conditionCount(); i < count; i++)
+        {
+            auto condition = transition->condition(i);
+            if (!condition->is<TransitionInputCondition>())
+            {
+                return;
+            }
+            auto inputId = condition->as<TransitionInputCondition>()->inputId();
+            if (std::find(m_TransitionInputIds.begin(), m_TransitionInputIds.end(), inputId) ==
+                m_TransitionInputIds.end())
+            {
+                m_TransitionInputIds.push_back(inputId);
+            }
+        }
+    }
+    m_TransitionsOnlyReadInputs = true;
+}
+
 std::unique_ptr<StateInstance> LayerState::makeInstance(ArtboardInstance* instance) const
 {
     return rivestd::make_unique<SystemStateInstance>(this, instance);
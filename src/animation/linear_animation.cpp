@@ -37,16 +37,31 @@ StatusCode LinearAnimation::onAddedDirty(CoreContext* context)
 StatusCode LinearAnimation::onAddedClean(CoreContext* context)
 {
     StatusCode code;
+    m_keysOnlyCallbacks = true;
     for (const auto& object : m_KeyedObjects)
     {
         if ((code = object->onAddedClean(context)) != StatusCode::Ok)
         {
             return code;
         }
+        if (!object->keysOnlyCallbacks())
+        {
+            m_keysOnlyCallbacks = false;
+        }
     }
     return StatusCode::Ok;
 }
 
+float LinearAnimation::nextCallbackSeconds(float seconds) const
+{
+    float next = endSeconds();
+    for (const auto& object : m_KeyedObjects)
+    {
+        next = object->nextCallbackSeconds(seconds, next);
+    }
+    return next;
+}
+
 void LinearAnimation::addKeyedObject(std::unique_ptr<KeyedObject> object)
 {
     m_KeyedObjects.push_back(std::move(object));
@@ -2,8 +2,10 @@
 #include "rive/animation/linear_animation.hpp"
 #include "rive/animation/loop.hpp"
 #include "rive/animation/keyed_callback_reporter.hpp"
+#include <algorithm>
 #include <cmath>
 #include <cassert>
+#include <limits>
 
 using namespace rive;
 
@@ -225,6 +227,18 @@ void LinearAnimationInstance::reset(float speedMultiplier = 1.0)
     m_time = (speedMultiplier >= 0) ? m_animation->startTime() : m_animation->endTime();
 }
 
+void LinearAnimationInstance::restart(float speedMultiplier)
+{
+    reset(speedMultiplier);
+    m_speedDirection = (speedMultiplier >= 0) ? 1 : -1;
+    m_totalTime = 0.0f;
+    m_lastTotalTime = 0.0f;
+    m_spilledTime = 0.0f;
+    m_direction = 1;
+    m_didLoop = false;
+    m_loopValue = -1;
+}
+
 uint32_t LinearAnimationInstance::fps() const { return m_animation->fps(); }
 
 uint32_t LinearAnimationInstance::duration() const { return m_animation->duration(); }
@@ -266,6 +280,32 @@ void LinearAnimationInstance::loopValue(int value)
 
 float LinearAnimationInstance::durationSeconds() const { return m_animation->durationSeconds(); }
 
+float LinearAnimationInstance::secondsUntilChange(float speedMultiplier) const
+{
+    if (!keepGoing(speedMultiplier))
+    {
+        return std::numeric_limits<float>::infinity();
+    }
+    float localSpeed = directedSpeed() * speedMultiplier;
+    if (!m_animation->keysOnlyCallbacks() || loop() == Loop::pingPong || localSpeed <= 0.0f)
+    {
+        return 0.0f;
+    }
+    // Callbacks on the first frame get reported by the first advance.
+    if (m_time == m_animation->startSeconds())
+    {
+        return 0.0f;
+    }
+    // Wake up at the end of the work area too, in case we loop and there are
+    // callbacks before the current time.
+    return (m_animation->nextCallbackSeconds(m_time) - m_time) / localSpeed;
+}
+
+float LinearAnimationInstance::settledSeconds() const
+{
+    return std::min(secondsUntilChange(1.0f), m_artboardInstance->settledSeconds());
+}
+
 void LinearAnimationInstance::reportEvent(Event* event, float secondsDelay)
 {
     const std::vector<Event*> events{event};
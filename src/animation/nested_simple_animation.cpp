@@ -1,5 +1,6 @@
 #include "rive/animation/nested_simple_animation.hpp"
 #include "rive/animation/linear_animation_instance.hpp"
+#include <limits>
 
 using namespace rive;
 
@@ -19,4 +20,12 @@ bool NestedSimpleAnimation::advance(float elapsedSeconds)
         }
     }
     return keepGoing;
-}
\ No newline at end of file
+}
+float NestedSimpleAnimation::settledSeconds() const
+{
+    if (m_AnimationInstance == nullptr || !isPlaying())
+    {
+        return std::numeric_limits<float>::infinity();
+    }
+    return m_AnimationInstance->secondsUntilChange(speed());
+}
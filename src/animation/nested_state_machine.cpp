@@ -4,6 +4,7 @@
 #include "rive/animation/nested_state_machine.hpp"
 #include "rive/animation/state_machine_instance.hpp"
 #include "rive/hit_result.hpp"
+#include <limits>
 
 using namespace rive;
 
@@ -20,6 +21,15 @@ bool NestedStateMachine::advance(float elapsedSeconds)
     return keepGoing;
 }
 
+float NestedStateMachine::settledSeconds() const
+{
+    if (m_StateMachineInstance == nullptr)
+    {
+        return std::numeric_limits<float>::infinity();
+    }
+    return m_StateMachineInstance->settledSeconds();
+}
+
 void NestedStateMachine::initializeAnimation(ArtboardInstance* artboard)
 {
     m_StateMachineInstance = artboard->stateMachineAt(animationId());
@@ -16,6 +16,7 @@ const std::string& SMIInput::name() const { return m_input->name(); }
 
 void SMIInput::valueChanged()
 {
+    m_changeCount = ++m_machineInstance->m_inputChangeCount;
     m_machineInstance->markNeedsAdvance();
 #ifdef WITH_RIVE_TOOLS
     auto callback = m_machineInstance->m_inputChangedCallback;
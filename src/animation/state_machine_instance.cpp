@@ -35,6 +35,7 @@
 #include "rive/shapes/shape.hpp"
 #include "rive/math/math_types.hpp"
 #include "rive/audio_event.hpp"
+#include <limits>
 #include <unordered_map>
 #include <chrono>
 
@@ -49,6 +50,10 @@ public:
         delete m_anyStateInstance;
         delete m_currentState;
         delete m_stateFrom;
+        for (auto instance : m_statePool)
+        {
+            delete instance;
+        }
     }
 
     void init(StateMachineInstance* stateMachineInstance,
@@ -119,6 +124,24 @@ public:
                (m_currentState != nullptr && m_currentState->keepGoing());
     }
 
+    // Returns how many seconds the layer can advance before it changes
+    // anything, as of the last advance.
+    float settledSeconds() const
+    {
+        if (m_mix != 1.0f)
+        {
+            return 0.0f;
+        }
+        // A state that has stopped can't reach an exit time or report
+        // anything, and the transitions that were evaluated on the last
+        // advance won't change their minds until an input does.
+        if (m_currentState == nullptr || !m_currentState->keepGoing())
+        {
+            return std::numeric_limits<float>::infinity();
+        }
+        return m_currentState->secondsUntilChange();
+    }
+
     bool isTransitioning()
     {
         return m_transition != nullptr && m_stateFrom != nullptr && m_transition->duration() != 0 &&
@@ -134,6 +157,11 @@ public:
             return false;
         }
 
+        if (transitionsAreIdle())
+        {
+            return false;
+        }
+
         m_waitingForExit = false;
 
         if (tryChangeState(m_anyStateInstance, ignoreTriggers))
@@ -141,7 +169,50 @@ public:
             return true;
         }
 
-        return tryChangeState(m_currentState, ignoreTriggers);
+        if (tryChangeState(m_currentState, ignoreTriggers))
+        {
+            return true;
+        }
+
+        // Nothing is allowed right now. If that can only change when an input does, remember which
+        // inputs we've seen so we don't evaluate the transitions again until one of them changes.
+        // Triggers that were ignored can still fire later, so those passes don't count.
+        m_idleTransitions =
+            !ignoreTriggers && m_currentState != nullptr &&
+            m_currentState->state()->transitionsOnlyReadInputs() &&
+            m_anyStateInstance->state()->transitionsOnlyReadInputs();
+        m_idleInputChangeCount = m_stateMachineInstance->m_inputChangeCount;
+        return false;
+    }
+
+    // Returns true if no transition out of the current state (or the
+    // AnyState) can be allowed, because none of the inputs they read have
+    // changed since they were last found not to be.
+    bool transitionsAreIdle() const
+    {
+        if (!m_idleTransitions)
+        {
+            return false;
+        }
+        if (m_stateMachineInstance->m_inputChangeCount == m_idleInputChangeCount)
+        {
+            return true;
+        }
+        return !inputsChangedSinceIdle(m_anyStateInstance->state()) &&
+               !inputsChangedSinceIdle(m_currentState->state());
+    }
+
+    bool inputsChangedSinceIdle(const LayerState* state) const
+    {
+        for (auto inputId : state->transitionInputIds())
+        {
+            auto input = m_stateMachineInstance->input(inputId);
+            if (input != nullptr && input->m_changeCount > m_idleInputChangeCount)
+            {
+                return true;
+            }
+        }
+        return false;
     }
 
     void fireEvents(StateMachineFireOccurance occurs,
@@ -176,8 +247,8 @@ public:
             fireEvents(StateMachineFireOccurance::atEnd, m_currentState->state()->events());
         }
 
-        m_currentState =
-            stateTo == nullptr ? nullptr : stateTo->makeInstance(m_artboardInstance).release();
+        m_currentState = stateTo == nullptr ? nullptr : makeStateInstance(stateTo);
+        m_idleTransitions = false;
 
         // Fire start events for the state we're changing to.
         if (m_currentState != nullptr)
@@ -187,6 +258,47 @@ public:
         return true;
     }
 
+    // Reuses an instance of the state from the pool, if there is one.
+    StateInstance* makeStateInstance(const LayerState* state)
+    {
+        for (size_t i = 0; i < m_statePool.size(); i++)
+        {
+            auto instance = m_statePool[i];
+            if (instance->state() == state)
+            {
+                m_statePool[i] = m_statePool.back();
+                m_statePool.pop_back();
+                return instance;
+            }
+        }
+        return state->makeInstance(m_artboardInstance).release();
+    }
+
+    // Keeps an instance we're done with, so toggling back and forth between
+    // states doesn't keep allocating new ones. At most one instance of each
+    // state is kept.
+    void releaseStateInstance(StateInstance* instance)
+    {
+        if (instance == nullptr)
+        {
+            return;
+        }
+        for (auto pooled : m_statePool)
+        {
+            if (pooled->state() == instance->state())
+            {
+                delete instance;
+                return;
+            }
+        }
+        if (!instance->restart())
+        {
+            delete instance;
+            return;
+        }
+        m_statePool.push_back(instance);
+    }
+
     StateTransition* findRandomTransition(StateInstance* stateFromInstance, bool ignoreTriggers)
     {
         uint32_t totalWeight = 0;
@@ -265,8 +377,10 @@ public:
 
     void buildAnimationResetForTransition()
     {
-        m_animationReset =
-            AnimationResetFactory::fromStates(m_stateFrom, m_currentState, m_artboardInstance);
+        m_animationReset = AnimationResetFactory::fromStates(m_stateFrom,
+                                                             m_currentState,
+                                                             m_artboardInstance,
+                                                             m_transition->animationResetPlan());
     }
 
     void clearAnimationReset()
@@ -307,7 +421,7 @@ public:
             if (m_stateFrom != m_anyStateInstance)
             {
                 // Old state from is done.
-                delete m_stateFrom;
+                releaseStateInstance(m_stateFrom);
             }
             m_stateFrom = outState;
 
@@ -408,6 +522,8 @@ private:
     StateInstance* m_anyStateInstance = nullptr;
     StateInstance* m_currentState = nullptr;
     StateInstance* m_stateFrom = nullptr;
+    // Instances of states we've left, kept for when they're entered again.
+    std::vector<StateInstance*> m_statePool;
 
     const StateTransition* m_transition = nullptr;
     std::unique_ptr<AnimationReset> m_animationReset = nullptr;
@@ -420,6 +536,11 @@ private:
     bool m_stateMachineChangedOnAdvance = false;
 
     bool m_waitingForExit = false;
+    /// Set when the transitions out of the current state were all found not
+    /// to be allowed, and only depend on inputs. They don't need to be
+    /// evaluated again until an input changes after m_idleInputChangeCount.
+    bool m_idleTransitions = false;
+    uint64_t m_idleInputChangeCount = 0;
     /// Used to ensure a specific animation is applied on the next apply.
     const LinearAnimation* m_holdAnimation = nullptr;
     float m_holdTime = 0.0f;
@@ -1070,6 +1191,12 @@ bool StateMachineInstance::advance(float seconds)
     {
         sortHitComponents();
     }
+    // Events reported by the last advance are only notified now, so they happened an extra
+    // 'seconds' before the end of this one.
+    for (auto& report : m_reportedEvents)
+    {
+        report = EventReport(report.event(), report.secondsDelay() + seconds);
+    }
     this->notifyEventListeners(m_reportedEvents, nullptr);
     m_reportedEvents.clear();
     m_needsAdvance = false;
@@ -1086,9 +1213,32 @@ bool StateMachineInstance::advance(float seconds)
         inst->advanced();
     }
 
+    m_settledSeconds = std::numeric_limits<float>::infinity();
+    for (size_t i = 0; i < m_layerCount; i++)
+    {
+        m_settledSeconds = std::min(m_settledSeconds, m_layers[i].settledSeconds());
+    }
+
     return m_needsAdvance;
 }
 
+float StateMachineInstance::settledSeconds() const
+{
+    // Reported events get sent to listeners on the next advance.
+    if (!m_reportedEvents.empty())
+    {
+        return 0.0f;
+    }
+    for (auto dataBind : m_dataBinds)
+    {
+        if (dataBind->dirt() != ComponentDirt::None)
+        {
+            return 0.0f;
+        }
+    }
+    return std::min(m_settledSeconds, m_artboardInstance->settledSeconds());
+}
+
 bool StateMachineInstance::advanceAndApply(float seconds)
 {
     bool keepGoing = this->advance(seconds);
@@ -1096,7 +1246,11 @@ bool StateMachineInstance::advanceAndApply(float seconds)
     return keepGoing;
 }
 
-void StateMachineInstance::markNeedsAdvance() { m_needsAdvance = true; }
+void StateMachineInstance::markNeedsAdvance()
+{
+    m_needsAdvance = true;
+    m_settledSeconds = 0.0f;
+}
 bool StateMachineInstance::needsAdvance() const { return m_needsAdvance; }
 
 std::string StateMachineInstance::name() const { return m_machine->name(); }
@@ -1286,7 +1440,7 @@ void StateMachineInstance::notifyEventListeners(const std::vector<EventReport>&
             auto event = report.event();
             if (event->is<AudioEvent>())
             {
-                event->as<AudioEvent>()->play();
+                event->as<AudioEvent>()->play(report.secondsDelay());
             }
         }
     }
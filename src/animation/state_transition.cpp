@@ -1,3 +1,4 @@
+#include "rive/animation/animation_reset_factory.hpp"
 #include "rive/animation/animation_state_instance.hpp"
 #include "rive/animation/animation_state.hpp"
 #include "rive/animation/cubic_interpolator.hpp"
@@ -23,6 +24,7 @@ StateTransition::~StateTransition()
     {
         delete condition;
     }
+    delete m_AnimationResetPlan;
 }
 
 StatusCode StateTransition::onAddedDirty(CoreContext* context)
@@ -78,6 +80,18 @@ void StateTransition::addCondition(TransitionCondition* condition)
     m_Conditions.push_back(condition);
 }
 
+void StateTransition::buildAnimationResetPlan(const LayerState* stateFrom)
+{
+    if (duration() == 0)
+    {
+        // Instant transitions never mix, so they never need a reset.
+        return;
+    }
+    delete m_AnimationResetPlan;
+    m_AnimationResetPlan = new AnimationResetPlan(AnimationResetPlan::resetAnimation(stateFrom),
+                                                  AnimationResetPlan::resetAnimation(m_StateTo));
+}
+
 float StateTransition::mixTime(const LayerState* stateFrom) const
 {
     if (duration() == 0)
@@ -31,6 +31,8 @@
 #include "rive/event.hpp"
 #include "rive/assets/audio_asset.hpp"
 
+#include <algorithm>
+#include <limits>
 #include <unordered_map>
 
 using namespace rive;
@@ -48,7 +50,8 @@ Artboard::~Artboard()
 #ifdef EXTERNAL_RIVE_AUDIO_ENGINE
     auto audioEngine = m_audioEngine;
 #else
-    auto audioEngine = AudioEngine::RuntimeEngine(false);
+    auto audioEngine =
+        m_audioEngine != nullptr ? m_audioEngine : AudioEngine::RuntimeEngine(false);
 #endif
     if (audioEngine)
     {
@@ -545,6 +548,28 @@ void Artboard::host(NestedArtboard* nestedArtboard)
 
 NestedArtboard* Artboard::host() const { return m_host; }
 
+LayerCache* Artboard::layerCache() const
+{
+    if (m_layerCache != nullptr)
+    {
+        return m_layerCache;
+    }
+    Artboard* parent = parentArtboard();
+    return parent != nullptr ? parent->layerCache() : nullptr;
+}
+
+AABB Artboard::visibleRegion() const
+{
+    if (m_hasVisibleRegion)
+    {
+        return m_visibleRegion;
+    }
+    return AABB::fromLTWH(-layoutWidth() * originX(),
+                          -layoutHeight() * originY(),
+                          layoutWidth(),
+                          layoutHeight());
+}
+
 Artboard* Artboard::parentArtboard() const
 {
     if (m_host == nullptr)
@@ -608,8 +633,7 @@ void Artboard::updateRenderPath()
     m_clipPath = factory()->makeRenderPath(clip);
     m_backgroundRawPath.rewind();
     m_backgroundRawPath.addRect(bg);
-    m_backgroundPath->rewind();
-    m_backgroundRawPath.addTo(m_backgroundPath.get());
+    m_backgroundPath->copy(m_backgroundRawPath);
 }
 
 void Artboard::update(ComponentDirt value)
@@ -752,6 +776,7 @@ bool Artboard::advanceInternal(double elapsedSeconds, bool isRoot, bool nested)
 {
     bool didUpdate = false;
     m_HasChangedDrawOrderInLastUpdate = false;
+    m_HasAnimatingLayoutsInLastUpdate = false;
 #ifdef WITH_RIVE_LAYOUT
     if (syncStyleChanges() && m_updatesOwnLayout)
     {
@@ -768,6 +793,7 @@ bool Artboard::advanceInternal(double elapsedSeconds, bool isRoot, bool nested)
                 (dep != this && layout->advance(elapsedSeconds)))
             {
                 didUpdate = true;
+                m_HasAnimatingLayoutsInLastUpdate = true;
             }
         }
     }
@@ -832,6 +858,28 @@ bool Artboard::advance(double elapsedSeconds, bool nested)
     return advanceInternal(elapsedSeconds, true, nested);
 }
 
+float Artboard::settledSeconds() const
+{
+    if (hasDirt(ComponentDirt::Components) || m_HasAnimatingLayoutsInLastUpdate ||
+        !m_dirtyLayout.empty())
+    {
+        return 0.0f;
+    }
+    for (auto dataBind : m_AllDataBinds)
+    {
+        if (dataBind->dirt() != ComponentDirt::None)
+        {
+            return 0.0f;
+        }
+    }
+    float seconds = std::numeric_limits<float>::infinity();
+    for (auto nestedArtboard : m_NestedArtboards)
+    {
+        seconds = std::min(seconds, nestedArtboard->settledSeconds());
+    }
+    return seconds;
+}
+
 Core* Artboard::hitTest(HitInfo* hinfo, const Mat2D& xform)
 {
     if (clip())
@@ -1410,7 +1458,7 @@ TextValueRun* ArtboardInstance::getTextRun(const std::string& name, const std::s
     return artboardInstance->find<TextValueRun>(name);
 }
 
-#ifdef EXTERNAL_RIVE_AUDIO_ENGINE
+#ifdef WITH_RIVE_AUDIO
 rcp<AudioEngine> Artboard::audioEngine() const { return m_audioEngine; }
 void Artboard::audioEngine(rcp<AudioEngine> audioEngine)
 {
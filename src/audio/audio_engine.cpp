@@ -19,6 +19,7 @@
 #include "rive/audio/audio_source.hpp"
 
 #include <algorithm>
+#include <cassert>
 #include <cmath>
 
 using namespace rive;
@@ -162,34 +163,49 @@ void AudioEngine::start() { ma_engine_start(m_engine); }
 void AudioEngine::stop() { ma_engine_stop(m_engine); }
 
 rcp<AudioEngine> AudioEngine::Make(uint32_t numChannels, uint32_t sampleRate)
+{
+    return Make(numChannels, sampleRate, false);
+}
+
+rcp<AudioEngine> AudioEngine::MakeOffline(uint32_t numChannels, uint32_t sampleRate)
+{
+    return Make(numChannels, sampleRate, true);
+}
+
+rcp<AudioEngine> AudioEngine::Make(uint32_t numChannels, uint32_t sampleRate, bool isOffline)
 {
 // I _think_ MA_NO_DEVICE_IO is defined when building for Unity; otherwise, it seems to pass
 // "standard" building When defined, pContext is unavailable, which causes build errors when
 // building Unity for iOS. - David
 #if (TARGET_IPHONE_SIMULATOR || TARGET_OS_MACCATALYST || TARGET_OS_IPHONE) &&                      \
     !defined(MA_NO_DEVICE_IO)
-    // Used for configuration only, and isn't referenced past the usage of ma_context_init; thus,
-    // can be locally scoped. Uses the "logical" defaults from miniaudio, and updates only what we
-    // need. This should automatically set available backends in priority order based on the target
-    // it's built for, which in the case of Apple is Core Audio first.
-    ma_context_config contextConfig = ma_context_config_init();
-
-    // By setting the core audio session to none, miniaudio will not
-    // - set a (new) category on the shared audio session
-    // - set any (new) options when setting a new category
-    // This means that the shared AVAudioSession instance will be respected
-    // when audio is played; the developer will have to set up the shared
-    // AVAudioSession instance explicitly for their own set up.
-    // This does not touch whether the session is made (in)active.
-    contextConfig.coreaudio.sessionCategory = ma_ios_session_category_none;
-
-    // We only need to initialize space for the context if we're targeting Apple platforms
-    ma_context* context = (ma_context*)malloc(sizeof(ma_context));
-
-    if (ma_context_init(NULL, 0, &contextConfig, context) != MA_SUCCESS)
-    {
-        free(context);
-        context = nullptr;
+    ma_context* context = nullptr;
+    if (!isOffline)
+    {
+        // Used for configuration only, and isn't referenced past the usage of ma_context_init;
+        // thus, can be locally scoped. Uses the "logical" defaults from miniaudio, and updates only
+        // what we need. This should automatically set available backends in priority order based
+        // on the target it's built for, which in the case of Apple is Core Audio first. Offline
+        // engines never open a device so they don't need a context at all.
+        ma_context_config contextConfig = ma_context_config_init();
+
+        // By setting the core audio session to none, miniaudio will not
+        // - set a (new) category on the shared audio session
+        // - set any (new) options when setting a new category
+        // This means that the shared AVAudioSession instance will be respected
+        // when audio is played; the developer will have to set up the shared
+        // AVAudioSession instance explicitly for their own set up.
+        // This does not touch whether the session is made (in)active.
+        contextConfig.coreaudio.sessionCategory = ma_ios_session_category_none;
+
+        // We only need to initialize space for the context if we're targeting Apple platforms
+        context = (ma_context*)malloc(sizeof(ma_context));
+
+        if (ma_context_init(NULL, 0, &contextConfig, context) != MA_SUCCESS)
+        {
+            free(context);
+            context = nullptr;
+        }
     }
 #else
     ma_context* context = nullptr;
@@ -209,6 +225,11 @@ rcp<AudioEngine> AudioEngine::Make(uint32_t numChannels, uint32_t sampleRate)
 
 #ifdef EXTERNAL_RIVE_AUDIO_ENGINE
     engineConfig.noDevice = MA_TRUE;
+#else
+    if (isOffline)
+    {
+        engineConfig.noDevice = MA_TRUE;
+    }
 #endif
 
     ma_engine* engine = new ma_engine();
@@ -229,14 +250,17 @@ rcp<AudioEngine> AudioEngine::Make(uint32_t numChannels, uint32_t sampleRate)
         return nullptr;
     }
 
-    return rcp<AudioEngine>(new AudioEngine(engine, context));
+    return rcp<AudioEngine>(new AudioEngine(engine, context, isOffline));
 }
 
 uint32_t AudioEngine::channels() const { return ma_engine_get_channels(m_engine); }
 uint32_t AudioEngine::sampleRate() const { return ma_engine_get_sample_rate(m_engine); }
 
-AudioEngine::AudioEngine(ma_engine* engine, ma_context* context) :
-    m_device(ma_engine_get_device(engine)), m_engine(engine), m_context(context)
+AudioEngine::AudioEngine(ma_engine* engine, ma_context* context, bool isOffline) :
+    m_device(ma_engine_get_device(engine)),
+    m_engine(engine),
+    m_context(context),
+    m_isOffline(isOffline)
 {}
 
 rcp<AudioSound> AudioEngine::play(rcp<AudioSource> source,
@@ -459,7 +483,6 @@ rcp<AudioEngine> AudioEngine::RuntimeEngine(bool makeWhenNecessary)
     return m_runtimeAudioEngine;
 }
 
-#ifdef EXTERNAL_RIVE_AUDIO_ENGINE
 bool AudioEngine::readAudioFrames(float* frames, uint64_t numFrames, uint64_t* framesRead)
 {
     return ma_engine_read_pcm_frames(m_engine,
@@ -506,6 +529,62 @@ bool AudioEngine::sumAudioFrames(float* frames, uint64_t numFrames)
     }
     return true;
 }
-#endif
+
+uint64_t AudioEngine::beginOfflineStep(float elapsedSeconds)
+{
+    assert(m_isOffline);
+    if (elapsedSeconds > 0.0f)
+    {
+        m_offlineSeconds += elapsedSeconds;
+    }
+    // Round the accumulated time rather than each step so that rounding
+    // errors never build up across steps.
+    uint64_t scheduledFrames = (uint64_t)std::llround(m_offlineSeconds * sampleRate());
+    m_offlineStepFrames = scheduledFrames - m_offlineScheduledFrames;
+    m_offlineScheduledFrames = scheduledFrames;
+    return m_offlineStepFrames;
+}
+
+bool AudioEngine::renderOfflineStep(float* frames)
+{
+    assert(m_isOffline);
+    uint64_t numFrames = m_offlineStepFrames;
+    m_offlineStepFrames = 0;
+    if (numFrames == 0)
+    {
+        return true;
+    }
+    uint64_t framesRead = 0;
+    if (!readAudioFrames(frames, numFrames, &framesRead))
+    {
+        return false;
+    }
+    // An engine with no playing sounds may read short, make sure the step is
+    // still accounted for with silence so time stays in lockstep.
+    if (framesRead < numFrames)
+    {
+        size_t numChannels = (size_t)channels();
+        std::fill(frames + (size_t)framesRead * numChannels,
+                  frames + (size_t)numFrames * numChannels,
+                  0.0f);
+        ma_engine_set_time_in_pcm_frames(m_engine, timeInFrames() + numFrames - framesRead);
+    }
+    return true;
+}
+
+uint64_t AudioEngine::eventTimeInFrames(float delaySeconds)
+{
+    uint64_t now = timeInFrames();
+    if (!m_isOffline)
+    {
+        return now;
+    }
+    // The step being advanced hasn't been rendered yet, so its end is at now +
+    // m_offlineStepFrames. Events are reported relative to that end.
+    uint64_t stepEnd = now + m_offlineStepFrames;
+    uint64_t delayFrames =
+        delaySeconds > 0.0f ? (uint64_t)std::llround((double)delaySeconds * sampleRate()) : 0;
+    return delayFrames >= stepEnd - now ? now : stepEnd - delayFrames;
+}
 
 #endif
\ No newline at end of file
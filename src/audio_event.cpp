@@ -6,7 +6,7 @@
 
 using namespace rive;
 
-void AudioEvent::play()
+void AudioEvent::play(float delaySeconds)
 {
 #ifdef WITH_RIVE_AUDIO
     auto audioAsset = (AudioAsset*)m_fileAsset;
@@ -26,13 +26,15 @@ void AudioEvent::play()
         return;
     }
 
-    auto engine =
-#ifdef EXTERNAL_RIVE_AUDIO_ENGINE
-        artboard()->audioEngine() != nullptr ? artboard()->audioEngine() :
-#endif
-                                             AudioEngine::RuntimeEngine();
+    auto engine = artboard()->audioEngine() != nullptr ? artboard()->audioEngine()
+                                                       : AudioEngine::RuntimeEngine();
 
-    auto sound = engine->play(audioSource, engine->timeInFrames(), 0, 0, artboard());
+    auto sound =
+        engine->play(audioSource, engine->eventTimeInFrames(delaySeconds), 0, 0, artboard());
+    if (sound == nullptr)
+    {
+        return;
+    }
 
     if (volume != 1.0f)
     {
@@ -47,7 +49,7 @@ void AudioEvent::trigger(const CallbackData& value)
     if (!value.context()->playsAudio())
     {
         // Context won't play audio, we'll do it ourselves.
-        play();
+        play(value.delaySeconds());
     }
 }
 
@@ -0,0 +1,10 @@
+#include "rive/command_path.hpp"
+#include "rive/math/raw_path.hpp"
+
+using namespace rive;
+
+void CommandPath::copy(const RawPath& rawPath)
+{
+    rewind();
+    rawPath.addTo(this);
+}
@@ -22,12 +22,13 @@ const Mat2D FollowPathConstraint::targetTransform() const
     if (m_Target->is<Shape>() || m_Target->is<Path>())
     {
         auto result = m_pathMeasure.atPercentage(distance());
-        Vec2D position = result.pos;
+        Vec2D position = m_measureTransform * result.pos;
         Mat2D transformB = Mat2D(m_Target->worldTransform());
 
         if (orient())
         {
-            transformB = Mat2D::fromRotation(std::atan2(result.tan.y, result.tan.x));
+            Vec2D tangent = Vec2D::transformDir(result.tan, m_measureTransform);
+            transformB = Mat2D::fromRotation(std::atan2(tangent.y, tangent.x));
         }
         Vec2D offsetPosition = Vec2D();
         if (offset())
@@ -111,14 +112,81 @@ void FollowPathConstraint::update(ComponentDirt value)
     }
     if (paths.size() > 0)
     {
+        if (canReuseMeasure(paths, &m_measureTransform))
+        {
+            return;
+        }
         m_rawPath.rewind();
+        m_measuredPaths.clear();
         for (auto path : paths)
         {
             m_rawPath.addPath(path->rawPath(), &path->pathTransform());
+            m_measuredPaths.push_back({path, path->rawPathVersion(), path->pathTransform()});
         }
 
         m_pathMeasure = PathMeasure(&m_rawPath);
+        m_measureTransform = Mat2D();
+    }
+}
+
+static bool isNearlyEqual(const Mat2D& a, const Mat2D& b)
+{
+    for (int i = 0; i < 6; i++)
+    {
+        if (!math::nearly_equal(a[i], b[i], 1e-4f * std::max(1.0f, std::abs(a[i]))))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Returns true if the geometry of paths hasn't changed since the measure was
+// built and their transforms all moved by the same similarity transform, which
+// is written to measureTransform.
+bool FollowPathConstraint::canReuseMeasure(const std::vector<Path*>& paths,
+                                           Mat2D* measureTransform) const
+{
+    if (paths.size() != m_measuredPaths.size())
+    {
+        return false;
+    }
+    for (size_t i = 0; i < paths.size(); i++)
+    {
+        if (paths[i] != m_measuredPaths[i].path ||
+            paths[i]->rawPathVersion() != m_measuredPaths[i].rawPathVersion)
+        {
+            return false;
+        }
+    }
+
+    Mat2D inverse;
+    if (!m_measuredPaths[0].pathTransform.invert(&inverse))
+    {
+        return false;
+    }
+    Mat2D delta = paths[0]->pathTransform() * inverse;
+
+    // Only similarity transforms keep the percentage based lookup on the
+    // measure valid, anything that stretches the path needs a new measure.
+    float tolerance = 1e-4f * std::max(1.0f, delta.findMaxScale());
+    bool isRotation = math::nearly_equal(delta.xx(), delta.yy(), tolerance) &&
+                      math::nearly_equal(delta.xy(), -delta.yx(), tolerance);
+    bool isReflection = math::nearly_equal(delta.xx(), -delta.yy(), tolerance) &&
+                        math::nearly_equal(delta.xy(), delta.yx(), tolerance);
+    if (!isRotation && !isReflection)
+    {
+        return false;
+    }
+    for (size_t i = 1; i < paths.size(); i++)
+    {
+        if (!isNearlyEqual(delta * m_measuredPaths[i].pathTransform, paths[i]->pathTransform()))
+        {
+            return false;
+        }
     }
+    *measureTransform = delta;
+    return true;
 }
 
 StatusCode FollowPathConstraint::onAddedClean(CoreContext* context)
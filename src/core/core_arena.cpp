@@ -0,0 +1,94 @@
+/*
+ * Copyright 2024 Rive
+ */
+
+#include "rive/core/core_arena.hpp"
+#include "rive/core.hpp"
+#include <cassert>
+#include <cstdlib>
+
+using namespace rive;
+
+static thread_local CoreArena* s_currentArena = nullptr;
+
+CoreArena::~CoreArena()
+{
+    for (auto chunk : m_chunks)
+    {
+        std::free(chunk);
+    }
+}
+
+uint8_t* CoreArena::allocateChunk(size_t size)
+{
+    // malloc's alignment is at least 16 bytes on every platform we support.
+    auto chunk = static_cast<uint8_t*>(std::malloc(size));
+    if (chunk == nullptr)
+    {
+        std::abort();
+    }
+    assert(reinterpret_cast<uintptr_t>(chunk) % kAlignment == 0);
+    m_chunks.push_back(chunk);
+    m_reservedBytes += size;
+    return chunk;
+}
+
+void* CoreArena::allocate(size_t size)
+{
+    size = (size + kAlignment - 1) & ~(kAlignment - 1);
+    m_allocatedBytes += size;
+    if (size > kMaxSizeClassBytes)
+    {
+        return allocateChunk(size);
+    }
+    SizeClass& sizeClass = m_sizeClasses[size / kAlignment - 1];
+    if (sizeClass.cursor == sizeClass.end)
+    {
+        // Chunks hold a whole number of objects, so the cursor lands exactly on the end.
+        size_t chunkSize = (kChunkBytes / size) * size;
+        sizeClass.cursor = allocateChunk(chunkSize);
+        sizeClass.end = sizeClass.cursor + chunkSize;
+    }
+    void* ptr = sizeClass.cursor;
+    sizeClass.cursor += size;
+    return ptr;
+}
+
+CoreArena* CoreArena::current() { return s_currentArena; }
+
+CoreArena::Scope::Scope(CoreArena* arena) : m_previous(s_currentArena) { s_currentArena = arena; }
+
+CoreArena::Scope::~Scope() { s_currentArena = m_previous; }
+
+#ifdef WITH_RIVE_CORE_ARENA
+// Every Core allocation starts with a header that records the arena it came from, so delete knows
+// whether to free it.
+static_assert(sizeof(CoreArena*) <= CoreArena::kAlignment, "arena pointer must fit the header");
+
+void* Core::operator new(size_t size)
+{
+    auto arena = s_currentArena;
+    size += CoreArena::kAlignment;
+    void* header = arena != nullptr ? arena->allocate(size) : std::malloc(size);
+    if (header == nullptr)
+    {
+        std::abort();
+    }
+    *static_cast<CoreArena**>(header) = arena;
+    return static_cast<uint8_t*>(header) + CoreArena::kAlignment;
+}
+
+void Core::operator delete(void* ptr)
+{
+    if (ptr == nullptr)
+    {
+        return;
+    }
+    void* header = static_cast<uint8_t*>(ptr) - CoreArena::kAlignment;
+    if (*static_cast<CoreArena**>(header) == nullptr)
+    {
+        std::free(header);
+    }
+    // Otherwise the arena frees it when it's destroyed.
+}
+#endif
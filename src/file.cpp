@@ -151,7 +151,11 @@ static Core* readRuntimeObject(BinaryReader& reader, const RuntimeHeader& header
 }
 
 File::File(Factory* factory, FileAssetLoader* assetLoader) :
-    m_factory(factory), m_assetLoader(assetLoader)
+#ifdef WITH_RIVE_CORE_ARENA
+    m_coreArena(rivestd::make_unique<CoreArena>()),
+#endif
+    m_factory(factory),
+    m_assetLoader(assetLoader)
 {
     assert(factory);
 }
@@ -216,6 +220,9 @@ std::unique_ptr<File> File::import(Span<const uint8_t> bytes,
 
 ImportResult File::read(BinaryReader& reader, const RuntimeHeader& header)
 {
+#ifdef WITH_RIVE_CORE_ARENA
+    CoreArena::Scope arenaScope(m_coreArena.get());
+#endif
     ImportStack importStack;
     // TODO: @hernan consider moving this to a special importer. It's not that
     // simple because Core doesn't have a typeKey, so it should be treated as
@@ -2,6 +2,7 @@
 #include "rive/importers/artboard_importer.hpp"
 #include "rive/animation/state_machine_layer.hpp"
 #include "rive/animation/animation_state.hpp"
+#include "rive/animation/any_state.hpp"
 #include "rive/animation/state_transition.hpp"
 #include "rive/artboard.hpp"
 
@@ -42,6 +43,22 @@ StatusCode StateMachineLayerImporter::resolve()
             }
         }
     }
+
+    // Now that every state's animation is resolved, find the inputs each state's transitions read
+    // and precompute the resets transitions need while mixing. AnyState transitions can be taken
+    // from any state, so they build their resets on the fly.
+    for (auto state : m_Layer->m_States)
+    {
+        state->findTransitionInputs();
+        if (state->is<AnyState>())
+        {
+            continue;
+        }
+        for (auto transition : state->m_Transitions)
+        {
+            transition->buildAnimationResetPlan(state);
+        }
+    }
     return StatusCode::Ok;
 }
 
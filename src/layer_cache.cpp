@@ -0,0 +1,92 @@
+/*
+ * Copyright 2024 Rive
+ */
+
+#include "rive/layer_cache.hpp"
+
+#include <atomic>
+
+using namespace rive;
+
+LayerCache::LayerCache(size_t budgetInBytes) : m_budgetInBytes(budgetInBytes) {}
+
+LayerCache::~LayerCache() {}
+
+void LayerCache::budgetInBytes(size_t value)
+{
+    m_budgetInBytes = value;
+    evictDownTo(m_budgetInBytes);
+}
+
+void LayerCache::clear()
+{
+    m_lru.clear();
+    m_entries.clear();
+    m_usedBytes = 0;
+}
+
+uint64_t LayerCache::makeKey()
+{
+    static std::atomic<uint64_t> nextKey(1);
+    return nextKey++;
+}
+
+LayerCache::DrawResult LayerCache::draw(uint64_t key, Renderer* renderer)
+{
+    auto iter = m_entries.find(key);
+    if (iter == m_entries.end())
+    {
+        ++m_stats.misses;
+        return DrawResult::notCached;
+    }
+    auto entry = iter->second;
+    if (!renderer->drawLayer(entry->layer.get(), m_scaleTolerance))
+    {
+        erase(entry);
+        ++m_stats.misses;
+        return DrawResult::dropped;
+    }
+    m_lru.splice(m_lru.begin(), m_lru, entry);
+    ++m_stats.hits;
+    return DrawResult::drawn;
+}
+
+bool LayerCache::add(uint64_t key, rcp<RenderLayer> layer)
+{
+    remove(key);
+    size_t sizeInBytes = layer->sizeInBytes();
+    if (sizeInBytes > m_budgetInBytes)
+    {
+        return false;
+    }
+    evictDownTo(m_budgetInBytes - sizeInBytes);
+    m_lru.push_front({key, std::move(layer)});
+    m_entries[key] = m_lru.begin();
+    m_usedBytes += sizeInBytes;
+    return true;
+}
+
+void LayerCache::remove(uint64_t key)
+{
+    auto iter = m_entries.find(key);
+    if (iter != m_entries.end())
+    {
+        erase(iter->second);
+    }
+}
+
+void LayerCache::evictDownTo(size_t budgetInBytes)
+{
+    while (m_usedBytes > budgetInBytes)
+    {
+        erase(std::prev(m_lru.end()));
+        ++m_stats.evictions;
+    }
+}
+
+void LayerCache::erase(std::list<Entry>::iterator entry)
+{
+    m_usedBytes -= entry->layer->sizeInBytes();
+    m_entries.erase(entry->key);
+    m_lru.erase(entry);
+}
@@ -96,8 +96,7 @@ void LayoutComponent::updateRenderPath()
     m_backgroundRect->cornerRadiusBR(style()->cornerRadiusBR());
     m_backgroundRect->update(ComponentDirt::Path);
 
-    m_backgroundPath->rewind();
-    m_backgroundRect->rawPath().addTo(m_backgroundPath.get());
+    m_backgroundPath->copy(m_backgroundRect->rawPath());
 
     RawPath clipPath;
     clipPath.addPath(m_backgroundRect->rawPath(), &m_WorldTransform);
@@ -1,6 +1,6 @@
 #include "rive/math/math_types.hpp"
 #include "rive/math/mat2d.hpp"
-#include "rive/math/simd.hpp"
+#include "rive/math/simd_dispatch.hpp"
 #include "rive/math/transform_components.hpp"
 #include "rive/math/vec2d.hpp"
 #include <cmath>
@@ -58,112 +58,12 @@ Mat2D Mat2D::multiply(const Mat2D& a, const Mat2D& b)
 
 void Mat2D::mapPoints(Vec2D dst[], const Vec2D pts[], size_t n) const
 {
-    size_t i = 0;
-    float4 scale = float2{m_buffer[0], m_buffer[3]}.xyxy;
-    float4 skew = simd::load2f(&m_buffer[1]).yxyx;
-    float4 trans = simd::load2f(&m_buffer[4]).xyxy;
-    if (simd::all(skew.xy == 0.f))
-    {
-        // Scale + translate matrix.
-        if (n & 1)
-        {
-            float2 p = simd::load2f(pts);
-            p = scale.xy * p + trans.xy;
-            simd::store(dst, p);
-            ++i;
-        }
-        for (; i < n; i += 2)
-        {
-            float4 p = simd::load4f(pts + i);
-            p = scale * p + trans;
-            simd::store(dst + i, p);
-        }
-    }
-    else
-    {
-        // Affine matrix.
-        if (n & 1)
-        {
-            float2 p = simd::load2f(pts);
-            float2 p_ = skew.xy * p.yx + trans.xy;
-            p_ = scale.xy * p + p_;
-            simd::store(dst, p_);
-            ++i;
-        }
-        for (; i < n; i += 2)
-        {
-            float4 p = simd::load4f(pts + i);
-            float4 p_ = skew * p.yxwz + trans;
-            p_ = scale * p + p_;
-            simd::store(dst + i, p_);
-        }
-    }
+    simd::kernels().mapPoints(values(), dst, pts, n);
 }
 
 AABB Mat2D::mapBoundingBox(const Vec2D pts[], size_t n) const
 {
-    size_t i = 0;
-    float4 scale = float2{m_buffer[0], m_buffer[3]}.xyxy;
-    float4 skew = simd::load2f(&m_buffer[1]).yxyx;
-    float4 mins = std::numeric_limits<float>::infinity();
-    float4 maxes = -std::numeric_limits<float>::infinity();
-    if (simd::all(skew.xy == 0.f))
-    {
-        // Scale + translate matrix.
-        if (n & 1)
-        {
-            float2 p = simd::load2f(pts);
-            p = scale.xy * p;
-            mins.xy = maxes.xy = p;
-            ++i;
-        }
-        for (; i < n; i += 2)
-        {
-            float4 p = simd::load4f(pts + i);
-            p = scale * p;
-            mins = simd::min(p, mins);
-            maxes = simd::max(p, maxes);
-        }
-    }
-    else
-    {
-        // Affine matrix.
-        if (n & 1)
-        {
-            float2 p = simd::load2f(pts);
-            float2 p_ = skew.xy * p.yx;
-            p_ = scale.xy * p + p_;
-            mins.xy = maxes.xy = p_;
-            ++i;
-        }
-        for (; i < n; i += 2)
-        {
-            float4 p = simd::load4f(pts + i);
-            float4 p_ = skew * p.yxwz;
-            p_ = scale * p + p_;
-            mins = simd::min(p_, mins);
-            maxes = simd::max(p_, maxes);
-        }
-    }
-
-    float4 bbox = simd::join(simd::min(mins.xy, mins.zw), simd::max(maxes.xy, maxes.zw));
-    // Use logic that takes the "nonfinite" branch when bbox has NaN values.
-    // Use "b - a >= 0" instead of "a >= b" because it fails when b == a == inf.
-    if (!simd::all(bbox.zw - bbox.xy >= 0))
-    {
-        // The given points were NaN or empty, or infinite.
-        bbox = float4(0);
-    }
-    else
-    {
-        float4 trans = simd::load2f(&m_buffer[4]).xyxy;
-        bbox += trans;
-    }
-
-    auto aabb = math::bit_cast<AABB>(bbox);
-    assert(aabb.width() >= 0);
-    assert(aabb.height() >= 0);
-    return aabb;
+    return simd::kernels().mapBoundingBox(values(), pts, n);
 }
 
 AABB Mat2D::mapBoundingBox(const AABB& aabb) const
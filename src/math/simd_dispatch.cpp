@@ -0,0 +1,314 @@
+/*
+ * Copyright 2024 Rive
+ */
+
+// The AVX variants pass wide vectors between inlined functions, which warns about the ABI when AVX
+// isn't enabled for the whole file.
+#if defined(__clang__) || defined(__GNUC__)
+#pragma GCC diagnostic ignored "-Wpsabi"
+#endif
+
+// The avx512f target also enables FMA, and GCC (in GNU modes) and clang both contract a*b + c into
+// fused multiply-adds when it's available, which rounds differently than the baseline. Turn
+// contraction off for the whole file, including the inline simd.hpp math the kernels pull in, so
+// every variant stays bit-identical.
+#if defined(__clang__)
+#pragma clang fp contract(off)
+#elif defined(__GNUC__)
+#pragma GCC optimize("fp-contract=off")
+#endif
+
+#include "rive/math/simd_dispatch.hpp"
+#include "rive/math/math_types.hpp"
+#include "rive/math/simd.hpp"
+
+#include <atomic>
+#include <limits>
+
+using namespace rive;
+
+namespace
+{
+// Returns a vector of repeating [x, y] pairs.
+template <int N> RIVE_ALWAYS_INLINE simd::gvec<float, N> splat_xy(float x, float y)
+{
+    simd::gvec<float, N> ret;
+    for (int i = 0; i < N; i += 2)
+    {
+        ret[i] = x;
+        ret[i + 1] = y;
+    }
+    return ret;
+}
+
+// Swaps the x and y of every [x, y] pair.
+template <int N> RIVE_ALWAYS_INLINE simd::gvec<float, N> swap_xy(simd::gvec<float, N> p)
+{
+    simd::gvec<float, N> ret;
+    for (int i = 0; i < N; i += 2)
+    {
+        ret[i] = p[i + 1];
+        ret[i + 1] = p[i];
+    }
+    return ret;
+}
+
+// Maps N / 2 points at a time.
+template <int N>
+RIVE_ALWAYS_INLINE void map_points(const float m[6], Vec2D dst[], const Vec2D pts[], size_t n)
+{
+    using floatN = simd::gvec<float, N>;
+    floatN scale = splat_xy<N>(m[0], m[3]);
+    floatN skew = splat_xy<N>(m[2], m[1]);
+    floatN trans = splat_xy<N>(m[4], m[5]);
+    float2 scale2 = {m[0], m[3]};
+    float2 skew2 = {m[2], m[1]};
+    float2 trans2 = {m[4], m[5]};
+    size_t i = 0;
+    if (m[1] == 0 && m[2] == 0)
+    {
+        // Scale + translate matrix.
+        for (; i + N / 2 <= n; i += N / 2)
+        {
+            floatN p = simd::load<float, N>(pts + i);
+            p = scale * p + trans;
+            simd::store(dst + i, p);
+        }
+        for (; i < n; ++i)
+        {
+            float2 p = simd::load2f(pts + i);
+            p = scale2 * p + trans2;
+            simd::store(dst + i, p);
+        }
+    }
+    else
+    {
+        // Affine matrix.
+        for (; i + N / 2 <= n; i += N / 2)
+        {
+            floatN p = simd::load<float, N>(pts + i);
+            floatN p_ = skew * swap_xy(p) + trans;
+            p_ = scale * p + p_;
+            simd::store(dst + i, p_);
+        }
+        for (; i < n; ++i)
+        {
+            float2 p = simd::load2f(pts + i);
+            float2 p_ = skew2 * p.yx + trans2;
+            p_ = scale2 * p + p_;
+            simd::store(dst + i, p_);
+        }
+    }
+}
+
+// Finds the bounds of N / 2 mapped points at a time.
+template <int N>
+RIVE_ALWAYS_INLINE AABB map_bounding_box(const float m[6], const Vec2D pts[], size_t n)
+{
+    using floatN = simd::gvec<float, N>;
+    floatN scale = splat_xy<N>(m[0], m[3]);
+    floatN skew = splat_xy<N>(m[2], m[1]);
+    float2 scale2 = {m[0], m[3]};
+    float2 skew2 = {m[2], m[1]};
+    floatN mins = std::numeric_limits<float>::infinity();
+    floatN maxes = -std::numeric_limits<float>::infinity();
+    float2 mins2 = std::numeric_limits<float>::infinity();
+    float2 maxes2 = -std::numeric_limits<float>::infinity();
+    size_t i = 0;
+    if (m[1] == 0 && m[2] == 0)
+    {
+        // Scale + translate matrix.
+        for (; i + N / 2 <= n; i += N / 2)
+        {
+            floatN p = simd::load<float, N>(pts + i);
+            p = scale * p;
+            mins = simd::min(p, mins);
+            maxes = simd::max(p, maxes);
+        }
+        for (; i < n; ++i)
+        {
+            float2 p = simd::load2f(pts + i);
+            p = scale2 * p;
+            mins2 = simd::min(p, mins2);
+            maxes2 = simd::max(p, maxes2);
+        }
+    }
+    else
+    {
+        // Affine matrix.
+        for (; i + N / 2 <= n; i += N / 2)
+        {
+            floatN p = simd::load<float, N>(pts + i);
+            floatN p_ = skew * swap_xy(p);
+            p_ = scale * p + p_;
+            mins = simd::min(p_, mins);
+            maxes = simd::max(p_, maxes);
+        }
+        for (; i < n; ++i)
+        {
+            float2 p = simd::load2f(pts + i);
+            float2 p_ = skew2 * p.yx;
+            p_ = scale2 * p + p_;
+            mins2 = simd::min(p_, mins2);
+            maxes2 = simd::max(p_, maxes2);
+        }
+    }
+    for (int j = 0; j < N; j += 2)
+    {
+        mins2 = simd::min(float2{mins[j], mins[j + 1]}, mins2);
+        maxes2 = simd::max(float2{maxes[j], maxes[j + 1]}, maxes2);
+    }
+
+    float4 bbox = simd::join(mins2, maxes2);
+    // Use logic that takes the "nonfinite" branch when bbox has NaN values.
+    // Use "b - a >= 0" instead of "a >= b" because it fails when b == a == inf.
+    if (!simd::all(bbox.zw - bbox.xy >= 0))
+    {
+        // The given points were NaN or empty, or infinite.
+        bbox = float4(0);
+    }
+    else
+    {
+        float4 trans = simd::load2f(&m[4]).xyxy;
+        bbox += trans;
+    }
+
+    auto aabb = math::bit_cast<AABB>(bbox);
+    assert(aabb.width() >= 0);
+    assert(aabb.height() >= 0);
+    return aabb;
+}
+
+// Defines the kernel table for one ISA, with every kernel compiled for that ISA.
+#define DEFINE_KERNELS(ISA_NAME, TARGET, WIDTH)                                                    \
+    TARGET void map_points_##ISA_NAME(const float m[6], Vec2D dst[], const Vec2D pts[], size_t n)  \
+    {                                                                                              \
+        map_points<WIDTH>(m, dst, pts, n);                                                         \
+    }                                                                                              \
+    TARGET AABB map_bounding_box_##ISA_NAME(const float m[6], const Vec2D pts[], size_t n)         \
+    {                                                                                              \
+        return map_bounding_box<WIDTH>(m, pts, n);                                                 \
+    }                                                                                              \
+    const simd::Kernels kKernels_##ISA_NAME = {                                                    \
+        map_points_##ISA_NAME,                                                                     \
+        map_bounding_box_##ISA_NAME,                                                               \
+    };
+
+DEFINE_KERNELS(baseline, , 4)
+#if RIVE_SIMD_X86_DISPATCH
+DEFINE_KERNELS(sse4_1, RIVE_SIMD_TARGET_SSE4_1, 4)
+DEFINE_KERNELS(avx2, RIVE_SIMD_TARGET_AVX2, 8)
+DEFINE_KERNELS(avx512, RIVE_SIMD_TARGET_AVX512, 16)
+#endif
+
+#undef DEFINE_KERNELS
+
+const simd::Kernels* find_kernels(simd::ISA isa)
+{
+    switch (isa)
+    {
+        case simd::ISA::baseline:
+            return &kKernels_baseline;
+#if RIVE_SIMD_X86_DISPATCH
+        case simd::ISA::sse4_1:
+            return &kKernels_sse4_1;
+        case simd::ISA::avx2:
+            return &kKernels_avx2;
+        case simd::ISA::avx512:
+            return &kKernels_avx512;
+#else
+        default:
+            break;
+#endif
+    }
+    return nullptr;
+}
+
+bool cpu_supports(simd::ISA isa)
+{
+#if RIVE_SIMD_X86_DISPATCH
+    __builtin_cpu_init();
+    switch (isa)
+    {
+        case simd::ISA::baseline:
+            return true;
+        case simd::ISA::sse4_1:
+            return __builtin_cpu_supports("sse4.1");
+        case simd::ISA::avx2:
+            return __builtin_cpu_supports("avx2");
+        case simd::ISA::avx512:
+            return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("avx512f") &&
+                   __builtin_cpu_supports("avx512bw") && __builtin_cpu_supports("avx512vl");
+    }
+    return false;
+#else
+    return isa == simd::ISA::baseline;
+#endif
+}
+
+simd::ISA best_isa()
+{
+    static const simd::ISA bestISA = []() {
+        for (simd::ISA isa : {simd::ISA::avx512, simd::ISA::avx2, simd::ISA::sse4_1})
+        {
+            if (simd::is_isa_supported(isa))
+            {
+                return isa;
+            }
+        }
+        return simd::ISA::baseline;
+    }();
+    return bestISA;
+}
+
+std::atomic<simd::ISA> s_activeISA(simd::ISA::baseline);
+std::atomic<const simd::Kernels*> s_activeKernels(nullptr);
+} // namespace
+
+const char* simd::isa_name(ISA isa)
+{
+    switch (isa)
+    {
+        case ISA::baseline:
+            return "baseline";
+        case ISA::sse4_1:
+            return "sse4.1";
+        case ISA::avx2:
+            return "avx2";
+        case ISA::avx512:
+            return "avx512";
+    }
+    return "unknown";
+}
+
+bool simd::is_isa_supported(ISA isa) { return find_kernels(isa) != nullptr && cpu_supports(isa); }
+
+simd::ISA simd::active_isa()
+{
+    kernels(); // Make sure the best ISA has been picked.
+    return s_activeISA.load(std::memory_order_relaxed);
+}
+
+bool simd::force_isa(ISA isa)
+{
+    if (!is_isa_supported(isa))
+    {
+        return false;
+    }
+    s_activeISA.store(isa, std::memory_order_relaxed);
+    s_activeKernels.store(find_kernels(isa), std::memory_order_release);
+    return true;
+}
+
+void simd::reset_isa() { force_isa(best_isa()); }
+
+const simd::Kernels& simd::kernels()
+{
+    const Kernels* activeKernels = s_activeKernels.load(std::memory_order_acquire);
+    if (activeKernels == nullptr)
+    {
+        reset_isa();
+        activeKernels = s_activeKernels.load(std::memory_order_acquire);
+    }
+    return *activeKernels;
+}
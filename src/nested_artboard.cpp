@@ -6,13 +6,21 @@
 #include "rive/nested_animation.hpp"
 #include "rive/animation/nested_state_machine.hpp"
 #include "rive/clip_result.hpp"
+#include "rive/layer_cache.hpp"
+#include <algorithm>
 #include <limits>
 #include <cassert>
 
 using namespace rive;
 
 NestedArtboard::NestedArtboard() {}
-NestedArtboard::~NestedArtboard() {}
+NestedArtboard::~NestedArtboard()
+{
+    if (m_layerCache != nullptr)
+    {
+        m_layerCache->remove(m_layerCacheKey);
+    }
+}
 
 Core* NestedArtboard::clone() const
 {
@@ -31,6 +39,7 @@ void NestedArtboard::nest(Artboard* artboard)
     assert(artboard != nullptr);
 
     m_Artboard = artboard;
+    m_layerContentChanged = true;
     if (!m_Artboard->isInstance())
     {
         // We're just marking the source artboard so we can later instance from
@@ -72,11 +81,76 @@ void NestedArtboard::draw(Renderer* renderer)
     if (clipResult != ClipResult::emptyClip)
     {
         renderer->transform(worldTransform());
-        m_Artboard->draw(renderer);
+        if (!drawFromLayerCache(renderer))
+        {
+            m_Artboard->draw(renderer);
+        }
     }
     renderer->restore();
 }
 
+bool NestedArtboard::drawFromLayerCache(Renderer* renderer)
+{
+    // Only clipped content is guaranteed to stay within the artboard's bounds.
+    LayerCache* cache = m_cacheAsLayer && m_Artboard->clip() ? artboard()->layerCache() : nullptr;
+    if (cache != m_layerCache)
+    {
+        if (m_layerCache != nullptr)
+        {
+            m_layerCache->remove(m_layerCacheKey);
+        }
+        m_layerCache = cache;
+        m_layerIdleFrames = 0;
+    }
+    if (cache == nullptr)
+    {
+        return false;
+    }
+
+    if (m_layerContentChanged || m_Artboard->hasDirt(ComponentDirt::Components))
+    {
+        m_layerContentChanged = false;
+        m_layerIdleFrames = 0;
+        cache->remove(m_layerCacheKey);
+        return false;
+    }
+    if (m_layerIdleFrames < cache->idleFrameThreshold())
+    {
+        ++m_layerIdleFrames;
+        return false;
+    }
+
+    if (m_layerCacheKey == 0)
+    {
+        m_layerCacheKey = LayerCache::makeKey();
+    }
+    switch (cache->draw(m_layerCacheKey, renderer))
+    {
+        case LayerCache::DrawResult::drawn:
+            return true;
+        case LayerCache::DrawResult::dropped:
+            // The scale changed. Wait for it to settle before drawing a new layer.
+            m_layerIdleFrames = 0;
+            return false;
+        case LayerCache::DrawResult::notCached:
+            break;
+    }
+
+    rcp<RenderLayer> layer = renderer->beginLayer(m_Artboard->bounds());
+    if (layer == nullptr)
+    {
+        m_layerIdleFrames = 0;
+        return false;
+    }
+    m_Artboard->draw(renderer);
+    renderer->endLayer();
+    if (!cache->add(m_layerCacheKey, layer))
+    {
+        m_layerIdleFrames = 0;
+    }
+    return renderer->drawLayer(layer.get(), cache->scaleTolerance());
+}
+
 Core* NestedArtboard::hitTest(HitInfo* hinfo, const Mat2D& xform)
 {
     if (m_Artboard == nullptr)
@@ -131,6 +205,20 @@ StatusCode NestedArtboard::onAddedClean(CoreContext* context)
     return Super::onAddedClean(context);
 }
 
+float NestedArtboard::settledSeconds() const
+{
+    if (m_Artboard == nullptr || isCollapsed() || m_isCulled)
+    {
+        return std::numeric_limits<float>::infinity();
+    }
+    float seconds = m_Artboard->settledSeconds();
+    for (auto animation : m_NestedAnimations)
+    {
+        seconds = std::min(seconds, animation->settledSeconds());
+    }
+    return seconds;
+}
+
 bool NestedArtboard::advance(float elapsedSeconds)
 {
     bool keepGoing = false;
@@ -138,11 +226,59 @@ bool NestedArtboard::advance(float elapsedSeconds)
     {
         return keepGoing;
     }
+    if (shouldCull())
+    {
+        // Keep track of the time that goes by, so looping and timed animations pick up where
+        // they would have been once the artboard is visible again.
+        m_isCulled = true;
+        m_culledSeconds += elapsedSeconds;
+        return keepGoing;
+    }
+    if (m_isCulled)
+    {
+        m_isCulled = false;
+        elapsedSeconds += m_culledSeconds;
+        m_culledSeconds = 0.0f;
+        m_layerContentChanged = true;
+    }
     for (auto animation : m_NestedAnimations)
     {
         keepGoing = animation->advance(elapsedSeconds) || keepGoing;
     }
-    return m_Artboard->advanceInternal(elapsedSeconds, false) || keepGoing;
+    bool didUpdate = m_Artboard->advanceInternal(elapsedSeconds, false);
+    if (didUpdate)
+    {
+        m_layerContentChanged = true;
+    }
+    return didUpdate || keepGoing;
+}
+
+bool NestedArtboard::shouldCull() const
+{
+    // Culling is configured on the root artboard, and tested in its world space.
+    Mat2D toRoot = worldTransform();
+    const Artboard* root = artboard();
+    while (root->host() != nullptr)
+    {
+        toRoot = root->host()->worldTransform() * toRoot;
+        root = root->host()->artboard();
+    }
+    if (!root->cullHiddenNestedArtboards())
+    {
+        return false;
+    }
+    if (isHidden() || renderOpacity() == 0.0f)
+    {
+        return true;
+    }
+    if (!m_Artboard->clip())
+    {
+        return false; // The content can draw anywhere.
+    }
+    AABB bounds = toRoot.mapBoundingBox(m_Artboard->bounds());
+    AABB visible = root->visibleRegion();
+    return bounds.maxX <= visible.minX || bounds.minX >= visible.maxX ||
+           bounds.maxY <= visible.minY || bounds.minY >= visible.maxY;
 }
 
 void NestedArtboard::update(ComponentDirt value)
@@ -151,6 +287,7 @@ void NestedArtboard::update(ComponentDirt value)
     if (hasDirt(value, ComponentDirt::RenderOpacity) && m_Artboard != nullptr)
     {
         m_Artboard->opacity(renderOpacity());
+        m_layerContentChanged = true;
     }
 }
 
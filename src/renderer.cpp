@@ -111,6 +111,11 @@ RenderImage::RenderImage(const Mat2D& uvTransform) : m_uvTransform(uvTransform)
 RenderImage::RenderImage() {}
 RenderImage::~RenderImage() {}
 
+RenderLayer::RenderLayer(const AABB& bounds, size_t sizeInBytes) :
+    m_bounds(bounds), m_sizeInBytes(sizeInBytes)
+{}
+RenderLayer::~RenderLayer() {}
+
 RenderPath::RenderPath() {}
 RenderPath::~RenderPath() {}
 
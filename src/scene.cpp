@@ -15,6 +15,8 @@ float Scene::height() const { return m_artboardInstance->height(); }
 
 void Scene::draw(Renderer* renderer) { m_artboardInstance->draw(renderer); }
 
+float Scene::settledSeconds() const { return m_artboardInstance->settledSeconds(); }
+
 HitResult Scene::pointerDown(Vec2D) { return HitResult::none; }
 HitResult Scene::pointerMove(Vec2D) { return HitResult::none; }
 HitResult Scene::pointerUp(Vec2D) { return HitResult::none; }
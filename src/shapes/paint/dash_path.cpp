@@ -103,13 +103,9 @@ RenderPath* PathDasher::dash(const RawPath& source,
     {
         m_dashedPath = factory->makeEmptyRenderPath();
     }
-    else
-    {
-        m_dashedPath->rewind();
-    }
 
     m_renderPath = m_dashedPath.get();
-    m_rawPath.addTo(m_renderPath);
+    m_renderPath->copy(m_rawPath);
 
     return m_renderPath;
 }
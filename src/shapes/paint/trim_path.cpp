@@ -125,13 +125,9 @@ RenderPath* TrimPath::effectPath(const RawPath& source, Factory* factory)
     {
         m_trimmedPath = factory->makeEmptyRenderPath();
     }
-    else
-    {
-        m_trimmedPath->rewind();
-    }
 
     m_renderPath = m_trimmedPath.get();
-    m_rawPath.addTo(m_renderPath);
+    m_renderPath->copy(m_rawPath);
     return m_renderPath;
 }
 
@@ -266,6 +266,7 @@ void Path::update(ComponentDirt value)
         // tester).
         m_rawPath.rewind();
         buildPath(m_rawPath);
+        m_rawPathVersion++;
     }
     // if (hasDirt(value, ComponentDirt::WorldTransform) && m_Shape != nullptr)
     // {
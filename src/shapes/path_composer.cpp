@@ -4,6 +4,8 @@
 #include "rive/shapes/path.hpp"
 #include "rive/shapes/shape.hpp"
 #include "rive/factory.hpp"
+#include "rive/math/math_types.hpp"
+#include <algorithm>
 
 using namespace rive;
 
@@ -30,6 +32,73 @@ void PathComposer::onDirty(ComponentDirt dirt)
     }
 }
 
+// inverse(world) * pathTransform picks up float noise as the shape moves around,
+// so compare shape space transforms with a tolerance that amounts to well under
+// a pixel once mapped back to world space.
+static bool isSameLocalTransform(const Mat2D& a, const Mat2D& b, float translateTolerance)
+{
+    for (int i = 0; i < 4; i++)
+    {
+        if (!math::nearly_equal(a[i], b[i], 1e-5f * std::max(1.0f, std::abs(a[i]))))
+        {
+            return false;
+        }
+    }
+    return math::nearly_equal(a[4], b[4], translateTolerance) &&
+           math::nearly_equal(a[5], b[5], translateTolerance);
+}
+
+// Updates the records of paths (and their shape space transforms) that make up
+// the local geometry. Returns true if anything changed since the last build.
+bool PathComposer::updateLocalRecords(const Mat2D& inverseWorld)
+{
+    const float maxScale = m_shape->worldTransform().findMaxScale();
+    const float translateTolerance = 1e-3f / (maxScale > 1e-3f ? maxScale : 1e-3f);
+    bool changed = false;
+    size_t index = 0;
+    for (auto path : m_shape->paths())
+    {
+        if (path->isHidden() || path->isCollapsed())
+        {
+            continue;
+        }
+        const auto localTransform = inverseWorld * path->pathTransform();
+        if (index == m_localRecords.size())
+        {
+            m_localRecords.push_back({path, path->rawPathVersion(), localTransform});
+            changed = true;
+        }
+        else
+        {
+            auto& record = m_localRecords[index];
+            if (record.path != path || record.rawPathVersion != path->rawPathVersion() ||
+                !isSameLocalTransform(record.localTransform, localTransform, translateTolerance))
+            {
+                record = {path, path->rawPathVersion(), localTransform};
+                changed = true;
+            }
+        }
+        index++;
+    }
+    if (index != m_localRecords.size())
+    {
+        m_localRecords.resize(index);
+        changed = true;
+    }
+    return changed;
+}
+
+void PathComposer::buildLocalRawPath()
+{
+    m_localRawPath.rewind();
+    // Get all the paths into local shape space.
+    for (const auto& record : m_localRecords)
+    {
+        m_localRawPath.addPath(record.path->rawPath(), &record.localTransform);
+    }
+    m_localGeometryVersion++;
+}
+
 void PathComposer::update(ComponentDirt value)
 {
     if (hasDirt(value, ComponentDirt::Path))
@@ -41,53 +110,65 @@ void PathComposer::update(ComponentDirt value)
         }
         m_deferredPathDirt = false;
 
+        // Path dirt arrives both when a path's geometry changes and when any
+        // world transform in the hierarchy changes. Only rebuild the shape
+        // space geometry when it actually changed, a shape that just moves,
+        // rotates or scales keeps its local geometry and only needs the new
+        // world transform (which local paints apply at draw time).
+        auto world = m_shape->worldTransform();
+        Mat2D inverseWorld;
+        bool isInvertible = world.invert(&inverseWorld);
+        if (!isInvertible)
+        {
+            inverseWorld = Mat2D();
+        }
+        bool localGeometryChanged = updateLocalRecords(inverseWorld);
+        if (localGeometryChanged)
+        {
+            buildLocalRawPath();
+        }
+
         if (m_shape->isFlagged(PathFlags::local))
         {
             if (m_localPath == nullptr)
             {
                 m_localPath = artboard()->factory()->makeEmptyRenderPath();
+                m_localRawPath.addTo(m_localPath.get());
             }
-            else
+            else if (localGeometryChanged)
+            {
+                m_localPath->copy(m_localRawPath);
+            }
+        }
+        if (m_shape->isFlagged(PathFlags::world))
+        {
+            m_worldRawPath.rewind();
+            if (isInvertible)
             {
-                m_localPath->rewind();
-                m_localRawPath.rewind();
+                // Map the cached local geometry through the new transform
+                // instead of re-concatenating every path.
+                m_worldRawPath.addPath(m_localRawPath, &world);
             }
-            auto world = m_shape->worldTransform();
-            Mat2D inverseWorld = world.invertOrIdentity();
-            // Get all the paths into local shape space.
-            for (auto path : m_shape->paths())
+            else
             {
-                if (!path->isHidden() && !path->isCollapsed())
+                for (auto path : m_shape->paths())
                 {
-                    const auto localTransform = inverseWorld * path->pathTransform();
-                    m_localRawPath.addPath(path->rawPath(), &localTransform);
+                    if (!path->isHidden() && !path->isCollapsed())
+                    {
+                        const Mat2D& transform = path->pathTransform();
+                        m_worldRawPath.addPath(path->rawPath(), &transform);
+                    }
                 }
             }
-
-            // TODO: add a CommandPath::copy(RawPath)
-            m_localRawPath.addTo(m_localPath.get());
-        }
-        if (m_shape->isFlagged(PathFlags::world))
-        {
             if (m_worldPath == nullptr)
             {
                 m_worldPath = artboard()->factory()->makeEmptyRenderPath();
+                m_worldRawPath.addTo(m_worldPath.get());
             }
             else
             {
-                m_worldPath->rewind();
-                m_worldRawPath.rewind();
-            }
-            for (auto path : m_shape->paths())
-            {
-                if (!path->isHidden() && !path->isCollapsed())
-                {
-                    const Mat2D& transform = path->pathTransform();
-                    m_worldRawPath.addPath(path->rawPath(), &transform);
-                }
+                m_worldPath->copy(m_worldRawPath);
             }
-            // TODO: add a CommandPath::copy(RawPath)
-            m_worldRawPath.addTo(m_worldPath.get());
         }
         m_shape->markBoundsDirty();
     }
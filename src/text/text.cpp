@@ -738,6 +738,26 @@ void StyledText::clear()
 
 bool StyledText::empty() const { return m_runs.empty(); }
 
+bool StyledText::operator==(const StyledText& other) const
+{
+    if (m_value != other.m_value || m_runs.size() != other.m_runs.size())
+    {
+        return false;
+    }
+    for (size_t i = 0; i < m_runs.size(); i++)
+    {
+        const TextRun& a = m_runs[i];
+        const TextRun& b = other.m_runs[i];
+        if (a.font != b.font || a.size != b.size || a.lineHeight != b.lineHeight ||
+            a.letterSpacing != b.letterSpacing || a.unicharCount != b.unicharCount ||
+            a.styleId != b.styleId)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
 void StyledText::append(rcp<Font> font,
                         float size,
                         float lineHeight,
@@ -865,8 +885,7 @@ void Text::update(ComponentDirt value)
         }
         if (makeStyled(m_styledText))
         {
-            auto runs = m_styledText.runs();
-            m_shape = runs[0].font->shapeText(m_styledText.unichars(), runs);
+            shapeStyledText();
             m_lines =
                 BreakLines(m_shape,
                            effectiveSizing() == TextSizing::autoWidth ? -1.0f : effectiveWidth(),
@@ -889,6 +908,8 @@ void Text::update(ComponentDirt value)
         else
         {
             m_shape = SimpleArray<Paragraph>();
+            m_shapedText.clear();
+            m_measureMemos.clear();
             m_lines = SimpleArray<SimpleArray<GlyphLine>>();
             m_glyphLookup.clear();
         }
@@ -914,78 +935,135 @@ void Text::update(ComponentDirt value)
     m_layoutMeasured = false;
 }
 
+void Text::shapeStyledText()
+{
+    if (m_styledText == m_shapedText)
+    {
+        return;
+    }
+    auto runs = m_styledText.runs();
+    m_shape = runs[0].font->shapeText(m_styledText.unichars(), runs);
+    m_shapedText = m_styledText;
+    m_measureMemos.clear();
+
+    // These refer to the previous shape.
+    m_lines = SimpleArray<SimpleArray<GlyphLine>>();
+    m_orderedLines.clear();
+    m_ellipsisRun = {};
+}
+
+bool Text::MeasureMemo::sameInputs(const MeasureMemo& other) const
+{
+    return maxSize == other.maxSize && width == other.width && height == other.height &&
+           paragraphSpacing == other.paragraphSpacing && sizing == other.sizing &&
+           align == other.align && wrap == other.wrap && overflow == other.overflow &&
+           verticalAlign == other.verticalAlign && origin == other.origin;
+}
+
 Vec2D Text::measure(Vec2D maxSize)
 {
-    if (makeStyled(m_styledText))
+    if (!makeStyled(m_styledText))
+    {
+        return Vec2D();
+    }
+    shapeStyledText();
+
+    MeasureMemo memo;
+    memo.maxSize = maxSize;
+    memo.width = width();
+    memo.height = height();
+    memo.paragraphSpacing = paragraphSpacing();
+    memo.sizing = sizingValue();
+    memo.align = alignValue();
+    memo.wrap = wrapValue();
+    memo.overflow = overflowValue();
+    memo.verticalAlign = verticalAlignValue();
+    memo.origin = originValue();
+    for (const MeasureMemo& previous : m_measureMemos)
     {
-        const float paragraphSpace = paragraphSpacing();
-        auto runs = m_styledText.runs();
-        auto shape = runs[0].font->shapeText(m_styledText.unichars(), runs);
-        auto lines =
-            BreakLines(shape,
-                       std::min(maxSize.x, sizing() == TextSizing::autoWidth ? -1.0f : width()),
-                       (TextAlign)alignValue(),
-                       wrap());
-        float y = 0;
-        float computedHeight = 0.0f;
-        float minY = 0;
-        int paragraphIndex = 0;
-        float maxWidth = 0;
-
-        if (textOrigin() == TextOrigin::baseline && !lines.empty() && !lines[0].empty())
+        if (previous.sameInputs(memo))
         {
-            y -= m_lines[0][0].baseline;
-            minY = y;
+            return previous.size;
         }
-        int ellipsisLine = -1;
-        bool wantEllipsis = overflow() == TextOverflow::ellipsis && sizing() == TextSizing::fixed &&
-                            verticalAlign() == VerticalTextAlign::top;
+    }
+
+    memo.size = measureShape(maxSize);
+    if (m_measureMemos.size() == kMaxMeasureMemos)
+    {
+        m_measureMemos.erase(m_measureMemos.begin());
+    }
+    m_measureMemos.push_back(memo);
+    return memo.size;
+}
+
+Vec2D Text::measureShape(Vec2D maxSize) const
+{
+    const float paragraphSpace = paragraphSpacing();
+    const SimpleArray<Paragraph>& shape = m_shape;
+    auto lines =
+        BreakLines(shape,
+                   std::min(maxSize.x, sizing() == TextSizing::autoWidth ? -1.0f : width()),
+                   (TextAlign)alignValue(),
+                   wrap());
+    float y = 0;
+    float computedHeight = 0.0f;
+    float minY = 0;
+    int paragraphIndex = 0;
+    float maxWidth = 0;
+
+    if (textOrigin() == TextOrigin::baseline && !lines.empty() && !lines[0].empty())
+    {
+        y -= lines[0][0].baseline;
+        minY = y;
+    }
+    int ellipsisLine = -1;
+    bool wantEllipsis = overflow() == TextOverflow::ellipsis && sizing() == TextSizing::fixed &&
+                        verticalAlign() == VerticalTextAlign::top;
 
-        for (const SimpleArray<GlyphLine>& paragraphLines : lines)
+    for (const SimpleArray<GlyphLine>& paragraphLines : lines)
+    {
+        const Paragraph& paragraph = shape[paragraphIndex++];
+        for (const GlyphLine& line : paragraphLines)
         {
-            const Paragraph& paragraph = shape[paragraphIndex++];
-            for (const GlyphLine& line : paragraphLines)
+            const GlyphRun& endRun = paragraph.runs[line.endRunIndex];
+            const GlyphRun& startRun = paragraph.runs[line.startRunIndex];
+            float width = endRun.xpos[line.endGlyphIndex] -
+                          startRun.xpos[line.startGlyphIndex] - endRun.letterSpacing;
+            if (width > maxWidth)
             {
-                const GlyphRun& endRun = paragraph.runs[line.endRunIndex];
-                const GlyphRun& startRun = paragraph.runs[line.startRunIndex];
-                float width = endRun.xpos[line.endGlyphIndex] -
-                              startRun.xpos[line.startGlyphIndex] - endRun.letterSpacing;
-                if (width > maxWidth)
-                {
-                    maxWidth = width;
-                }
-                if (wantEllipsis && y + line.bottom > maxSize.y)
-                {
-                    if (ellipsisLine == -1)
-                    {
-                        // Nothing fits, just show the first line and ellipse it.
-                        computedHeight = y + line.bottom;
-                    }
-                    goto doneMeasuring;
-                }
-                ellipsisLine++;
-                computedHeight = y + line.bottom;
+                maxWidth = width;
             }
-            if (!paragraphLines.empty())
+            if (wantEllipsis && y + line.bottom > maxSize.y)
             {
-                y += paragraphLines.back().bottom;
+                if (ellipsisLine == -1)
+                {
+                    // Nothing fits, just show the first line and ellipse it.
+                    computedHeight = y + line.bottom;
+                }
+                goto doneMeasuring;
             }
-            y += paragraphSpace;
+            ellipsisLine++;
+            computedHeight = y + line.bottom;
         }
-    doneMeasuring:
-
-        switch (sizing())
+        if (!paragraphLines.empty())
         {
-            case TextSizing::autoWidth:
-                return Vec2D(maxWidth, std::max(minY, computedHeight));
-                break;
-            case TextSizing::autoHeight:
-                return Vec2D(width(), std::max(minY, computedHeight));
-                break;
-            case TextSizing::fixed:
-                return Vec2D(width(), minY + height());
-                break;
+            y += paragraphLines.back().bottom;
         }
+        y += paragraphSpace;
+    }
+doneMeasuring:
+
+    switch (sizing())
+    {
+        case TextSizing::autoWidth:
+            return Vec2D(maxWidth, std::max(minY, computedHeight));
+            break;
+        case TextSizing::autoHeight:
+            return Vec2D(width(), std::max(minY, computedHeight));
+            break;
+        case TextSizing::fixed:
+            return Vec2D(width(), minY + height());
+            break;
     }
     return Vec2D();
 }
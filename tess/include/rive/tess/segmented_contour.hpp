@@ -16,6 +16,10 @@ class SegmentedContour
 private:
     std::vector<Vec2D> m_contourPoints;
 
+    // Points produced by segment(), before transform() maps them into
+    // m_contourPoints.
+    std::vector<Vec2D> m_localPoints;
+
     AABB m_bounds;
     float m_threshold;
     float m_thresholdSquared;
@@ -39,6 +43,15 @@ public:
     const AABB& bounds() const;
 
     void contour(const RawPath& rawPath, const Mat2D& transform);
+
+    /// Segments rawPath in its own coordinate space and keeps the result, so
+    /// that subsequent calls to transform() can place it without segmenting
+    /// again. The threshold is in local units.
+    void segment(const RawPath& rawPath);
+
+    /// Replaces the contour points with the points from the last segment()
+    /// mapped through transform.
+    void transform(const Mat2D& transform);
 };
 } // namespace rive
 #endif
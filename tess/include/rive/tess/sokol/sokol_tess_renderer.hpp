@@ -7,6 +7,7 @@
 
 #include "rive/tess/tess_renderer.hpp"
 #include "sokol_gfx.h"
+#include <memory>
 
 namespace rive
 {
@@ -50,12 +51,13 @@ public:
     sg_buffer uvBuffer() const { return m_uvBuffer; }
 };
 
+class SokolStreamArena;
+
 class SokolTessRenderer : public TessRenderer
 {
 private:
     static const std::size_t maxClippingPaths = 16;
     sg_pipeline m_meshPipeline;
-    sg_pipeline m_currentPipeline = {0};
     int m_clipCount = 0;
 
     // Src Over Pipelines
@@ -76,8 +78,11 @@ private:
 
     std::vector<SubPath> m_ClipPaths;
 
+    // Geometry and draws recorded since the last reset(), submitted by flush().
+    std::unique_ptr<SokolStreamArena> m_arena;
+
     void applyClipping();
-    void setPipeline(sg_pipeline pipeline);
+    sg_pipeline pathPipeline(BlendMode blendMode) const;
 
 public:
     SokolTessRenderer();
@@ -99,7 +104,13 @@ public:
                        BlendMode,
                        float opacity) override;
     void restore() override;
+
+    // Starts a new frame, discarding anything recorded but not flushed.
     void reset();
+
+    // Uploads the frame's streamed geometry and issues its batched draws. Call once per frame,
+    // inside the pass being rendered to, after all drawing is done.
+    void flush();
 };
 } // namespace rive
 #endif
@@ -27,17 +27,41 @@ private:
 
     mapbox::detail::Earcut<uint16_t> m_earcut;
 
+    // Triangles for one level of detail, in the path's local space.
+    struct Triangulation
+    {
+        int level;
+        std::vector<Vec2D> vertices;
+        std::vector<uint16_t> indices;
+        AABB bounds;
+    };
+
+    // Most recently used level of detail last.
+    std::vector<Triangulation> m_triangulations;
+    int m_triangulationLevel = 0;
+
     bool m_isContourDirty = true;
     bool m_isTriangulationDirty = true;
+    // Level of detail the segmented contour was built for, and the transform
+    // its points were last mapped through.
+    int m_contourLevel = 0;
     Mat2D m_contourTransform;
     bool m_isClosed = false;
 
+    void triangulate(Triangulation& triangulation, float scale);
+
 protected:
     std::vector<SubPath> m_subPaths;
     virtual void addTriangles(Span<const Vec2D> vertices, Span<const uint16_t> indices) = 0;
     virtual void setTriangulatedBounds(const AABB& value) = 0;
-    void contour(const Mat2D& transform);
-    void triangulate(TessRenderPath* containerPath);
+
+    // Called before a (possibly cached) triangulation is handed back through
+    // addTriangles, so implementations can drop the triangles they hold.
+    virtual void resetTriangles() {}
+
+    // Segments the path (if needed) with a tolerance suited to drawing it at
+    // scale times the transform's scale, then maps it through transform.
+    void contour(const Mat2D& transform, float scale = 1.0f);
 
 public:
     TessRenderPath();
@@ -55,10 +79,21 @@ public:
     void lineTo(float x, float y) override;
     void cubicTo(float ox, float oy, float ix, float iy, float x, float y) override;
     void close() override;
+    void copy(const RawPath& rawPath) override;
     void addRenderPath(RenderPath* path, const Mat2D& transform) override;
 
+    // Paths are segmented and triangulated per level of detail: half octave
+    // steps of the scale they're drawn at. Translating, or scaling within a
+    // level, reuses the same segmentation and triangles.
+    static int LevelOfDetail(float scale);
+    static float LevelOfDetailScale(int level);
+
     const SegmentedContour& segmentedContour() const;
-    bool triangulate();
+
+    // Triangulates the fill for drawing at the given device scale. Returns
+    // true when new triangles were passed to addTriangles, either from a
+    // fresh triangulation or from the level of detail cache.
+    bool triangulate(float scale = 1.0f);
     void extrudeStroke(ContourStroke* stroke,
                        StrokeJoin join,
                        StrokeCap cap,
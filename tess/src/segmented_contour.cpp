@@ -62,6 +62,7 @@ void SegmentedContour::segmentCubic(const Vec2D& from,
 void SegmentedContour::contour(const RawPath& rawPath, const Mat2D& transform)
 {
     m_contourPoints.clear();
+    m_bounds = AABB::forExpansion();
 
     // Possible perf consideration: could add second path that doesn't transform
     // if transform is the identity.
@@ -95,3 +96,20 @@ void SegmentedContour::contour(const RawPath& rawPath, const Mat2D& transform)
         }
     }
 }
+
+void SegmentedContour::segment(const RawPath& rawPath)
+{
+    contour(rawPath, Mat2D());
+    m_localPoints.swap(m_contourPoints);
+    m_contourPoints.clear();
+}
+
+void SegmentedContour::transform(const Mat2D& transform)
+{
+    m_contourPoints.clear();
+    m_bounds = AABB::forExpansion();
+    for (Vec2D point : m_localPoints)
+    {
+        addVertex(transform * point);
+    }
+}
@@ -0,0 +1,285 @@
+//
+// Copyright 2024 Rive
+//
+
+#ifndef _RIVE_SOKOL_STREAM_ARENA_HPP_
+#define _RIVE_SOKOL_STREAM_ARENA_HPP_
+
+#include "rive/math/mat2d.hpp"
+#include "rive/math/mat4.hpp"
+#include "rive/renderer.hpp"
+#include "rive/span.hpp"
+#include "sokol_gfx.h"
+#include "generated/shader.h"
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <vector>
+
+namespace rive
+{
+// Every path fill, stroke and clip drawn in a frame appends its triangles to this CPU-side arena.
+// flush() uploads the whole frame with a single update of one vertex and one index buffer, and
+// merges draws that share a pipeline and uniforms into a single sg_draw, so the number of paths
+// no longer drives buffer churn or draw calls.
+class SokolStreamArena
+{
+public:
+    // The largest vertex count uint16_t indices can address from one base vertex.
+    static constexpr std::size_t kMaxSegmentVertices = 1 << 16;
+
+    ~SokolStreamArena()
+    {
+        // Nothing was ever flushed (and sokol may not even be set up) if the buffers are invalid.
+        if (m_vertexBuffer.id != SG_INVALID_ID)
+        {
+            sg_destroy_buffer(m_vertexBuffer);
+            sg_destroy_buffer(m_indexBuffer);
+        }
+    }
+
+    void reset()
+    {
+        m_vertices.clear();
+        m_indices.clear();
+        m_segmentBase = 0;
+        m_uniforms.clear();
+        m_draws.clear();
+        m_meshDraws.clear();
+    }
+
+    // Returns the index of the uniforms in this frame's table, sharing the previous entry when
+    // it is identical so that consecutive draws can be merged.
+    uint32_t pushUniforms(const vs_path_params_t& vertexUniforms,
+                          const fs_path_uniforms_t& fragmentUniforms)
+    {
+        if (!m_uniforms.empty() &&
+            memcmp(&m_uniforms.back().vertex, &vertexUniforms, sizeof(vs_path_params_t)) == 0 &&
+            memcmp(&m_uniforms.back().fragment, &fragmentUniforms, sizeof(fs_path_uniforms_t)) ==
+                0)
+        {
+            return (uint32_t)m_uniforms.size() - 1;
+        }
+        m_uniforms.push_back({vertexUniforms, fragmentUniforms});
+        return (uint32_t)m_uniforms.size() - 1;
+    }
+
+    // Appends triangles to the arena, mapping the vertices through transform when it is
+    // non-null.
+    void appendTriangles(Span<const Vec2D> vertices,
+                         Span<const uint16_t> indices,
+                         const Mat2D* transform,
+                         sg_pipeline pipeline,
+                         uint32_t uniformIndex)
+    {
+        if (vertices.empty() || indices.empty())
+        {
+            return;
+        }
+        assert(vertices.size() <= kMaxSegmentVertices);
+        std::size_t vertexStart = m_vertices.size();
+        if (vertexStart + vertices.size() - m_segmentBase > kMaxSegmentVertices)
+        {
+            m_segmentBase = vertexStart;
+        }
+        if (transform != nullptr)
+        {
+            m_vertices.reserve(vertexStart + vertices.size());
+            for (const Vec2D& vertex : vertices)
+            {
+                m_vertices.push_back(*transform * vertex);
+            }
+        }
+        else
+        {
+            m_vertices.insert(m_vertices.end(), vertices.begin(), vertices.end());
+        }
+
+        auto rebase = (uint16_t)(vertexStart - m_segmentBase);
+        auto indexStart = (uint32_t)m_indices.size();
+        m_indices.reserve(indexStart + indices.size());
+        for (uint16_t index : indices)
+        {
+            m_indices.push_back(index + rebase);
+        }
+
+        if (!m_draws.empty())
+        {
+            Draw& last = m_draws.back();
+            if (last.meshIndex < 0 && last.pipeline.id == pipeline.id &&
+                last.uniformIndex == uniformIndex && last.baseVertex == m_segmentBase &&
+                last.indexStart + last.indexCount == indexStart)
+            {
+                last.indexCount += (uint32_t)indices.size();
+                return;
+            }
+        }
+        m_draws.push_back({
+            .pipeline = pipeline,
+            .meshIndex = -1,
+            .uniformIndex = uniformIndex,
+            .baseVertex = m_segmentBase,
+            .indexStart = indexStart,
+            .indexCount = (uint32_t)indices.size(),
+        });
+    }
+
+    // Records a draw that binds its own buffers (images and image meshes). The references keep
+    // those buffers alive until the frame is flushed.
+    void appendMesh(sg_pipeline pipeline,
+                    const sg_bindings& bindings,
+                    const vs_params_t& uniforms,
+                    uint32_t indexCount,
+                    rcp<const RenderImage> image,
+                    std::vector<rcp<RenderBuffer>> buffers)
+    {
+        m_draws.push_back({
+            .pipeline = pipeline,
+            .meshIndex = (int)m_meshDraws.size(),
+            .indexCount = indexCount,
+        });
+        m_meshDraws.push_back({bindings, uniforms, std::move(image), std::move(buffers)});
+    }
+
+    void flush()
+    {
+        if (!m_vertices.empty())
+        {
+            reserve(m_vertexBuffer,
+                    m_vertexCapacity,
+                    m_vertices.size() * sizeof(Vec2D),
+                    SG_BUFFERTYPE_VERTEXBUFFER);
+            reserve(m_indexBuffer,
+                    m_indexCapacity,
+                    m_indices.size() * sizeof(uint16_t),
+                    SG_BUFFERTYPE_INDEXBUFFER);
+            sg_update_buffer(m_vertexBuffer,
+                             sg_range{
+                                 .ptr = m_vertices.data(),
+                                 .size = m_vertices.size() * sizeof(Vec2D),
+                             });
+            sg_update_buffer(m_indexBuffer,
+                             sg_range{
+                                 .ptr = m_indices.data(),
+                                 .size = m_indices.size() * sizeof(uint16_t),
+                             });
+        }
+
+        sg_pipeline currentPipeline = {0};
+        std::size_t currentBaseVertex = ~std::size_t(0);
+        uint32_t currentUniforms = ~uint32_t(0);
+        for (const Draw& draw : m_draws)
+        {
+            if (draw.pipeline.id != currentPipeline.id)
+            {
+                currentPipeline = draw.pipeline;
+                sg_apply_pipeline(currentPipeline);
+                // Bindings and uniforms have to be applied again after switching pipelines.
+                currentBaseVertex = ~std::size_t(0);
+                currentUniforms = ~uint32_t(0);
+            }
+
+            if (draw.meshIndex >= 0)
+            {
+                const MeshDraw& mesh = m_meshDraws[draw.meshIndex];
+                sg_apply_bindings(&mesh.bindings);
+                sg_apply_uniforms(SG_SHADERSTAGE_VS, SLOT_vs_params, SG_RANGE_REF(mesh.uniforms));
+                sg_draw(0, draw.indexCount, 1);
+                currentBaseVertex = ~std::size_t(0);
+                currentUniforms = ~uint32_t(0);
+                continue;
+            }
+
+            if (draw.baseVertex != currentBaseVertex)
+            {
+                currentBaseVertex = draw.baseVertex;
+                sg_bindings bind = {
+                    .vertex_buffers[0] = m_vertexBuffer,
+                    .vertex_buffer_offsets[0] = (int)(currentBaseVertex * sizeof(Vec2D)),
+                    .index_buffer = m_indexBuffer,
+                };
+                sg_apply_bindings(&bind);
+            }
+            if (draw.uniformIndex != currentUniforms)
+            {
+                currentUniforms = draw.uniformIndex;
+                const PathUniforms& uniforms = m_uniforms[currentUniforms];
+                sg_apply_uniforms(SG_SHADERSTAGE_VS,
+                                  SLOT_vs_path_params,
+                                  SG_RANGE_REF(uniforms.vertex));
+                sg_apply_uniforms(SG_SHADERSTAGE_FS,
+                                  SLOT_fs_path_uniforms,
+                                  SG_RANGE_REF(uniforms.fragment));
+            }
+            sg_draw(draw.indexStart, draw.indexCount, 1);
+        }
+        reset();
+    }
+
+#ifdef TESTING
+    const std::vector<Vec2D>& vertices() const { return m_vertices; }
+    const std::vector<uint16_t>& indices() const { return m_indices; }
+    std::size_t uniformCount() const { return m_uniforms.size(); }
+    const auto& draws() const { return m_draws; }
+#endif
+
+private:
+    struct PathUniforms
+    {
+        vs_path_params_t vertex;
+        fs_path_uniforms_t fragment;
+    };
+
+    struct Draw
+    {
+        sg_pipeline pipeline;
+        // Index into m_meshDraws, or -1 for triangles stored in the arena.
+        int meshIndex = -1;
+        uint32_t uniformIndex = 0;
+        std::size_t baseVertex = 0;
+        uint32_t indexStart = 0;
+        uint32_t indexCount = 0;
+    };
+
+    struct MeshDraw
+    {
+        sg_bindings bindings;
+        vs_params_t uniforms;
+        rcp<const RenderImage> image;
+        std::vector<rcp<RenderBuffer>> buffers;
+    };
+
+    static void reserve(sg_buffer& buffer,
+                        std::size_t& capacity,
+                        std::size_t size,
+                        sg_buffer_type type)
+    {
+        if (size <= capacity)
+        {
+            return;
+        }
+        capacity = std::max(size, std::max(capacity * 2, (std::size_t)64 * 1024));
+        sg_destroy_buffer(buffer);
+        buffer = sg_make_buffer((sg_buffer_desc){
+            .size = capacity,
+            .usage = SG_USAGE_STREAM,
+            .type = type,
+        });
+    }
+
+    std::vector<Vec2D> m_vertices;
+    std::vector<uint16_t> m_indices;
+    // First vertex of the range the most recently appended indices are relative to.
+    std::size_t m_segmentBase = 0;
+    std::vector<PathUniforms> m_uniforms;
+    std::vector<Draw> m_draws;
+    std::vector<MeshDraw> m_meshDraws;
+
+    sg_buffer m_vertexBuffer = {0};
+    sg_buffer m_indexBuffer = {0};
+    std::size_t m_vertexCapacity = 0;
+    std::size_t m_indexCapacity = 0;
+};
+} // namespace rive
+
+#endif
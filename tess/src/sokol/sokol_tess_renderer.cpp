@@ -2,7 +2,9 @@
 #include "rive/tess/sokol/sokol_factory.hpp"
 #include "rive/tess/tess_render_path.hpp"
 #include "rive/tess/contour_stroke.hpp"
-#include "generated/shader.h"
+#include "sokol_stream_arena.hpp"
+#include <algorithm>
+#include <cstring>
 #include <unordered_set>
 
 using namespace rive;
@@ -21,35 +23,31 @@ public:
     SokolRenderPath() {}
     SokolRenderPath(RawPath& rawPath, FillRule fillRule) : lite_rtti_override(rawPath, fillRule) {}
 
-    ~SokolRenderPath()
-    {
-        sg_destroy_buffer(m_vertexBuffer);
-        sg_destroy_buffer(m_indexBuffer);
-    }
-
 private:
+    // The triangulation is kept on the CPU across frames and streamed into the frame's arena
+    // every time the path is drawn.
     std::vector<Vec2D> m_vertices;
     std::vector<uint16_t> m_indices;
 
-    sg_buffer m_vertexBuffer = {0};
-    sg_buffer m_indexBuffer = {0};
-
-    std::size_t m_boundsIndex = 0;
-
 protected:
     void addTriangles(rive::Span<const rive::Vec2D> vts, rive::Span<const uint16_t> idx) override
     {
+        // Sub-paths of a container can each add triangles, with indices relative to their own
+        // vertices.
+        auto rebase = (uint16_t)m_vertices.size();
         m_vertices.insert(m_vertices.end(), vts.begin(), vts.end());
-        m_indices.insert(m_indices.end(), idx.begin(), idx.end());
+        for (uint16_t index : idx)
+        {
+            m_indices.push_back(index + rebase);
+        }
     }
 
-    void setTriangulatedBounds(const AABB& value) override
+    void setTriangulatedBounds(const AABB& value) override {}
+
+    void resetTriangles() override
     {
-        m_boundsIndex = m_vertices.size();
-        m_vertices.emplace_back(Vec2D(value.minX, value.minY));
-        m_vertices.emplace_back(Vec2D(value.maxX, value.minY));
-        m_vertices.emplace_back(Vec2D(value.maxX, value.maxY));
-        m_vertices.emplace_back(Vec2D(value.minX, value.maxY));
+        m_vertices.clear();
+        m_indices.clear();
     }
 
 public:
@@ -60,82 +58,26 @@ public:
         m_indices.clear();
     }
 
-    void drawStroke(ContourStroke* stroke)
+    // Streams the fill into the arena, triangulated for drawing with the given world transform.
+    // When streamVertexTransform is true the vertices are mapped to world space on the way.
+    void drawFill(SokolStreamArena& arena,
+                  const Mat2D& world,
+                  bool streamVertexTransform,
+                  sg_pipeline pipeline,
+                  uint32_t uniformIndex)
     {
-        if (isContainer())
+        if (triangulate(world.findMaxScale()) &&
+            m_vertices.size() > SokolStreamArena::kMaxSegmentVertices)
         {
-            for (auto& subPath : m_subPaths)
-            {
-                LITE_RTTI_CAST_OR_CONTINUE(sokolPath, SokolRenderPath*, subPath.path());
-                sokolPath->drawStroke(stroke);
-            }
-            return;
+            // Not addressable with 16 bit indices.
+            m_vertices.clear();
+            m_indices.clear();
         }
-        std::size_t start, end;
-        stroke->nextRenderOffset(start, end);
-        sg_draw(start < 2 ? 0 : (start - 2) * 3, end - start < 2 ? 0 : (end - start - 2) * 3, 1);
-    }
-
-    void drawFill()
-    {
-        if (triangulate())
-        {
-            sg_destroy_buffer(m_vertexBuffer);
-            sg_destroy_buffer(m_indexBuffer);
-            if (m_indices.size() == 0 || m_vertices.size() == 0)
-            {
-                m_vertexBuffer = {0};
-                m_indexBuffer = {0};
-                return;
-            }
-
-            m_vertexBuffer = sg_make_buffer((sg_buffer_desc){
-                .type = SG_BUFFERTYPE_VERTEXBUFFER,
-                .data =
-                    {
-                        m_vertices.data(),
-                        m_vertices.size() * sizeof(Vec2D),
-                    },
-            });
-
-            m_indexBuffer = sg_make_buffer((sg_buffer_desc){
-                .type = SG_BUFFERTYPE_INDEXBUFFER,
-                .data =
-                    {
-                        m_indices.data(),
-                        m_indices.size() * sizeof(uint16_t),
-                    },
-            });
-        }
-
-        if (m_vertexBuffer.id == 0)
-        {
-            return;
-        }
-
-        sg_bindings bind = {
-            .vertex_buffers[0] = m_vertexBuffer,
-            .index_buffer = m_indexBuffer,
-        };
-
-        sg_apply_bindings(&bind);
-        sg_draw(0, m_indices.size(), 1);
-    }
-
-    void drawBounds(const sg_buffer& boundsIndexBuffer)
-    {
-        if (m_vertexBuffer.id == 0)
-        {
-            return;
-        }
-        sg_bindings bind = {
-            .vertex_buffers[0] = m_vertexBuffer,
-            .vertex_buffer_offsets[0] = (int)(m_boundsIndex * sizeof(Vec2D)),
-            .index_buffer = boundsIndexBuffer,
-        };
-
-        sg_apply_bindings(&bind);
-        sg_draw(0, 6, 1);
+        arena.appendTriangles(m_vertices,
+                              m_indices,
+                              streamVertexTransform ? &world : nullptr,
+                              pipeline,
+                              uniformIndex);
     }
 };
 
@@ -260,7 +202,7 @@ sg_pipeline vectorPipeline(sg_shader shader,
     });
 }
 
-SokolTessRenderer::SokolTessRenderer()
+SokolTessRenderer::SokolTessRenderer() : m_arena(rivestd::make_unique<SokolStreamArena>())
 {
     m_meshPipeline = sg_make_pipeline((sg_pipeline_desc){
         .layout =
@@ -587,7 +529,6 @@ void SokolTessRenderer::drawImage(const RenderImage* image, BlendMode, float opa
     const Mat2D& world = transform();
     vs_params.mvp = m_Projection * world;
 
-    setPipeline(m_meshPipeline);
     sg_bindings bind = {
         .vertex_buffers[0] = sokolImage->vertexBuffer(),
         .vertex_buffers[1] = sokolImage->uvBuffer(),
@@ -595,9 +536,7 @@ void SokolTessRenderer::drawImage(const RenderImage* image, BlendMode, float opa
         .fs_images[SLOT_tex] = sokolImage->image(),
     };
 
-    sg_apply_bindings(&bind);
-    sg_apply_uniforms(SG_SHADERSTAGE_VS, SLOT_vs_params, SG_RANGE_REF(vs_params));
-    sg_draw(0, 6, 1);
+    m_arena->appendMesh(m_meshPipeline, bind, vs_params, 6, ref_rcp(image), {});
 }
 
 void SokolTessRenderer::drawImageMesh(const RenderImage* renderImage,
@@ -619,7 +558,6 @@ void SokolTessRenderer::drawImageMesh(const RenderImage* renderImage,
     const Mat2D& world = transform();
     vs_params.mvp = m_Projection * world;
 
-    setPipeline(m_meshPipeline);
     sg_bindings bind = {
         .vertex_buffers[0] = sokolVertices->buffer(),
         .vertex_buffers[1] = sokolUVCoords->buffer(),
@@ -627,9 +565,12 @@ void SokolTessRenderer::drawImageMesh(const RenderImage* renderImage,
         .fs_images[SLOT_tex] = sokolRenderImage->image(),
     };
 
-    sg_apply_bindings(&bind);
-    sg_apply_uniforms(SG_SHADERSTAGE_VS, SLOT_vs_params, SG_RANGE_REF(vs_params));
-    sg_draw(0, indexCount, 1);
+    m_arena->appendMesh(m_meshPipeline,
+                        bind,
+                        vs_params,
+                        indexCount,
+                        ref_rcp(renderImage),
+                        {std::move(vertices_f32), std::move(uvCoords_f32), std::move(indices_u16)});
 }
 
 class SokolGradient : public lite_rtti_override<RenderShader, SokolGradient>
@@ -739,19 +680,12 @@ private:
     StrokeJoin m_strokeJoin;
     StrokeCap m_strokeCap;
 
-    sg_buffer m_strokeVertexBuffer = {0};
-    sg_buffer m_strokeIndexBuffer = {0};
-    std::vector<std::size_t> m_StrokeOffsets;
+    // Extruded stroke triangles, kept until the stroke is invalidated.
+    std::vector<uint16_t> m_strokeIndices;
 
     BlendMode m_blendMode = BlendMode::srcOver;
 
 public:
-    ~SokolRenderPaint() override
-    {
-        sg_destroy_buffer(m_strokeVertexBuffer);
-        sg_destroy_buffer(m_strokeIndexBuffer);
-    }
-
     void color(ColorInt value) override
     {
         fillColorBuffer(m_uniforms.colors[0], value);
@@ -811,119 +745,92 @@ public:
         m_shader = lite_rtti_rcp_cast<SokolGradient>(std::move(shader));
     }
 
-    void draw(vs_path_params_t& vertexUniforms, SokolRenderPath* path)
+    void draw(SokolStreamArena& arena,
+              const Mat4& projection,
+              const Mat2D& world,
+              sg_pipeline pipeline,
+              SokolRenderPath* path)
     {
+        vs_path_params_t vertexUniforms = {.fillType = 0};
         if (m_shader)
         {
             m_shader->bind(vertexUniforms, m_uniforms);
         }
 
-        sg_apply_uniforms(SG_SHADERSTAGE_VS, SLOT_vs_path_params, SG_RANGE_REF(vertexUniforms));
-        sg_apply_uniforms(SG_SHADERSTAGE_FS, SLOT_fs_path_uniforms, SG_RANGE_REF(m_uniforms));
-        if (m_stroke != nullptr)
+        // Solid colors don't depend on local coordinates, so their vertices are mapped to world
+        // space while streaming. That keeps the uniforms independent of the transform and lets
+        // consecutive draws of the same color merge. Gradients are evaluated in local space and
+        // keep the transform in their uniforms.
+        const Mat2D* vertexTransform = nullptr;
+        if (vertexUniforms.fillType == 0)
         {
-            if (m_strokeDirty)
-            {
-                static Mat2D identity;
-                m_stroke->reset();
-                path->extrudeStroke(m_stroke.get(),
-                                    m_strokeJoin,
-                                    m_strokeCap,
-                                    m_strokeThickness / 2.0f,
-                                    identity);
-                m_strokeDirty = false;
+            vertexUniforms.mvp = projection;
+            vertexTransform = &world;
+        }
+        else
+        {
+            vertexUniforms.mvp = projection * world;
+        }
+        uint32_t uniformIndex = arena.pushUniforms(vertexUniforms, m_uniforms);
 
-                const std::vector<Vec2D>& strip = m_stroke->triangleStrip();
+        if (m_stroke == nullptr)
+        {
+            path->drawFill(arena, world, vertexTransform != nullptr, pipeline, uniformIndex);
+            return;
+        }
 
-                sg_destroy_buffer(m_strokeVertexBuffer);
-                sg_destroy_buffer(m_strokeIndexBuffer);
-                auto size = strip.size();
-                if (size <= 2)
+        if (m_strokeDirty)
+        {
+            static Mat2D identity;
+            m_stroke->reset();
+            path->extrudeStroke(m_stroke.get(),
+                                m_strokeJoin,
+                                m_strokeCap,
+                                m_strokeThickness / 2.0f,
+                                identity);
+            m_strokeDirty = false;
+
+            // Let's use a tris index buffer so we can keep the same sokol pipeline.
+            m_strokeIndices.clear();
+
+            // Build them by stroke offsets (where each offset represents a sub-path, or a move
+            // to)
+            m_stroke->resetRenderOffset();
+            while (true)
+            {
+                std::size_t strokeStart, strokeEnd;
+                if (!m_stroke->nextRenderOffset(strokeStart, strokeEnd))
                 {
-                    m_strokeVertexBuffer = {0};
-                    m_strokeIndexBuffer = {0};
-                    return;
+                    break;
                 }
-
-                m_strokeVertexBuffer = sg_make_buffer((sg_buffer_desc){
-                    .type = SG_BUFFERTYPE_VERTEXBUFFER,
-                    .data =
-                        {
-                            strip.data(),
-                            strip.size() * sizeof(Vec2D),
-                        },
-                });
-
-                // Let's use a tris index buffer so we can keep the same sokol pipeline.
-                std::vector<uint16_t> indices;
-
-                // Build them by stroke offsets (where each offset represents a sub-path, or a move
-                // to)
-                m_stroke->resetRenderOffset();
-                m_StrokeOffsets.clear();
-                while (true)
+                std::size_t length = strokeEnd - strokeStart;
+                if (length > 2)
                 {
-                    std::size_t strokeStart, strokeEnd;
-                    if (!m_stroke->nextRenderOffset(strokeStart, strokeEnd))
+                    for (std::size_t i = 0, end = length - 2; i < end; i++)
                     {
-                        break;
-                    }
-                    std::size_t length = strokeEnd - strokeStart;
-                    if (length > 2)
-                    {
-                        for (std::size_t i = 0, end = length - 2; i < end; i++)
+                        if ((i % 2) == 1)
                         {
-                            if ((i % 2) == 1)
-                            {
-                                indices.push_back(i + strokeStart);
-                                indices.push_back(i + 1 + strokeStart);
-                                indices.push_back(i + 2 + strokeStart);
-                            }
-                            else
-                            {
-                                indices.push_back(i + strokeStart);
-                                indices.push_back(i + 2 + strokeStart);
-                                indices.push_back(i + 1 + strokeStart);
-                            }
+                            m_strokeIndices.push_back(i + strokeStart);
+                            m_strokeIndices.push_back(i + 1 + strokeStart);
+                            m_strokeIndices.push_back(i + 2 + strokeStart);
+                        }
+                        else
+                        {
+                            m_strokeIndices.push_back(i + strokeStart);
+                            m_strokeIndices.push_back(i + 2 + strokeStart);
+                            m_strokeIndices.push_back(i + 1 + strokeStart);
                         }
-                        m_StrokeOffsets.push_back(indices.size());
                     }
                 }
-
-                m_strokeIndexBuffer = sg_make_buffer((sg_buffer_desc){
-                    .type = SG_BUFFERTYPE_INDEXBUFFER,
-                    .data =
-                        {
-                            indices.data(),
-                            indices.size() * sizeof(uint16_t),
-                        },
-                });
-            }
-            if (m_strokeVertexBuffer.id == 0)
-            {
-                return;
-            }
-
-            sg_bindings bind = {
-                .vertex_buffers[0] = m_strokeVertexBuffer,
-                .index_buffer = m_strokeIndexBuffer,
-            };
-
-            sg_apply_bindings(&bind);
-
-            m_stroke->resetRenderOffset();
-            // path->drawStroke(m_stroke.get());
-            std::size_t start = 0;
-            for (auto end : m_StrokeOffsets)
-            {
-                sg_draw(start, end - start, 1);
-                start = end;
             }
         }
-        else
+
+        const std::vector<Vec2D>& strip = m_stroke->triangleStrip();
+        if (strip.size() <= 2 || strip.size() > SokolStreamArena::kMaxSegmentVertices)
         {
-            path->drawFill();
+            return;
         }
+        arena.appendTriangles(strip, m_strokeIndices, vertexTransform, pipeline, uniformIndex);
     }
 };
 
@@ -936,7 +843,6 @@ void SokolTessRenderer::restore()
     {
         // When we've fully restored, immediately update clip to not wait for next draw.
         applyClipping();
-        m_currentPipeline = {0};
     }
 }
 
@@ -968,8 +874,12 @@ void SokolTessRenderer::applyClipping()
         }
     }
 
+    // Clip paths only write stencil, so they all share the same uniforms with their vertices
+    // streamed in world space.
     vs_path_params_t vs_params = {.fillType = 0};
+    vs_params.mvp = m_Projection;
     fs_path_uniforms_t uniforms = {0};
+    uint32_t clipUniforms = m_arena->pushUniforms(vs_params, uniforms);
 
     // Decr any paths from the last clip that are gone.
     std::unordered_set<RenderPath*> alreadyApplied;
@@ -990,11 +900,11 @@ void SokolTessRenderer::applyClipping()
         {
             // Draw appliedPath.path() with decr pipeline
             LITE_RTTI_CAST_OR_CONTINUE(sokolPath, SokolRenderPath*, appliedPath.path());
-            setPipeline(m_decClipPipeline);
-            vs_params.mvp = m_Projection * appliedPath.transform();
-            sg_apply_uniforms(SG_SHADERSTAGE_VS, SLOT_vs_path_params, SG_RANGE_REF(vs_params));
-            sg_apply_uniforms(SG_SHADERSTAGE_FS, SLOT_fs_path_uniforms, SG_RANGE_REF(uniforms));
-            sokolPath->drawFill();
+            sokolPath->drawFill(*m_arena,
+                                appliedPath.transform(),
+                                true,
+                                m_decClipPipeline,
+                                clipUniforms);
         }
     }
 
@@ -1008,11 +918,11 @@ void SokolTessRenderer::applyClipping()
         }
         // Draw nextClipPath.path() with incr pipeline
         LITE_RTTI_CAST_OR_CONTINUE(sokolPath, SokolRenderPath*, nextClipPath.path());
-        setPipeline(m_incClipPipeline);
-        vs_params.mvp = m_Projection * nextClipPath.transform();
-        sg_apply_uniforms(SG_SHADERSTAGE_VS, SLOT_vs_path_params, SG_RANGE_REF(vs_params));
-        sg_apply_uniforms(SG_SHADERSTAGE_FS, SLOT_fs_path_uniforms, SG_RANGE_REF(uniforms));
-        sokolPath->drawFill();
+        sokolPath->drawFill(*m_arena,
+                            nextClipPath.transform(),
+                            true,
+                            m_incClipPipeline,
+                            clipUniforms);
     }
 
     // Pick which pipeline to use for draw path operations.
@@ -1022,15 +932,25 @@ void SokolTessRenderer::applyClipping()
     m_ClipPaths = state.clipPaths;
 }
 
-void SokolTessRenderer::reset() { m_currentPipeline = {0}; }
-void SokolTessRenderer::setPipeline(sg_pipeline pipeline)
+void SokolTessRenderer::reset() { m_arena->reset(); }
+
+void SokolTessRenderer::flush() { m_arena->flush(); }
+
+sg_pipeline SokolTessRenderer::pathPipeline(BlendMode blendMode) const
 {
-    if (m_currentPipeline.id == pipeline.id)
+    switch (blendMode)
     {
-        return;
+        case BlendMode::srcOver:
+            return m_pathPipeline[m_clipCount];
+        case BlendMode::screen:
+            return m_pathScreenPipeline[m_clipCount];
+        case BlendMode::colorDodge:
+            return m_pathAdditivePipeline[m_clipCount];
+        case BlendMode::multiply:
+            return m_pathMultiplyPipeline[m_clipCount];
+        default:
+            return m_pathScreenPipeline[m_clipCount];
     }
-    m_currentPipeline = pipeline;
-    sg_apply_pipeline(pipeline);
 }
 
 void SokolTessRenderer::drawPath(RenderPath* path, RenderPaint* paint)
@@ -1039,30 +959,11 @@ void SokolTessRenderer::drawPath(RenderPath* path, RenderPaint* paint)
     LITE_RTTI_CAST_OR_RETURN(sokolPaint, SokolRenderPaint*, paint);
 
     applyClipping();
-    vs_path_params_t vs_params = {.fillType = 0};
-    const Mat2D& world = transform();
-
-    vs_params.mvp = m_Projection * world;
-    switch (sokolPaint->blendMode())
-    {
-        case BlendMode::srcOver:
-            setPipeline(m_pathPipeline[m_clipCount]);
-            break;
-        case BlendMode::screen:
-            setPipeline(m_pathScreenPipeline[m_clipCount]);
-            break;
-        case BlendMode::colorDodge:
-            setPipeline(m_pathAdditivePipeline[m_clipCount]);
-            break;
-        case BlendMode::multiply:
-            setPipeline(m_pathMultiplyPipeline[m_clipCount]);
-            break;
-        default:
-            setPipeline(m_pathScreenPipeline[m_clipCount]);
-            break;
-    }
-
-    sokolPaint->draw(vs_params, sokolPath);
+    sokolPaint->draw(*m_arena,
+                     m_Projection,
+                     transform(),
+                     pathPipeline(sokolPaint->blendMode()),
+                     sokolPath);
 }
 
 SokolRenderImageResource::SokolRenderImageResource(const uint8_t* bytes,
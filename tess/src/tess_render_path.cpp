@@ -1,9 +1,18 @@
 #include "rive/tess/tess_render_path.hpp"
 #include "rive/tess/contour_stroke.hpp"
 #include "tesselator.h"
+#include <algorithm>
+#include <cmath>
 
 static const float contourThreshold = 1.0f;
 
+// Levels of detail are half octaves of scale, clamped to 1/256x - 256x.
+static const int minLevelOfDetail = -16;
+static const int maxLevelOfDetail = 16;
+
+// How many levels of detail a path keeps triangulations for.
+static const std::size_t maxCachedTriangulations = 4;
+
 using namespace rive;
 TessRenderPath::TessRenderPath() : m_segmentedContour(contourThreshold) {}
 TessRenderPath::TessRenderPath(RawPath& rawPath, FillRule fillRule) :
@@ -18,6 +27,7 @@ void TessRenderPath::rewind()
 {
     m_rawPath.rewind();
     m_subPaths.clear();
+    m_triangulations.clear();
     m_isContourDirty = m_isTriangulationDirty = true;
     m_isClosed = false;
 }
@@ -36,6 +46,20 @@ void TessRenderPath::close()
     m_isClosed = true;
 }
 
+void TessRenderPath::copy(const RawPath& rawPath)
+{
+    rewind();
+    m_rawPath = rawPath;
+    for (PathVerb verb : m_rawPath.verbs())
+    {
+        if (verb == PathVerb::close)
+        {
+            m_isClosed = true;
+            break;
+        }
+    }
+}
+
 void TessRenderPath::addRenderPath(RenderPath* path, const Mat2D& transform)
 {
     m_subPaths.emplace_back(SubPath(path, transform));
@@ -77,20 +101,80 @@ void stdFree(void* userData, void* ptr)
     free(ptr);
 }
 
-bool TessRenderPath::triangulate()
+int TessRenderPath::LevelOfDetail(float scale)
+{
+    // Also catches NaN.
+    if (!(scale > 0.0f))
+    {
+        return minLevelOfDetail;
+    }
+    // Round up so the device space tolerance is never coarser than
+    // contourThreshold, with a little slack so exact half octaves (most
+    // importantly 1.0) land on their own level.
+    float level = std::ceil(std::log2(scale) * 2.0f - 1e-3f);
+    return (int)std::max((float)minLevelOfDetail, std::min(level, (float)maxLevelOfDetail));
+}
+
+float TessRenderPath::LevelOfDetailScale(int level) { return std::exp2(level * 0.5f); }
+
+static void appendTriangles(std::vector<Vec2D>& vertices,
+                            std::vector<uint16_t>& indices,
+                            Span<const Vec2D> newVertices,
+                            Span<const uint16_t> newIndices)
+{
+    auto rebase = (uint16_t)vertices.size();
+    vertices.insert(vertices.end(), newVertices.begin(), newVertices.end());
+    for (uint16_t index : newIndices)
+    {
+        indices.push_back(index + rebase);
+    }
+}
+
+bool TessRenderPath::triangulate(float scale)
 {
-    if (!m_isTriangulationDirty)
+    int level = LevelOfDetail(scale);
+    if (m_isTriangulationDirty)
+    {
+        m_triangulations.clear();
+        m_isTriangulationDirty = false;
+    }
+    else if (level == m_triangulationLevel && !m_triangulations.empty())
     {
         return false;
     }
-    m_isTriangulationDirty = false;
-    triangulate(this);
+    m_triangulationLevel = level;
+
+    auto cached = std::find_if(m_triangulations.begin(),
+                               m_triangulations.end(),
+                               [level](const Triangulation& t) { return t.level == level; });
+    if (cached != m_triangulations.end())
+    {
+        // Move it to the back as the most recently used.
+        std::rotate(cached, cached + 1, m_triangulations.end());
+    }
+    else
+    {
+        if (m_triangulations.size() == maxCachedTriangulations)
+        {
+            m_triangulations.erase(m_triangulations.begin());
+        }
+        m_triangulations.push_back({level, {}, {}, AABB::forExpansion()});
+        triangulate(m_triangulations.back(), LevelOfDetailScale(level));
+    }
+
+    const Triangulation& triangulation = m_triangulations.back();
+    resetTriangles();
+    if (!triangulation.indices.empty())
+    {
+        addTriangles(triangulation.vertices, triangulation.indices);
+    }
+    setTriangulatedBounds(triangulation.bounds);
     return true;
 }
 
-void TessRenderPath::triangulate(TessRenderPath* containerPath)
+void TessRenderPath::triangulate(Triangulation& triangulation, float scale)
 {
-    AABB bounds = AABB::forExpansion();
+    AABB& bounds = triangulation.bounds;
     // If there's a single path, we're going to try to assume the user isn't
     // doing any funky self overlapping winding and we'll try to triangulate it
     // quickly as a single polygon.
@@ -99,15 +183,18 @@ void TessRenderPath::triangulate(TessRenderPath* containerPath)
         if (!empty())
         {
             Mat2D identity;
-            contour(identity);
+            contour(identity, scale);
 
-            bounds = m_segmentedContour.bounds();
+            bounds.expand(m_segmentedContour.bounds());
 
             auto contour = m_segmentedContour.contourPoints();
             auto contours = rive::make_span(&contour, 1);
             m_earcut(contours);
 
-            containerPath->addTriangles(contour, m_earcut.indices);
+            appendTriangles(triangulation.vertices,
+                            triangulation.indices,
+                            contour,
+                            m_earcut.indices);
         }
     }
     else if (m_subPaths.size() == 1)
@@ -119,18 +206,21 @@ void TessRenderPath::triangulate(TessRenderPath* containerPath)
         if (subRenderPath->isContainer())
         {
             // Nope, subpath is also a container, keep going.
-            subRenderPath->triangulate(containerPath);
+            subRenderPath->triangulate(triangulation, scale);
         }
         else if (!subRenderPath->empty())
         {
             // Yes, it's a single path with commands, triangulate it.
-            subRenderPath->contour(subPath.transform());
+            subRenderPath->contour(subPath.transform(), scale);
             const SegmentedContour& segmentedContour = subRenderPath->segmentedContour();
             auto contour = segmentedContour.contourPoints();
             auto contours = rive::make_span(&contour, 1);
             m_earcut(contours);
 
-            containerPath->addTriangles(contour, m_earcut.indices);
+            appendTriangles(triangulation.vertices,
+                            triangulation.indices,
+                            contour,
+                            m_earcut.indices);
         }
     }
     else
@@ -142,7 +232,7 @@ void TessRenderPath::triangulate(TessRenderPath* containerPath)
             auto subRenderPath = static_cast<TessRenderPath*>(subPath.path());
             if (subRenderPath->isContainer())
             {
-                subRenderPath->triangulate(containerPath);
+                subRenderPath->triangulate(triangulation, scale);
             }
             else if (!subRenderPath->empty())
             {
@@ -150,7 +240,7 @@ void TessRenderPath::triangulate(TessRenderPath* containerPath)
                 {
                     tess = tessNewTess(nullptr);
                 }
-                subRenderPath->contour(subPath.transform());
+                subRenderPath->contour(subPath.transform(), scale);
                 const SegmentedContour& segmentedContour = subRenderPath->segmentedContour();
                 auto contour = segmentedContour.contourPoints();
                 tessAddContour(tess, 2, contour.data(), sizeof(float) * 2, contour.size());
@@ -173,27 +263,38 @@ void TessRenderPath::triangulate(TessRenderPath* containerPath)
                     indices.push_back(elems[i]);
                 }
 
-                containerPath->addTriangles(
+                appendTriangles(
+                    triangulation.vertices,
+                    triangulation.indices,
                     Span<const rive::Vec2D>(reinterpret_cast<const Vec2D*>(verts), nverts),
                     indices);
             }
             tessDeleteTess(tess);
         }
     }
-
-    containerPath->setTriangulatedBounds(bounds);
 }
 
-void TessRenderPath::contour(const Mat2D& transform)
+void TessRenderPath::contour(const Mat2D& transform, float scale)
 {
-    if (!m_isContourDirty && transform == m_contourTransform)
+    int level = LevelOfDetail(scale * transform.findMaxScale());
+    if (m_isContourDirty || level != m_contourLevel)
+    {
+        // Segment in local space, with the threshold shrunk so that the error
+        // is contourThreshold once drawn at this level of detail.
+        m_isContourDirty = false;
+        m_contourLevel = level;
+        m_segmentedContour.threshold(contourThreshold / LevelOfDetailScale(level));
+        m_segmentedContour.segment(m_rawPath);
+    }
+    else if (transform == m_contourTransform)
     {
         return;
     }
 
-    m_isContourDirty = false;
+    // Translation and scale changes within the level only need the existing
+    // segments mapped again.
     m_contourTransform = transform;
-    m_segmentedContour.contour(m_rawPath, transform);
+    m_segmentedContour.transform(transform);
 }
 
 void TessRenderPath::extrudeStroke(ContourStroke* stroke,
@@ -0,0 +1,85 @@
+#include <catch.hpp>
+#include "../src/sokol/sokol_stream_arena.hpp"
+
+using namespace rive;
+
+static const std::vector<Vec2D> kTriangle = {{0.0f, 0.0f}, {10.0f, 0.0f}, {0.0f, 10.0f}};
+static const std::vector<uint16_t> kTriangleIndices = {0, 1, 2};
+
+TEST_CASE("solid color paths with different transforms merge into one draw", "[stream]")
+{
+    SokolStreamArena arena;
+    sg_pipeline pipeline = {1};
+    vs_path_params_t vertexUniforms = {.fillType = 0};
+    fs_path_uniforms_t fragmentUniforms = {0};
+    fragmentUniforms.colors[0][0] = 1.0f;
+
+    // Solid colors stream world space vertices, so their uniforms don't change with the
+    // transform and get shared.
+    Mat2D translateA = Mat2D::fromTranslate(5.0f, 0.0f);
+    Mat2D translateB = Mat2D::fromTranslate(0.0f, 7.0f);
+    uint32_t uniformsA = arena.pushUniforms(vertexUniforms, fragmentUniforms);
+    arena.appendTriangles(kTriangle, kTriangleIndices, &translateA, pipeline, uniformsA);
+    uint32_t uniformsB = arena.pushUniforms(vertexUniforms, fragmentUniforms);
+    arena.appendTriangles(kTriangle, kTriangleIndices, &translateB, pipeline, uniformsB);
+
+    REQUIRE(uniformsA == uniformsB);
+    REQUIRE(arena.uniformCount() == 1);
+    REQUIRE(arena.draws().size() == 1);
+    REQUIRE(arena.draws()[0].indexStart == 0);
+    REQUIRE(arena.draws()[0].indexCount == 6);
+    REQUIRE(arena.vertices().size() == 6);
+    REQUIRE(arena.vertices()[1] == Vec2D(15.0f, 0.0f));
+    REQUIRE(arena.vertices()[5] == Vec2D(0.0f, 17.0f));
+    REQUIRE(arena.indices() == std::vector<uint16_t>({0, 1, 2, 3, 4, 5}));
+
+    // Another color needs its own uniforms, and so its own draw.
+    fragmentUniforms.colors[0][0] = 0.5f;
+    uint32_t uniformsC = arena.pushUniforms(vertexUniforms, fragmentUniforms);
+    arena.appendTriangles(kTriangle, kTriangleIndices, nullptr, pipeline, uniformsC);
+    REQUIRE(uniformsC != uniformsA);
+    REQUIRE(arena.uniformCount() == 2);
+    REQUIRE(arena.draws().size() == 2);
+    REQUIRE(arena.draws()[1].indexStart == 6);
+    REQUIRE(arena.draws()[1].indexCount == 3);
+    REQUIRE(arena.vertices()[7] == Vec2D(10.0f, 0.0f));
+
+    // So does another pipeline, even with the same uniforms.
+    arena.appendTriangles(kTriangle, kTriangleIndices, nullptr, sg_pipeline{2}, uniformsC);
+    REQUIRE(arena.draws().size() == 3);
+
+    arena.reset();
+    REQUIRE(arena.vertices().empty());
+    REQUIRE(arena.indices().empty());
+    REQUIRE(arena.uniformCount() == 0);
+    REQUIRE(arena.draws().empty());
+}
+
+TEST_CASE("stream arena starts a new segment when indices overflow", "[stream]")
+{
+    SokolStreamArena arena;
+    sg_pipeline pipeline = {1};
+    vs_path_params_t vertexUniforms = {.fillType = 0};
+    fs_path_uniforms_t fragmentUniforms = {0};
+    uint32_t uniformIndex = arena.pushUniforms(vertexUniforms, fragmentUniforms);
+
+    std::vector<Vec2D> vertices(SokolStreamArena::kMaxSegmentVertices - 1);
+    std::vector<uint16_t> indices = {0, 1, 2};
+    arena.appendTriangles(vertices, indices, nullptr, pipeline, uniformIndex);
+    REQUIRE(arena.draws().size() == 1);
+
+    // The next triangle doesn't fit below 16-bit indices, so it's rebased onto a new base vertex
+    // and can't merge with the previous draw.
+    arena.appendTriangles(kTriangle, kTriangleIndices, nullptr, pipeline, uniformIndex);
+    REQUIRE(arena.draws().size() == 2);
+    REQUIRE(arena.draws()[1].baseVertex == SokolStreamArena::kMaxSegmentVertices - 1);
+    REQUIRE(arena.indices().size() == 6);
+    REQUIRE(arena.indices()[3] == 0);
+    REQUIRE(arena.indices()[5] == 2);
+
+    // Later triangles in the same segment merge again.
+    arena.appendTriangles(kTriangle, kTriangleIndices, nullptr, pipeline, uniformIndex);
+    REQUIRE(arena.draws().size() == 2);
+    REQUIRE(arena.draws()[1].indexCount == 6);
+    REQUIRE(arena.indices()[6] == 3);
+}
@@ -18,6 +18,12 @@ protected:
     }
 
     void setTriangulatedBounds(const rive::AABB& value) override {}
+
+    void resetTriangles() override
+    {
+        vertices.clear();
+        indices.clear();
+    }
 };
 
 TEST_CASE("simple triangle path triangulates as expected", "[file]")
@@ -40,4 +46,50 @@ TEST_CASE("simple triangle path triangulates as expected", "[file]")
     REQUIRE(shapeRenderPath.indices[0] == 2);
     REQUIRE(shapeRenderPath.indices[1] == 0);
     REQUIRE(shapeRenderPath.indices[2] == 1);
-}
\ No newline at end of file
+}
+
+TEST_CASE("level of detail steps in half octaves of scale", "[tess]")
+{
+    REQUIRE(rive::TessRenderPath::LevelOfDetail(1.0f) == 0);
+    REQUIRE(rive::TessRenderPath::LevelOfDetail(1.2f) == 1);
+    REQUIRE(rive::TessRenderPath::LevelOfDetail(2.0f) == 2);
+    REQUIRE(rive::TessRenderPath::LevelOfDetail(0.5f) == -2);
+    REQUIRE(rive::TessRenderPath::LevelOfDetail(0.0f) ==
+            rive::TessRenderPath::LevelOfDetail(-1.0f));
+    REQUIRE(rive::TessRenderPath::LevelOfDetail(1e9f) == rive::TessRenderPath::LevelOfDetail(1e8f));
+    for (float scale : {0.3f, 0.9f, 1.0f, 1.5f, 3.0f, 10.0f})
+    {
+        // A level's scale always covers the scale it was picked for.
+        REQUIRE(rive::TessRenderPath::LevelOfDetailScale(
+                    rive::TessRenderPath::LevelOfDetail(scale)) >= scale * 0.999f);
+    }
+}
+
+TEST_CASE("triangulation is cached per level of detail", "[tess]")
+{
+    TestRenderPath renderPath;
+    renderPath.moveTo(0.0f, 0.0f);
+    renderPath.cubicTo(50.0f, -20.0f, 100.0f, 20.0f, 100.0f, 100.0f);
+    renderPath.lineTo(0.0f, 100.0f);
+    renderPath.close();
+
+    REQUIRE(renderPath.triangulate(1.0f));
+    auto lowDetailVertices = renderPath.vertices;
+
+    // Scales within the same level reuse the triangles.
+    REQUIRE(!renderPath.triangulate(1.0f));
+    REQUIRE(!renderPath.triangulate(0.9f));
+
+    // Zooming in segments the curve more finely.
+    REQUIRE(renderPath.triangulate(8.0f));
+    REQUIRE(renderPath.vertices.size() > lowDetailVertices.size());
+
+    // Zooming back out hands back the cached triangles.
+    REQUIRE(renderPath.triangulate(1.0f));
+    REQUIRE(renderPath.vertices == lowDetailVertices);
+
+    // Changing the path throws the cache away.
+    renderPath.rewind();
+    REQUIRE(renderPath.triangulate(1.0f));
+    REQUIRE(renderPath.vertices.empty());
+}
@@ -31,14 +31,26 @@ private:
     void onUnmapAndSubmitBuffer(int bufferIdx, size_t bytesWritten) {}
 };
 
+class RenderTargetNULL : public rive::gpu::RenderTarget
+{
+public:
+    RenderTargetNULL(uint32_t width, uint32_t height) : RenderTarget(width, height) {}
+};
+
 rive::rcp<rive::gpu::RenderTarget> RenderContextNULL::makeRenderTarget(uint32_t width,
                                                                        uint32_t height)
 {
-    class RenderTargetNULL : public rive::gpu::RenderTarget
-    {
-    public:
-        RenderTargetNULL(uint32_t width, uint32_t height) : RenderTarget(width, height) {}
-    };
+    return rive::make_rcp<RenderTargetNULL>(width, height);
+}
+
+rive::rcp<rive::gpu::RenderTarget> RenderContextNULL::makeLayerRenderTarget(
+    uint32_t width,
+    uint32_t height,
+    rive::rcp<rive::gpu::Texture>* texture,
+    bool* textureIsBottomUp)
+{
+    *texture = make_rcp<Texture>(width, height);
+    *textureIsBottomUp = false;
     return rive::make_rcp<RenderTargetNULL>(width, height);
 }
 
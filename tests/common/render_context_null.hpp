@@ -25,6 +25,11 @@ private:
                                                    uint32_t mipLevelCount,
                                                    const uint8_t imageDataRGBA[]) override;
 
+    rive::rcp<rive::gpu::RenderTarget> makeLayerRenderTarget(uint32_t width,
+                                                             uint32_t height,
+                                                             rive::rcp<rive::gpu::Texture>*,
+                                                             bool* textureIsBottomUp) override;
+
     std::unique_ptr<rive::gpu::BufferRing> makeUniformBufferRing(size_t capacityInBytes) override;
     std::unique_ptr<rive::gpu::BufferRing> makeStorageBufferRing(
         size_t capacityInBytes,
@@ -0,0 +1,69 @@
+#ifndef _RIVE_KTX2_TEST_FILE_HPP_
+#define _RIVE_KTX2_TEST_FILE_HPP_
+
+#include <algorithm>
+#include <stdint.h>
+#include <vector>
+
+// Builds a minimal KTX2 file with a tightly packed mip chain. The last level is at the end of the
+// file, so tests can overwrite its contents.
+static inline std::vector<uint8_t> make_ktx2(uint32_t vkFormat,
+                                             uint32_t width,
+                                             uint32_t height,
+                                             uint32_t levelCount,
+                                             uint32_t supercompressionScheme = 0)
+{
+    const uint8_t identifier[] = {0xAB, 0x4B, 0x54, 0x58, 0x20, 0x32,
+                                  0x30, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A};
+    std::vector<uint8_t> bytes(identifier, identifier + sizeof(identifier));
+    auto pushU32 = [&bytes](uint32_t value) {
+        for (int i = 0; i < 4; ++i)
+        {
+            bytes.push_back(static_cast<uint8_t>(value >> (i * 8)));
+        }
+    };
+    auto pushU64 = [&](uint64_t value) {
+        pushU32(static_cast<uint32_t>(value));
+        pushU32(static_cast<uint32_t>(value >> 32));
+    };
+    pushU32(vkFormat);
+    pushU32(1); // typeSize
+    pushU32(width);
+    pushU32(height);
+    pushU32(0); // pixelDepth
+    pushU32(0); // layerCount
+    pushU32(1); // faceCount
+    pushU32(levelCount);
+    pushU32(supercompressionScheme);
+    for (int i = 0; i < 4; ++i)
+    {
+        pushU32(0); // dfd/kvd offsets and lengths
+    }
+    pushU64(0); // sgdByteOffset
+    pushU64(0); // sgdByteLength
+
+    bool isRGBA8 = vkFormat == 37;
+    size_t dataOffset = bytes.size() + levelCount * 24;
+    std::vector<size_t> levelSizes;
+    for (uint32_t i = 0; i < levelCount; ++i)
+    {
+        uint32_t w = std::max(width >> i, 1u);
+        uint32_t h = std::max(height >> i, 1u);
+        size_t size = isRGBA8 ? w * h * 4 : (w + 3) / 4 * ((h + 3) / 4) * 16;
+        pushU64(dataOffset);
+        pushU64(size);
+        pushU64(size); // uncompressedByteLength
+        dataOffset += size;
+        levelSizes.push_back(size);
+    }
+    for (size_t size : levelSizes)
+    {
+        for (size_t i = 0; i < size; ++i)
+        {
+            bytes.push_back(static_cast<uint8_t>(i));
+        }
+    }
+    return bytes;
+}
+
+#endif
@@ -0,0 +1,223 @@
+/*
+ * Copyright 2024 Rive
+ */
+
+#include "common/render_context_null.hpp"
+#include "rive/renderer/rive_renderer.hpp"
+#include "../src/damage_tracker.hpp"
+#include "../src/rive_render_paint.hpp"
+#include "../src/rive_render_path.hpp"
+#include <catch.hpp>
+#include <functional>
+
+namespace rive::gpu
+{
+// Records the descriptor of the most recent logical flush.
+class RenderContextRecordFlush : public RenderContextNULL
+{
+public:
+    void flush(const FlushDescriptor& desc) override
+    {
+        colorLoadAction = desc.colorLoadAction;
+        renderTargetUpdateBounds = desc.renderTargetUpdateBounds;
+        pathCount = desc.pathCount - 1; // The first path record is reserved for the clear color.
+    }
+
+    LoadAction colorLoadAction;
+    IAABB renderTargetUpdateBounds;
+    uint32_t pathCount;
+};
+
+class TestRenderTarget : public RenderTarget
+{
+public:
+    TestRenderTarget(uint32_t width, uint32_t height) : RenderTarget(width, height) {}
+};
+
+TEST_CASE("DamageTracker", "[damage_tracking]")
+{
+    TestRenderTarget renderTarget(100, 100);
+    DamageTracker tracker;
+    auto findDamage = [&](std::vector<std::pair<uint64_t, IAABB>> draws) {
+        tracker.beginFrame();
+        for (const auto& [key, bounds] : draws)
+        {
+            tracker.addDraw(key, bounds);
+        }
+        return tracker.findDamage(&renderTarget, 0xff000000, InterlockMode::rasterOrdering);
+    };
+
+    const IAABB a = {0, 0, 10, 10};
+    const IAABB b = {20, 20, 30, 30};
+    const IAABB c = {40, 40, 50, 50};
+    CHECK(findDamage({{1, a}, {2, b}}) == renderTarget.bounds()); // No previous frame.
+    CHECK(findDamage({{1, a}, {2, b}}).empty());
+    CHECK(findDamage({{1, a}, {2, b}, {3, c}}) == c);         // Added.
+    CHECK(findDamage({{1, a}, {3, c}}) == b);                 // Removed.
+    CHECK(findDamage({{1, a}, {4, b}, {3, c}}) == b);         // Changed.
+    CHECK(findDamage({{3, c}, {1, a}, {4, b}}) == a.join(b)); // Reordered.
+    CHECK(findDamage({{3, c}, {1, a}, {4, b}}).empty());
+
+    // Duplicate keys match in order.
+    CHECK(findDamage({{1, a}, {1, a}}) == a.join(b).join(c));
+    CHECK(findDamage({{1, a}, {1, a}}).empty());
+    CHECK(findDamage({{1, a}}) == a);
+
+    // Some draws never match.
+    CHECK(findDamage({{Draw::kAlwaysDamagedContentKey, c}}) == a.join(c));
+    CHECK(findDamage({{Draw::kAlwaysDamagedContentKey, c}}) == c);
+
+    // Frames that can't be compared are entirely damaged.
+    tracker.beginFrame();
+    CHECK(tracker.findDamage(&renderTarget, 0xffffffff, InterlockMode::rasterOrdering) ==
+          renderTarget.bounds());
+    tracker.beginFrame();
+    CHECK(tracker.findDamage(&renderTarget, 0xffffffff, InterlockMode::atomics) ==
+          renderTarget.bounds());
+    TestRenderTarget otherRenderTarget(100, 100);
+    tracker.beginFrame();
+    CHECK(tracker.findDamage(&otherRenderTarget, 0xffffffff, InterlockMode::atomics) ==
+          renderTarget.bounds());
+    tracker.reset();
+    tracker.beginFrame();
+    CHECK(tracker.findDamage(&otherRenderTarget, 0xffffffff, InterlockMode::atomics) ==
+          renderTarget.bounds());
+    tracker.beginFrame();
+    CHECK(tracker.findDamage(&otherRenderTarget, 0xffffffff, InterlockMode::atomics).empty());
+}
+
+TEST_CASE("DamageTrackingFlush", "[damage_tracking]")
+{
+    auto renderContext =
+        std::make_unique<RenderContext>(std::make_unique<RenderContextRecordFlush>());
+    auto impl = renderContext->static_impl_cast<RenderContextRecordFlush>();
+    auto renderTarget = impl->makeRenderTarget(100, 100);
+    RenderContext::FrameDescriptor frameDescriptor;
+    frameDescriptor.renderTargetWidth = 100;
+    frameDescriptor.renderTargetHeight = 100;
+    frameDescriptor.clearColor = 0xff000000;
+    frameDescriptor.damageTracking = true;
+    auto drawFrame = [&](std::function<void(RiveRenderer*)> draw) {
+        renderContext->beginFrame(frameDescriptor);
+        RiveRenderer renderer(renderContext.get());
+        draw(&renderer);
+        renderContext->flush({.renderTarget = renderTarget.get()});
+        return renderContext->damageBounds();
+    };
+
+    auto rect = [](float l, float t, float r, float b) {
+        auto path = make_rcp<RiveRenderPath>();
+        path->addRect(l, t, r - l, b - t);
+        return path;
+    };
+    auto paint = [](ColorInt color) {
+        auto paint = make_rcp<RiveRenderPaint>();
+        paint->color(color);
+        return paint;
+    };
+    auto background = rect(0, 0, 100, 100);
+    auto a = rect(10, 10, 20, 20);
+    auto b = rect(50, 50, 60, 60);
+    auto gray = paint(0xff808080);
+    auto red = paint(0xffff0000);
+    auto blue = paint(0xff0000ff);
+    auto scene = [&](RiveRenderer* r) {
+        r->drawPath(background.get(), gray.get());
+        r->drawPath(a.get(), red.get());
+        r->drawPath(b.get(), blue.get());
+    };
+
+    CHECK(drawFrame(scene) == renderTarget->bounds());
+    CHECK(impl->colorLoadAction == LoadAction::clear);
+    CHECK(impl->pathCount == 3);
+
+    // Nothing changed.
+    CHECK(drawFrame(scene).empty());
+    CHECK(impl->colorLoadAction == LoadAction::preserveRenderTarget);
+    CHECK(impl->renderTargetUpdateBounds.empty());
+    CHECK(impl->pathCount == 0);
+
+    // Only the old and new bounds of "a" get redrawn. The background gets clipped to them, and
+    // hides the draw that clears them, so only it and "a" are left.
+    a->rewind();
+    a->addRect(12, 10, 10, 10);
+    CHECK(drawFrame(scene) == IAABB{10, 10, 22, 20});
+    CHECK(impl->colorLoadAction == LoadAction::preserveRenderTarget);
+    CHECK(impl->renderTargetUpdateBounds == IAABB{10, 10, 22, 20});
+    CHECK(impl->pathCount == 2);
+    CHECK(renderContext->occlusionCulledDrawCount() == 1);
+
+    // Paint changes are damage too.
+    blue->color(0xff0000fe);
+    CHECK(drawFrame(scene) == IAABB{50, 50, 60, 60});
+
+    // Reordering damages the draw that moved back.
+    CHECK(drawFrame([&](RiveRenderer* r) {
+              r->drawPath(background.get(), gray.get());
+              r->drawPath(b.get(), blue.get());
+              r->drawPath(a.get(), red.get());
+          }) == IAABB{12, 10, 22, 20});
+    CHECK(drawFrame(scene) == IAABB{50, 50, 60, 60});
+
+    // Changing a clip damages the draws that read it.
+    auto clip = make_rcp<RiveRenderPath>();
+    clip->moveTo(0, 0);
+    clip->lineTo(110, 0);
+    clip->lineTo(0, 110);
+    auto clippedScene = [&](RiveRenderer* r) {
+        r->drawPath(background.get(), gray.get());
+        r->save();
+        r->clipPath(clip.get());
+        r->drawPath(b.get(), blue.get());
+        r->restore();
+        r->drawPath(a.get(), red.get());
+    };
+    CHECK(drawFrame(clippedScene) == IAABB{50, 50, 60, 60});
+    CHECK(drawFrame(clippedScene).empty());
+    clip->rewind();
+    clip->moveTo(0, 0);
+    clip->lineTo(100, 0);
+    clip->lineTo(0, 100);
+    CHECK(drawFrame(clippedScene) == IAABB{50, 50, 60, 60});
+
+    // Draws clipped by non-axis-aligned clipRects can't be clipped to the damage, so they're
+    // damaged in full.
+    auto square = rect(0, 0, 40, 40);
+    auto rotatedClipScene = [&](RiveRenderer* r) {
+        r->drawPath(background.get(), gray.get());
+        r->save();
+        r->transform(Mat2D::fromRotation(.1f));
+        r->clipPath(square.get());
+        r->drawPath(square.get(), blue.get());
+        r->restore();
+        r->drawPath(a.get(), red.get());
+    };
+    drawFrame(rotatedClipScene);
+    CHECK(drawFrame(rotatedClipScene).empty());
+    red->color(0xfffe0000);
+    CHECK(drawFrame(rotatedClipScene) == IAABB{0, 0, 40, 44});
+    CHECK(drawFrame(scene) == IAABB{0, 0, 60, 60});
+
+    // Frames that can't preserve the render target are drawn in full, and so is the next one.
+    frameDescriptor.clearColor = 0x80000000;
+    CHECK(drawFrame(scene) == renderTarget->bounds());
+    CHECK(impl->colorLoadAction == LoadAction::clear);
+    frameDescriptor.clearColor = 0xff000000;
+    CHECK(drawFrame(scene) == renderTarget->bounds());
+    CHECK(drawFrame(scene).empty());
+    frameDescriptor.damageTracking = false;
+    CHECK(drawFrame(scene) == renderTarget->bounds());
+    frameDescriptor.damageTracking = true;
+    CHECK(drawFrame(scene) == renderTarget->bounds());
+    CHECK(drawFrame(scene).empty());
+    auto otherRenderTarget = impl->makeRenderTarget(100, 100);
+    renderContext->beginFrame(frameDescriptor);
+    {
+        RiveRenderer renderer(renderContext.get());
+        scene(&renderer);
+    }
+    renderContext->flush({.renderTarget = otherRenderTarget.get()});
+    CHECK(renderContext->damageBounds() == renderTarget->bounds());
+    CHECK(impl->colorLoadAction == LoadAction::clear);
+}
+} // namespace rive::gpu
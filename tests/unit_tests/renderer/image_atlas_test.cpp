@@ -0,0 +1,313 @@
+/*
+ * Copyright 2024 Rive
+ */
+
+#include "common/render_context_null.hpp"
+#include "rive/renderer/rive_render_image.hpp"
+#include "rive/renderer/rive_renderer.hpp"
+#include "../src/image_atlas.hpp"
+#include <catch.hpp>
+
+namespace rive::gpu
+{
+// Records the image textures of each batch in the most recent flush.
+class RenderContextRecordBatches : public RenderContextNULL
+{
+public:
+    void flush(const FlushDescriptor& desc) override
+    {
+        batchTextures.clear();
+        for (const DrawBatch& batch : *desc.drawList)
+        {
+            batchTextures.push_back(batch.imageTexture);
+        }
+    }
+
+    std::vector<const Texture*> batchTextures;
+};
+
+// Updates image textures in place, and records every update.
+class RenderContextUpdateInPlace : public RenderContextNULL
+{
+public:
+    struct Update
+    {
+        uint32_t mipLevel;
+        IAABB bounds;
+        size_t rowBytes;
+        const uint8_t* data;
+        // Copy of the region, with tightly packed rows.
+        std::vector<uint8_t> pixels;
+    };
+
+    bool updateImageTexture(Texture*,
+                            uint32_t mipLevel,
+                            uint32_t x,
+                            uint32_t y,
+                            uint32_t width,
+                            uint32_t height,
+                            size_t rowBytes,
+                            const uint8_t imageDataRGBA[]) override
+    {
+        Update& update = updates.emplace_back();
+        update.mipLevel = mipLevel;
+        update.bounds = {static_cast<int32_t>(x),
+                         static_cast<int32_t>(y),
+                         static_cast<int32_t>(x + width),
+                         static_cast<int32_t>(y + height)};
+        update.rowBytes = rowBytes;
+        update.data = imageDataRGBA;
+        for (uint32_t row = 0; row < height; ++row)
+        {
+            const uint8_t* src = imageDataRGBA + row * rowBytes;
+            update.pixels.insert(update.pixels.end(), src, src + width * 4);
+        }
+        return true;
+    }
+
+    std::vector<Update> updates;
+};
+
+// Fills an image with pixels whose red and green channels are their x and y coordinates.
+static std::vector<uint8_t> make_pixels(uint32_t width, uint32_t height)
+{
+    std::vector<uint8_t> pixels(width * height * 4);
+    for (uint32_t y = 0; y < height; ++y)
+    {
+        for (uint32_t x = 0; x < width; ++x)
+        {
+            uint8_t* pixel = &pixels[(y * width + x) * 4];
+            pixel[0] = static_cast<uint8_t>(x);
+            pixel[1] = static_cast<uint8_t>(y);
+            pixel[2] = 0;
+            pixel[3] = 255;
+        }
+    }
+    return pixels;
+}
+
+static const uint8_t* page_pixel(const ImageAtlasPage* page, uint32_t x, uint32_t y)
+{
+    return page->pixels() + (y * ImageAtlasPage::kSize + x) * 4;
+}
+
+TEST_CASE("ImageAtlas packing", "[image_atlas]")
+{
+    RenderContextNULL impl;
+    ImageAtlas atlas(&impl);
+    CHECK(atlas.addImage(4, 4, make_pixels(4, 4).data()) == nullptr); // Disabled.
+
+    atlas.setMaxImageDimension(64);
+    CHECK(atlas.maxImageDimension() == 64);
+    CHECK(atlas.addImage(65, 1, make_pixels(65, 1).data()) == nullptr);
+    CHECK(atlas.addImage(1, 65, make_pixels(1, 65).data()) == nullptr);
+
+    constexpr float k = 1.f / ImageAtlasPage::kSize;
+    constexpr uint32_t p = ImageAtlasPage::kPadding;
+
+    auto a = atlas.addImage(10, 6, make_pixels(10, 6).data());
+    REQUIRE(a != nullptr);
+    CHECK(a->width() == 10);
+    CHECK(a->height() == 6);
+    CHECK(a->getTexture() == nullptr);
+    REQUIRE(a->atlasPage() != nullptr);
+    CHECK(a->uvTransform() == Mat2D(10 * k, 0, 0, 6 * k, p * k, p * k));
+
+    // The next image goes to the right of "a", at a multiple of the padding.
+    auto b = atlas.addImage(20, 20, make_pixels(20, 20).data());
+    REQUIRE(b != nullptr);
+    CHECK(b->atlasPage() == a->atlasPage());
+    uint32_t bx = p + (10 + p * 2 + p - 1) / p * p;
+    CHECK(b->uvTransform() == Mat2D(20 * k, 0, 0, 20 * k, bx * k, p * k));
+    CHECK(bx % p == 0);
+
+    // Edge texels get replicated out into the padding.
+    const ImageAtlasPage* page = a->atlasPage();
+    CHECK(page->imageCount() == 2);
+    for (uint32_t i = 1; i <= p; ++i)
+    {
+        CHECK(page_pixel(page, p - i, p + 3)[0] == 0);
+        CHECK(page_pixel(page, p - i, p + 3)[1] == 3);
+        CHECK(page_pixel(page, p + 9 + i, p + 3)[0] == 9);
+        CHECK(page_pixel(page, p + 5, p + 5 + i)[1] == 5);
+        CHECK(page_pixel(page, p - i, p - i)[3] == 255); // Corners too.
+    }
+    CHECK(page_pixel(page, p + 7, p + 2)[0] == 7);
+    CHECK(page_pixel(page, p + 7, p + 2)[1] == 2);
+    CHECK(page_pixel(page, bx + 19, p + 19)[0] == 19);
+
+    // Images that don't fit start a new page.
+    atlas.setMaxImageDimension(ImageAtlasPage::kSize);
+    CHECK(atlas.maxImageDimension() == ImageAtlasPage::kSize - p * 2);
+    auto c = atlas.addImage(600, 600, make_pixels(600, 600).data());
+    REQUIRE(c != nullptr);
+    CHECK(c->atlasPage() == a->atlasPage());
+    auto d = atlas.addImage(600, 600, make_pixels(600, 600).data());
+    REQUIRE(d != nullptr);
+    CHECK(d->atlasPage() != c->atlasPage());
+    CHECK(d->uvTransform().tx() == p * k);
+    CHECK(d->uvTransform().ty() == p * k);
+
+    // The page texture gets uploaded lazily, and again after the page changes.
+    rcp<Texture> texture = d->atlasPage()->refTexture(&impl);
+    REQUIRE(texture != nullptr);
+    CHECK(texture->width() == ImageAtlasPage::kSize);
+    CHECK(d->atlasPage()->refTexture(&impl) == texture);
+    auto e = atlas.addImage(8, 8, make_pixels(8, 8).data());
+    REQUIRE(e != nullptr);
+    CHECK(e->atlasPage() == d->atlasPage());
+    CHECK(d->atlasPage()->refTexture(&impl) != texture);
+}
+
+TEST_CASE("ImageAtlas uploads only the region that changed", "[image_atlas]")
+{
+    RenderContextUpdateInPlace impl;
+    ImageAtlas atlas(&impl);
+    atlas.setMaxImageDimension(64);
+    constexpr uint32_t p = ImageAtlasPage::kPadding;
+    auto slotSize = [](uint32_t size) {
+        return static_cast<int32_t>((size + p * 2 + p - 1) / p * p);
+    };
+
+    auto a = atlas.addImage(10, 6, make_pixels(10, 6).data());
+    REQUIRE(a != nullptr);
+    ImageAtlasPage* page = a->atlasPage();
+    CHECK(page->dirtyBounds() == IAABB{0, 0, slotSize(10), slotSize(6)});
+
+    // The first upload makes the texture.
+    rcp<Texture> texture = page->refTexture(&impl);
+    REQUIRE(texture != nullptr);
+    CHECK(impl.updates.empty());
+    CHECK(page->dirtyBounds().empty());
+    CHECK(page->refTexture(&impl) == texture);
+    CHECK(impl.updates.empty());
+
+    // Later ones update just the slots of the images that were added, in the same texture.
+    auto b = atlas.addImage(20, 20, make_pixels(20, 20).data());
+    auto c = atlas.addImage(4, 30, make_pixels(4, 30).data());
+    REQUIRE(b != nullptr);
+    REQUIRE(c != nullptr);
+    REQUIRE(b->atlasPage() == page);
+    REQUIRE(c->atlasPage() == page);
+    uint32_t bx = static_cast<uint32_t>(b->uvTransform().tx() * ImageAtlasPage::kSize + .5f) - p;
+    uint32_t cx = static_cast<uint32_t>(c->uvTransform().tx() * ImageAtlasPage::kSize + .5f) - p;
+    IAABB dirtyBounds = {static_cast<int32_t>(bx),
+                         0,
+                         static_cast<int32_t>(cx) + slotSize(4),
+                         slotSize(30)};
+    CHECK(page->dirtyBounds() == dirtyBounds);
+    CHECK(page->refTexture(&impl) == texture);
+    REQUIRE(impl.updates.size() == ImageAtlasPage::kMipLevelCount);
+    CHECK(impl.updates[0].mipLevel == 0);
+    CHECK(impl.updates[0].bounds == dirtyBounds);
+    CHECK(impl.updates[0].rowBytes == ImageAtlasPage::kSize * 4);
+    CHECK(impl.updates[0].data == page_pixel(page, bx, 0));
+    CHECK(page->dirtyBounds().empty());
+
+    // The same region of each mip level gets box filtered from the level above it.
+    for (uint32_t level = 1; level < ImageAtlasPage::kMipLevelCount; ++level)
+    {
+        const RenderContextUpdateInPlace::Update& parent = impl.updates[level - 1];
+        const RenderContextUpdateInPlace::Update& update = impl.updates[level];
+        CHECK(update.mipLevel == level);
+        IAABB bounds = {dirtyBounds.left >> level,
+                        dirtyBounds.top >> level,
+                        dirtyBounds.right >> level,
+                        dirtyBounds.bottom >> level};
+        REQUIRE(update.bounds == bounds);
+        CHECK(update.rowBytes == bounds.width() * 4);
+        size_t parentRowBytes = parent.bounds.width() * 4;
+        bool filtered = true;
+        for (int32_t y = 0; y < bounds.height(); ++y)
+        {
+            for (int32_t x = 0; x < bounds.width() * 4; ++x)
+            {
+                size_t i = y * 2 * parentRowBytes + (x & ~3) * 2 + (x & 3);
+                const uint8_t* src = &parent.pixels[i];
+                uint32_t sum = src[0] + src[4] + src[parentRowBytes] + src[parentRowBytes + 4];
+                filtered = filtered && update.pixels[y * bounds.width() * 4 + x] == (sum + 2) / 4;
+            }
+        }
+        CHECK(filtered);
+    }
+}
+
+TEST_CASE("ImageAtlas frees full pages once they're uploaded", "[image_atlas]")
+{
+    RenderContextUpdateInPlace impl;
+    ImageAtlas atlas(&impl);
+    atlas.setMaxImageDimension(ImageAtlasPage::kSize);
+
+    // Only one 600x600 image fits on each shelf, and only one shelf fits on each page.
+    auto a = atlas.addImage(600, 600, make_pixels(600, 600).data());
+    REQUIRE(a != nullptr);
+    rcp<Texture> textureA = a->atlasPage()->refTexture(&impl);
+    REQUIRE(textureA != nullptr);
+    CHECK(a->atlasPage()->pixels() != nullptr);
+
+    // Starting a new page frees the old one's pixels right away if they've been uploaded...
+    auto b = atlas.addImage(600, 600, make_pixels(600, 600).data());
+    REQUIRE(b != nullptr);
+    REQUIRE(b->atlasPage() != a->atlasPage());
+    CHECK(a->atlasPage()->pixels() == nullptr);
+    CHECK(a->atlasPage()->refTexture(&impl) == textureA);
+
+    // ...or after they get uploaded.
+    auto c = atlas.addImage(600, 600, make_pixels(600, 600).data());
+    REQUIRE(c != nullptr);
+    REQUIRE(c->atlasPage() != b->atlasPage());
+    CHECK(b->atlasPage()->pixels() != nullptr);
+    rcp<Texture> textureB = b->atlasPage()->refTexture(&impl);
+    REQUIRE(textureB != nullptr);
+    CHECK(b->atlasPage()->pixels() == nullptr);
+    CHECK(b->atlasPage()->refTexture(&impl) == textureB);
+    CHECK(c->atlasPage()->pixels() != nullptr);
+    CHECK(impl.updates.empty());
+}
+
+TEST_CASE("Atlased images batch together", "[image_atlas]")
+{
+    auto renderContext =
+        std::make_unique<RenderContext>(std::make_unique<RenderContextRecordBatches>());
+    auto impl = renderContext->static_impl_cast<RenderContextRecordBatches>();
+    auto renderTarget = impl->makeRenderTarget(100, 100);
+    RenderContext::FrameDescriptor frameDescriptor;
+    frameDescriptor.renderTargetWidth = 100;
+    frameDescriptor.renderTargetHeight = 100;
+    auto drawFrame = [&](const std::vector<RenderImage*>& images) {
+        renderContext->beginFrame(frameDescriptor);
+        RiveRenderer renderer(renderContext.get());
+        for (RenderImage* image : images)
+        {
+            renderer.translate(10, 0);
+            renderer.drawImage(image, BlendMode::srcOver, 1);
+        }
+        renderContext->flush({.renderTarget = renderTarget.get()});
+    };
+
+    ImageAtlas atlas(impl);
+    atlas.setMaxImageDimension(16);
+    auto a = atlas.addImage(8, 8, make_pixels(8, 8).data());
+    auto b = atlas.addImage(16, 4, make_pixels(16, 4).data());
+    REQUIRE(a != nullptr);
+    REQUIRE(b != nullptr);
+    rcp<Texture> pageTexture = renderContext->refImageTexture(a.get());
+    REQUIRE(pageTexture != nullptr);
+    CHECK(renderContext->refImageTexture(b.get()) == pageTexture);
+
+    drawFrame({a.get(), b.get(), a.get()});
+    REQUIRE(impl->batchTextures.size() == 1);
+    CHECK(impl->batchTextures[0] == pageTexture.get());
+
+    // Standalone textures can't share a batch.
+    auto c = make_rcp<RiveRenderImage>(make_rcp<Texture>(8, 8));
+    auto d = make_rcp<RiveRenderImage>(make_rcp<Texture>(8, 8));
+    drawFrame({c.get(), d.get()});
+    CHECK(impl->batchTextures.size() == 2);
+
+    // Pages may outlive the context.
+    renderContext.reset();
+    a = nullptr;
+    b = nullptr;
+}
+} // namespace rive::gpu
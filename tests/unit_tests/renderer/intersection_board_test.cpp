@@ -4,6 +4,7 @@
 
 #include "../src/intersection_board.hpp"
 #include "common/intersection_board_reference_impl.hpp"
+#include "rive/math/simd_dispatch.hpp"
 #include <catch.hpp>
 
 namespace rive::gpu
@@ -221,4 +222,26 @@ TEST_CASE("IntersectionBoard", "IntersectionBoard")
     check_intersection_board_random_rectangles(10000, 1000);
     check_intersection_board_random_rectangles2(1000);
 }
+
+// The tile test is dispatched on the CPU's instruction set. Check every variant the CPU supports.
+TEST_CASE("IntersectionBoardDispatch", "IntersectionBoard")
+{
+    for (simd::ISA isa :
+         {simd::ISA::baseline, simd::ISA::sse4_1, simd::ISA::avx2, simd::ISA::avx512})
+    {
+        if (!simd::force_isa(isa))
+        {
+            continue;
+        }
+        INFO(simd::isa_name(isa));
+        IntersectionBoardReferenceImpl ref;
+        IntersectionBoard fast;
+        check_intersection_board_corner_cases(ref);
+        check_intersection_board_corner_cases(fast);
+        srand(0);
+        check_intersection_board_random_rectangles(1000, 1000);
+        check_intersection_board_random_rectangles2(1000);
+    }
+    simd::reset_isa();
+}
 } // namespace rive::gpu
@@ -0,0 +1,95 @@
+/*
+ * Copyright 2024 Rive
+ */
+
+#include "common/render_context_null.hpp"
+#include "rive/renderer/rive_render_image.hpp"
+#include "ktx2_test_file.hpp"
+#include <catch.hpp>
+
+namespace rive::gpu
+{
+// Records the textures it's asked to make, and which block formats it supports.
+class RenderContextRecordTextures : public RenderContextNULL
+{
+public:
+    void setSupportsBC7Textures(bool supported)
+    {
+        m_platformFeatures.supportsBC7Textures = supported;
+    }
+
+    rcp<Texture> makeImageTexture(uint32_t width,
+                                  uint32_t height,
+                                  uint32_t mipLevelCount,
+                                  const uint8_t imageDataRGBA[]) override
+    {
+        imageTextureMipLevelCount = mipLevelCount;
+        imageTexturePixels.assign(imageDataRGBA, imageDataRGBA + width * height * 4);
+        return make_rcp<Texture>(width, height);
+    }
+
+    rcp<Texture> makeCompressedImageTexture(uint32_t width,
+                                            uint32_t height,
+                                            ImageTextureFormat format,
+                                            uint32_t mipLevelCount,
+                                            const uint8_t* const levelData[],
+                                            const size_t levelSizesInBytes[]) override
+    {
+        ++compressedImageTextureCount;
+        return make_rcp<Texture>(width, height, format);
+    }
+
+    uint32_t imageTextureMipLevelCount = 0;
+    std::vector<uint8_t> imageTexturePixels;
+    int compressedImageTextureCount = 0;
+};
+
+static std::vector<uint8_t> make_bc7_ktx2()
+{
+    // A single 4x4 bc7 block in mode 6.
+    const uint8_t block[] = {0x40, 0x05, 0x99, 0xe2, 0xf6, 0xe0, 0xff, 0xc0,
+                             0xf0, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00};
+    auto file = make_ktx2(145, 4, 4, 1);
+    std::copy(block, block + sizeof(block), file.end() - sizeof(block));
+    return file;
+}
+
+TEST_CASE("unsupported block formats decode to rgba", "[ktx2]")
+{
+    auto renderContext =
+        std::make_unique<RenderContext>(std::make_unique<RenderContextRecordTextures>());
+    auto impl = renderContext->static_impl_cast<RenderContextRecordTextures>();
+    auto file = make_bc7_ktx2();
+
+    auto image = renderContext->decodeImage(file);
+    REQUIRE(image != nullptr);
+    auto texture = static_cast<const RiveRenderImage*>(image.get())->getTexture();
+    REQUIRE(texture != nullptr);
+    CHECK(texture->format() == ImageTextureFormat::rgba8);
+    CHECK(texture->width() == 4);
+    CHECK(texture->height() == 4);
+    CHECK(impl->compressedImageTextureCount == 0);
+    CHECK(impl->imageTextureMipLevelCount == 3);
+    REQUIRE(impl->imageTexturePixels.size() == 4 * 4 * 4);
+    CHECK(std::vector<uint8_t>(impl->imageTexturePixels.begin(),
+                               impl->imageTexturePixels.begin() + 12) ==
+          std::vector<uint8_t>{21, 41, 61, 255, 200, 220, 240, 128, 116, 136, 156, 188});
+}
+
+TEST_CASE("supported block formats upload as-is", "[ktx2]")
+{
+    auto renderContext =
+        std::make_unique<RenderContext>(std::make_unique<RenderContextRecordTextures>());
+    auto impl = renderContext->static_impl_cast<RenderContextRecordTextures>();
+    impl->setSupportsBC7Textures(true);
+    auto file = make_bc7_ktx2();
+
+    auto image = renderContext->decodeImage(file);
+    REQUIRE(image != nullptr);
+    auto texture = static_cast<const RiveRenderImage*>(image.get())->getTexture();
+    REQUIRE(texture != nullptr);
+    CHECK(texture->format() == ImageTextureFormat::bc7);
+    CHECK(impl->compressedImageTextureCount == 1);
+    CHECK(impl->imageTexturePixels.empty());
+}
+} // namespace rive::gpu
@@ -0,0 +1,293 @@
+/*
+ * Copyright 2024 Rive
+ */
+
+#include "common/render_context_null.hpp"
+#include "rive/layer_cache.hpp"
+#include "rive/renderer/rive_render_image.hpp"
+#include "rive/renderer/rive_renderer.hpp"
+#include "../src/rive_render_paint.hpp"
+#include "../src/rive_render_path.hpp"
+#include "../src/shaders/constants.glsl"
+#include <catch.hpp>
+#include <array>
+#include <cstring>
+
+namespace rive::gpu
+{
+// Records every logical flush, along with the paint data of its paths.
+class RenderContextRecordFlushes : public RenderContextNULL
+{
+public:
+    struct FlushRecord
+    {
+        const RenderTarget* renderTarget;
+        LoadAction colorLoadAction;
+        ColorInt clearColor;
+        uint32_t pathCount;
+        std::vector<std::array<uint32_t, 2>> paints; // [params, color/opacity]
+    };
+
+    std::unique_ptr<BufferRing> makeStorageBufferRing(size_t capacityInBytes,
+                                                      StorageBufferStructure) override
+    {
+        return std::make_unique<HeapBufferRing>(capacityInBytes);
+    }
+
+    void flush(const FlushDescriptor& desc) override
+    {
+        // The first path record is reserved for the clear color.
+        FlushRecord record = {desc.renderTarget,
+                              desc.colorLoadAction,
+                              desc.clearColor,
+                              desc.pathCount - 1};
+        auto paintBuffer = static_cast<HeapBufferRing*>(paintBufferRing());
+        const auto* paints =
+            reinterpret_cast<const std::array<uint32_t, 2>*>(paintBuffer->contents()) +
+            desc.firstPaint;
+        record.paints.assign(paints + 1, paints + desc.pathCount);
+        flushes.push_back(std::move(record));
+    }
+
+    std::vector<FlushRecord> flushes;
+};
+
+class LayerCacheTestFixture
+{
+public:
+    LayerCacheTestFixture() :
+        m_renderContext(std::make_unique<RenderContext>(
+            std::make_unique<RenderContextRecordFlushes>())),
+        m_impl(m_renderContext->static_impl_cast<RenderContextRecordFlushes>()),
+        m_renderTarget(m_impl->makeRenderTarget(100, 100))
+    {}
+
+    RenderContextRecordFlushes* impl() const { return m_impl; }
+    const RenderTarget* renderTarget() const { return m_renderTarget.get(); }
+
+    template <typename Fn> void drawFrame(Fn&& draw)
+    {
+        RenderContext::FrameDescriptor frameDescriptor;
+        frameDescriptor.renderTargetWidth = 100;
+        frameDescriptor.renderTargetHeight = 100;
+        frameDescriptor.clearColor = 0xff000000;
+        m_impl->flushes.clear();
+        m_renderContext->beginFrame(frameDescriptor);
+        {
+            RiveRenderer renderer(m_renderContext.get());
+            draw(&renderer);
+        }
+        m_renderContext->flush({.renderTarget = m_renderTarget.get()});
+    }
+
+private:
+    std::unique_ptr<RenderContext> m_renderContext;
+    RenderContextRecordFlushes* m_impl;
+    rcp<RenderTarget> m_renderTarget;
+};
+
+static rcp<RiveRenderPath> make_rect(float l, float t, float r, float b)
+{
+    auto path = make_rcp<RiveRenderPath>();
+    path->addRect(l, t, r - l, b - t);
+    return path;
+}
+
+TEST_CASE("RenderLayerFlushes", "[layer_cache]")
+{
+    LayerCacheTestFixture fixture;
+    auto impl = fixture.impl();
+    auto rect = make_rect(0, 0, 10, 10);
+    auto innerRect = make_rect(2, 2, 8, 8);
+    auto paint = make_rcp<RiveRenderPaint>();
+    paint->color(0xffff0000);
+
+    rcp<RenderLayer> layer;
+    fixture.drawFrame([&](RiveRenderer* r) {
+        r->drawPath(rect.get(), paint.get());
+        r->save();
+        r->transform(Mat2D::fromTranslate(20, 20));
+        layer = r->beginLayer(AABB{0, 0, 10, 10});
+        REQUIRE(layer != nullptr);
+        CHECK(r->beginLayer(AABB{0, 0, 10, 10}) == nullptr); // Layers don't nest.
+        r->drawPath(rect.get(), paint.get());
+        r->drawPath(innerRect.get(), paint.get());
+        r->endLayer();
+        CHECK(r->drawLayer(layer.get(), 0));
+        r->restore();
+        r->drawPath(rect.get(), paint.get());
+    });
+    CHECK(layer->bounds() == AABB{0, 0, 10, 10});
+    CHECK(layer->sizeInBytes() == 10 * 10 * 4);
+
+    // The layer renders to its own target, before the main target draws it.
+    REQUIRE(impl->flushes.size() == 3);
+    CHECK(impl->flushes[0].renderTarget == fixture.renderTarget());
+    CHECK(impl->flushes[0].colorLoadAction == LoadAction::clear);
+    CHECK(impl->flushes[0].pathCount == 1);
+    CHECK(impl->flushes[1].renderTarget != fixture.renderTarget());
+    CHECK(impl->flushes[1].colorLoadAction == LoadAction::clear);
+    CHECK(impl->flushes[1].clearColor == 0);
+    CHECK(impl->flushes[1].pathCount == 2);
+    CHECK(impl->flushes[2].renderTarget == fixture.renderTarget());
+    CHECK(impl->flushes[2].colorLoadAction == LoadAction::preserveRenderTarget);
+    CHECK(impl->flushes[2].pathCount == 2); // The layer image and the last rect.
+
+    // Layers can be drawn in later frames, as long as the scale hasn't changed too much.
+    fixture.drawFrame([&](RiveRenderer* r) {
+        r->transform(Mat2D::fromTranslate(50, 50));
+        CHECK(r->drawLayer(layer.get(), .1f));
+        r->transform(Mat2D::fromScale(1.05f, 1));
+        CHECK(r->drawLayer(layer.get(), .1f));
+        r->transform(Mat2D::fromScale(1.1f, 1));
+        CHECK(!r->drawLayer(layer.get(), .1f));
+    });
+    REQUIRE(impl->flushes.size() == 1);
+    CHECK(impl->flushes[0].pathCount == 2);
+
+    // Layers can't be larger than the frame.
+    fixture.drawFrame([&](RiveRenderer* r) {
+        CHECK(r->beginLayer(AABB{0, 0, 101, 10}) == nullptr);
+        CHECK(r->beginLayer(AABB{0, 0, 0, 10}) == nullptr);
+    });
+}
+
+using Color4 = std::array<float, 4>;
+
+// Mirrors the shaders: paint colors stay straight (unmultiplied) until they blend src-over onto a
+// premultiplied destination.
+static Color4 blend_src_over(Color4 straight, Color4 dst)
+{
+    Color4 result;
+    for (int i = 0; i < 3; ++i)
+    {
+        result[i] = straight[i] * straight[3] + dst[i] * (1 - straight[3]);
+    }
+    result[3] = straight[3] + dst[3] * (1 - straight[3]);
+    return result;
+}
+
+static Color4 unpack_rgba(uint32_t rgba)
+{
+    return {(rgba & 0xff) / 255.f,
+            (rgba >> 8 & 0xff) / 255.f,
+            (rgba >> 16 & 0xff) / 255.f,
+            (rgba >> 24) / 255.f};
+}
+
+// Mirrors find_paint_color() for image paints, given the texel the image samples.
+static Color4 image_paint_color(Color4 texel, const std::array<uint32_t, 2>& paint)
+{
+    if ((paint[0] & PAINT_FLAG_PREMULTIPLIED_IMAGE) && texel[3] != 0)
+    {
+        for (int i = 0; i < 3; ++i)
+        {
+            texel[i] /= texel[3];
+        }
+    }
+    float opacity;
+    memcpy(&opacity, &paint[1], sizeof(float));
+    texel[3] *= opacity;
+    return texel;
+}
+
+TEST_CASE("TranslucentLayers", "[layer_cache]")
+{
+    LayerCacheTestFixture fixture;
+    auto impl = fixture.impl();
+    auto rect = make_rect(0, 0, 10, 10);
+    auto paint = make_rcp<RiveRenderPaint>();
+    paint->color(0x80ff8040);
+    auto decodedImage = make_rcp<RiveRenderImage>(make_rcp<Texture>(10, 10));
+
+    fixture.drawFrame([&](RiveRenderer* r) {
+        auto layer = r->beginLayer(AABB{0, 0, 10, 10});
+        REQUIRE(layer != nullptr);
+        r->drawPath(rect.get(), paint.get());
+        r->endLayer();
+        r->drawPath(rect.get(), paint.get());
+        CHECK(r->drawLayer(layer.get(), 0));
+        r->drawImage(decodedImage.get(), BlendMode::srcOver, 1);
+    });
+    REQUIRE(impl->flushes.size() == 3);
+    const auto& layerFlush = impl->flushes[1];
+    const auto& mainFlush = impl->flushes[2];
+    REQUIRE(layerFlush.paints.size() == 1);
+    REQUIRE(mainFlush.paints.size() == 3);
+    const auto& directPaint = mainFlush.paints[0];
+    const auto& layerPaint = mainFlush.paints[1];
+    const auto& decodedImagePaint = mainFlush.paints[2];
+    CHECK((directPaint[0] & 0xf) == SOLID_COLOR_PAINT_TYPE);
+    CHECK((layerPaint[0] & 0xf) == IMAGE_PAINT_TYPE);
+    CHECK((decodedImagePaint[0] & 0xf) == IMAGE_PAINT_TYPE);
+
+    // Layers hold premultiplied colors. Decoded images don't.
+    CHECK((layerPaint[0] & PAINT_FLAG_PREMULTIPLIED_IMAGE) != 0);
+    CHECK((decodedImagePaint[0] & PAINT_FLAG_PREMULTIPLIED_IMAGE) == 0);
+
+    // Drawing the layer blends the same color as drawing its content directly.
+    Color4 background = {0, 0, 0, 1};
+    Color4 layerTexel = blend_src_over(unpack_rgba(layerFlush.paints[0][1]), {0, 0, 0, 0});
+    Color4 direct = blend_src_over(unpack_rgba(directPaint[1]), background);
+    Color4 fromLayer = blend_src_over(image_paint_color(layerTexel, layerPaint), background);
+    for (int i = 0; i < 4; ++i)
+    {
+        CHECK(fromLayer[i] == Approx(direct[i]));
+    }
+
+    // Treating the layer's texels as straight colors would premultiply them twice.
+    CHECK(blend_src_over(layerTexel, background)[0] != Approx(direct[0]));
+}
+
+TEST_CASE("LayerCache", "[layer_cache]")
+{
+    LayerCacheTestFixture fixture;
+    auto rect = make_rect(0, 0, 10, 10);
+    auto paint = make_rcp<RiveRenderPaint>();
+    auto makeLayer = [&](RiveRenderer* r, float size) {
+        auto layer = r->beginLayer(AABB{0, 0, size, size});
+        r->drawPath(rect.get(), paint.get());
+        r->endLayer();
+        return layer;
+    };
+
+    // Fits two 10x10 layers.
+    LayerCache cache(10 * 10 * 4 * 2 + 1);
+    uint64_t a = LayerCache::makeKey();
+    uint64_t b = LayerCache::makeKey();
+    uint64_t c = LayerCache::makeKey();
+    CHECK(a != b);
+    fixture.drawFrame([&](RiveRenderer* r) {
+        CHECK(cache.draw(a, r) == LayerCache::DrawResult::notCached);
+        CHECK(cache.add(a, makeLayer(r, 10)));
+        CHECK(cache.add(b, makeLayer(r, 10)));
+        CHECK(cache.layerCount() == 2);
+        CHECK(cache.usedBytes() == 10 * 10 * 4 * 2);
+        CHECK(cache.draw(a, r) == LayerCache::DrawResult::drawn);
+
+        // "b" was drawn least recently.
+        CHECK(cache.add(c, makeLayer(r, 10)));
+        CHECK(cache.layerCount() == 2);
+        CHECK(cache.draw(b, r) == LayerCache::DrawResult::notCached);
+        CHECK(cache.draw(a, r) == LayerCache::DrawResult::drawn);
+        CHECK(cache.draw(c, r) == LayerCache::DrawResult::drawn);
+
+        // Layers larger than the budget aren't kept.
+        CHECK(!cache.add(b, makeLayer(r, 20)));
+        CHECK(cache.layerCount() == 2);
+
+        // Layers drawn at the wrong scale get dropped.
+        r->transform(Mat2D::fromScale(2, 2));
+        CHECK(cache.draw(a, r) == LayerCache::DrawResult::dropped);
+        CHECK(cache.layerCount() == 1);
+    });
+    CHECK(cache.stats().hits == 3);
+    CHECK(cache.stats().misses == 3);
+    CHECK(cache.stats().evictions == 1);
+
+    cache.budgetInBytes(0);
+    CHECK(cache.layerCount() == 0);
+    CHECK(cache.usedBytes() == 0);
+    CHECK(cache.stats().evictions == 2);
+}
+} // namespace rive::gpu
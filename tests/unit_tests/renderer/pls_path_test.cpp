@@ -3,7 +3,11 @@
  */
 
 #include "rive/math/math_types.hpp"
+#include "rive/renderer/rive_renderer.hpp"
+#include "common/render_context_null.hpp"
+#include "../src/rive_render_paint.hpp"
 #include "../src/rive_render_path.hpp"
+#include "gr_inner_fan_triangulator.hpp"
 #include <catch.hpp>
 
 namespace rive::gpu
@@ -63,4 +67,228 @@ TEST_CASE("getCoarseArea", "[RiveRenderPath]")
     CHECK(path.getCoarseArea() / (math::PI * 1000 * 1000 - math::PI * 900 * 900) ==
           Approx(1).margin(1e-2f));
 }
+
+// Check that RiveRenderPath::copy() matches replaying the same RawPath verb by verb, and that it
+// invalidates the bounds, area, and mutation ID.
+TEST_CASE("copy", "[RiveRenderPath]")
+{
+    RawPath rawPath;
+    rawPath.moveTo(0, 0);
+    rawPath.lineTo(100, 0);
+    rawPath.lineTo(100, 0); // empty
+    rawPath.cubicTo(100, 50, 50, 100, 0, 100);
+    rawPath.cubicTo(0, 100, 0, 100, 0, 100); // empty
+    rawPath.close();
+
+    PLSTestPath replayed;
+    rawPath.addTo(&replayed);
+
+    PLSTestPath copied;
+    copied.addRect(-10, -10, 5, 5, PathDirection::clockwise);
+    uint64_t mutationID = copied.getRawPathMutationID();
+    CHECK(copied.getBounds() == AABB{-10, -10, -5, -5});
+    CHECK(copied.getCoarseArea() == 25);
+
+    copied.copy(rawPath);
+    CHECK(copied.getRawPath() == replayed.getRawPath());
+    CHECK(copied.getRawPathMutationID() != mutationID);
+    CHECK(copied.getBounds() == replayed.getBounds());
+    CHECK(copied.getBounds() == AABB{0, 0, 100, 100});
+    CHECK(copied.getCoarseArea() == replayed.getCoarseArea());
+
+    // The source is left intact.
+    CHECK(rawPath.verbs().size() == 6);
+}
+
+// Check that interior triangulations are shared across draws of the same linearized path, and
+// rebuilt when the path, its linearization, or the fill rule changes.
+TEST_CASE("interior triangulation cache", "[RiveRenderPath]")
+{
+    using Axis = InteriorTriangulation::TriangulatorAxis;
+    size_t initialCachedBytes = InteriorTriangulation::TotalCachedBytes();
+
+    PLSTestPath path;
+    path.addRect(0, 0, 100, 200, PathDirection::clockwise);
+
+    RawPath linearized = path.getRawPath();
+    InteriorTriangulation* a =
+        path.refInteriorTriangulation(linearized, FillRule::nonZero, Axis::vertical);
+    REQUIRE(a != nullptr);
+    CHECK(a->triangulator() != nullptr);
+    CHECK(a->triangulator()->maxVertexCount() > 0);
+    CHECK(InteriorTriangulation::TotalCachedBytes() == initialCachedBytes + a->sizeInBytes());
+
+    // Same linearization on a later frame: reuse.
+    InteriorTriangulation* b =
+        path.refInteriorTriangulation(linearized, FillRule::nonZero, Axis::vertical);
+    CHECK(b == a);
+    b->unref();
+
+    // A different fill rule or axis needs a new triangulation.
+    b = path.refInteriorTriangulation(linearized, FillRule::evenOdd, Axis::vertical);
+    CHECK(b != a);
+    b->unref();
+    b = path.refInteriorTriangulation(linearized, FillRule::evenOdd, Axis::horizontal);
+    CHECK(b != a);
+    b->unref();
+
+    // So does a different linearization of the same path.
+    RawPath finerLinearization = linearized;
+    finerLinearization.moveTo(0, 0);
+    finerLinearization.lineTo(50, 100);
+    finerLinearization.lineTo(0, 100);
+    b = path.refInteriorTriangulation(finerLinearization, FillRule::evenOdd, Axis::horizontal);
+    CHECK(b != a);
+    b->unref();
+
+    // The draw that still holds the first triangulation keeps it alive after the path mutates.
+    path.addRect(0, 0, 10, 10, PathDirection::clockwise);
+    linearized = path.getRawPath();
+    b = path.refInteriorTriangulation(linearized, FillRule::nonZero, Axis::vertical);
+    CHECK(b != a);
+    CHECK(a->triangulator()->maxVertexCount() > 0);
+    a->unref();
+    b->unref();
+
+    path.rewind();
+    CHECK(InteriorTriangulation::TotalCachedBytes() == initialCachedBytes);
+}
+
+// Check that a path whose triangulation doesn't fit in the cache budget stops triangulating until
+// it changes.
+TEST_CASE("interior triangulation over budget", "[RiveRenderPath]")
+{
+    using Axis = InteriorTriangulation::TriangulatorAxis;
+    size_t initialCachedBytes = InteriorTriangulation::TotalCachedBytes();
+
+    // Fill up the budget with cached triangulations.
+    std::vector<std::unique_ptr<PLSTestPath>> paths;
+    PLSTestPath* overBudgetPath = nullptr;
+    while (overBudgetPath == nullptr)
+    {
+        auto path = std::make_unique<PLSTestPath>();
+        path->addRect(0, 0, 100, 200, PathDirection::clockwise);
+        InteriorTriangulation* triangulation =
+            path->refInteriorTriangulation(path->getRawPath(), FillRule::nonZero, Axis::vertical);
+        // The triangulation that goes over budget is still returned for the current draw.
+        REQUIRE(triangulation != nullptr);
+        CHECK(triangulation->triangulator() != nullptr);
+        triangulation->unref();
+        if (path->isInteriorTriangulationOverBudget())
+        {
+            overBudgetPath = path.get();
+        }
+        paths.push_back(std::move(path));
+    }
+    CHECK(InteriorTriangulation::TotalCachedBytes() <= InteriorTriangulation::kCacheBudgetInBytes);
+
+    // Until the path changes, it doesn't triangulate again.
+    RawPath linearized = overBudgetPath->getRawPath();
+    CHECK(overBudgetPath->refInteriorTriangulation(linearized,
+                                                   FillRule::nonZero,
+                                                   Axis::vertical) == nullptr);
+    CHECK(overBudgetPath->refInteriorTriangulation(linearized, FillRule::evenOdd, Axis::vertical) ==
+          nullptr);
+
+    // Once it does, and there's room in the budget again, it gets cached.
+    for (size_t i = 0; i < 4; ++i)
+    {
+        paths[i]->rewind();
+    }
+    overBudgetPath->addRect(0, 0, 10, 10, PathDirection::clockwise);
+    CHECK(!overBudgetPath->isInteriorTriangulationOverBudget());
+    InteriorTriangulation* triangulation =
+        overBudgetPath->refInteriorTriangulation(overBudgetPath->getRawPath(),
+                                                 FillRule::nonZero,
+                                                 Axis::vertical);
+    REQUIRE(triangulation != nullptr);
+    CHECK(!overBudgetPath->isInteriorTriangulationOverBudget());
+    triangulation->unref();
+
+    paths.clear();
+    CHECK(InteriorTriangulation::TotalCachedBytes() == initialCachedBytes);
+}
+
+// Records the tessellation texture height of the most recent flush.
+class RenderContextRecordTessHeight : public RenderContextNULL
+{
+public:
+    void flush(const FlushDescriptor& desc) override { tessDataHeight = desc.tessDataHeight; }
+
+    uint32_t tessDataHeight = 0;
+};
+
+// Check that midpoint fan segment counts get reused across frames while a path is unchanged and
+// drawn at a similar scale, at any rotation.
+TEST_CASE("tess count cache", "[RiveRenderPath]")
+{
+    auto renderContext =
+        std::make_unique<RenderContext>(std::make_unique<RenderContextRecordTessHeight>());
+    auto impl = renderContext->static_impl_cast<RenderContextRecordTessHeight>();
+    auto renderTarget = impl->makeRenderTarget(1000, 1000);
+    auto paint = make_rcp<RiveRenderPaint>();
+    paint->style(RenderPaintStyle::stroke);
+    paint->thickness(10);
+    RenderContext::FrameDescriptor frameDescriptor;
+    frameDescriptor.renderTargetWidth = 1000;
+    frameDescriptor.renderTargetHeight = 1000;
+    auto drawFrame = [&](RiveRenderPath* path, const Mat2D& matrix) {
+        renderContext->beginFrame(frameDescriptor);
+        {
+            RiveRenderer renderer(renderContext.get());
+            renderer.transform(matrix);
+            renderer.drawPath(path, paint.get());
+        }
+        renderContext->flush({.renderTarget = renderTarget.get()});
+        return impl->tessDataHeight;
+    };
+
+    const Mat2D center = Mat2D::fromTranslate(500, 500);
+    auto circle = make_rcp<PLSTestPath>();
+    circle->addCircle(0, 0, 200, PathDirection::clockwise);
+    uint32_t tessDataHeight = drawFrame(circle.get(), center);
+    const auto& tessCounts = circle->tessCounts(/*isStroked=*/true);
+    REQUIRE(tessCounts != nullptr);
+    CHECK(!tessCounts->hasCounts); // Not saved until the path is drawn twice unchanged.
+    CHECK(drawFrame(circle.get(), center) == tessDataHeight);
+    CHECK(tessCounts->hasCounts);
+    CHECK(tessCounts->matrix == center);
+
+    // Rotation and slightly shrinking reuse the counts, so the saved matrix doesn't change.
+    const Mat2D rotated = center * Mat2D::fromRotation(1);
+    CHECK(drawFrame(circle.get(), rotated) == tessDataHeight);
+    CHECK(tessCounts->matrix == center);
+    CHECK(drawFrame(circle.get(), center * Mat2D::fromScale(.95f, .95f)) == tessDataHeight);
+    CHECK(tessCounts->matrix == center);
+
+    // The reused counts match what the rotated draw would have computed itself.
+    auto otherCircle = make_rcp<PLSTestPath>();
+    otherCircle->addCircle(0, 0, 200, PathDirection::clockwise);
+    CHECK(drawFrame(otherCircle.get(), rotated) == tessDataHeight);
+
+    // Growing at all, even slightly, computes new counts (reused counts would be too few).
+    const Mat2D grown = center * Mat2D::fromScale(1.05f, 1.05f);
+    drawFrame(circle.get(), grown);
+    CHECK(tessCounts->matrix == grown);
+
+    // So do larger scale changes and skews.
+    const Mat2D scaled = center * Mat2D::fromScale(2, 2);
+    drawFrame(circle.get(), scaled);
+    CHECK(tessCounts->matrix == scaled);
+    const Mat2D skewed = scaled * Mat2D(1, 0, .5f, 1, 0, 0);
+    drawFrame(circle.get(), skewed);
+    CHECK(tessCounts->matrix == skewed);
+
+    // So does a different stroke.
+    paint->thickness(20);
+    drawFrame(circle.get(), skewed);
+    CHECK(tessCounts->hasCounts);
+    CHECK(tessCounts->strokeRadius == 10);
+
+    // Changing the path drops them.
+    circle->addCircle(0, 0, 100, PathDirection::clockwise);
+    drawFrame(circle.get(), skewed);
+    CHECK(!tessCounts->hasCounts);
+    CHECK(circle->tessCounts(/*isStroked=*/false) == nullptr);
+}
 } // namespace rive::gpu
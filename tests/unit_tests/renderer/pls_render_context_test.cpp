@@ -2,9 +2,13 @@
  * Copyright 2024 Rive
  */
 
+#include "rive/renderer/draw.hpp"
 #include "rive/renderer/rive_renderer.hpp"
 #include "common/render_context_null.hpp"
+#include "../src/rive_render_paint.hpp"
+#include "../src/rive_render_path.hpp"
 #include <catch.hpp>
+#include <functional>
 
 class RenderContextNULLTest : public RenderContextNULL
 {
@@ -16,6 +20,7 @@ public:
 class RenderContextTest : public rive::gpu::RenderContext
 {
 public:
+    using RenderContext::interiorTriangulationWorker;
     using RenderContext::ResourceAllocationCounts;
     RenderContextTest() : RenderContext(std::make_unique<RenderContextNULLTest>()) {}
     RenderContextNULLTest* testingImpl() { return static_impl_cast<RenderContextNULLTest>(); }
@@ -209,4 +214,160 @@ TEST_CASE("ResourceTriming", "RenderContext")
     CHECK(ctx.currentResourceAllocations().gradTextureHeight == 0);
     CHECK(ctx.currentResourceAllocations().tessTextureHeight == 0);
 }
+
+// Checks the FrameDescriptor thresholds for interior triangulation, and that async mode draws
+// midpoint fans until the background triangulation is ready.
+TEST_CASE("InteriorTriangulationThresholds", "RenderContext")
+{
+    RenderContextTest ctx;
+    auto renderTarget = ctx.testingImpl()->makeRenderTarget(1000, 1000);
+    RiveRenderPaint paint;
+    RawPath scratchPath;
+
+    auto drawType = [&](rcp<RiveRenderPath> path, const RenderContext::FrameDescriptor& desc) {
+        ctx.beginFrame(desc);
+        DrawUniquePtr draw =
+            RiveRenderPathDraw::Make(&ctx, Mat2D(), path, FillRule::nonZero, &paint, &scratchPath);
+        Draw::Type type = draw->type();
+        draw.reset();
+        ctx.flush({.renderTarget = renderTarget.get()});
+        return type;
+    };
+
+    auto path = make_rcp<RiveRenderPath>();
+    path->addRect(0, 0, 900, 900);
+
+    RenderContext::FrameDescriptor desc = {
+        .renderTargetWidth = 1000,
+        .renderTargetHeight = 1000,
+    };
+    CHECK(drawType(path, desc) == Draw::Type::interiorTriangulationPath);
+
+    RenderContext::FrameDescriptor smallDesc = desc;
+    smallDesc.interiorTriangulationMinArea = 900 * 900;
+    CHECK(drawType(path, smallDesc) == Draw::Type::midpointFanPath);
+
+    RenderContext::FrameDescriptor fewVerbsDesc = desc;
+    fewVerbsDesc.interiorTriangulationMaxVerbCount = path->getRawPath().verbs().count();
+    CHECK(drawType(path, fewVerbsDesc) == Draw::Type::midpointFanPath);
+
+    RenderContext::FrameDescriptor asyncDesc = desc;
+    asyncDesc.asyncInteriorTriangulation = true;
+    auto asyncPath = make_rcp<RiveRenderPath>();
+    asyncPath->addRect(0, 0, 800, 900);
+    CHECK(drawType(asyncPath, asyncDesc) == Draw::Type::midpointFanPath);
+    ctx.interiorTriangulationWorker()->waitUntilIdle();
+    auto vertical = RiveRenderPathDraw::TriangulatorAxis::vertical;
+    auto horizontal = RiveRenderPathDraw::TriangulatorAxis::horizontal;
+    CHECK(!asyncPath->isInteriorTriangulationPending(FillRule::nonZero, vertical));
+    CHECK(drawType(asyncPath, asyncDesc) == Draw::Type::interiorTriangulationPath);
+
+    // A path the synchronous mode already triangulated doesn't need to wait.
+    CHECK(drawType(path, asyncDesc) == Draw::Type::interiorTriangulationPath);
+
+    // Draws check for pending triangulations by the path's contents, without linearizing it.
+    auto pending =
+        make_rcp<InteriorTriangulation>(path->getRawPath(), 1, FillRule::nonZero, vertical);
+    CHECK(pending->isPendingFor(1, FillRule::nonZero, vertical));
+    CHECK(!pending->isPendingFor(2, FillRule::nonZero, vertical));
+    CHECK(!pending->isPendingFor(1, FillRule::evenOdd, vertical));
+    CHECK(!pending->isPendingFor(1, FillRule::nonZero, horizontal));
+    pending->triangulate();
+    CHECK(!pending->isPendingFor(1, FillRule::nonZero, vertical));
+}
+
+TEST_CASE("OcclusionCulling", "RenderContext")
+{
+    RenderContextTest ctx;
+    auto renderTarget = ctx.testingImpl()->makeRenderTarget(100, 100);
+    RenderContext::FrameDescriptor desc = {
+        .renderTargetWidth = 100,
+        .renderTargetHeight = 100,
+    };
+
+    auto rect = [](float l, float t, float r, float b) {
+        auto path = make_rcp<RiveRenderPath>();
+        path->addRect(l, t, r - l, b - t);
+        return path;
+    };
+    auto paint = [](ColorInt color, bool stroked = false) {
+        auto paint = make_rcp<RiveRenderPaint>();
+        paint->color(color);
+        paint->style(stroked ? RenderPaintStyle::stroke : RenderPaintStyle::fill);
+        return paint;
+    };
+    auto opaque = paint(0xff0000ff);
+    auto translucent = paint(0x800000ff);
+    auto background = rect(0, 0, 100, 100);
+    auto small = rect(10, 10, 20, 20);
+    auto curve = make_rcp<RiveRenderPath>();
+    curve->moveTo(30, 30);
+    curve->cubicTo(60, 30, 60, 60, 30, 60);
+
+    auto culledCount = [&](std::function<void(RiveRenderer*)> draw) {
+        ctx.beginFrame(desc);
+        RiveRenderer renderer(&ctx);
+        draw(&renderer);
+        ctx.flush({.renderTarget = renderTarget.get()});
+        return ctx.occlusionCulledDrawCount();
+    };
+
+    CHECK(culledCount([&](RiveRenderer* r) {
+              r->drawPath(small.get(), translucent.get());
+              r->drawPath(curve.get(), paint(0xff00ff00, true).get());
+              r->drawPath(background.get(), opaque.get());
+          }) == 2);
+
+    // Draws in front of the occluder stay.
+    CHECK(culledCount([&](RiveRenderer* r) {
+              r->drawPath(background.get(), opaque.get());
+              r->drawPath(small.get(), opaque.get());
+          }) == 0);
+
+    // Occluders have to be opaque, filled, axis-aligned, and unclipped.
+    CHECK(culledCount([&](RiveRenderer* r) {
+              r->drawPath(small.get(), opaque.get());
+              r->drawPath(background.get(), translucent.get());
+              r->drawPath(background.get(), paint(0xff0000ff, true).get());
+              r->save();
+              r->transform(Mat2D::fromRotation(.1f));
+              r->drawPath(rect(-50, -50, 150, 150).get(), opaque.get());
+              r->restore();
+              r->save();
+              r->clipPath(rect(0, 0, 50, 100).get());
+              r->drawPath(background.get(), opaque.get());
+              r->restore();
+              r->save();
+              r->clipPath(curve.get());
+              r->drawPath(background.get(), opaque.get());
+              r->restore();
+          }) == 0);
+
+    // Only the parts of draws inside the render target need to be covered.
+    CHECK(culledCount([&](RiveRenderer* r) {
+              r->drawPath(rect(90, 90, 110, 110).get(), opaque.get());
+              r->drawPath(rect(50, 50, 150, 60).get(), opaque.get());
+              r->drawPath(rect(0, 0, 100, 100).get(), opaque.get());
+              r->drawPath(rect(60, 40, 100, 70).get(), opaque.get());
+          }) == 2);
+
+    // Occluders only count pixels they cover completely.
+    CHECK(culledCount([&](RiveRenderer* r) {
+              r->drawPath(rect(0, 0, 10, 10).get(), opaque.get());
+              r->drawPath(rect(.5f, .5f, 50.5f, 50.5f).get(), opaque.get());
+          }) == 0);
+    CHECK(culledCount([&](RiveRenderer* r) {
+              r->drawPath(rect(1, 1, 50, 50).get(), opaque.get());
+              r->drawPath(rect(.5f, .5f, 50.5f, 50.5f).get(), opaque.get());
+          }) == 1);
+
+    // Clipped draws get culled, but the clip updates they depend on don't.
+    CHECK(culledCount([&](RiveRenderer* r) {
+              r->save();
+              r->clipPath(curve.get());
+              r->drawPath(small.get(), opaque.get());
+              r->restore();
+              r->drawPath(background.get(), opaque.get());
+          }) == 1);
+}
 } // namespace rive::gpu
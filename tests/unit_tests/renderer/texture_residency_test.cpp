@@ -0,0 +1,143 @@
+/*
+ * Copyright 2024 Rive
+ */
+
+#include "common/render_context_null.hpp"
+#include "rive/renderer/rive_render_image.hpp"
+#include "rive/renderer/rive_renderer.hpp"
+#include "../src/texture_residency_manager.hpp"
+#include <catch.hpp>
+
+namespace rive::gpu
+{
+// "Decodes" images whose encoded bytes are just their width and height, honoring maxDimension.
+class RenderContextFakeDecode : public RenderContextNULL
+{
+public:
+    rcp<Texture> decodeImageTexture(Span<const uint8_t> encodedBytes,
+                                    uint32_t maxDimension) override
+    {
+        ++decodeCount;
+        uint32_t width = encodedBytes[0] | encodedBytes[1] << 8;
+        uint32_t height = encodedBytes[2] | encodedBytes[3] << 8;
+        while (maxDimension != 0 && std::max(width, height) > maxDimension)
+        {
+            width = std::max(width / 2, 1u);
+            height = std::max(height / 2, 1u);
+        }
+        return make_rcp<Texture>(width, height);
+    }
+
+    int decodeCount = 0;
+};
+
+static rcp<RenderImage> decode_image_of_size(RenderContext* renderContext,
+                                             uint16_t width,
+                                             uint16_t height)
+{
+    const uint8_t encodedBytes[] = {static_cast<uint8_t>(width),
+                                    static_cast<uint8_t>(width >> 8),
+                                    static_cast<uint8_t>(height),
+                                    static_cast<uint8_t>(height >> 8)};
+    return renderContext->decodeImage(Span<const uint8_t>(encodedBytes, sizeof(encodedBytes)));
+}
+
+static const Texture* texture_of(const rcp<RenderImage>& image)
+{
+    return static_cast<const RiveRenderImage*>(image.get())->getTexture();
+}
+
+TEST_CASE("TextureSizeInBytes", "[texture_residency]")
+{
+    auto rgba = make_rcp<Texture>(64, 32);
+    CHECK(TextureResidencyManager::TextureSizeInBytes(rgba.get()) == 64 * 32 * 4 * 4 / 3);
+    auto bc7 = make_rcp<Texture>(10, 5, ImageTextureFormat::bc7);
+    CHECK(TextureResidencyManager::TextureSizeInBytes(bc7.get()) == 3 * 2 * 16 * 4 / 3);
+    CHECK(TextureResidencyManager::TextureSizeInBytes(nullptr) == 0);
+}
+
+TEST_CASE("ImageTextureBudget", "[texture_residency]")
+{
+    auto renderContext =
+        std::make_unique<RenderContext>(std::make_unique<RenderContextFakeDecode>());
+    auto impl = renderContext->static_impl_cast<RenderContextFakeDecode>();
+    RenderContext::FrameDescriptor frameDescriptor;
+    frameDescriptor.renderTargetWidth = 100;
+    frameDescriptor.renderTargetHeight = 100;
+    auto renderTarget = impl->makeRenderTarget(100, 100);
+    auto drawFrame = [&](const std::vector<RenderImage*>& images) {
+        renderContext->beginFrame(frameDescriptor);
+        RiveRenderer renderer(renderContext.get());
+        for (RenderImage* image : images)
+        {
+            renderer.drawImage(image, BlendMode::srcOver, 1);
+        }
+        renderContext->flush({.renderTarget = renderTarget.get()});
+    };
+
+    constexpr size_t kFullSize = 64 * 64 * 4 * 4 / 3;
+    constexpr size_t kDownscaledSize = 16 * 16 * 4 * 4 / 3;
+
+    // Without a budget, images don't hold on to their encoded bytes.
+    auto untracked = decode_image_of_size(renderContext.get(), 64, 64);
+    CHECK(static_cast<const RiveRenderImage*>(untracked.get())->residency() == nullptr);
+    CHECK(renderContext->residentImageTextureBytes() == 0);
+
+    renderContext->setImageTextureBudget(kFullSize * 2 + kFullSize / 2);
+    auto a = decode_image_of_size(renderContext.get(), 64, 64);
+    auto b = decode_image_of_size(renderContext.get(), 64, 64);
+    auto c = decode_image_of_size(renderContext.get(), 64, 64);
+    CHECK(impl->decodeCount == 4);
+    CHECK(renderContext->residentImageTextureBytes() == kFullSize * 3);
+
+    // "c" is the coldest, so it gets downscaled.
+    drawFrame({a.get(), b.get()});
+    CHECK(texture_of(a)->width() == 64);
+    CHECK(texture_of(b)->width() == 64);
+    CHECK(texture_of(c)->width() == 16);
+    CHECK(renderContext->residentImageTextureBytes() == kFullSize * 2 + kDownscaledSize);
+
+    // There isn't room to bring "c" back at full size, so it gets drawn downscaled.
+    drawFrame({c.get()});
+    CHECK(texture_of(c)->width() == 16);
+    CHECK(impl->decodeCount == 5);
+
+    // Under a tighter budget, "a" is now the coldest.
+    renderContext->setImageTextureBudget(kFullSize + kFullSize / 2);
+    drawFrame({c.get()});
+    CHECK(texture_of(a)->width() == 16);
+    CHECK(texture_of(b)->width() == 64);
+    CHECK(renderContext->residentImageTextureBytes() == kFullSize + kDownscaledSize * 2);
+
+    // Textures that can't fit even downscaled get released.
+    renderContext->setImageTextureBudget(1);
+    drawFrame({});
+    CHECK(texture_of(a) == nullptr);
+    CHECK(texture_of(b) == nullptr);
+    CHECK(texture_of(c) == nullptr);
+    CHECK(renderContext->residentImageTextureBytes() == 0);
+
+    // Released textures come back when drawn, and are never evicted in the frame that drew them.
+    drawFrame({a.get()});
+    REQUIRE(texture_of(a) != nullptr);
+    CHECK(texture_of(a)->width() == 16);
+    CHECK(renderContext->residentImageTextureBytes() == kDownscaledSize);
+
+    // Without a budget, downscaled textures come back at full size.
+    renderContext->setImageTextureBudget(0);
+    drawFrame({a.get(), b.get()});
+    CHECK(texture_of(a)->width() == 64);
+    CHECK(texture_of(b)->width() == 64);
+    CHECK(texture_of(c) == nullptr);
+    CHECK(renderContext->residentImageTextureBytes() == kFullSize * 2);
+
+    // Deleting an image takes its texture out of the accounting.
+    a = nullptr;
+    CHECK(renderContext->residentImageTextureBytes() == kFullSize);
+
+    // Images may outlive the context.
+    renderContext.reset();
+    b = nullptr;
+    c = nullptr;
+}
+} // namespace rive::gpu
@@ -1019,7 +1019,6 @@ static void verify_simple_inner_polygons(const char* shapeName, const RawPath& p
         // path.setFillType(fillType);
         TrivialBlockAllocator alloc(GrTriangulator::kArenaDefaultChunkSize);
         GrInnerFanTriangulator triangulator(path,
-                                            Mat2D(),
                                             path.bounds().width() > path.bounds().height()
                                                 ? GrTriangulator::Comparator::Direction::kHorizontal
                                                 : GrTriangulator::Comparator::Direction::kVertical,
@@ -1029,7 +1028,7 @@ static void verify_simple_inner_polygons(const char* shapeName, const RawPath& p
         std::vector<gpu::TriangleVertex> vertexData(triangulator.maxVertexCount());
         gpu::WriteOnlyMappedMemory<gpu::TriangleVertex> mappedMemory(vertexData.data(),
                                                                      triangulator.maxVertexCount());
-        size_t vertexCount = triangulator.polysToTriangles(&mappedMemory, pathID);
+        size_t vertexCount = triangulator.polysToTriangles(&mappedMemory, pathID, false);
         const gpu::TriangleVertex* tris = vertexData.data();
         const GrInnerFanTriangulator::GroutTriangleList& grouts = triangulator.groutList();
 
@@ -3,9 +3,11 @@
 #include "rive/audio/audio_sound.hpp"
 #include "rive/audio/audio_reader.hpp"
 #include "rive/audio_event.hpp"
+#include "rive/animation/state_machine_instance.hpp"
 #include "rive/assets/audio_asset.hpp"
 #include "rive_file_reader.hpp"
 #include "catch.hpp"
+#include <cmath>
 #include <string>
 
 using namespace rive;
@@ -230,4 +232,120 @@ TEST_CASE("Artboard does not have audio", "[audio]")
     REQUIRE(artboard->hasAudio() == false);
 }
 
-// TODO check if sound->stop calls completed callback!!!
\ No newline at end of file
+// TODO check if sound->stop calls completed callback!!!
+
+static size_t firstAudibleFrame(const std::vector<float>& frames, uint32_t channels)
+{
+    for (size_t i = 0; i < frames.size(); i++)
+    {
+        if (frames[i] != 0.0f)
+        {
+            return i / channels;
+        }
+    }
+    return frames.size() / channels;
+}
+
+// Renders 1 second of audio at 60fps, playing source during the given step
+// with the given delay (relative to the end of that step).
+static std::vector<float> renderOffline(rcp<AudioSource> source,
+                                        int playStep,
+                                        float delaySeconds)
+{
+    rcp<AudioEngine> engine = AudioEngine::MakeOffline(2, 48000);
+    REQUIRE(engine != nullptr);
+    REQUIRE(engine->isOffline());
+
+    std::vector<float> output;
+    for (int step = 0; step < 60; step++)
+    {
+        uint64_t numFrames = engine->beginOfflineStep(1.0f / 60.0f);
+        if (step == playStep)
+        {
+            REQUIRE(engine->play(source, engine->eventTimeInFrames(delaySeconds), 0, 0) !=
+                    nullptr);
+        }
+        size_t offset = output.size();
+        output.resize(offset + numFrames * engine->channels());
+        REQUIRE(engine->renderOfflineStep(output.data() + offset));
+    }
+    // Steps are accumulated precisely, 60 steps of 1/60s is exactly 1s.
+    REQUIRE(output.size() == 48000 * 2);
+    REQUIRE(engine->timeInFrames() == 48000);
+    return output;
+}
+
+TEST_CASE("offline audio engine renders sample accurately", "[audio]")
+{
+    for (auto filename : {"assets/audio/what.wav", "assets/audio/song.mp3"})
+    {
+        auto file = loadFile(filename);
+        rcp<AudioSource> audioSource = rcp<AudioSource>(new AudioSource(Span<uint8_t>(file)));
+
+        auto reference = renderOffline(audioSource, 0, 1.0f / 60.0f);
+        size_t referenceStart = firstAudibleFrame(reference, 2);
+        REQUIRE(referenceStart + 8800 < 48000);
+
+        // Reported at the end of step 10, so it starts at frame 8800.
+        auto atStepEnd = renderOffline(audioSource, 10, 0.0f);
+        CHECK(firstAudibleFrame(atStepEnd, 2) == 8800 + referenceStart);
+
+        // Reported 5ms (240 frames) before the end of step 10.
+        auto delayed = renderOffline(audioSource, 10, 0.005f);
+        CHECK(firstAudibleFrame(delayed, 2) == 8800 - 240 + referenceStart);
+
+        // Offline rendering is deterministic.
+        CHECK(renderOffline(audioSource, 10, 0.005f) == delayed);
+    }
+}
+
+TEST_CASE("state machine audio events start on the frame they were reported at", "[audio]")
+{
+    rcp<AudioEngine> engine = AudioEngine::MakeOffline(2, 48000);
+    REQUIRE(engine != nullptr);
+
+    auto file = ReadRiveFile("assets/sound2.riv");
+    auto artboard = file->artboardNamed("child");
+    REQUIRE(artboard != nullptr);
+    artboard->audioEngine(engine);
+
+    auto audioEvents = artboard->find<AudioEvent>();
+    REQUIRE(audioEvents.size() == 1);
+    rcp<AudioSource> audioSource = audioEvents[0]->asset()->audioSource();
+    REQUIRE(audioSource != nullptr);
+    size_t referenceStart = firstAudibleFrame(renderOffline(audioSource, 0, 1.0f / 60.0f), 2);
+    REQUIRE(referenceStart + 800 < 48000);
+
+    auto stateMachine = artboard->stateMachineAt(0);
+    REQUIRE(stateMachine != nullptr);
+    std::vector<float> output;
+    for (int step = 0; step < 60; step++)
+    {
+        uint64_t numFrames = engine->beginOfflineStep(1.0f / 60.0f);
+        stateMachine->advanceAndApply(1.0f / 60.0f);
+        size_t offset = output.size();
+        output.resize(offset + numFrames * engine->channels());
+        REQUIRE(engine->renderOfflineStep(output.data() + offset));
+    }
+    // The timeline fires the event on its first frame, which the second step starts at (frame
+    // 800). The state machine only plays it during the third step, 1/30s after the event.
+    CHECK(firstAudibleFrame(output, 2) == 800 + referenceStart);
+}
+
+TEST_CASE("offline audio engine stays in lockstep with odd step sizes", "[audio]")
+{
+    rcp<AudioEngine> engine = AudioEngine::MakeOffline(2, 44100);
+    REQUIRE(engine != nullptr);
+    std::vector<float> frames;
+    uint64_t total = 0;
+    for (int i = 0; i < 1000; i++)
+    {
+        uint64_t numFrames = engine->beginOfflineStep(1.0f / 29.97f);
+        frames.resize(numFrames * 2);
+        REQUIRE(engine->renderOfflineStep(frames.data()));
+        total += numFrames;
+    }
+    double stepSeconds = 1.0f / 29.97f;
+    CHECK(total == (uint64_t)std::llround(stepSeconds * 1000 * 44100));
+    CHECK(engine->timeInFrames() == total);
+}
@@ -0,0 +1,105 @@
+/*
+ * Copyright 2024 Rive
+ */
+
+#include <rive/core/core_arena.hpp>
+#include <rive/file.hpp>
+#include <rive/node.hpp>
+#include <rive/animation/state_machine_instance.hpp>
+#include "rive_file_reader.hpp"
+#include <catch.hpp>
+
+using namespace rive;
+
+TEST_CASE("arena allocations are aligned and grouped by size", "[core_arena]")
+{
+    // Chunks hold a whole number of objects of their size class.
+    auto chunkBytes = [](size_t size) { return (CoreArena::kChunkBytes / size) * size; };
+
+    CoreArena arena;
+    auto a = static_cast<uint8_t*>(arena.allocate(40));
+    auto b = static_cast<uint8_t*>(arena.allocate(100));
+    auto c = static_cast<uint8_t*>(arena.allocate(48));
+    for (auto ptr : {a, b, c})
+    {
+        CHECK(reinterpret_cast<uintptr_t>(ptr) % CoreArena::kAlignment == 0);
+    }
+    // 40 and 48 bytes share a size class, so they're next to each other.
+    CHECK(c == a + 48);
+    CHECK(arena.allocatedBytes() == 48 + 112 + 48);
+    size_t reservedBytes = chunkBytes(48) + chunkBytes(112);
+    CHECK(arena.reservedBytes() == reservedBytes);
+
+    // Large allocations get a chunk of their own.
+    arena.allocate(CoreArena::kMaxSizeClassBytes + 1);
+    reservedBytes += CoreArena::kMaxSizeClassBytes + CoreArena::kAlignment;
+    CHECK(arena.reservedBytes() == reservedBytes);
+
+    // Size classes move on to a new chunk once theirs fills up.
+    for (size_t i = 0; i < CoreArena::kChunkBytes / 48; i++)
+    {
+        arena.allocate(48);
+    }
+    reservedBytes += chunkBytes(48);
+    CHECK(arena.reservedBytes() == reservedBytes);
+}
+
+TEST_CASE("arena scopes nest", "[core_arena]")
+{
+    CoreArena a, b;
+    CHECK(CoreArena::current() == nullptr);
+    {
+        CoreArena::Scope scopeA(&a);
+        CHECK(CoreArena::current() == &a);
+        {
+            CoreArena::Scope scopeB(&b);
+            CHECK(CoreArena::current() == &b);
+            {
+                CoreArena::Scope heapScope(nullptr);
+                CHECK(CoreArena::current() == nullptr);
+            }
+            CHECK(CoreArena::current() == &b);
+        }
+        CHECK(CoreArena::current() == &a);
+    }
+    CHECK(CoreArena::current() == nullptr);
+}
+
+#ifdef WITH_RIVE_CORE_ARENA
+TEST_CASE("core objects come from the current arena", "[core_arena]")
+{
+    CoreArena arena;
+    Node* node;
+    {
+        CoreArena::Scope scope(&arena);
+        node = new Node();
+    }
+    CHECK(arena.allocatedBytes() >= sizeof(Node));
+    auto allocatedBytes = arena.allocatedBytes();
+    // Objects made outside of a scope come from the heap.
+    auto heapNode = new Node();
+    CHECK(arena.allocatedBytes() == allocatedBytes);
+    delete heapNode;
+    // Deleting only runs the destructor, the memory goes away with the arena.
+    delete node;
+    CHECK(arena.allocatedBytes() == allocatedBytes);
+}
+
+TEST_CASE("artboard instances free their arenas after their objects", "[core_arena]")
+{
+    // Nested artboards get instanced while their parent is being cloned.
+    auto file = ReadRiveFile("assets/nested_event_test.riv");
+    REQUIRE(CoreArena::current() == nullptr);
+    auto artboard = file->artboard()->instance();
+    REQUIRE(CoreArena::current() == nullptr);
+    auto stateMachine = artboard->defaultStateMachine();
+    REQUIRE(stateMachine != nullptr);
+    stateMachine->advanceAndApply(0.1f);
+
+    // Instances don't depend on each other's arenas.
+    auto other = file->artboard()->instance();
+    stateMachine = nullptr;
+    artboard = nullptr;
+    other->advance(0.1f);
+}
+#endif
@@ -66,3 +66,32 @@ TEST_CASE("follow path constraint with path at 0 opacity updates world transform
     REQUIRE(targetComponents.x() == rectComponents.x());
     REQUIRE(targetComponents.y() == rectComponents.y());
 }
+
+TEST_CASE("follow path constraint follows a moving target path", "[file]")
+{
+    // Move the followed path after its measure was built and compare against
+    // a file where the path was moved before anything was measured.
+    auto movedFile = ReadRiveFile("assets/follow_path.riv");
+    auto movedArtboard = movedFile->artboard();
+    movedArtboard->advance(0.0f);
+
+    auto freshFile = ReadRiveFile("assets/follow_path.riv");
+    auto freshArtboard = freshFile->artboard();
+
+    for (auto artboard : {movedArtboard, freshArtboard})
+    {
+        auto rect = artboard->find<rive::Node>("rect");
+        REQUIRE(rect != nullptr);
+        rect->x(rect->x() + 40.0f);
+        rect->y(rect->y() - 15.0f);
+        rect->rotation(rect->rotation() + 0.75f);
+        artboard->advance(0.0f);
+    }
+
+    auto moved = movedArtboard->find<rive::TransformComponent>("target")->worldTransform();
+    auto fresh = freshArtboard->find<rive::TransformComponent>("target")->worldTransform();
+    for (int i = 0; i < 6; i++)
+    {
+        REQUIRE(moved[i] == Approx(fresh[i]).margin(0.01f));
+    }
+}
@@ -1,6 +1,10 @@
 #include "rive_file_reader.hpp"
 #include "rive_testing.hpp"
 #include "rive/decoders/bitmap_decoder.hpp"
+#include "rive/decoders/ktx2_image.hpp"
+#include "ktx2_test_file.hpp"
+#include <array>
+#include <vector>
 
 TEST_CASE("png file decodes correctly", "[image-decoder]")
 {
@@ -76,4 +80,312 @@ TEST_CASE("webp file decodes correctly", "[image-decoder]")
 
     REQUIRE(bitmap->width() == 550);
     REQUIRE(bitmap->height() == 368);
-}
\ No newline at end of file
+}
+
+TEST_CASE("jpeg file decodes at reduced size", "[image-decoder]")
+{
+    auto file = ReadFile("assets/open_source.jpg");
+
+    Bitmap::DecodeOptions options;
+    options.maxWidth = 100;
+    options.maxHeight = 100;
+    uint32_t fitWidth, fitHeight;
+    Bitmap::FitWithin(options, 350, 200, &fitWidth, &fitHeight);
+    REQUIRE(fitWidth == 100);
+    REQUIRE(fitHeight == 58);
+
+    auto bitmap = Bitmap::decode(file.data(), file.size(), options);
+
+    REQUIRE(bitmap != nullptr);
+    // Never smaller than the fitted size, but well under full resolution.
+    REQUIRE(bitmap->width() >= fitWidth);
+    REQUIRE(bitmap->height() >= fitHeight);
+    REQUIRE(bitmap->width() < 350);
+    REQUIRE(bitmap->height() < 200);
+}
+
+TEST_CASE("decoders write RGBA directly", "[image-decoder]")
+{
+    Bitmap::DecodeOptions options;
+    options.forceRGBA = true;
+
+    auto jpeg = ReadFile("assets/open_source.jpg");
+    auto bitmap = Bitmap::decode(jpeg.data(), jpeg.size(), options);
+    REQUIRE(bitmap != nullptr);
+    REQUIRE(bitmap->pixelFormat() == Bitmap::PixelFormat::RGBA);
+    REQUIRE(bitmap->width() == 350);
+    REQUIRE(bitmap->height() == 200);
+    for (size_t i = 0; i < bitmap->byteSize(); i += 4)
+    {
+        REQUIRE(bitmap->bytes()[i + 3] == 255);
+    }
+
+    auto png = ReadFile("assets/placeholder.png");
+    bitmap = Bitmap::decode(png.data(), png.size(), options);
+    REQUIRE(bitmap != nullptr);
+    REQUIRE(bitmap->pixelFormat() == Bitmap::PixelFormat::RGBA);
+}
+
+TEST_CASE("webp file decodes at reduced size", "[image-decoder]")
+{
+    auto file = ReadFile("assets/1.webp");
+
+    Bitmap::DecodeOptions options;
+    options.maxWidth = 275;
+    auto bitmap = Bitmap::decode(file.data(), file.size(), options);
+
+    REQUIRE(bitmap != nullptr);
+#ifdef __APPLE__
+    REQUIRE(bitmap->width() >= 275);
+    REQUIRE(bitmap->width() < 550);
+#else
+    REQUIRE(bitmap->width() == 275);
+    REQUIRE(bitmap->height() == 184);
+#endif
+}
+
+TEST_CASE("RGB expands to opaque RGBA", "[image-decoder]")
+{
+    // Odd sizes exercise both the vectorized loop and the tail.
+    for (size_t pixelCount : {1, 5, 6, 7, 33})
+    {
+        std::vector<uint8_t> rgb(pixelCount * 3);
+        for (size_t i = 0; i < rgb.size(); ++i)
+        {
+            rgb[i] = static_cast<uint8_t>(i * 7);
+        }
+        std::vector<uint8_t> rgba(pixelCount * 4);
+        Bitmap::ExpandRGBToRGBA(rgb.data(), rgba.data(), pixelCount);
+        for (size_t i = 0; i < pixelCount; ++i)
+        {
+            CHECK(rgba[i * 4 + 0] == rgb[i * 3 + 0]);
+            CHECK(rgba[i * 4 + 1] == rgb[i * 3 + 1]);
+            CHECK(rgba[i * 4 + 2] == rgb[i * 3 + 2]);
+            CHECK(rgba[i * 4 + 3] == 255);
+        }
+    }
+}
+
+TEST_CASE("RGBA premultiplies with rounding", "[image-decoder]")
+{
+    uint8_t pixels[] = {
+        255, 128, 0,   255, // opaque
+        255, 128, 1,   128, // half
+        200, 100, 50,  0,   // transparent
+        255, 255, 255, 1,   // odd pixel takes the scalar path
+    };
+    Bitmap::PremultiplyRGBA(pixels, 4);
+    uint8_t expected[] = {
+        255, 128, 0, 255, 128, 64, 1, 128, 0, 0, 0, 0, 1, 1, 1, 1,
+    };
+    for (size_t i = 0; i < sizeof(pixels); ++i)
+    {
+        CHECK(pixels[i] == expected[i]);
+    }
+}
+
+TEST_CASE("ktx2 rgba8 file decodes correctly", "[image-decoder]")
+{
+    auto file = make_ktx2(37, 2, 2, 2);
+    REQUIRE(KTX2Image::IsKTX2(file.data(), file.size()));
+    REQUIRE(!Bitmap::decode(file.data(), file.size()));
+
+    auto image = KTX2Image::decode(file.data(), file.size());
+    REQUIRE(image != nullptr);
+    CHECK(image->format() == KTX2Image::Format::rgba8);
+    CHECK(!image->isBlockCompressed());
+    CHECK(image->width() == 2);
+    CHECK(image->height() == 2);
+    REQUIRE(image->levels().size() == 2);
+    CHECK(image->levels()[0].byteCount == 16);
+    CHECK(image->levels()[1].width == 1);
+    CHECK(image->levels()[1].byteCount == 4);
+    CHECK(image->levels()[1].bytes == image->levels()[0].bytes + 16);
+}
+
+TEST_CASE("ktx2 block-compressed mips keep their size", "[image-decoder]")
+{
+    // bc7, etc2, astc 4x4.
+    for (uint32_t vkFormat : {145u, 151u, 157u})
+    {
+        auto file = make_ktx2(vkFormat, 8, 6, 4);
+        auto image = KTX2Image::decode(file.data(), file.size());
+        REQUIRE(image != nullptr);
+        CHECK(image->isBlockCompressed());
+        REQUIRE(image->levels().size() == 4);
+        CHECK(image->levels()[0].byteCount == 2 * 2 * 16);
+        CHECK(image->levels()[1].byteCount == 1 * 1 * 16);
+        CHECK(image->levels()[2].width == 2);
+        CHECK(image->levels()[2].byteCount == 16);
+        CHECK(image->levels()[3].width == 1);
+        CHECK(image->levels()[3].height == 1);
+        CHECK(image->levels()[3].byteCount == 16);
+    }
+}
+
+TEST_CASE("ktx2 rejects files it can't upload directly", "[image-decoder]")
+{
+    auto file = make_ktx2(145, 8, 8, 2);
+    // Truncated.
+    CHECK(KTX2Image::decode(file.data(), file.size() - 1) == nullptr);
+    CHECK(KTX2Image::decode(file.data(), 60) == nullptr);
+    // Basis Universal.
+    auto basis = make_ktx2(0, 8, 8, 1);
+    CHECK(KTX2Image::decode(basis.data(), basis.size()) == nullptr);
+    // Zstandard.
+    auto zstd = make_ktx2(145, 8, 8, 1, 2);
+    CHECK(KTX2Image::decode(zstd.data(), zstd.size()) == nullptr);
+    // Too many levels for the dimensions.
+    auto extraLevels = make_ktx2(37, 2, 2, 3);
+    CHECK(KTX2Image::decode(extraLevels.data(), extraLevels.size()) == nullptr);
+    // Not a KTX2 file at all.
+    auto png = ReadFile("assets/placeholder.png");
+    CHECK(!KTX2Image::IsKTX2(png.data(), png.size()));
+    CHECK(KTX2Image::decode(png.data(), png.size()) == nullptr);
+}
+
+static void check_pixel(const Bitmap& bitmap,
+                        uint32_t x,
+                        uint32_t y,
+                        std::initializer_list<uint8_t> rgba)
+{
+    INFO("pixel " << x << "," << y);
+    const uint8_t* pixel = bitmap.bytes() + (y * bitmap.width() + x) * 4;
+    CHECK(std::vector<uint8_t>(pixel, pixel + 4) == std::vector<uint8_t>(rgba));
+}
+
+// Builds a one block, 4x4 KTX2 file.
+static std::vector<uint8_t> make_ktx2_block(uint32_t vkFormat, std::array<uint8_t, 16> block)
+{
+    auto file = make_ktx2(vkFormat, 4, 4, 1);
+    std::copy(block.begin(), block.end(), file.end() - 16);
+    return file;
+}
+
+TEST_CASE("ktx2 levels decode to rgba on the cpu", "[image-decoder]")
+{
+    // bc7 mode 6.
+    auto bc7 = make_ktx2_block(145,
+                               {0x40, 0x05, 0x99, 0xe2, 0xf6, 0xe0, 0xff, 0xc0,
+                                0xf0, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00});
+    auto image = KTX2Image::decode(bc7.data(), bc7.size());
+    REQUIRE(image != nullptr);
+    auto bitmap = image->decodeLevel(0);
+    REQUIRE(bitmap != nullptr);
+    CHECK(bitmap->pixelFormat() == Bitmap::PixelFormat::RGBA);
+    CHECK(bitmap->width() == 4);
+    CHECK(bitmap->height() == 4);
+    check_pixel(*bitmap, 0, 0, {21, 41, 61, 255});
+    check_pixel(*bitmap, 1, 0, {200, 220, 240, 128});
+    check_pixel(*bitmap, 2, 0, {116, 136, 156, 188});
+
+    // etc2 individual mode with eac alpha.
+    auto etc2 = make_ktx2_block(151,
+                                {0x80, 0x2d, 0x92, 0x3f, 0x24, 0x92, 0x49, 0x24,
+                                 0x8f, 0x40, 0x28, 0x1c, 0x10, 0x00, 0x10, 0x00});
+    image = KTX2Image::decode(etc2.data(), etc2.size());
+    REQUIRE(image != nullptr);
+    bitmap = image->decodeLevel(0);
+    REQUIRE(bitmap != nullptr);
+    check_pixel(*bitmap, 0, 0, {138, 70, 36, 128});
+    check_pixel(*bitmap, 1, 0, {138, 70, 36, 146});
+    check_pixel(*bitmap, 3, 0, {72, 0, 0, 128});
+    check_pixel(*bitmap, 2, 1, {255, 47, 183, 128});
+    check_pixel(*bitmap, 0, 3, {138, 70, 36, 108});
+
+    // astc 4x4 with a single partition of rgba endpoints.
+    auto astc = make_ktx2_block(157,
+                                {0x42, 0x80, 0x15, 0xf4, 0x29, 0xe0, 0x3d, 0xcc,
+                                 0xff, 0xc9, 0x00, 0x00, 0x01, 0x08, 0x30, 0x00});
+    image = KTX2Image::decode(astc.data(), astc.size());
+    REQUIRE(image != nullptr);
+    bitmap = image->decodeLevel(0);
+    REQUIRE(bitmap != nullptr);
+    check_pixel(*bitmap, 0, 0, {10, 20, 30, 255});
+    check_pixel(*bitmap, 1, 1, {250, 240, 230, 100});
+    check_pixel(*bitmap, 2, 2, {89, 92, 96, 204});
+    check_pixel(*bitmap, 3, 3, {171, 168, 165, 151});
+}
+
+TEST_CASE("ktx2 cpu decoding clips edge blocks", "[image-decoder]")
+{
+    // A 6x5 astc image is 2x2 blocks. Fill them all with a void extent color.
+    const uint8_t voidExtent[] = {0xfc, 0xfd, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+                                  0x34, 0x12, 0x78, 0x56, 0xbc, 0x9a, 0xf0, 0xde};
+    auto file = make_ktx2(157, 6, 5, 1);
+    for (int i = 0; i < 4; ++i)
+    {
+        std::copy(voidExtent, voidExtent + 16, file.end() - 16 * (i + 1));
+    }
+    auto image = KTX2Image::decode(file.data(), file.size());
+    REQUIRE(image != nullptr);
+    auto bitmap = image->decodeLevel(0);
+    REQUIRE(bitmap != nullptr);
+    CHECK(bitmap->width() == 6);
+    CHECK(bitmap->height() == 5);
+    for (uint32_t y = 0; y < 5; ++y)
+    {
+        for (uint32_t x = 0; x < 6; ++x)
+        {
+            check_pixel(*bitmap, x, y, {0x12, 0x56, 0x9a, 0xde});
+        }
+    }
+
+    // Uncompressed levels are copied as-is.
+    auto rgba8 = make_ktx2(37, 2, 2, 2);
+    image = KTX2Image::decode(rgba8.data(), rgba8.size());
+    REQUIRE(image != nullptr);
+    bitmap = image->decodeLevel(1);
+    REQUIRE(bitmap != nullptr);
+    CHECK(bitmap->width() == 1);
+    CHECK(bitmap->height() == 1);
+    CHECK(std::equal(bitmap->bytes(), bitmap->bytes() + 4, rgba8.end() - 4));
+    CHECK(image->decodeLevel(2) == nullptr);
+}
+
+TEST_CASE("ktx2 cpu decoding matches a reference decoder", "[image-decoder]")
+{
+    // FNV-1a hashes of 1024x1024 images of pseudo-random blocks, as decoded by Mesa 22.3.6
+    // (llvmpipe): uploaded with glCompressedTexImage2D, and read back with texelFetch. Most random
+    // astc blocks are malformed, but about 2000 of them decode.
+    struct
+    {
+        uint32_t vkFormat;
+        uint32_t hash;
+    } references[] = {{145, 0x62a1bf83}, {151, 0x370feaeb}, {157, 0x6b9f5471}};
+    for (auto reference : references)
+    {
+        INFO("vkFormat " << reference.vkFormat);
+        constexpr uint32_t kSize = 1024;
+        constexpr size_t kBlockCount = kSize / 4 * (kSize / 4);
+        auto file = make_ktx2(reference.vkFormat, kSize, kSize, 1);
+        uint8_t* blocks = file.data() + file.size() - kBlockCount * 16;
+        uint32_t random = 0x12345678;
+        for (size_t i = 0; i < kBlockCount; ++i)
+        {
+            for (size_t j = 0; j < 16; ++j)
+            {
+                random ^= random << 13;
+                random ^= random >> 17;
+                random ^= random << 5;
+                blocks[i * 16 + j] = static_cast<uint8_t>(random >> 24);
+            }
+            if (reference.vkFormat == 145)
+            {
+                // Cycle through the bc7 modes, which are the first byte's lowest set bit.
+                uint8_t mode = i % 8;
+                blocks[i * 16] = (blocks[i * 16] & ~((2 << mode) - 1)) | (1 << mode);
+            }
+        }
+        auto image = KTX2Image::decode(file.data(), file.size());
+        REQUIRE(image != nullptr);
+        auto bitmap = image->decodeLevel(0);
+        REQUIRE(bitmap != nullptr);
+        uint32_t hash = 0x811c9dc5;
+        for (size_t i = 0; i < bitmap->byteSize(); ++i)
+        {
+            hash = (hash ^ bitmap->bytes()[i]) * 0x01000193;
+        }
+        CHECK(hash == reference.hash);
+    }
+}
@@ -161,4 +161,44 @@ TEST_CASE("Looping timeline events load correctly and report", "[events]")
     animationInstance->advance(1.01f, &reporter);
     REQUIRE(animationInstance->time() == Approx(0.01f));
     REQUIRE(reporter.count() == 7);
-}
\ No newline at end of file
+}
+
+TEST_CASE("Animations that only key events know when they'll report next", "[events]")
+{
+    auto file = ReadRiveFile("assets/looping_timeline_events.riv");
+
+    auto artboard = file->artboard()->instance();
+    auto animationInstance = artboard->animationAt(0);
+    REQUIRE(animationInstance->animation()->keysOnlyCallbacks());
+
+    // The event on the first frame is still pending.
+    REQUIRE(animationInstance->secondsUntilChange(1.0f) == 0.0f);
+
+    TestReporter reporter;
+    animationInstance->advance(0.1f, &reporter);
+    REQUIRE(reporter.count() == 1);
+
+    // Nothing happens until the event at frame 25.
+    auto seconds = animationInstance->secondsUntilChange(1.0f);
+    REQUIRE(seconds == Approx(25.0f / 60.0f - 0.1f));
+    animationInstance->advance(seconds * 0.5f, &reporter);
+    REQUIRE(reporter.count() == 1);
+    animationInstance->advance(animationInstance->secondsUntilChange(1.0f), &reporter);
+    REQUIRE(reporter.count() == 2);
+
+    // Then the event at 1 second, which is also where it loops.
+    REQUIRE(animationInstance->secondsUntilChange(1.0f) == Approx(1.0f - 25.0f / 60.0f));
+
+    // Played as a scene, the artboard has to be settled too.
+    REQUIRE(animationInstance->settledSeconds() == 0.0f);
+    animationInstance->advanceAndApply(0.1f);
+    REQUIRE(animationInstance->settledSeconds() == Approx(0.9f - 25.0f / 60.0f));
+
+    // Animations that key properties change every time they advance.
+    auto otherFile = ReadRiveFile("assets/timeline_event_test.riv");
+    auto otherArtboard = otherFile->artboard()->instance();
+    auto otherInstance = otherArtboard->animationAt(0);
+    otherInstance->advanceAndApply(0.1f);
+    REQUIRE(!otherInstance->animation()->keysOnlyCallbacks());
+    REQUIRE(otherInstance->settledSeconds() == 0.0f);
+}
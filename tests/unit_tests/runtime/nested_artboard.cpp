@@ -63,4 +63,44 @@ TEST_CASE("nested artboards with one shot animations will not main advanceAndApp
     REQUIRE(stateMachine->advanceAndApply(0.1f) == true);
     // nested artboards animation is 1s long
     REQUIRE(stateMachine->advanceAndApply(0.1f) == false);
-}
\ No newline at end of file
+}
+TEST_CASE("nested artboards that can't be seen don't advance when culling", "[nested]")
+{
+    auto file = ReadRiveFile("assets/solos_with_nested_artboards.riv");
+
+    auto artboard = file->artboard("main-artboard")->instance();
+    artboard->cullHiddenNestedArtboards(true);
+    artboard->advance(0.0f);
+    auto stateMachine = artboard->stateMachineAt(0);
+    stateMachine->advanceAndApply(0.0f);
+    auto redNestedArtboard = artboard->find<rive::NestedArtboard>("red-artboard");
+    REQUIRE(redNestedArtboard->artboardInstance()->clip());
+    auto redRect = redNestedArtboard->artboardInstance()->find<rive::Shape>().at(0);
+    REQUIRE(redRect->x() == 50);
+
+    // Out of view.
+    artboard->visibleRegion(rive::AABB(10000, 10000, 10100, 10100));
+    artboard->advance(0.75f);
+    CHECK(redNestedArtboard->isCulled());
+    CHECK(redRect->x() == 50);
+
+    // Back in view, it catches up on the time it missed.
+    artboard->resetVisibleRegion();
+    artboard->advance(0.0f);
+    CHECK(!redNestedArtboard->isCulled());
+    CHECK(redRect->x() > 50);
+    float x = redRect->x();
+
+    // Zero opacity.
+    redNestedArtboard->opacity(0.0f);
+    artboard->advance(0.0f);
+    artboard->advance(0.25f);
+    CHECK(redNestedArtboard->isCulled());
+    CHECK(redRect->x() == x);
+
+    // Without culling, everything advances.
+    artboard->cullHiddenNestedArtboards(false);
+    artboard->advance(0.25f);
+    CHECK(!redNestedArtboard->isCulled());
+    CHECK(redRect->x() != x);
+}
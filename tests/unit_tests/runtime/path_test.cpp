@@ -429,3 +429,40 @@ TEST_CASE("double nested solos clipping with animation", "[path]")
     REQUIRE(clippingPath->commands[11].command == TestPathCommandType::AddPath);
     REQUIRE(clippingPath->commands.size() == 12);
 }
+
+TEST_CASE("path composer keeps local geometry when only transforms change", "[path]")
+{
+    TestNoOpFactory emptyFactory;
+    auto file = ReadRiveFile("assets/solos_collapse_tests.riv", &emptyFactory);
+
+    auto artboard = file->artboard("test-1-shape-with-shape-and-path")->instance();
+    artboard->advance(0.0f);
+    auto shape = artboard->find<rive::Shape>("Rectangle-shape");
+    REQUIRE(shape != nullptr);
+    REQUIRE(shape->paths().size() == 1);
+    REQUIRE(shape->paths()[0]->is<rive::Rectangle>());
+    auto rectangle = shape->paths()[0]->as<rive::Rectangle>();
+
+    auto pathComposer = shape->pathComposer();
+    auto localPath = static_cast<TestRenderPath*>(pathComposer->localPath());
+    REQUIRE(localPath != nullptr);
+    auto version = pathComposer->localGeometryVersion();
+    auto commandCount = localPath->commands.size();
+    auto bounds = pathComposer->localRawPath().bounds();
+
+    // Moving and rotating the shape doesn't touch its local geometry.
+    shape->x(shape->x() + 25.0f);
+    shape->rotation(shape->rotation() + 0.5f);
+    artboard->advance(0.0f);
+    REQUIRE(pathComposer->localGeometryVersion() == version);
+    REQUIRE(localPath->commands.size() == commandCount);
+    REQUIRE(pathComposer->localRawPath().bounds() == bounds);
+
+    // Changing the path itself does.
+    rectangle->width(rectangle->width() + 10.0f);
+    artboard->advance(0.0f);
+    REQUIRE(pathComposer->localGeometryVersion() != version);
+    REQUIRE(localPath->commands.size() > commandCount);
+    REQUIRE(pathComposer->localRawPath().bounds().width() ==
+            Approx(bounds.width() + 10.0f).margin(0.001f));
+}
@@ -20,9 +20,12 @@
 
 #include <catch.hpp>
 
+#include "rive/math/mat2d.hpp"
 #include "rive/math/math_types.hpp"
 #include "rive/math/simd.hpp"
+#include "rive/math/simd_dispatch.hpp"
 #include <limits>
+#include <vector>
 
 #define CHECK_ALL(B) CHECK(simd::all(B))
 #define CHECK_ANY(B) CHECK(simd::any(B))
@@ -778,4 +781,73 @@ TEST_CASE("load4x4f", "[simd]")
     CHECK(simd::all(std::get<3>(c) == float4{12, 13, 14, 15}));
 }
 
+// Check that every dispatched kernel variant the CPU supports gives the same results as the
+// baseline.
+TEST_CASE("dispatch", "[simd]")
+{
+    std::vector<simd::ISA> isas;
+    for (simd::ISA isa :
+         {simd::ISA::baseline, simd::ISA::sse4_1, simd::ISA::avx2, simd::ISA::avx512})
+    {
+        if (simd::is_isa_supported(isa))
+        {
+            isas.push_back(isa);
+        }
+    }
+    REQUIRE(isas.size() >= 1);
+    CHECK(isas[0] == simd::ISA::baseline);
+    CHECK(simd::active_isa() == isas.back());
+
+    srand(0);
+    std::vector<Vec2D> pts(37);
+    for (Vec2D& pt : pts)
+    {
+        pt = {static_cast<float>(rand() % 2000) / 10 - 100,
+              static_cast<float>(rand() % 2000) / 10 - 100};
+    }
+    std::vector<Vec2D> nonfinitePts = pts;
+    nonfinitePts[5].y = kNaN;
+    nonfinitePts[20].x = kInf;
+    nonfinitePts[36].y = -kInf;
+    const Mat2D matrices[] = {Mat2D(),
+                              Mat2D(2, 0, 0, -3, 10, 20),
+                              Mat2D::fromRotation(.5f) * Mat2D(1.5f, 0, 0, .5f, -7, 3),
+                              Mat2D(1, .25f, -.75f, 1, 0, 0)};
+    for (const Mat2D& m : matrices)
+    {
+        for (size_t n = 0; n <= pts.size(); ++n)
+        {
+            REQUIRE(simd::force_isa(simd::ISA::baseline));
+            std::vector<Vec2D> expected(n);
+            m.mapPoints(expected.data(), pts.data(), n);
+            AABB expectedBounds = m.mapBoundingBox(pts.data(), n);
+            AABB expectedNonfiniteBounds = m.mapBoundingBox(nonfinitePts.data(), n);
+            for (size_t i = 0; i < n; ++i)
+            {
+                CHECK(expected[i].x == Approx(m[0] * pts[i].x + m[2] * pts[i].y + m[4]));
+                CHECK(expected[i].y == Approx(m[1] * pts[i].x + m[3] * pts[i].y + m[5]));
+                CHECK(expectedBounds.contains(expected[i]));
+            }
+            for (simd::ISA isa : isas)
+            {
+                INFO(simd::isa_name(isa) << ", " << n << " points");
+                REQUIRE(simd::force_isa(isa));
+                CHECK(simd::active_isa() == isa);
+                std::vector<Vec2D> mapped(n);
+                m.mapPoints(mapped.data(), pts.data(), n);
+                CHECK(mapped == expected);
+                CHECK(m.mapBoundingBox(pts.data(), n) == expectedBounds);
+                CHECK(m.mapBoundingBox(nonfinitePts.data(), n) == expectedNonfiniteBounds);
+
+                // In place.
+                std::vector<Vec2D> inPlace(pts.begin(), pts.begin() + n);
+                m.mapPoints(inPlace.data(), inPlace.data(), n);
+                CHECK(inPlace == expected);
+            }
+        }
+    }
+
+    simd::reset_isa();
+    CHECK(simd::active_isa() == isas.back());
+}
 } // namespace rive
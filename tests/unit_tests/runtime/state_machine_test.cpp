@@ -3,6 +3,7 @@
 #include <rive/animation/state_machine_layer.hpp>
 #include <rive/animation/animation_state.hpp>
 #include <rive/animation/entry_state.hpp>
+#include <rive/animation/any_state.hpp>
 #include <rive/animation/state_transition.hpp>
 #include <rive/animation/state_machine_instance.hpp>
 #include <rive/animation/state_machine_input_instance.hpp>
@@ -16,6 +17,7 @@
 #include <rive/shapes/shape.hpp>
 #include "catch.hpp"
 #include "rive_file_reader.hpp"
+#include <cmath>
 #include <cstdio>
 
 TEST_CASE("file with state machine be read", "[file]")
@@ -414,3 +416,145 @@ TEST_CASE("Transitions with reset applied to them.", "[file]")
 
     delete stateMachineInstance;
 }
+
+TEST_CASE("Transitions precompute their animation reset plans.", "[file]")
+{
+    auto file = ReadRiveFile("assets/animation_reset_cases.riv");
+
+    auto artboard = file->artboard("transitions");
+    auto stateMachine = artboard->stateMachine("transitions-state-machine");
+    REQUIRE(stateMachine != nullptr);
+    auto abi = artboard->instance();
+
+    size_t planCount = 0;
+    for (size_t i = 0; i < stateMachine->layerCount(); i++)
+    {
+        auto layer = stateMachine->layer(i);
+        for (size_t j = 0; j < layer->stateCount(); j++)
+        {
+            auto state = layer->state(j);
+            for (size_t k = 0; k < state->transitionCount(); k++)
+            {
+                auto transition = state->transition(k);
+                auto plan = transition->animationResetPlan();
+                if (state->is<rive::AnyState>() || transition->duration() == 0)
+                {
+                    REQUIRE(plan == nullptr);
+                    continue;
+                }
+                REQUIRE(plan != nullptr);
+                REQUIRE(plan->matches(
+                    rive::AnimationResetPlan::resetAnimation(state),
+                    rive::AnimationResetPlan::resetAnimation(transition->stateTo())));
+                planCount++;
+
+                // The plan captures the same values as building the reset on the fly.
+                auto stateFrom = state->makeInstance(abi.get());
+                auto stateTo = transition->stateTo()->makeInstance(abi.get());
+                auto planned = rive::AnimationResetFactory::fromStates(stateFrom.get(),
+                                                                       stateTo.get(),
+                                                                       abi.get(),
+                                                                       plan);
+                auto unplanned = rive::AnimationResetFactory::fromStates(stateFrom.get(),
+                                                                         stateTo.get(),
+                                                                         abi.get());
+                CHECK(planned->data() == unplanned->data());
+                rive::AnimationResetFactory::release(std::move(planned));
+                rive::AnimationResetFactory::release(std::move(unplanned));
+            }
+        }
+    }
+    REQUIRE(planCount > 0);
+}
+
+TEST_CASE("Transitions that only read inputs are evaluated when inputs change.", "[file]")
+{
+    auto file = ReadRiveFile("assets/rocket.riv");
+
+    auto artboard = file->artboard();
+    auto stateMachine = artboard->stateMachine("Button");
+    REQUIRE(stateMachine != nullptr);
+    auto layer = stateMachine->layer(0);
+    REQUIRE(layer->anyState()->transitionsOnlyReadInputs());
+
+    auto idleState = layer->entryState()->transition(0)->stateTo();
+    REQUIRE(idleState->transitionsOnlyReadInputs());
+    REQUIRE(!idleState->transitionInputIds().empty());
+
+    auto abi = artboard->instance();
+    rive::StateMachineInstance smi(stateMachine, abi.get());
+    auto hover = smi.getBool("Hover");
+    REQUIRE(hover != nullptr);
+
+    smi.advanceAndApply(0.1f);
+    REQUIRE(smi.stateChangedCount() == 1);
+    REQUIRE(smi.stateChangedByIndex(0) == idleState);
+
+    // Nothing changes while the inputs stay the same.
+    for (int i = 0; i < 10; i++)
+    {
+        smi.advanceAndApply(0.1f);
+        REQUIRE(smi.stateChangedCount() == 0);
+    }
+
+    // Setting an input to the value it already has isn't a change.
+    hover->value(false);
+    smi.advanceAndApply(0.1f);
+    REQUIRE(smi.stateChangedCount() == 0);
+
+    // The transitions get evaluated again as soon as an input they read changes.
+    hover->value(true);
+    smi.advanceAndApply(0.1f);
+    REQUIRE(smi.stateChangedCount() == 1);
+    REQUIRE(smi.stateChangedByIndex(0) != idleState);
+}
+
+TEST_CASE("State machines report when they've settled.", "[file]")
+{
+    auto file = ReadRiveFile("assets/rocket.riv");
+
+    auto abi = file->artboard()->instance();
+    rive::StateMachineInstance smi(abi->stateMachine("Button"), abi.get());
+    REQUIRE(smi.settledSeconds() == 0.0f);
+
+    // Keeps animating until the idle animation stops.
+    float seconds = 0.0f;
+    while (smi.advanceAndApply(0.1f))
+    {
+        REQUIRE(smi.settledSeconds() == 0.0f);
+        seconds += 0.1f;
+        REQUIRE(seconds < 10.0f);
+    }
+    REQUIRE(std::isinf(smi.settledSeconds()));
+
+    // Changes from the outside need an advance.
+    abi->addDirt(rive::ComponentDirt::Paint);
+    REQUIRE(smi.settledSeconds() == 0.0f);
+    smi.advanceAndApply(0.1f);
+    REQUIRE(std::isinf(smi.settledSeconds()));
+
+    smi.getBool("Hover")->value(true);
+    REQUIRE(smi.settledSeconds() == 0.0f);
+    smi.advanceAndApply(0.1f);
+    REQUIRE(smi.stateChangedCount() == 1);
+    REQUIRE(smi.settledSeconds() == 0.0f);
+}
+
+TEST_CASE("State machines settle while waiting on animations that only report events.", "[file]")
+{
+    auto file = ReadRiveFile("assets/events_on_states.riv");
+
+    auto abi = file->artboard()->instance();
+    auto smi = abi->stateMachineAt(0);
+    smi->advanceAndApply(0.0f);
+    smi->advanceAndApply(0.1f);
+    REQUIRE(smi->currentAnimationCount() == 1);
+    auto animationInstance = smi->currentAnimationByIndex(0);
+    REQUIRE(animationInstance->animation()->keysOnlyCallbacks());
+
+    // The state keeps going, but nothing changes until its animation loops.
+    auto seconds = smi->settledSeconds();
+    REQUIRE(seconds > 0.0f);
+    REQUIRE(seconds ==
+            Approx(animationInstance->animation()->durationSeconds() - animationInstance->time()));
+}
@@ -332,3 +332,49 @@ TEST_CASE("double new line type works", "[text]")
     auto lines = text->orderedLines();
     REQUIRE(lines.size() == 3);
 }
+
+TEST_CASE("layout changes don't reshape text", "[text]")
+{
+    auto file = ReadRiveFile("assets/hello_world.riv");
+    auto artboard = file->artboard();
+    auto text = artboard->find<rive::Text>()[0];
+    auto run = artboard->find<rive::TextValueRun>()[0];
+
+    artboard->advance(0.0f);
+    REQUIRE(text->shape().size() == 1);
+    const rive::Paragraph* shaped = text->shape().data();
+
+    // Realigning only breaks the lines again.
+    text->alignValue((uint32_t)rive::TextAlign::center);
+    artboard->advance(0.0f);
+    REQUIRE(text->shape().data() == shaped);
+    REQUIRE(text->orderedLines().size() == 1);
+
+    // Changing the content shapes it again.
+    run->text("Just Hello");
+    artboard->advance(0.0f);
+    REQUIRE(text->shape().size() == 1);
+    REQUIRE(text->shape()[0].runs[0].glyphs.size() == 10);
+}
+
+TEST_CASE("styled text compares content and styles", "[text]")
+{
+    rive::StyledText a;
+    a.append(nullptr, 12.0f, -1.0f, 0.0f, "Hello", 0);
+    rive::StyledText b;
+    b.append(nullptr, 12.0f, -1.0f, 0.0f, "Hello", 0);
+    CHECK(a == b);
+
+    b.clear();
+    b.append(nullptr, 13.0f, -1.0f, 0.0f, "Hello", 0);
+    CHECK(a != b);
+
+    b.clear();
+    b.append(nullptr, 12.0f, -1.0f, 0.0f, "Hell", 0);
+    b.append(nullptr, 12.0f, -1.0f, 0.0f, "o", 0);
+    CHECK(a != b);
+
+    b.clear();
+    b.append(nullptr, 12.0f, -1.0f, 0.0f, "Hello", 1);
+    CHECK(a != b);
+}
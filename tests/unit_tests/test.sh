@@ -14,6 +14,8 @@ CONFIG=debug
 for var in "$@"; do
   if [[ $var = "release" ]]; then
     CONFIG=release
+  elif [[ $var = "arena" ]]; then
+    ARENA=true
   elif [ "$var" = "memory" ]; then
     echo Will perform memory checks...
     UTILITY='leaks --atExit --'
@@ -74,9 +76,16 @@ popd
 
 export PREMAKE_PATH="$RUNTIME/dependencies/export-compile-commands":"$RUNTIME/build":"$PREMAKE_PATH"
 PREMAKE_COMMANDS="--with_rive_text --with_rive_audio=external --with_rive_layout --config=$CONFIG"
+if [[ $ARENA = true ]]; then
+  PREMAKE_COMMANDS="$PREMAKE_COMMANDS --with_rive_core_arena"
+fi
 
 out_dir() {
-  echo "out/$CONFIG"
+  if [[ $ARENA = true ]]; then
+    echo "out/${CONFIG}_arena"
+  else
+    echo "out/$CONFIG"
+  fi
 }
 if [[ $machine = "macosx" ]]; then
   OUT_DIR="$(out_dir)"
@@ -34,6 +34,7 @@ public:
         {
             content->handleDraw(m_renderer.get(), elapsed);
         }
+        m_renderer->flush();
     }
 };
 
@@ -6,12 +6,14 @@
 
 rive::rcp<rive::RenderImage> ViewerSokolFactory::decodeImage(rive::Span<const uint8_t> bytes)
 {
-    auto bitmap = Bitmap::decode(bytes.data(), bytes.size());
+    // For now our SokolRenderImage only works with RGBA. Ask the decoders to
+    // write it directly, and convert if one can't.
+    Bitmap::DecodeOptions options;
+    options.forceRGBA = true;
+    auto bitmap = Bitmap::decode(bytes.data(), bytes.size(), options);
     if (bitmap)
     {
         // We have a bitmap, let's make an image.
-
-        // For now our SokolRenderImage only works with RGBA.
         if (bitmap->pixelFormat() != Bitmap::PixelFormat::RGBA)
         {
             bitmap->pixelFormat(Bitmap::PixelFormat::RGBA);